@@ -52,6 +52,10 @@ void CollectionConfig::setLoaded(uint32_t loaded) {
 	config->loaded = loaded; 
 }
 
+void CollectionConfig::setReuseBuffers(bool reuseBuffers) {
+	config->reuseBuffers = reuseBuffers;
+}
+
 uint32_t CollectionConfig::getCapacity() const {
 	return config->capacity; 
 }
@@ -64,6 +68,10 @@ uint32_t CollectionConfig::getLoaded() const {
 	return config->loaded;
 }
 
+bool CollectionConfig::getReuseBuffers() const {
+	return config->reuseBuffers;
+}
+
 fiftyoneDegreesCollectionConfig* CollectionConfig::getConfig() const {
 	return config;
 }
\ No newline at end of file
@@ -95,6 +95,13 @@ namespace FiftyoneDegrees {
 			 */
 			void setLoaded(uint32_t loaded);
 
+			/**
+			 * Set whether the memory items are read into from file without a
+			 * cache is kept by the thread for reuse rather than freed.
+			 * @param reuseBuffers true if the memory should be reused
+			 */
+			void setReuseBuffers(bool reuseBuffers);
+
 			/**
 			 * @}
 			 * @name Getters
@@ -120,6 +127,13 @@ namespace FiftyoneDegrees {
 			 */
 			uint32_t getLoaded() const;
 
+			/**
+			 * Get whether the memory items are read into from file without a
+			 * cache is kept by the thread for reuse rather than freed.
+			 * @return true if the memory is reused
+			 */
+			bool getReuseBuffers() const;
+
 			/**
 			 * Get a pointer to the underlying configuration structure.
 			 * @return C structure pointer
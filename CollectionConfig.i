@@ -31,8 +31,10 @@ public:
 	void setCapacity(uint32_t capacity);
 	void setConcurrency(uint16_t concurrency);
 	void setLoaded(uint32_t loaded);
+	void setReuseBuffers(bool reuseBuffers);
 
 	uint32_t getCapacity();
 	uint16_t getConcurrency();
 	uint32_t getLoaded();
+	bool getReuseBuffers();
 };
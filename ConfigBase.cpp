@@ -56,6 +56,30 @@ void ConfigBase::setPropertyValueIndex(bool index) {
 	this->config->propertyValueIndex = index;
 }
 
+void ConfigBase::setPropertyValueIndexSidecar(bool sidecar) {
+	this->config->propertyValueIndexSidecar = sidecar;
+}
+
+void ConfigBase::setPropertyValueIndexLazy(bool lazy) {
+	this->config->propertyValueIndexLazy = lazy;
+}
+
+void ConfigBase::setPropertyValueIndexBackground(bool background) {
+	this->config->propertyValueIndexBackground = background;
+}
+
+void ConfigBase::setPropertyValueIndexRanges(bool ranges) {
+	this->config->propertyValueIndexRanges = ranges;
+}
+
+void ConfigBase::setRenderCacheCapacity(uint32_t capacity) {
+	this->config->renderCacheCapacity = capacity;
+}
+
+void ConfigBase::setWktCacheCapacity(uint32_t capacity) {
+	this->config->wktCacheCapacity = capacity;
+}
+
 bool ConfigBase::getUseUpperPrefixHeaders() const {
 	return config->usesUpperPrefixedHeaders;
 }
@@ -76,6 +100,30 @@ bool ConfigBase::getPropertyValueIndex() const {
 	return config->propertyValueIndex;
 }
 
+bool ConfigBase::getPropertyValueIndexSidecar() const {
+	return config->propertyValueIndexSidecar;
+}
+
+bool ConfigBase::getPropertyValueIndexLazy() const {
+	return config->propertyValueIndexLazy;
+}
+
+bool ConfigBase::getPropertyValueIndexBackground() const {
+	return config->propertyValueIndexBackground;
+}
+
+bool ConfigBase::getPropertyValueIndexRanges() const {
+	return config->propertyValueIndexRanges;
+}
+
+uint32_t ConfigBase::getRenderCacheCapacity() const {
+	return config->renderCacheCapacity;
+}
+
+uint32_t ConfigBase::getWktCacheCapacity() const {
+	return config->wktCacheCapacity;
+}
+
 uint16_t ConfigBase::getConcurrency() const {
 	return 0;
 }
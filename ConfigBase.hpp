@@ -120,6 +120,50 @@ namespace FiftyoneDegrees {
 			 */
 			void setPropertyValueIndex(bool index);
 
+			/**
+			 * Set whether or not the index of values for profiles and
+			 * properties should be loaded from, and saved to, a sidecar file
+			 * next to the data file to avoid creating it at start up.
+			 * @param sidecar should use a sidecar file
+			 */
+			void setPropertyValueIndexSidecar(bool sidecar);
+
+			/**
+			 * Set whether or not the index of values for profiles and
+			 * properties is populated for each profile when first used rather
+			 * than when the data set is created.
+			 * @param lazy should populate the index on demand
+			 */
+			void setPropertyValueIndexLazy(bool lazy);
+
+			/**
+			 * Set whether or not a background thread populates the remaining
+			 * rows of a lazy index after start up.
+			 * @param background should complete the index in the background
+			 */
+			void setPropertyValueIndexBackground(bool background);
+
+			/**
+			 * Set whether or not the index to values should also record the
+			 * position after the last value for each profile and property.
+			 * @param ranges should record the ranges of values
+			 */
+			void setPropertyValueIndexRanges(bool ranges);
+
+			/**
+			 * Set the maximum number of rendered property value strings to
+			 * cache for the data set. Zero disables the cache.
+			 * @param capacity maximum number of strings to cache
+			 */
+			void setRenderCacheCapacity(uint32_t capacity);
+
+			/**
+			 * Set the maximum number of WKT strings rendered from geometry
+			 * values to cache for the data set. Zero disables the cache.
+			 * @param capacity maximum number of strings to cache
+			 */
+			void setWktCacheCapacity(uint32_t capacity);
+
 			/**
 			 * @}
 			 * @name Getters
@@ -163,6 +207,48 @@ namespace FiftyoneDegrees {
 			 */
 			bool getPropertyValueIndex() const;
 
+			/**
+			 * Gets a flag indicating if the index of values for properties and
+			 * profiles is loaded from, and saved to, a sidecar file.
+			 * @return true if a sidecar file should be used, or false if not.
+			 */
+			bool getPropertyValueIndexSidecar() const;
+
+			/**
+			 * Gets a flag indicating if the index of values for properties and
+			 * profiles is populated on demand.
+			 * @return true if the index is lazy, or false if not.
+			 */
+			bool getPropertyValueIndexLazy() const;
+
+			/**
+			 * Gets a flag indicating if a background thread populates the
+			 * remaining rows of a lazy index.
+			 * @return true if a background thread is used, or false if not.
+			 */
+			bool getPropertyValueIndexBackground() const;
+
+			/**
+			 * Get whether or not the index to values records the range of
+			 * values for each profile and property.
+			 * @return true if ranges are recorded, or false if not.
+			 */
+			bool getPropertyValueIndexRanges() const;
+
+			/**
+			 * Get the maximum number of rendered property value strings
+			 * cached for the data set.
+			 * @return capacity of the cache, or zero if disabled.
+			 */
+			uint32_t getRenderCacheCapacity() const;
+
+			/**
+			 * Get the maximum number of WKT strings rendered from geometry
+			 * values cached for the data set.
+			 * @return capacity of the cache, or zero if disabled.
+			 */
+			uint32_t getWktCacheCapacity() const;
+
 			/**
 			 * Get the expected number of concurrent accessors of the data set.
 			 * @return concurrency
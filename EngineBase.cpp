@@ -22,6 +22,11 @@
 
 #include "EngineBase.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "fiftyone.h"
 #include "string_pp.hpp"
 
@@ -147,6 +152,133 @@ const vector<string>* EngineBase::getKeys() const {
 	return &keys;
 }
 
+namespace {
+	/**
+	 * Holds a use of the data set for the lifetime of the instance.
+	 */
+	class BatchPin {
+	public:
+		BatchPin(fiftyoneDegreesResourceManager *manager)
+			: handle(ResourceHandleIncUse(manager)) {}
+		~BatchPin() { ResourceHandleDecUse(handle); }
+		BatchPin(const BatchPin&) = delete;
+		BatchPin& operator=(const BatchPin&) = delete;
+		fiftyoneDegreesResourceHandle * const handle;
+	};
+
+	/**
+	 * Worker threads which are joined when the instance is destroyed,
+	 * including when a later thread could not be started.
+	 */
+	class BatchWorkers : public vector<std::thread> {
+	public:
+		~BatchWorkers() {
+			for (std::thread &worker : *this) {
+				if (worker.joinable()) {
+					worker.join();
+				}
+			}
+		}
+	};
+}
+
+vector<BatchThroughput> EngineBase::processBatchBase(
+	EvidenceBase * const *evidence,
+	size_t count,
+	vector<ResultsBase*> &results,
+	uint16_t concurrency) const {
+	std::atomic<size_t> next(0);
+	std::exception_ptr error = nullptr;
+	std::mutex errorLock;
+
+	// Delete any results beyond the end of this batch and make space for
+	// the results of every item.
+	for (size_t i = count; i < results.size(); i++) {
+		delete results[i];
+	}
+	results.resize(count, nullptr);
+
+	// Only use as many workers as there is evidence, and a single worker if
+	// the engine can't process evidence concurrently.
+	if (concurrency == 0 || getIsThreadSafe() == false) {
+		concurrency = 1;
+	}
+	if ((size_t)concurrency > count) {
+		concurrency = count == 0 ? 1 : (uint16_t)count;
+	}
+	vector<BatchThroughput> throughput(concurrency);
+
+	// Pin the data set once so that every item in the batch is processed
+	// against it, and it is not freed during a refresh.
+	BatchPin pin(manager.get());
+
+	// Each worker takes the next unprocessed index until none remain,
+	// storing the results at the same index as the evidence. Workers pin
+	// their thread to the data set so that the uses taken by the results of
+	// each item are taken from it in batches.
+	auto work = [&](uint16_t thread) {
+		BatchThroughput *metrics = &throughput[thread];
+		auto start = std::chrono::steady_clock::now();
+		metrics->thread = thread;
+		metrics->count = 0;
+		ResourceHandlePinThread(pin.handle);
+		try {
+			for (size_t i = next++; i < count; i = next++) {
+				ResultsBase *previous = results[i];
+				results[i] = nullptr;
+				results[i] = processBatchItem(
+					pin.handle,
+					evidence[i],
+					previous);
+				metrics->count++;
+			}
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(errorLock);
+			if (error == nullptr) {
+				error = std::current_exception();
+			}
+			next = count;
+		}
+		ResourceHandleUnpinThread();
+		metrics->seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+		metrics->perSecond = metrics->seconds > 0 ?
+			(double)metrics->count / metrics->seconds : 0;
+
+		// Threads started for the batch add any memory accounted to them
+		// before they exit.
+		if (thread > 0) {
+			MemoryAccountingFlush();
+		}
+	};
+
+	// Run the first worker on the calling thread, and the rest on new
+	// threads. The workers are joined before the data set is unpinned.
+	{
+		BatchWorkers workers;
+		workers.reserve(concurrency - 1);
+		for (uint16_t i = 1; i < concurrency; i++) {
+			workers.emplace_back(work, i);
+		}
+		work(0);
+	}
+
+	if (error != nullptr) {
+		std::rethrow_exception(error);
+	}
+	return throughput;
+}
+
+ResultsBase* EngineBase::processBatchItem(
+	fiftyoneDegreesResourceHandle *handle,
+	EvidenceBase *evidence,
+	ResultsBase *previous) const {
+	(void)handle;
+	delete previous;
+	return processBase(evidence);
+}
+
 bool EngineBase::getIsThreadSafe() const {
 	return ThreadingGetIsThreadSafe();
 }
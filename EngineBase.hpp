@@ -38,10 +38,27 @@
 #include "dataset.h"
 #include "property.h"
 #include "collection.h"
+#include "resource.h"
 
 
 namespace FiftyoneDegrees {
 	namespace Common {
+		/**
+		 * Throughput of a single worker thread used by
+		 * EngineBase::processBatchBase. One instance is returned for each
+		 * worker that took part in processing the batch.
+		 */
+		struct BatchThroughput {
+			/** Index of the worker thread within the batch. */
+			uint16_t thread;
+			/** Number of evidence items processed by the worker. */
+			size_t count;
+			/** Elapsed seconds the worker spent processing. */
+			double seconds;
+			/** Items processed per second by the worker. */
+			double perSecond;
+		};
+
 		/**
 		 * Encapsulates the engine class to be extended by engine
 		 * implementations. Common logic is contained in this base class to be
@@ -113,6 +130,31 @@ namespace FiftyoneDegrees {
 			 */
 			virtual ResultsBase* processBase(EvidenceBase *evidence) const = 0;
 
+			/**
+			 * Processes a batch of evidence, placing the results in the same
+			 * order as the evidence. The data set is pinned once for the
+			 * whole batch so that every item is processed against the same
+			 * data set, even if the engine is refreshed part way through.
+			 * Any results already present in the results vector are passed
+			 * to #processBatchItem so that engines which support it can reuse
+			 * their storage when the same vector is used for consecutive
+			 * batches. Results which are not reused are deleted.
+			 * The caller is responsible for deleting the results.
+			 * @param evidence pointer to the first item of evidence
+			 * @param count number of items of evidence
+			 * @param results vector to be resized to count and populated
+			 * with a results instance for each item of evidence
+			 * @param concurrency maximum number of worker threads to use. If
+			 * the engine is not thread-safe, or is 0 or 1, then the batch is
+			 * processed on the calling thread
+			 * @return throughput for each worker thread that was used
+			 */
+			virtual vector<BatchThroughput> processBatchBase(
+				EvidenceBase * const *evidence,
+				size_t count,
+				vector<ResultsBase*> &results,
+				uint16_t concurrency = 1) const;
+
 			/**
 			 * Refresh the data set from the original file location. This
 			 * should be implemented by the extending class.
@@ -322,6 +364,26 @@ namespace FiftyoneDegrees {
 			 * @param key to add
 			 */
 			void addKey(string key);
+
+			/**
+			 * Processes a single item of evidence from a batch using the data
+			 * set pinned by #processBatchBase. The calling thread is pinned
+			 * to the handle with #fiftyoneDegreesResourceHandlePinThread, so
+			 * the results created by #processBase use the pinned data set and
+			 * take their use of it without an interlocked operation. The
+			 * default implementation deletes any previous results and calls
+			 * #processBase. Engines can override this to reset and refill
+			 * the previous results rather than allocating new ones.
+			 * @param handle to the data set pinned for the batch
+			 * @param evidence to process
+			 * @param previous results for the same position from an earlier
+			 * batch, or nullptr if there are none
+			 * @return results for the evidence
+			 */
+			virtual ResultsBase* processBatchItem(
+				fiftyoneDegreesResourceHandle *handle,
+				EvidenceBase *evidence,
+				ResultsBase *previous) const;
 		};
 	}
 }
@@ -0,0 +1,173 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_MEMORY_COLLECTION_HPP
+#define FIFTYONE_DEGREES_MEMORY_COLLECTION_HPP
+
+#include "collection.h"
+
+namespace FiftyoneDegrees {
+	namespace Common {
+		/**
+		 * Typed, statically dispatched access to the elements of a
+		 * collection which is held in continuous memory. Elements are
+		 * returned as pointers into the collection's memory without the
+		 * collection's get method, an item, or a release, so the accessors
+		 * can be inlined and loops over the elements optimised by the
+		 * compiler.
+		 *
+		 * If the collection is not held in memory, for example because it is
+		 * cached or read from file, then isValid() returns false and the
+		 * collection's get method must be used instead.
+		 *
+		 * ## Usage Example
+		 *
+		 * ```
+		 * using namespace FiftyoneDegrees::Common;
+		 * fiftyoneDegreesCollection *values;
+		 * MemoryCollection<fiftyoneDegreesValue> memory(values);
+		 * if (memory.isValid()) {
+		 *     for (const fiftyoneDegreesValue &value : memory) {
+		 *         // Do something with the value
+		 *         // ...
+		 *     }
+		 * }
+		 * ```
+		 *
+		 * @tparam T type of the elements in the collection
+		 */
+		template <class T> class MemoryCollection {
+		public:
+			/**
+			 * @name Constructors
+			 * @{
+			 */
+
+			/**
+			 * Constructs a new instance for the collection provided.
+			 * @param collection to access the elements of
+			 */
+			MemoryCollection(const fiftyoneDegreesCollection *collection) {
+				fiftyoneDegreesCollectionMemory *memory =
+					fiftyoneDegreesCollectionGetMemory(collection);
+				if (memory != nullptr) {
+					firstByte = memory->firstByte;
+					size = collection->size;
+					count = collection->elementSize == sizeof(T) ?
+						collection->count : 0;
+				}
+			}
+
+			/**
+			 * @}
+			 * @name Accessors
+			 * @{
+			 */
+
+			/**
+			 * Get whether or not the collection is held in memory and the
+			 * accessors can be used.
+			 * @return true if the collection is held in memory
+			 */
+			bool isValid() const { return firstByte != nullptr; }
+
+			/**
+			 * Get the number of fixed size elements which can be accessed by
+			 * index. This is zero if the collection is not held in memory,
+			 * contains variable size elements, or elements of a different
+			 * size to T.
+			 * @return number of elements
+			 */
+			uint32_t getCount() const { return count; }
+
+			/**
+			 * Get the number of bytes of data in the collection.
+			 * @return size of the collection in bytes
+			 */
+			uint32_t getSize() const { return size; }
+
+			/**
+			 * Get the fixed size element at the index without checking the
+			 * index is less than getCount().
+			 * @param index of the element
+			 * @return reference to the element
+			 */
+			const T& operator[](uint32_t index) const {
+				return *FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX(
+					this, T, index);
+			}
+
+			/**
+			 * Get the fixed size element at the index.
+			 * @param index of the element
+			 * @return pointer to the element, or nullptr if the index is not
+			 * less than getCount()
+			 */
+			const T* getByIndex(uint32_t index) const {
+				return index < count ?
+					FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX(this, T, index) :
+					nullptr;
+			}
+
+			/**
+			 * Get the variable size element at the offset in bytes.
+			 * @param offset of the element
+			 * @return pointer to the element, or nullptr if the offset is not
+			 * less than getSize()
+			 */
+			const T* getByOffset(uint32_t offset) const {
+				return offset < size ?
+					FIFTYONE_DEGREES_COLLECTION_MEMORY_OFFSET(this, T, offset) :
+					nullptr;
+			}
+
+			/**
+			 * Get the first fixed size element.
+			 * @return pointer to the first element
+			 */
+			const T* begin() const { return (const T*)firstByte; }
+
+			/**
+			 * Get the end of the fixed size elements.
+			 * @return pointer to the element after the last element
+			 */
+			const T* end() const { return (const T*)firstByte + count; }
+
+			/**
+			 * @}
+			 */
+
+		private:
+			/** First byte of the collection's data, or nullptr if the
+			collection is not held in memory. */
+			const byte *firstByte = nullptr;
+
+			/** Number of bytes of data. */
+			uint32_t size = 0;
+
+			/** Number of fixed size elements of type T. */
+			uint32_t count = 0;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,329 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "MetaDataView.hpp"
+#include "fiftyone.h"
+#include "string_pp.hpp"
+
+using namespace FiftyoneDegrees::Common;
+
+// Returns the number of items in the collection or zero if not present.
+static uint32_t getCount(const fiftyoneDegreesCollection *collection) {
+	return collection == nullptr ? 0 : collection->count;
+}
+
+PinnedItem::PinnedItem() {
+	DataReset(&item.data);
+	item.collection = nullptr;
+	item.handle = nullptr;
+}
+
+PinnedItem::PinnedItem(fiftyoneDegreesCollectionItem &item) : item(item) {}
+
+PinnedItem::PinnedItem(PinnedItem &&other) noexcept : item(other.item) {
+	other.item.collection = nullptr;
+}
+
+PinnedItem& PinnedItem::operator=(PinnedItem &&other) noexcept {
+	if (this != &other) {
+		release();
+		item = other.item;
+		other.item.collection = nullptr;
+	}
+	return *this;
+}
+
+PinnedItem::~PinnedItem() {
+	release();
+}
+
+void PinnedItem::release() {
+	if (item.collection != nullptr) {
+		COLLECTION_RELEASE(item.collection, &item);
+		item.collection = nullptr;
+	}
+}
+
+PinnedString::PinnedString(
+	fiftyoneDegreesCollectionItem &item,
+	const fiftyoneDegreesString *value) : PinnedItem(item) {
+	if (value != nullptr && value->size > 1) {
+		this->value = string_view(&value->value, (size_t)value->size - 1);
+	}
+}
+
+PinnedString::PinnedString(PinnedString &&other) noexcept
+	: PinnedItem(std::move(other)), value(other.value) {
+	other.value = string_view();
+}
+
+PinnedString& PinnedString::operator=(PinnedString &&other) noexcept {
+	if (this != &other) {
+		PinnedItem::operator=(std::move(other));
+		value = other.value;
+		other.value = string_view();
+	}
+	return *this;
+}
+
+PinnedBinaryValue::PinnedBinaryValue(
+	fiftyoneDegreesCollectionItem &item,
+	const fiftyoneDegreesStoredBinaryValue *value,
+	fiftyoneDegreesPropertyValueType storedType)
+	: PinnedItem(item), value(value), storedType(storedType) {}
+
+PinnedBinaryValue::PinnedBinaryValue(PinnedBinaryValue &&other) noexcept
+	: PinnedItem(std::move(other)), value(other.value),
+	storedType(other.storedType) {
+	other.value = nullptr;
+}
+
+string PinnedBinaryValue::str() const {
+	if (value == nullptr) {
+		return string();
+	}
+	EXCEPTION_CREATE;
+	std::stringstream stream;
+	writeStoredBinaryValueToStringStream(
+		value,
+		storedType,
+		stream,
+		(uint8_t)stream.precision(),
+		exception);
+	EXCEPTION_THROW;
+	return stream.str();
+}
+
+// Gets the string using the method provided, returning an empty string if
+// the entity is not available.
+template <class T> static PinnedString getString(
+	const fiftyoneDegreesCollection *strings,
+	const T *entity,
+	const fiftyoneDegreesString*(*method)(
+		const fiftyoneDegreesCollection*,
+		const T*,
+		fiftyoneDegreesCollectionItem*,
+		fiftyoneDegreesException*)) {
+	EXCEPTION_CREATE;
+	Item item;
+	DataReset(&item.data);
+	item.collection = nullptr;
+	item.handle = nullptr;
+	if (strings == nullptr || entity == nullptr) {
+		return PinnedString();
+	}
+	const fiftyoneDegreesString *value = method(
+		strings,
+		entity,
+		&item,
+		exception);
+	if (EXCEPTION_OKAY == false && item.collection != nullptr) {
+		COLLECTION_RELEASE(item.collection, &item);
+	}
+	EXCEPTION_THROW;
+	return PinnedString(item, value);
+}
+
+PropertyView::PropertyView(const MetaDataViews *views, uint32_t index)
+	: EntityView(views, index) {
+	EXCEPTION_CREATE;
+	entity = PropertyGet(
+		views->getCollections().properties,
+		index,
+		&item,
+		exception);
+	EXCEPTION_THROW;
+}
+
+PinnedString PropertyView::getName() const {
+	return getString(views->getCollections().strings, entity, PropertyGetName);
+}
+
+PinnedString PropertyView::getDescription() const {
+	return getString(
+		views->getCollections().strings,
+		entity,
+		PropertyGetDescription);
+}
+
+PinnedString PropertyView::getCategory() const {
+	return getString(
+		views->getCollections().strings,
+		entity,
+		PropertyGetCategory);
+}
+
+PinnedString PropertyView::getUrl() const {
+	return getString(views->getCollections().strings, entity, PropertyGetUrl);
+}
+
+ViewRange<ValueView> PropertyView::getValues() const {
+	if (getCount(views->getCollections().values) == 0 ||
+		entity->lastValueIndex < entity->firstValueIndex) {
+		return ViewRange<ValueView>(views, 0, 0);
+	}
+	return ViewRange<ValueView>(
+		views,
+		entity->firstValueIndex,
+		entity->lastValueIndex + 1);
+}
+
+ValueView::ValueView(const MetaDataViews *views, uint32_t index)
+	: EntityView(views, index) {
+	EXCEPTION_CREATE;
+	entity = ValueGet(
+		views->getCollections().values,
+		index,
+		&item,
+		exception);
+	EXCEPTION_THROW;
+}
+
+fiftyoneDegreesPropertyValueType ValueView::getStoredType() const {
+	const fiftyoneDegreesCollection *propertyTypes =
+		views->getCollections().propertyTypes;
+	if (propertyTypes == nullptr) {
+		return FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING;
+	}
+	EXCEPTION_CREATE;
+	PropertyValueType storedType = PropertyGetStoredTypeByIndex(
+		propertyTypes,
+		(uint32_t)entity->propertyIndex,
+		exception);
+	EXCEPTION_THROW;
+	return storedType;
+}
+
+PinnedString ValueView::getName() const {
+	// The name offset only refers to a string for values stored as strings.
+	if (getStoredType() != FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING) {
+		return PinnedString();
+	}
+	return getString(views->getCollections().strings, entity, ValueGetName);
+}
+
+PinnedBinaryValue ValueView::getContent() const {
+	EXCEPTION_CREATE;
+	Item item;
+	DataReset(&item.data);
+	item.collection = nullptr;
+	item.handle = nullptr;
+	PropertyValueType storedType = getStoredType();
+	const fiftyoneDegreesCollection *strings = views->getCollections().strings;
+	const StoredBinaryValue *value = nullptr;
+	if (strings != nullptr) {
+		value = ValueGetContent(strings, entity, storedType, &item, exception);
+		if (EXCEPTION_OKAY == false && item.collection != nullptr) {
+			COLLECTION_RELEASE(item.collection, &item);
+		}
+		EXCEPTION_THROW;
+	}
+	return PinnedBinaryValue(item, value, storedType);
+}
+
+PinnedString ValueView::getDescription() const {
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+	return getString(
+		views->getCollections().strings,
+		entity,
+		ValueGetDescription);
+#else
+	return PinnedString();
+#endif
+}
+
+PinnedString ValueView::getUrl() const {
+	if (getIsWeighted()) {
+		return PinnedString();
+	}
+	return getString(views->getCollections().strings, entity, ValueGetUrl);
+}
+
+bool ValueView::getIsWeighted() const {
+	return ValueIsWeighted(entity);
+}
+
+uint16_t ValueView::getWeight() const {
+	return ValueGetWeight(entity);
+}
+
+PropertyView ValueView::getProperty() const {
+	return PropertyView(views, getPropertyIndex());
+}
+
+ProfileView::ProfileView(const MetaDataViews *views, uint32_t index)
+	: EntityView(views, index) {
+	EXCEPTION_CREATE;
+	entity = ProfileGetByIndex(
+		views->getCollections().profileOffsets,
+		views->getCollections().profiles,
+		index,
+		&item,
+		exception);
+	EXCEPTION_THROW;
+}
+
+ViewIndexRange<ValueView> ProfileView::getValues() const {
+	// The value indexes immediately follow the profile.
+	return ViewIndexRange<ValueView>(
+		views,
+		(const uint32_t*)(entity + 1),
+		entity->valueCount);
+}
+
+MetaDataViews::MetaDataViews(
+	shared_ptr<fiftyoneDegreesResourceManager> manager,
+	MetaDataCollectionsMethod getCollections) : manager(manager) {
+	handle = ResourceHandleIncUse(manager.get());
+	collections = getCollections(handle->resource);
+}
+
+MetaDataViews::~MetaDataViews() {
+	ResourceHandleDecUse(handle);
+}
+
+ViewRange<PropertyView> MetaDataViews::getProperties() const {
+	return ViewRange<PropertyView>(this, 0, getCount(collections.properties));
+}
+
+ViewRange<ValueView> MetaDataViews::getValues() const {
+	return ViewRange<ValueView>(this, 0, getCount(collections.values));
+}
+
+ViewRange<ProfileView> MetaDataViews::getProfiles() const {
+	return ViewRange<ProfileView>(
+		this,
+		0,
+		getCount(collections.profileOffsets));
+}
+
+PropertyView MetaDataViews::getProperty(uint32_t index) const {
+	return PropertyView(this, index);
+}
+
+ValueView MetaDataViews::getValue(uint32_t index) const {
+	return ValueView(this, index);
+}
+
+ProfileView MetaDataViews::getProfile(uint32_t index) const {
+	return ProfileView(this, index);
+}
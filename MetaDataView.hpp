@@ -0,0 +1,656 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_METADATA_VIEW_HPP
+#define FIFTYONE_DEGREES_METADATA_VIEW_HPP
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include "Exceptions.hpp"
+#include "collection.h"
+#include "resource.h"
+#include "property.h"
+#include "value.h"
+#include "profile.h"
+#include "storedBinaryValue.h"
+
+using std::shared_ptr;
+using std::string;
+using std::string_view;
+
+namespace FiftyoneDegrees {
+	namespace Common {
+		/**
+		 * Collections of a data set which the meta data views read from.
+		 * Any collection which is not present in the data set can be NULL
+		 * in which case the related views will be empty.
+		 */
+		struct MetaDataCollections {
+			/** Strings containing names, descriptions, etc. */
+			fiftyoneDegreesCollection *strings = nullptr;
+			/** Fixed size property records */
+			fiftyoneDegreesCollection *properties = nullptr;
+			/** Fixed size value records */
+			fiftyoneDegreesCollection *values = nullptr;
+			/** Variable size profile records */
+			fiftyoneDegreesCollection *profiles = nullptr;
+			/** Fixed size offsets to the profile records */
+			fiftyoneDegreesCollection *profileOffsets = nullptr;
+			/** Fixed size records of the type each property's values are
+			stored as, or NULL if all values are stored as strings */
+			fiftyoneDegreesCollection *propertyTypes = nullptr;
+		};
+
+		/**
+		 * Returns the collections of the data set provided. Implemented by
+		 * the engine which knows the layout of its data set.
+		 * @param dataSet pointer to the data set from the resource manager
+		 * @return collections for the meta data views to use
+		 */
+		typedef MetaDataCollections(*MetaDataCollectionsMethod)(
+			const void *dataSet);
+
+		class MetaDataViews;
+
+		/**
+		 * Collection item which is released when the instance is destroyed.
+		 * Instances can be moved but not copied.
+		 */
+		class PinnedItem {
+		public:
+			PinnedItem(PinnedItem &&other) noexcept;
+
+			PinnedItem& operator=(PinnedItem &&other) noexcept;
+
+			PinnedItem(const PinnedItem&) = delete;
+
+			PinnedItem& operator=(const PinnedItem&) = delete;
+
+			/**
+			 * Releases the item.
+			 */
+			virtual ~PinnedItem();
+
+		protected:
+			/**
+			 * Constructs a new instance without an item.
+			 */
+			PinnedItem();
+
+			/**
+			 * Constructs a new instance which takes ownership of the item.
+			 * @param item which will be released by the new instance
+			 */
+			PinnedItem(fiftyoneDegreesCollectionItem &item);
+
+		private:
+			void release();
+
+			fiftyoneDegreesCollectionItem item;
+		};
+
+		/**
+		 * String read directly from the strings collection. The collection
+		 * item holding the string is released when the instance is
+		 * destroyed, so the view is only valid for the lifetime of the
+		 * instance. For data sets held in memory no memory is allocated or
+		 * copied.
+		 */
+		class PinnedString : public PinnedItem {
+		public:
+			/**
+			 * @name Constructors
+			 * @{
+			 */
+
+			/**
+			 * Constructs a new empty instance.
+			 */
+			PinnedString() = default;
+
+			/**
+			 * Constructs a new instance which takes ownership of the item
+			 * containing the string.
+			 * @param item containing the string which will be released by
+			 * the new instance
+			 * @param value string in the item or NULL
+			 */
+			PinnedString(
+				fiftyoneDegreesCollectionItem &item,
+				const fiftyoneDegreesString *value);
+
+			PinnedString(PinnedString &&other) noexcept;
+
+			PinnedString& operator=(PinnedString &&other) noexcept;
+
+			/**
+			 * @}
+			 * @name Getters
+			 * @{
+			 */
+
+			/**
+			 * Get the characters of the string without the null
+			 * terminator.
+			 * @return view of the string
+			 */
+			string_view view() const { return value; }
+
+			/**
+			 * Get a copy of the string which remains valid after this
+			 * instance is destroyed.
+			 * @return copy of the string
+			 */
+			string str() const { return string(value); }
+
+			/**
+			 * Get whether the string is empty.
+			 * @return true if there are no characters
+			 */
+			bool empty() const { return value.empty(); }
+
+			operator string_view() const { return value; }
+
+			/**
+			 * @}
+			 */
+		private:
+			string_view value;
+		};
+
+		/**
+		 * Value of any stored type read directly from the strings
+		 * collection. The collection item holding the value is released when
+		 * the instance is destroyed, so the value is only valid for the
+		 * lifetime of the instance.
+		 */
+		class PinnedBinaryValue : public PinnedItem {
+		public:
+			/**
+			 * @name Constructors
+			 * @{
+			 */
+
+			/**
+			 * Constructs a new instance which takes ownership of the item
+			 * containing the value.
+			 * @param item containing the value which will be released by
+			 * the new instance
+			 * @param value in the item or NULL
+			 * @param storedType type the value is stored as
+			 */
+			PinnedBinaryValue(
+				fiftyoneDegreesCollectionItem &item,
+				const fiftyoneDegreesStoredBinaryValue *value,
+				fiftyoneDegreesPropertyValueType storedType);
+
+			PinnedBinaryValue(PinnedBinaryValue &&other) noexcept;
+
+			/**
+			 * @}
+			 * @name Getters
+			 * @{
+			 */
+
+			/**
+			 * Get the value which should be read according to the stored
+			 * type.
+			 * @return pointer to the value or NULL
+			 */
+			const fiftyoneDegreesStoredBinaryValue* get() const {
+				return value;
+			}
+
+			/**
+			 * Get the type the value is stored as.
+			 * @return stored type
+			 */
+			fiftyoneDegreesPropertyValueType getStoredType() const {
+				return storedType;
+			}
+
+			/**
+			 * Get the value as text, as returned by results.
+			 * @return text of the value, or an empty string if there is no
+			 * value
+			 */
+			string str() const;
+
+			/**
+			 * @}
+			 */
+		private:
+			const fiftyoneDegreesStoredBinaryValue *value;
+			fiftyoneDegreesPropertyValueType storedType;
+		};
+
+		/**
+		 * Base for views of an entity in a collection. The collection item
+		 * containing the entity is released when the view is destroyed.
+		 * Views can be moved but not copied.
+		 * @tparam T type of the entity in the collection
+		 */
+		template <class T> class EntityView {
+		public:
+			EntityView(EntityView &&other) noexcept
+				: views(other.views), index(other.index), item(other.item),
+				entity(other.entity) {
+				other.item.collection = nullptr;
+				other.entity = nullptr;
+			}
+
+			EntityView(const EntityView&) = delete;
+
+			EntityView& operator=(const EntityView&) = delete;
+
+			virtual ~EntityView() {
+				if (item.collection != nullptr) {
+					FIFTYONE_DEGREES_COLLECTION_RELEASE(
+						item.collection,
+						&item);
+				}
+			}
+
+			/**
+			 * Get the index of the entity in its collection.
+			 * @return zero based index
+			 */
+			uint32_t getIndex() const { return index; }
+
+		protected:
+			EntityView(const MetaDataViews *views, uint32_t index)
+				: views(views), index(index), entity(nullptr) {
+				fiftyoneDegreesDataReset(&item.data);
+				item.collection = nullptr;
+				item.handle = nullptr;
+			}
+
+			const MetaDataViews *views;
+			uint32_t index;
+			fiftyoneDegreesCollectionItem item;
+			const T *entity;
+		};
+
+		/**
+		 * Range of views for consecutive indexes in a collection for use
+		 * with range based for loops. Each view is created as the iterator
+		 * is dereferenced.
+		 * @tparam V type of view
+		 */
+		template <class V> class ViewRange {
+		public:
+			class iterator {
+			public:
+				iterator(const MetaDataViews *views, uint32_t index)
+					: views(views), index(index) {}
+				V operator*() const { return V(views, index); }
+				iterator& operator++() { index++; return *this; }
+				bool operator==(const iterator &other) const {
+					return index == other.index;
+				}
+				bool operator!=(const iterator &other) const {
+					return index != other.index;
+				}
+			private:
+				const MetaDataViews *views;
+				uint32_t index;
+			};
+
+			ViewRange(const MetaDataViews *views, uint32_t first, uint32_t end)
+				: views(views), first(first), last(end < first ? first : end) {}
+
+			iterator begin() const { return iterator(views, first); }
+
+			iterator end() const { return iterator(views, last); }
+
+			/**
+			 * Get the number of views in the range.
+			 * @return number of views
+			 */
+			uint32_t size() const { return last - first; }
+
+		private:
+			const MetaDataViews *views;
+			uint32_t first;
+			uint32_t last;
+		};
+
+		/**
+		 * Range of views for a list of indexes held by another view, such
+		 * as the values of a profile. The range is only valid while the view
+		 * holding the indexes exists.
+		 * @tparam V type of view
+		 */
+		template <class V> class ViewIndexRange {
+		public:
+			class iterator {
+			public:
+				iterator(const MetaDataViews *views, const uint32_t *current)
+					: views(views), current(current) {}
+				V operator*() const { return V(views, *current); }
+				iterator& operator++() { current++; return *this; }
+				bool operator==(const iterator &other) const {
+					return current == other.current;
+				}
+				bool operator!=(const iterator &other) const {
+					return current != other.current;
+				}
+			private:
+				const MetaDataViews *views;
+				const uint32_t *current;
+			};
+
+			ViewIndexRange(
+				const MetaDataViews *views,
+				const uint32_t *first,
+				uint32_t count)
+				: views(views), first(first), count(count) {}
+
+			iterator begin() const { return iterator(views, first); }
+
+			iterator end() const { return iterator(views, first + count); }
+
+			/**
+			 * Get the number of views in the range.
+			 * @return number of views
+			 */
+			uint32_t size() const { return count; }
+
+		private:
+			const MetaDataViews *views;
+			const uint32_t *first;
+			uint32_t count;
+		};
+
+		class ValueView;
+
+		/**
+		 * View of a property read directly from the properties collection.
+		 */
+		class PropertyView : public EntityView<fiftyoneDegreesProperty> {
+		public:
+			/**
+			 * Constructs a view of the property at the index.
+			 * @param views the property belongs to
+			 * @param index of the property
+			 */
+			PropertyView(const MetaDataViews *views, uint32_t index);
+
+			PropertyView(PropertyView &&other) noexcept = default;
+
+			/**
+			 * @name Getters
+			 * @{
+			 */
+
+			PinnedString getName() const;
+
+			PinnedString getDescription() const;
+
+			PinnedString getCategory() const;
+
+			PinnedString getUrl() const;
+
+			byte getComponentIndex() const { return entity->componentIndex; }
+
+			byte getDisplayOrder() const { return entity->displayOrder; }
+
+			bool getIsMandatory() const { return entity->isMandatory != 0; }
+
+			bool getIsList() const { return entity->isList != 0; }
+
+			bool getIsObsolete() const { return entity->isObsolete != 0; }
+
+			bool getShow() const { return entity->show != 0; }
+
+			bool getShowValues() const { return entity->showValues != 0; }
+
+			/**
+			 * Get the type of the values as a
+			 * #fiftyoneDegreesPropertyValueType.
+			 * @return value type
+			 */
+			byte getValueType() const { return entity->valueType; }
+
+			/**
+			 * Get the index of the default value in the values collection.
+			 * @return default value index
+			 */
+			uint32_t getDefaultValueIndex() const {
+				return entity->defaultValueIndex;
+			}
+
+			/**
+			 * Get the values of the property.
+			 * @return range of the property's values
+			 */
+			ViewRange<ValueView> getValues() const;
+
+			/**
+			 * @}
+			 */
+		};
+
+		/**
+		 * View of a value read directly from the values collection.
+		 */
+		class ValueView : public EntityView<fiftyoneDegreesValue> {
+		public:
+			/**
+			 * Constructs a view of the value at the index.
+			 * @param views the value belongs to
+			 * @param index of the value
+			 */
+			ValueView(const MetaDataViews *views, uint32_t index);
+
+			ValueView(ValueView &&other) noexcept = default;
+
+			/**
+			 * @name Getters
+			 * @{
+			 */
+
+			/**
+			 * Get the type the value is stored as. Values are stored as
+			 * strings unless the collections include the property types.
+			 * @return stored type of the value
+			 */
+			fiftyoneDegreesPropertyValueType getStoredType() const;
+
+			/**
+			 * Get the name of the value if it is stored as a string. Values
+			 * of other stored types return an empty string and should be
+			 * read with getContent().
+			 * @return name of the value
+			 */
+			PinnedString getName() const;
+
+			/**
+			 * Get the value in the type it is stored as. The text of values
+			 * of any type is available from PinnedBinaryValue::str().
+			 * @return the stored value
+			 */
+			PinnedBinaryValue getContent() const;
+
+			/**
+			 * Get the description of the value, or an empty string if the
+			 * data set does not contain descriptions.
+			 * @return description of the value
+			 */
+			PinnedString getDescription() const;
+
+			/**
+			 * Get the URL of the value, or an empty string if the value has
+			 * a weight rather than a URL.
+			 * @return URL of the value
+			 */
+			PinnedString getUrl() const;
+
+			uint32_t getPropertyIndex() const {
+				return (uint32_t)entity->propertyIndex;
+			}
+
+			bool getIsWeighted() const;
+
+			uint16_t getWeight() const;
+
+			/**
+			 * Get the property the value relates to.
+			 * @return view of the property
+			 */
+			PropertyView getProperty() const;
+
+			/**
+			 * @}
+			 */
+		};
+
+		/**
+		 * View of a profile read directly from the profiles collection.
+		 */
+		class ProfileView : public EntityView<fiftyoneDegreesProfile> {
+		public:
+			/**
+			 * Constructs a view of the profile at the index in the profile
+			 * offsets collection.
+			 * @param views the profile belongs to
+			 * @param index of the profile
+			 */
+			ProfileView(const MetaDataViews *views, uint32_t index);
+
+			ProfileView(ProfileView &&other) noexcept = default;
+
+			/**
+			 * @name Getters
+			 * @{
+			 */
+
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+			uint32_t getProfileId() const { return entity->profileId; }
+#endif
+
+			byte getComponentIndex() const { return entity->componentIndex; }
+
+			uint32_t getValueCount() const { return entity->valueCount; }
+
+			/**
+			 * Get the values of the profile. The range must not be used
+			 * after the profile view is destroyed.
+			 * @return range of the profile's values
+			 */
+			ViewIndexRange<ValueView> getValues() const;
+
+			/**
+			 * @}
+			 */
+		};
+
+		/**
+		 * Meta data views of a data set. Properties, values and profiles
+		 * are read directly from the data set's collections rather than
+		 * being copied into #PropertyMetaData, #ValueMetaData and
+		 * #ProfileMetaData instances. Iterating all the values of a data set
+		 * therefore does not allocate memory for each value when the data
+		 * set is held in memory.
+		 *
+		 * The data set is pinned by a resource handle for the lifetime of
+		 * the instance. All views, ranges and strings obtained from the
+		 * instance must not be used after it is destroyed. A single instance
+		 * can be used by one thread at a time, and many instances can be
+		 * created for the same manager.
+		 *
+		 * ```
+		 * MetaDataViews views(manager, getCollections);
+		 * for (auto property : views.getProperties()) {
+		 *     cout << property.getName().view() << "\n";
+		 *     for (auto value : property.getValues()) {
+		 *         cout << "\t" << value.getName().view() << "\n";
+		 *     }
+		 * }
+		 * ```
+		 */
+		class MetaDataViews {
+		public:
+			/**
+			 * @name Constructors
+			 * @{
+			 */
+
+			/**
+			 * Constructs a new instance pinning the current data set of the
+			 * manager.
+			 * @param manager containing the data set
+			 * @param getCollections method to get the collections from the
+			 * data set
+			 */
+			MetaDataViews(
+				shared_ptr<fiftyoneDegreesResourceManager> manager,
+				MetaDataCollectionsMethod getCollections);
+
+			MetaDataViews(const MetaDataViews&) = delete;
+
+			MetaDataViews& operator=(const MetaDataViews&) = delete;
+
+			/**
+			 * Releases the data set.
+			 */
+			virtual ~MetaDataViews();
+
+			/**
+			 * @}
+			 * @name Getters
+			 * @{
+			 */
+
+			ViewRange<PropertyView> getProperties() const;
+
+			ViewRange<ValueView> getValues() const;
+
+			ViewRange<ProfileView> getProfiles() const;
+
+			PropertyView getProperty(uint32_t index) const;
+
+			ValueView getValue(uint32_t index) const;
+
+			ProfileView getProfile(uint32_t index) const;
+
+			/**
+			 * Get the collections the views read from.
+			 * @return collections of the pinned data set
+			 */
+			const MetaDataCollections& getCollections() const {
+				return collections;
+			}
+
+			/**
+			 * @}
+			 */
+		private:
+			shared_ptr<fiftyoneDegreesResourceManager> manager;
+			fiftyoneDegreesResourceHandle *handle;
+			MetaDataCollections collections;
+		};
+	}
+}
+
+#endif
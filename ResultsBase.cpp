@@ -30,9 +30,21 @@ ResultsBase::ResultsBase(
 	fiftyoneDegreesResultsBase *results,
 	shared_ptr<fiftyoneDegreesResourceManager> manager) {
 	this->available = ((DataSetBase*)results->dataSet)->available;
+	this->renderCache = ((DataSetBase*)results->dataSet)->renderCache;
 	this->manager = manager;
 }
 
+ResultsBase::ResultsBase(fiftyoneDegreesResultsBase *results) {
+	this->available = ((DataSetBase*)results->dataSet)->available;
+	this->renderCache = ((DataSetBase*)results->dataSet)->renderCache;
+}
+
+void ResultsBase::reset(fiftyoneDegreesResultsBase *results) {
+	available = ((DataSetBase*)results->dataSet)->available;
+	renderCache = ((DataSetBase*)results->dataSet)->renderCache;
+	rendered.clear();
+}
+
 ResultsBase::~ResultsBase() {
 }
 
@@ -82,27 +94,77 @@ FiftyoneDegrees::Common::Value<string> ResultsBase::getValueAsString(int require
 			getNoValueMessageInternal(reason));
 	}
 	else {
-		vector<string> values;
-		getValuesInternal(requiredPropertyIndex, values);
-		if (values.size() > 1) {
-			stringstream stream;
-			for (vector<string>::iterator it = values.begin();
-				it != values.end();
-				it++) {
-				if (it != values.begin()) {
-					stream << "|";
-				}
-				stream << *it;
+		string value;
+		const RenderCacheEntry *entry;
+		if (getRendered(requiredPropertyIndex, entry, value)) {
+			if (entry != nullptr) {
+				result.setValue(string(
+					FIFTYONE_DEGREES_RENDER_CACHE_VALUE(entry),
+					entry->length));
+			}
+			else {
+				result.setValue(value);
 			}
-			result.setValue(stream.str());
 		}
-		else if (values.size() != 0) {
-			result.setValue(*values.begin());
+	}
+	return result;
+}
+
+FiftyoneDegrees::Common::Value<string_view> ResultsBase::getValueAsStringView(
+	int requiredPropertyIndex) {
+	Value<string_view> result;
+
+	// Use the string already held for the property if there is one.
+	map<int, string>::const_iterator held = rendered.find(
+		requiredPropertyIndex);
+	if (held != rendered.end()) {
+		result.setValue(held->second);
+		return result;
+	}
+
+	// Use the render cache if the values relate to a single profile.
+	uint32_t profileId;
+	if (renderCache != nullptr &&
+		requiredPropertyIndex >= 0 &&
+		hasValuesInternal(requiredPropertyIndex) &&
+		getProfileIdInternal(requiredPropertyIndex, profileId)) {
+		string value;
+		const RenderCacheEntry *entry;
+		if (getRendered(requiredPropertyIndex, entry, value) &&
+			entry != nullptr) {
+			result.setValue(string_view(
+				FIFTYONE_DEGREES_RENDER_CACHE_VALUE(entry),
+				entry->length));
+			return result;
 		}
 	}
+
+	// Otherwise get the string from getValueAsString, which may be
+	// overridden, and hold it so the view remains valid.
+	Value<string> value = getValueAsString(requiredPropertyIndex);
+	if (value.hasValue()) {
+		result.setValue(rendered.emplace(
+			requiredPropertyIndex,
+			std::move(*value)).first->second);
+	}
+	else {
+		result.setNoValueReason(
+			value.getNoValueReason(),
+			value.getNoValueMessage());
+	}
 	return result;
 }
 
+FiftyoneDegrees::Common::Value<string_view> ResultsBase::getValueAsStringView(
+	const char *propertyName) {
+	return getValueAsStringView(getRequiredPropertyIndex(propertyName));
+}
+
+FiftyoneDegrees::Common::Value<string_view> ResultsBase::getValueAsStringView(
+	const string &propertyName) {
+	return getValueAsStringView(propertyName.c_str());
+}
+
 FiftyoneDegrees::Common::Value<string> ResultsBase::getValueAsString(const char* propertyName) {
 	return getValueAsString(getRequiredPropertyIndex(propertyName));
 }
@@ -125,16 +187,31 @@ FiftyoneDegrees::Common::Value<bool> ResultsBase::getValueAsBool(int requiredPro
 			getNoValueMessageInternal(reason));
 	}
 	else {
-		vector<string> values;
-		getValuesInternal(requiredPropertyIndex, values);
-		if (values.size() > 1) {
+		fiftyoneDegreesStoredBinaryValueBuffer stored;
+		fiftyoneDegreesPropertyValueType valueType;
+		int count = getStoredValueInternal(
+			requiredPropertyIndex,
+			stored,
+			valueType);
+		if (count < 0) {
+			vector<string> values;
+			getValuesInternal(requiredPropertyIndex, values);
+			count = (int)values.size();
+			if (count == 1) {
+				result.setValue((*values.begin()).compare("True") == 0);
+			}
+		}
+		else if (count == 1) {
+			result.setValue(StoredBinaryValueToBoolOrDefault(
+				&stored.value,
+				valueType,
+				false));
+		}
+		if (count > 1) {
 			result.setNoValueReason(
 				FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_TOO_MANY_VALUES,
 				nullptr);
 		}
-		else if (values.size() != 0) {
-			result.setValue((*values.begin()).compare("True") == 0);
-		}
 	}
 	return result;
 }
@@ -161,16 +238,31 @@ FiftyoneDegrees::Common::Value<int> ResultsBase::getValueAsInteger(int requiredP
 			getNoValueMessageInternal(reason));
 	}
 	else {
-		vector<string> values;
-		getValuesInternal(requiredPropertyIndex, values);
-		if (values.size() > 1) {
+		fiftyoneDegreesStoredBinaryValueBuffer stored;
+		fiftyoneDegreesPropertyValueType valueType;
+		int count = getStoredValueInternal(
+			requiredPropertyIndex,
+			stored,
+			valueType);
+		if (count < 0) {
+			vector<string> values;
+			getValuesInternal(requiredPropertyIndex, values);
+			count = (int)values.size();
+			if (count == 1) {
+				result.setValue(atoi(values.begin()->c_str()));
+			}
+		}
+		else if (count == 1) {
+			result.setValue(StoredBinaryValueToIntOrDefault(
+				&stored.value,
+				valueType,
+				0));
+		}
+		if (count > 1) {
 			result.setNoValueReason(
 				FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_TOO_MANY_VALUES,
 				nullptr);
 		}
-		else if (values.size() != 0) {
-			result.setValue(atoi(values.begin()->c_str()));
-		}
 	}
 	return result;
 }
@@ -197,16 +289,31 @@ FiftyoneDegrees::Common::Value<double> ResultsBase::getValueAsDouble(int require
 			getNoValueMessageInternal(reason));
 	}
 	else {
-		vector<string> values;
-		getValuesInternal(requiredPropertyIndex, values);
-		if (values.size() > 1) {
+		fiftyoneDegreesStoredBinaryValueBuffer stored;
+		fiftyoneDegreesPropertyValueType valueType;
+		int count = getStoredValueInternal(
+			requiredPropertyIndex,
+			stored,
+			valueType);
+		if (count < 0) {
+			vector<string> values;
+			getValuesInternal(requiredPropertyIndex, values);
+			count = (int)values.size();
+			if (count == 1) {
+				result.setValue(strtod(values.begin()->c_str(), nullptr));
+			}
+		}
+		else if (count == 1) {
+			result.setValue(StoredBinaryValueToDoubleOrDefault(
+				&stored.value,
+				valueType,
+				0));
+		}
+		if (count > 1) {
 			result.setNoValueReason(
 				FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_TOO_MANY_VALUES,
 				nullptr);
 		}
-		else if (values.size() != 0) {
-			result.setValue(strtod(values.begin()->c_str(), nullptr));
-		}
 	}
 	return result;
 }
@@ -256,6 +363,74 @@ FiftyoneDegrees::Common::Value<vector<string>> ResultsBase::getValues(
 	return getValues(propertyName->c_str());
 }
 
+bool ResultsBase::getProfileIdInternal(int, uint32_t&) {
+	return false;
+}
+
+int ResultsBase::getStoredValueInternal(
+	int,
+	fiftyoneDegreesStoredBinaryValueBuffer&,
+	fiftyoneDegreesPropertyValueType&) {
+	return -1;
+}
+
+bool ResultsBase::renderValues(int requiredPropertyIndex, string &result) {
+	vector<string> values;
+	getValuesInternal(requiredPropertyIndex, values);
+	if (values.size() == 0) {
+		return false;
+	}
+	if (values.size() == 1) {
+		result = std::move(values[0]);
+		return true;
+	}
+	size_t length = 0;
+	for (const string &value : values) {
+		length += value.size() + 1;
+	}
+	result.clear();
+	result.reserve(length);
+	for (size_t i = 0; i < values.size(); i++) {
+		if (i > 0) {
+			result.push_back('|');
+		}
+		result.append(values[i]);
+	}
+	return true;
+}
+
+bool ResultsBase::getRendered(
+	int requiredPropertyIndex,
+	const fiftyoneDegreesRenderCacheEntry *&entry,
+	string &value) {
+	uint32_t profileId;
+	bool cacheable = renderCache != nullptr &&
+		requiredPropertyIndex >= 0 &&
+		getProfileIdInternal(requiredPropertyIndex, profileId);
+	entry = nullptr;
+	if (cacheable) {
+		entry = RenderCacheGet(
+			renderCache,
+			profileId,
+			(uint32_t)requiredPropertyIndex);
+		if (entry != nullptr) {
+			return true;
+		}
+	}
+	if (renderValues(requiredPropertyIndex, value) == false) {
+		return false;
+	}
+	if (cacheable) {
+		entry = RenderCacheAdd(
+			renderCache,
+			profileId,
+			(uint32_t)requiredPropertyIndex,
+			value.data(),
+			value.size());
+	}
+	return true;
+}
+
 int ResultsBase::getRequiredPropertyIndex(
 	const char *propertyName) {
 	return PropertiesGetRequiredPropertyIndexFromName(
@@ -24,7 +24,9 @@
 #define FIFTYONE_DEGREES_RESULTS_BASE_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <map>
 #include <memory>
 #include <sstream>
 #include "Exceptions.hpp"
@@ -32,9 +34,13 @@
 #include "RequiredPropertiesConfig.hpp"
 #include "results.h"
 #include "resource.h"
+#include "renderCache.h"
+#include "storedBinaryValue.h"
 
 using std::shared_ptr;
 using std::stringstream;
+using std::string_view;
+using std::map;
 
 namespace FiftyoneDegrees {
 	namespace Common {
@@ -75,6 +81,10 @@ namespace FiftyoneDegrees {
 		 * // Or get a value using the name of the property
 		 * string value = *results->getValueAsString("name of a property");
 		 *
+		 * // Or get a view of the value which avoids copying the string. The
+		 * // view is valid until the results are deleted
+		 * string_view view = *results->getValueAsStringView(0);
+		 *
 		 * // Delete the results
 		 * delete results;
 		 * ```
@@ -102,12 +112,40 @@ namespace FiftyoneDegrees {
 				fiftyoneDegreesResultsBase *results,
 				shared_ptr<fiftyoneDegreesResourceManager> manager);
 
+			/**
+			 * Create a new instance of Results from the results structure
+			 * provided without taking a reference to the manager. Used for
+			 * results held in a ResultsPool, where the pool guarantees the
+			 * manager outlives the results so no reference counting is needed
+			 * for each result.
+			 * @param results pointer to the underlying results structure
+			 */
+			ResultsBase(fiftyoneDegreesResultsBase *results);
+
 			/**
 			 * Free any memory associated with the results and release any
 			 * resource handles.
 			 */
 			virtual ~ResultsBase();
 
+			/**
+			 * @}
+			 * @name Reuse
+			 * @{
+			 */
+
+			/**
+			 * Prepares the instance to be reused for a new set of evidence.
+			 * The available properties and render cache are taken from the
+			 * data set of the results structure provided, and any strings
+			 * rendered for the previous evidence are discarded. Extending
+			 * classes override this to reset their own state and must call
+			 * this base implementation.
+			 * @param results pointer to the underlying results structure
+			 * which is now associated with the instance
+			 */
+			virtual void reset(fiftyoneDegreesResultsBase *results);
+
 			/**
 			 * @}
 			 * @name Available Properties
@@ -233,6 +271,43 @@ namespace FiftyoneDegrees {
 			 */
 			virtual Value<string> getValueAsString(int requiredPropertyIndex);
 
+			/**
+			 * Get a view of the string representation of the value associated
+			 * with the required property name. The view is valid until the
+			 * results instance is deleted.
+			 * @param propertyName string containing the property name
+			 * @return a view of the string representation of the value
+			 */
+			Value<string_view> getValueAsStringView(const char *propertyName);
+
+			/**
+			 * Get a view of the string representation of the value associated
+			 * with the required property name. The view is valid until the
+			 * results instance is deleted.
+			 * @param propertyName string containing the property name
+			 * @return a view of the string representation of the value
+			 */
+			Value<string_view> getValueAsStringView(
+				const string &propertyName);
+
+			/**
+			 * Get a view of the string representation of the value associated
+			 * with the required property index as returned by
+			 * getValueAsString(int). If the data set has a render cache and
+			 * the values relate to a single profile then the view refers to
+			 * the string held in the cache, which is shared by all results
+			 * from the same data set. Otherwise the string is obtained from
+			 * getValueAsString(int), so overrides of that method are used,
+			 * and held by this results instance for the property. Later calls
+			 * for the same property return a view of the same string. In both
+			 * cases the view is valid until the results instance is deleted
+			 * or reset.
+			 * @param requiredPropertyIndex of the property required
+			 * @return a view of the string representation of the value
+			 */
+			virtual Value<string_view> getValueAsStringView(
+				int requiredPropertyIndex);
+
 			/**
 			 * Get a boolean representation of the value associated with the
 			 * required property name. If the property name is not valid then
@@ -409,7 +484,74 @@ namespace FiftyoneDegrees {
 			virtual fiftyoneDegreesResultsNoValueReason getNoValueReasonInternal(
 				int requiredPropertyIndex) = 0;
 
+			/**
+			 * Get the id of the profile which the values for the property are
+			 * taken from. Extending classes implement this to enable the
+			 * render cache for values that depend only on the profile and the
+			 * property. The default implementation returns false so that
+			 * values are never cached.
+			 * @param requiredPropertyIndex index in the available properties
+			 * @param profileId set to the id of the profile
+			 * @return true if the values relate only to the profile and can be
+			 * cached, otherwise false
+			 */
+			virtual bool getProfileIdInternal(
+				int requiredPropertyIndex,
+				uint32_t &profileId);
+
+			/**
+			 * Get the value for the index in required properties in the
+			 * binary form it is stored in. Extending classes implement this
+			 * for properties with a fixed size stored value type, such as
+			 * integer, single byte or single precision float, so that the
+			 * typed getters can convert the value without rendering it as a
+			 * string. The value is copied into the buffer so nothing needs to
+			 * be released by the caller. The default implementation returns
+			 * -1 so that the string values are always used.
+			 * @param requiredPropertyIndex index in the available properties
+			 * @param value buffer to copy the first stored value into
+			 * @param valueType set to the stored value type of the property
+			 * @return the number of values for the property, or -1 if the
+			 * stored value is not available and the string values from
+			 * getValuesInternal must be used instead
+			 */
+			virtual int getStoredValueInternal(
+				int requiredPropertyIndex,
+				fiftyoneDegreesStoredBinaryValueBuffer &value,
+				fiftyoneDegreesPropertyValueType &valueType);
+
 		private:
+			/**
+			 * Joins the values for the property with '|' separators.
+			 * @param requiredPropertyIndex index in the available properties
+			 * @param result set to the string representation of the values
+			 * @return true if there were values, otherwise false
+			 */
+			bool renderValues(int requiredPropertyIndex, string &result);
+
+			/**
+			 * Gets the entry in the render cache for the property, rendering
+			 * and adding the values if not already present. If the values can
+			 * not be cached they are rendered into the value provided.
+			 * @param requiredPropertyIndex index in the available properties
+			 * @param entry set to the cache entry, or nullptr if the values
+			 * were not cached
+			 * @param value set to the rendered values if not cached
+			 * @return true if there were values, otherwise false
+			 */
+			bool getRendered(
+				int requiredPropertyIndex,
+				const fiftyoneDegreesRenderCacheEntry *&entry,
+				string &value);
+
+			/** Cache of rendered strings owned by the data set, or nullptr */
+			fiftyoneDegreesRenderCache *renderCache;
+
+			/** Rendered strings which could not be cached referenced by views
+			returned from getValueAsStringView, keyed by required property
+			index. The map nodes do not move as more are added. */
+			map<int, string> rendered;
+
 			/** A shared pointer to the manager is passed around and referenced
 			by all instances that hold open a resource handle. This acts as a
 			counter to ensure that the pointer to the manager remains valid
@@ -0,0 +1,181 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_RESULTS_POOL_HPP
+#define FIFTYONE_DEGREES_RESULTS_POOL_HPP
+
+#include <memory>
+#include <vector>
+#include "resource.h"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace FiftyoneDegrees {
+	namespace Common {
+		/**
+		 * Pool of results instances which can be reset and reused for new
+		 * evidence rather than being allocated and freed for every request.
+		 *
+		 * The pool holds the only reference to the resource manager's shared
+		 * pointer, so results created for the pool use the
+		 * ResultsBase(fiftyoneDegreesResultsBase*) constructor and do not
+		 * change the reference count. All results acquired from the pool
+		 * must therefore be released or deleted before the pool is deleted.
+		 *
+		 * A pool is not thread-safe and is intended to be owned by a single
+		 * thread, so acquiring and releasing results involves no atomic
+		 * operations. Each thread should use its own pool.
+		 *
+		 * ## Usage Example
+		 *
+		 * ```
+		 * using namespace FiftyoneDegrees::Common;
+		 * ResultsPool<ResultsHash> pool(manager, 16);
+		 *
+		 * // Reuse results from the pool if available, or create new ones
+		 * ResultsHash *results = pool.acquire();
+		 * if (results == nullptr) {
+		 *     results = new ResultsHash(...);
+		 * }
+		 * else {
+		 *     results->reset(...);
+		 * }
+		 *
+		 * // Do something with the results
+		 * // ...
+		 *
+		 * // Return the results to the pool
+		 * pool.release(results);
+		 * ```
+		 *
+		 * @tparam T type of results held in the pool, extending ResultsBase
+		 */
+		template <class T> class ResultsPool {
+		public:
+			/**
+			 * @name Constructors and Destructors
+			 * @{
+			 */
+
+			/**
+			 * Construct a new empty pool.
+			 * @param manager shared pointer to the manager of the data set
+			 * used by the results, kept valid for the lifetime of the pool
+			 * @param capacity maximum number of results kept in the pool,
+			 * results released when the pool is full are deleted
+			 */
+			ResultsPool(
+				shared_ptr<fiftyoneDegreesResourceManager> manager,
+				size_t capacity) : manager(manager), capacity(capacity) {
+				items.reserve(capacity);
+			}
+
+			ResultsPool(const ResultsPool&) = delete;
+			ResultsPool& operator=(const ResultsPool&) = delete;
+
+			/**
+			 * Deletes the results held in the pool.
+			 */
+			virtual ~ResultsPool() {
+				for (T *results : items) {
+					delete results;
+				}
+			}
+
+			/**
+			 * @}
+			 * @name Pool Methods
+			 * @{
+			 */
+
+			/**
+			 * Takes a results instance from the pool. The instance must be
+			 * reset with the new results structure before it is used.
+			 * @return a previously released results instance, or nullptr if
+			 * the pool is empty and a new instance needs to be created
+			 */
+			T* acquire() {
+				T *results = nullptr;
+				if (items.empty() == false) {
+					results = items.back();
+					items.pop_back();
+				}
+				return results;
+			}
+
+			/**
+			 * Returns a results instance to the pool so that it can be reused.
+			 * If the pool is full the results are deleted.
+			 * @param results instance to return to the pool
+			 */
+			void release(T *results) {
+				if (items.size() < capacity) {
+					items.push_back(results);
+				}
+				else {
+					delete results;
+				}
+			}
+
+			/**
+			 * @}
+			 * @name Getters
+			 * @{
+			 */
+
+			/**
+			 * Get the manager of the data set used by results from the pool.
+			 * The pointer is valid for the lifetime of the pool.
+			 * @return pointer to the resource manager
+			 */
+			fiftyoneDegreesResourceManager* getManager() const {
+				return manager.get();
+			}
+
+			/**
+			 * Get the number of results currently held in the pool.
+			 * @return number of results available to acquire
+			 */
+			size_t getCount() const {
+				return items.size();
+			}
+
+			/**
+			 * @}
+			 */
+
+		private:
+			/** Reference to the manager held for the lifetime of the pool
+			rather than by each of the results. */
+			shared_ptr<fiftyoneDegreesResourceManager> manager;
+
+			/** Maximum number of results held in the pool. */
+			size_t capacity;
+
+			/** Results available to acquire. */
+			vector<T*> items;
+		};
+	}
+}
+
+#endif
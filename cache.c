@@ -275,11 +275,14 @@ static CacheNode* cacheLoad(
 
 		// Load the data into then node setting the valid flag to indicate if
 		// the item was loaded correctly.
+		MemoryTag tag = MemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_CACHES);
 		shard->cache->load(
 			shard->cache->loaderState,
 			&node->data,
 			key,
 			exception);
+		MemoryAccountingSetTag(tag);
 
 		// If not exception then add the node to the head of the tree. The key
 		// hash was already computed by the caller, so reuse it rather than
@@ -337,6 +340,7 @@ fiftyoneDegreesCache* fiftyoneDegreesCacheCreate(
 	nodesSize = sizeof(CacheNode) * 
 		cacheShardCapacity(capacity, concurrency) * concurrency;
 	cacheSize = sizeof(Cache) + shardsSize + nodesSize;
+	MemoryTag tag = MemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_CACHES);
 	cache = (Cache*)Malloc(cacheSize);
 	if (cache != NULL) {
 
@@ -365,6 +369,7 @@ fiftyoneDegreesCache* fiftyoneDegreesCacheCreate(
 	assert(cacheValidate(cache));
 #endif
 
+	MemoryAccountingSetTag(tag);
 	return cache;
 }
 
@@ -51,6 +51,106 @@ if (exception->status == NOT_SET) { \
 #else
 #define GET_CLEAR_ITEM
 #define GET_EXCEPTION_SET(s)
+#endif
+
+#ifndef FIFTYONE_DEGREES_MEMORY_ONLY
+
+/**
+ * Maximum number of buffers each thread keeps for reuse by file collections.
+ * Enough for the items a single operation holds at the same time.
+ */
+#define THREAD_BUFFERS 8
+
+/**
+ * Buffers which have been used to read items from file and are available to
+ * be used again by the same thread.
+ */
+typedef struct collection_thread_buffers_t {
+	fiftyoneDegreesData items[THREAD_BUFFERS]; /* Buffers available */
+	uint32_t count; /* Number of buffers available */
+	bool registered; /* True if the buffers are freed when the thread exits */
+} threadBuffers;
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+static FIFTYONE_DEGREES_THREAD_LOCAL threadBuffers buffersLocal;
+#else
+static threadBuffers buffersLocal;
+#endif
+
+static void freeBuffers(threadBuffers *buffers) {
+	while (buffers->count > 0) {
+		buffers->count--;
+		Free(buffers->items[buffers->count].ptr);
+		DataReset(&buffers->items[buffers->count]);
+	}
+}
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+
+/**
+ * Called when a thread which has kept buffers exits. The memory freed is added
+ * to the accounting as the thread has no later chance to do so.
+ */
+#ifdef _MSC_VER
+static void WINAPI freeBuffersOnExit(void *buffers) {
+#else
+static void freeBuffersOnExit(void *buffers) {
+#endif
+	if (buffers != NULL) {
+		freeBuffers((threadBuffers*)buffers);
+		MemoryAccountingFlush();
+	}
+}
+
+#ifdef _MSC_VER
+static INIT_ONCE buffersKeyOnce = INIT_ONCE_STATIC_INIT;
+static DWORD buffersKey = FLS_OUT_OF_INDEXES;
+static BOOL CALLBACK createBuffersKey(
+	PINIT_ONCE once,
+	PVOID parameter,
+	PVOID *context) {
+	UNREFERENCED_PARAMETER(once);
+	UNREFERENCED_PARAMETER(parameter);
+	UNREFERENCED_PARAMETER(context);
+	buffersKey = FlsAlloc(freeBuffersOnExit);
+	return TRUE;
+}
+#else
+static pthread_once_t buffersKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t buffersKey;
+static bool buffersKeyCreated = false;
+static void createBuffersKey() {
+	buffersKeyCreated =
+		pthread_key_create(&buffersKey, freeBuffersOnExit) == 0;
+}
+#endif
+
+/**
+ * Registers the buffers of the calling thread to be freed when the thread
+ * exits so that threads which are not aware of the library do not leak them.
+ * @return true if registered, otherwise false and the thread must not keep
+ * buffers
+ */
+static bool registerBuffers() {
+#ifdef _MSC_VER
+	InitOnceExecuteOnce(&buffersKeyOnce, createBuffersKey, NULL, NULL);
+	buffersLocal.registered =
+		buffersKey != FLS_OUT_OF_INDEXES &&
+		FlsSetValue(buffersKey, &buffersLocal) != 0;
+#else
+	pthread_once(&buffersKeyOnce, createBuffersKey);
+	buffersLocal.registered =
+		buffersKeyCreated &&
+		pthread_setspecific(buffersKey, &buffersLocal) == 0;
+#endif
+	return buffersLocal.registered;
+}
+
+#define BUFFERS_REGISTERED (buffersLocal.registered || registerBuffers())
+#else
+#define BUFFERS_REGISTERED true
+#endif
+
 #endif
 
  /**
@@ -156,7 +256,7 @@ static void freeMemoryCollection(Collection *collection) {
 	CollectionMemory *memory = (CollectionMemory*)collection->state;
 
 	if (memory->memoryToFree != NULL) {
-		Free(memory->memoryToFree);
+		MemoryLargeFree(memory->memoryToFree);
 	}
 
 	freeCollection(collection);
@@ -256,6 +356,46 @@ static void* getFile(
 	return ptr;
 }
 
+/**
+ * Gets an item from file as getFile does, but reads it into a buffer kept by
+ * the thread from a previous read if one is available. The buffer is grown
+ * by the read method if it is too small for the item.
+ */
+static void* getFileReuse(
+	const Collection *collection,
+	const fiftyoneDegreesCollectionKey * const key,
+	Item *item,
+	Exception *exception) {
+	if (item->data.allocated == 0 && buffersLocal.count > 0) {
+		buffersLocal.count--;
+		item->data = buffersLocal.items[buffersLocal.count];
+	}
+	return getFile(collection, key, item, exception);
+}
+
+/**
+ * Returns the memory used by the file item to the thread's buffers so that
+ * it can be used by the next read, freeing it only if the thread already has
+ * enough buffers, and resets the item ready to be used in a subsequent
+ * request.
+ * @param item to be released with a handle set to the memory to be reused.
+ */
+static void releaseFileReuse(Item *item) {
+	if (item->handle != NULL) {
+		if (buffersLocal.count < THREAD_BUFFERS && BUFFERS_REGISTERED) {
+			item->data.ptr = (byte*)item->handle;
+			buffersLocal.items[buffersLocal.count] = item->data;
+			buffersLocal.count++;
+		}
+		else {
+			Free(item->handle);
+		}
+		DataReset(&item->data);
+		item->handle = NULL;
+		item->collection = NULL;
+	}
+}
+
 /**
  * Gets an item from the cache pointed to by the collection's state. If the
  * cache get method returns null or the item fetched is invalid, then the 
@@ -404,6 +544,7 @@ static Collection* createFromFile(
 	FILE *file,
 	FilePool *reader,
 	CollectionHeader *header,
+	bool reuseBuffers,
 	CollectionFileRead read) {
 
 	// Allocate the memory for the collection and file implementation.
@@ -424,9 +565,16 @@ static Collection* createFromFile(
 		return NULL;
 	}
 
-	// Set the get and release functions for the collection.
-	collection->get = getFile;
-	collection->release = releaseFile;
+	// Set the get and release functions for the collection, reusing the
+	// memory items are read into if configured to.
+	if (reuseBuffers) {
+		collection->get = getFileReuse;
+		collection->release = releaseFileReuse;
+	}
+	else {
+		collection->get = getFile;
+		collection->release = releaseFile;
+	}
 	collection->freeCollection = freeFileCollection;
 
 	return collection;
@@ -438,12 +586,12 @@ static Collection* createFromFileToMemory(
 	FILE *file,
 	CollectionHeader header) {
 	EXCEPTION_CREATE;
-	byte * const data = (byte*)Malloc(header.length * sizeof(byte));
+	byte * const data = (byte*)MemoryLargeMalloc(header.length * sizeof(byte));
 	MemoryReader memory;
 
 	memory.current = data;
 	if (memory.current == NULL) {
-		Free(data);
+		MemoryLargeFree(data);
 		return NULL;
 	}
 
@@ -453,13 +601,13 @@ static Collection* createFromFileToMemory(
 
 	// Position the file reader at the start of the collection.
 	if (FileSeek(file, (FileOffset)header.startPosition, SEEK_SET) != 0) {
-		Free(data);
+		MemoryLargeFree(data);
 		return NULL;
 	}
 
 	// Read the portion of the file into memory.
 	if (fread(memory.startByte, 1, header.length, file) != header.length) {
-		Free(data);
+		MemoryLargeFree(data);
 		return NULL;
 	}
 
@@ -467,7 +615,7 @@ static Collection* createFromFileToMemory(
 	Collection * const result = CollectionCreateFromMemory(&memory, header);
 
 	if (result == NULL) {
-		Free(data);
+		MemoryLargeFree(data);
 		return NULL;
 	}
 
@@ -495,7 +643,7 @@ static Collection* createFromFileCached(
 	cache->cache = NULL;
 
 	// Create the file collection to be used with the cache.
-	cache->source = createFromFile(file, reader, header, read);
+	cache->source = createFromFile(file, reader, header, false, read);
 	if (cache->source == NULL) {
 		freeCacheCollection(collection);
 		return NULL;
@@ -557,7 +705,12 @@ static Collection* createFromFileMaybeCached(
 
 			// If there is no cache then the entries will be fetched 
 			// directly from the source file.
-			return createFromFile(file, reader, &header, read);
+			return createFromFile(
+				file,
+				reader,
+				&header,
+				config->reuseBuffers,
+				read);
 		}
 	}
 
@@ -604,10 +757,13 @@ fiftyoneDegreesCollection* fiftyoneDegreesCollectionCreateFromMemory(
 	}
 
 	// Allocate the memory for the collection and implementation.
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
 	Collection *collection = createCollection(
 		sizeof(CollectionMemory),
 		&header,
 		"CollectionMemory");
+	MemoryAccountingSetTag(tag);
 	CollectionMemory *memory = (CollectionMemory*)collection->state;
 
 	// Configure the fields for the collection.
@@ -682,10 +838,21 @@ fiftyoneDegreesCollection* fiftyoneDegreesCollectionCreateFromFile(
 	const fiftyoneDegreesCollectionConfig *config,
 	fiftyoneDegreesCollectionHeader header,
 	fiftyoneDegreesCollectionFileRead read) {
+	Collection *collection;
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
 
 #ifndef FIFTYONE_DEGREES_MEMORY_ONLY
 	if (!config->loaded) {
-		return createFromFileMaybeCached(file, reader, config, header, read);
+		collection = createFromFileMaybeCached(
+			file,
+			reader,
+			config,
+			header,
+			read);
+	}
+	else {
+		collection = createFromFileToMemory(file, header);
 	}
 #else
 #	ifdef _MSC_VER
@@ -693,9 +860,11 @@ fiftyoneDegreesCollection* fiftyoneDegreesCollectionCreateFromFile(
 	UNREFERENCED_PARAMETER(config);
 	UNREFERENCED_PARAMETER(read);
 #	endif
+	collection = createFromFileToMemory(file, header);
 #endif
 
-	return createFromFileToMemory(file, header);
+	MemoryAccountingSetTag(tag);
+	return collection;
 }
 
 fiftyoneDegreesFileHandle* fiftyoneDegreesCollectionReadFilePosition(
@@ -756,7 +925,11 @@ void* fiftyoneDegreesCollectionReadFileFixed(
 		if (handle != NULL && EXCEPTION_OKAY) {
 
 			// Ensure sufficient memory is allocated for the item being read.
-			if (DataMalloc(data, lengthToRead) != NULL) {
+			MemoryTag tag = MemoryAccountingSetTag(
+				FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
+			void *allocated = DataMalloc(data, lengthToRead);
+			MemoryAccountingSetTag(tag);
+			if (allocated != NULL) {
 
 				// Read the record from file to the cache node's data field.
 				if (fread(
@@ -823,7 +996,11 @@ static void* readFileVariable(
 			// Ensure sufficient memory is allocated for the item being
 			// read and that the header is copied to the data buffer
 			// provided by the caller.
-			if (DataMalloc(data, bytesNeeded) != NULL &&
+			MemoryTag tag = MemoryAccountingSetTag(
+				FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
+			void *allocated = DataMalloc(data, bytesNeeded);
+			MemoryAccountingSetTag(tag);
+			if (allocated != NULL &&
 				memcpy(data->ptr, initial, initialSize) == data->ptr) {
 
 				// Read the rest of the item into the item's data 
@@ -1002,3 +1179,19 @@ long fiftyoneDegreesCollectionBinarySearch(
 	// The item could not be found and no error occurred.
 	return -1;
 }
+
+fiftyoneDegreesCollectionMemory* fiftyoneDegreesCollectionGetMemory(
+	const fiftyoneDegreesCollection *collection) {
+	if (collection != NULL && (
+		collection->get == getMemoryFixed ||
+		collection->get == getMemoryVariable)) {
+		return (CollectionMemory*)collection->state;
+	}
+	return NULL;
+}
+
+void fiftyoneDegreesCollectionFreeThreadBuffers() {
+#ifndef FIFTYONE_DEGREES_MEMORY_ONLY
+	freeBuffers(&buffersLocal);
+#endif
+}
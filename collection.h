@@ -125,6 +125,12 @@
  * cache.
 
  * **concurrency** : the expected number of concurrent operations, 1 or greater.
+ *
+ * **reuseBuffers** : true if a file Collection without a cache should keep the
+ * memory used to read Items in a small pool for each thread and reuse it for
+ * later reads rather than freeing it when the Item is released. The memory is
+ * freed automatically when each thread exits, or can be freed sooner by
+ * calling #fiftyoneDegreesCollectionFreeThreadBuffers from the thread.
  * 
  * The file create method will work out the different types of Collection(s)
  * needed and how to chain them based on the configuration provided.
@@ -292,6 +298,9 @@ typedef struct fiftyone_degrees_collection_config_t {
 	                       cache */
 	uint16_t concurrency; /**< Expected number of concurrent requests, 1 or
 						      greater */
+	bool reuseBuffers; /**< Memory used to read items from file without a
+	                       cache is kept for reuse by the thread rather than
+	                       freed when the item is released */
 } fiftyoneDegreesCollectionConfig;
 
 /** @cond FORWARD_DECLARATIONS */
@@ -432,6 +441,32 @@ typedef struct fiftyone_degrees_collection_memory_t {
 						if no memory to free*/
 } fiftyoneDegreesCollectionMemory;
 
+/**
+ * Pointer to the fixed size element of type t at the index in the memory
+ * collection m returned by #fiftyoneDegreesCollectionGetMemory. Unlike the
+ * get method of the collection no item is populated and no bounds checking
+ * is performed. The caller must check the index is less than the count of
+ * the collection, which can be done once before a loop, and that the
+ * element size of the collection is the size of t.
+ * @param m pointer to the memory collection
+ * @param t type of the element
+ * @param i index of the element
+ */
+#define FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX(m, t, i) \
+	((const t*)(m)->firstByte + (i))
+
+/**
+ * Pointer to the variable size element of type t at the offset in the memory
+ * collection m returned by #fiftyoneDegreesCollectionGetMemory. No item is
+ * populated and no bounds checking is performed. The caller must check the
+ * offset is less than the size of the collection.
+ * @param m pointer to the memory collection
+ * @param t type of the element
+ * @param o offset of the element in bytes
+ */
+#define FIFTYONE_DEGREES_COLLECTION_MEMORY_OFFSET(m, t, o) \
+	((const t*)((m)->firstByte + (o)))
+
 /**
  * Type of collection where the collection is streamed from file.
  */
@@ -466,6 +501,31 @@ typedef struct fiftyone_degrees_collection_cache_t {
  */
 EXTERNAL bool fiftyoneDegreesCollectionGetIsMemoryOnly();
 
+/**
+ * Gets the memory implementation of the collection if all the data is held
+ * in continuous memory. The result can be used with
+ * #FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX and
+ * #FIFTYONE_DEGREES_COLLECTION_MEMORY_OFFSET to access elements directly
+ * rather than via the get method of the collection. This should be called
+ * once outside any loops that access the elements.
+ * @param collection to get the memory implementation of
+ * @return pointer to the memory collection, or NULL if the collection is
+ * not held in memory
+ */
+EXTERNAL fiftyoneDegreesCollectionMemory* fiftyoneDegreesCollectionGetMemory(
+	const fiftyoneDegreesCollection *collection);
+
+/**
+ * Frees the buffers kept by the calling thread for reuse by file collections
+ * created with the reuseBuffers configuration option. The buffers are freed
+ * automatically when the thread exits, so this only needs to be called if the
+ * memory is needed back sooner, for example by the main thread before
+ * checking that all the memory allocated has been freed. If
+ * FIFTYONE_DEGREES_NO_THREADING is defined the buffers are shared by the
+ * process and are only freed by calling this.
+ */
+EXTERNAL void fiftyoneDegreesCollectionFreeThreadBuffers();
+
 /**
  * Returns a 32 bit integer from collections that provide such values.
  * @param collection the collection of 32 bit integers
@@ -65,6 +65,25 @@ typedef struct fiftyone_degrees_config_base_t {
 	int tempDirCount; /**< Number of directories in the tempDirs array. */
 	bool propertyValueIndex; /**< Indicates if an index to values for property 
 							     and profiles should be created. */
+	bool propertyValueIndexSidecar; /**< Indicates if the index to values 
+									should be loaded from, and saved to, a
+									sidecar file next to the data file. Only
+									applies if propertyValueIndex is true. */
+	bool propertyValueIndexLazy; /**< Indicates if the rows of the index to
+								 values should be populated when first used
+								 rather than when the data set is created. */
+	bool propertyValueIndexBackground; /**< Indicates if a background thread
+									   should populate the remaining rows of a
+									   lazy index after start up. */
+	bool propertyValueIndexRanges; /**< Indicates if the index to values should
+								   also record the position after the last 
+								   value for each profile and property. */
+	uint32_t renderCacheCapacity; /**< Maximum number of rendered property
+								  value strings to cache for the data set, or
+								  zero to disable the cache. */
+	uint32_t wktCacheCapacity; /**< Maximum number of WKT strings rendered
+							   from geometry values to cache for the data set,
+							   or zero to disable the cache. */
 } fiftyoneDegreesConfigBase;
 
 /** Default value for the #FIFTYONE_DEGREES_CONFIG_USE_TEMP_FILE macro. */
@@ -91,6 +110,17 @@ FIFTYONE_DEGREES_CONFIG_USE_TEMP_FILE_DEFAULT
 #define FIFTYONE_DEGREES_CONFIG_ALL_IN_MEMORY \
 FIFTYONE_DEGREES_CONFIG_ALL_IN_MEMORY_DEFAULT
 
+/**
+ * Default value for the render cache capacity. The cache is disabled by
+ * default.
+ */
+#define FIFTYONE_DEGREES_CONFIG_RENDER_CACHE_CAPACITY_DEFAULT 0
+
+/**
+ * Default value for the WKT cache capacity. The cache is disabled by default.
+ */
+#define FIFTYONE_DEGREES_CONFIG_WKT_CACHE_CAPACITY_DEFAULT 0
+
 /**
  * Default value for the #fiftyoneDegreesConfigBase structure with index.
  */
@@ -102,7 +132,13 @@ FIFTYONE_DEGREES_CONFIG_ALL_IN_MEMORY_DEFAULT
 	false, /* reuseTempFile */ \
 	NULL, /* tempDirs */ \
 	0, /* tempDirCount */ \
-	true /* propertyValueIndex */
+	true, /* propertyValueIndex */ \
+	false, /* propertyValueIndexSidecar */ \
+	false, /* propertyValueIndexLazy */ \
+	false, /* propertyValueIndexBackground */ \
+	false, /* propertyValueIndexRanges */ \
+	FIFTYONE_DEGREES_CONFIG_RENDER_CACHE_CAPACITY_DEFAULT, /* renderCacheCapacity */ \
+	FIFTYONE_DEGREES_CONFIG_WKT_CACHE_CAPACITY_DEFAULT /* wktCacheCapacity */
 
  /**
   * Default value for the #fiftyoneDegreesConfigBase structure without index.
@@ -115,7 +151,13 @@ FIFTYONE_DEGREES_CONFIG_ALL_IN_MEMORY_DEFAULT
 	false, /* reuseTempFile */ \
 	NULL, /* tempDirs */ \
 	0, /* tempDirCount */ \
-	false /* propertyValueIndex */
+	false, /* propertyValueIndex */ \
+	false, /* propertyValueIndexSidecar */ \
+	false, /* propertyValueIndexLazy */ \
+	false, /* propertyValueIndexBackground */ \
+	false, /* propertyValueIndexRanges */ \
+	FIFTYONE_DEGREES_CONFIG_RENDER_CACHE_CAPACITY_DEFAULT, /* renderCacheCapacity */ \
+	FIFTYONE_DEGREES_CONFIG_WKT_CACHE_CAPACITY_DEFAULT /* wktCacheCapacity */
 
 /**
  * @}
@@ -76,6 +76,12 @@ void fiftyoneDegreesDataSetFree(fiftyoneDegreesDataSetBase *dataSet) {
 		dataSet->indexPropertyProfile = NULL;
 	}
 
+	// Free the rendered strings.
+	RenderCacheFree(dataSet->renderCache);
+	dataSet->renderCache = NULL;
+	RenderCacheFree(dataSet->wktCache);
+	dataSet->wktCache = NULL;
+
 	// Free the memory used by the unique headers.
 	HeadersFree(dataSet->uniqueHeaders);
 	dataSet->uniqueHeaders = NULL;
@@ -96,7 +102,7 @@ void fiftyoneDegreesDataSetFree(fiftyoneDegreesDataSetBase *dataSet) {
 	// Free memory used to load the file into memory if still requires
 	// if used.
 	if (dataSet->memoryToFree != NULL) {
-		Free(dataSet->memoryToFree);
+		MemoryLargeFree(dataSet->memoryToFree);
 		dataSet->memoryToFree = NULL;
 	}
 
@@ -116,6 +122,8 @@ void fiftyoneDegreesDataSetReset(fiftyoneDegreesDataSetBase *dataSet) {
 	dataSet->available = NULL;
 	dataSet->overridable = NULL;
 	dataSet->indexPropertyProfile = NULL;
+	dataSet->renderCache = NULL;
+	dataSet->wktCache = NULL;
 	dataSet->config = NULL;
 	dataSet->handle = NULL;
 }
@@ -164,6 +172,28 @@ fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitProperties(
 			return COLLECTION_FAILURE;
 		}
 	}
+
+	// Create the cache for rendered strings if enabled. This is done here as
+	// the cache is keyed on the available property index.
+	if (CONFIG(dataSet)->renderCacheCapacity > 0) {
+		dataSet->renderCache = RenderCacheCreate(
+			CONFIG(dataSet)->renderCacheCapacity,
+			FIFTYONE_DEGREES_RENDER_CACHE_MAX_LENGTH_DEFAULT);
+		if (dataSet->renderCache == NULL) {
+			return INSUFFICIENT_MEMORY;
+		}
+	}
+
+	// Create the cache for WKT strings rendered from geometry values if
+	// enabled.
+	if (CONFIG(dataSet)->wktCacheCapacity > 0) {
+		dataSet->wktCache = RenderCacheCreate(
+			CONFIG(dataSet)->wktCacheCapacity,
+			FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+		if (dataSet->wktCache == NULL) {
+			return INSUFFICIENT_MEMORY;
+		}
+	}
 	
 	return SUCCESS;
 }
@@ -189,6 +219,150 @@ fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitHeaders(
 	return SUCCESS;
 }
 
+// Sets the sidecar file name for the master data file returning false if the
+// name would be too long.
+static bool getSidecarFileName(
+	DataSetBase *dataSet,
+	char *sidecarFileName,
+	size_t length) {
+	size_t masterLength = strlen(dataSet->masterFileName);
+	if (masterLength == 0 ||
+		masterLength + sizeof(FIFTYONE_DEGREES_INDICES_SIDECAR_EXTENSION) >
+		length) {
+		return false;
+	}
+	memcpy(sidecarFileName, dataSet->masterFileName, masterLength);
+	memcpy(
+		sidecarFileName + masterLength,
+		FIFTYONE_DEGREES_INDICES_SIDECAR_EXTENSION,
+		sizeof(FIFTYONE_DEGREES_INDICES_SIDECAR_EXTENSION));
+	return true;
+}
+
+// Creates the index with or without ranges as set in the configuration.
+static IndicesPropertyProfile* createIndex(
+	DataSetBase *dataSet,
+	fiftyoneDegreesCollection *profiles,
+	fiftyoneDegreesCollection *profileOffsets,
+	fiftyoneDegreesCollection *values,
+	bool lazy,
+	Exception* exception) {
+	if (CONFIG(dataSet)->propertyValueIndexRanges) {
+		return IndicesPropertyProfileCreateWithRanges(
+			profiles,
+			profileOffsets,
+			dataSet->available,
+			values,
+			lazy,
+			exception);
+	}
+	if (lazy) {
+		return IndicesPropertyProfileCreateLazy(
+			profiles,
+			profileOffsets,
+			dataSet->available,
+			values,
+			exception);
+	}
+	return IndicesPropertyProfileCreate(
+		profiles,
+		profileOffsets,
+		dataSet->available,
+		values,
+		exception);
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitIndex(
+	fiftyoneDegreesDataSetBase *dataSet,
+	fiftyoneDegreesCollection *profiles,
+	fiftyoneDegreesCollection *profileOffsets,
+	fiftyoneDegreesCollection *values,
+	fiftyoneDegreesException* exception) {
+	char sidecarFileName[FIFTYONE_DEGREES_FILE_MAX_PATH];
+	IndicesSidecarKey key;
+	bool useSidecar = false;
+
+	if (CONFIG(dataSet)->propertyValueIndex == false) {
+		return SUCCESS;
+	}
+
+	// Try to load the index from a valid sidecar file.
+	if (CONFIG(dataSet)->propertyValueIndexSidecar &&
+		getSidecarFileName(
+			dataSet,
+			sidecarFileName,
+			sizeof(sidecarFileName)) &&
+		IndicesSidecarKeyFromFile(
+			dataSet->masterFileName,
+			dataSet->available,
+			&key) == SUCCESS) {
+		useSidecar = true;
+		dataSet->indexPropertyProfile = IndicesPropertyProfileLoad(
+			sidecarFileName,
+			&key,
+			dataSet->available,
+			dataSet->uniqueHeaders == NULL ? &dataSet->uniqueHeaders : NULL,
+			exception);
+		if (EXCEPTION_FAILED) {
+			return CORRUPT_DATA;
+		}
+
+		// A sidecar with or without ranges is only used if it matches the
+		// configuration, otherwise it is replaced.
+		if (dataSet->indexPropertyProfile != NULL &&
+			(dataSet->indexPropertyProfile->valueEnds != NULL) != 
+			CONFIG(dataSet)->propertyValueIndexRanges) {
+			IndicesPropertyProfileFree(dataSet->indexPropertyProfile);
+			dataSet->indexPropertyProfile = NULL;
+		}
+		if (dataSet->indexPropertyProfile != NULL) {
+			return SUCCESS;
+		}
+	}
+
+	// Create a lazy index populated on demand, optionally completing the
+	// remaining rows in the background.
+	if (CONFIG(dataSet)->propertyValueIndexLazy) {
+		dataSet->indexPropertyProfile = createIndex(
+			dataSet,
+			profiles,
+			profileOffsets,
+			values,
+			true,
+			exception);
+		if (dataSet->indexPropertyProfile == NULL) {
+			return CORRUPT_DATA;
+		}
+		if (CONFIG(dataSet)->propertyValueIndexBackground) {
+			return IndicesPropertyProfileCompleteStart(
+				dataSet->indexPropertyProfile);
+		}
+		return SUCCESS;
+	}
+
+	// Create the index and record it in the sidecar for next time. Failing
+	// to save the sidecar is not an error as it is only an optimisation.
+	dataSet->indexPropertyProfile = createIndex(
+		dataSet,
+		profiles,
+		profileOffsets,
+		values,
+		false,
+		exception);
+	if (dataSet->indexPropertyProfile == NULL) {
+		return CORRUPT_DATA;
+	}
+	if (useSidecar) {
+		IndicesPropertyProfileSave(
+			dataSet->indexPropertyProfile,
+			dataSet->available,
+			dataSet->uniqueHeaders,
+			&key,
+			sidecarFileName);
+	}
+	return SUCCESS;
+}
+
 fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitFromFile(
 	fiftyoneDegreesDataSetBase *dataSet,
 	const char *fileName,
@@ -248,7 +422,9 @@ fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitInMemory(
 	fiftyoneDegreesMemoryReader *reader) {
 
 	// Read the file into memory checking that the operation completed.
+	MemoryTag tag = MemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_DATA_SET);
 	StatusCode status = FileReadToByteArray(dataSet->fileName, reader);
+	MemoryAccountingSetTag(tag);
 	
 	if (status == SUCCESS) {
 		// Set the data set so that memory can be freed.
@@ -96,6 +96,7 @@
 #include "overrides.h"
 #include "common.h"
 #include "indices.h"
+#include "renderCache.h"
 
 /**
  * Base data set structure which contains the 'must have's for all data sets.
@@ -131,6 +132,13 @@ typedef struct fiftyone_degrees_dataset_base_t {
 															   look up profile 
 															   values by 
 															   property */
+	fiftyoneDegreesRenderCache *renderCache; /**< Rendered strings for profile
+											 and property values, or NULL if
+											 not enabled */
+	fiftyoneDegreesRenderCache *wktCache; /**< WKT strings rendered from
+										  geometry values, or NULL if not
+										  enabled. See
+										  #fiftyoneDegreesWriteWkbAsWktToStringBuilderCached */
     const void *config; /**< Pointer to the config used to create the dataset */
 } fiftyoneDegreesDataSetBase;
 
@@ -158,6 +166,33 @@ typedef fiftyoneDegreesStatusCode(*fiftyoneDegreesDataSetInitFromMemoryMethod)(
 	fiftyoneDegreesFileOffset size,
 	fiftyoneDegreesException *exception);
 
+/**
+ * Initialises the index of values for profiles and properties if enabled by
+ * the configuration. If the sidecar option is enabled and the data set was
+ * initialised from a file then the index is loaded from the sidecar file next
+ * to the master data file when it is valid for the data file and available
+ * properties. Otherwise the index is created and then saved to the sidecar.
+ * If the lazy option is enabled and no sidecar was loaded a lazy index is
+ * created, and the remaining rows populated in the background if configured.
+ * If the unique headers have not yet been initialised and the sidecar holds
+ * headers then these are also restored, so the caller can skip
+ * #fiftyoneDegreesDataSetInitHeaders. Must be called after
+ * #fiftyoneDegreesDataSetInitProperties.
+ * @param dataSet pointer to a valid data set
+ * @param profiles collection of variable sized profiles to be indexed
+ * @param profileOffsets collection of fixed offsets to profiles to be indexed
+ * @param values collection to be indexed
+ * @param exception pointer to an exception data structure to be used if an
+ * exception occurs. See exceptions.h.
+ * @return the status associated with the index initialisation
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitIndex(
+	fiftyoneDegreesDataSetBase *dataSet,
+	fiftyoneDegreesCollection *profiles,
+	fiftyoneDegreesCollection *profileOffsets,
+	fiftyoneDegreesCollection *values,
+	fiftyoneDegreesException* exception);
+
 /**
  * Initialses the data set from data stored on file. This method
  * should clean up the resource properly if the initialisation process fails.
@@ -251,7 +286,7 @@ fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitFromFile(
  * other than #FIFTYONE_DEGREES_STATUS_SUCCESS means the data set was not
  * initialised correctly
  */
-fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitInMemory(
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesDataSetInitInMemory(
 	fiftyoneDegreesDataSetBase *dataSet,
 	fiftyoneDegreesMemoryReader *reader);
 
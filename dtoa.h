@@ -0,0 +1,77 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_DTOA_H_INCLUDED
+#define FIFTYONE_DEGREES_DTOA_H_INCLUDED
+
+/**
+ * @ingroup FiftyOneDegreesCommon
+ * @defgroup FiftyOneDegreesDtoa Double to Decimal
+ *
+ * Conversion of double precision floating point numbers to the shortest
+ * decimal representation.
+ *
+ * ## Introduction
+ *
+ * A double is converted to the decimal with the fewest significant digits
+ * which converts back to exactly the same double. Where more than one such
+ * decimal exists the one closest to the exact binary value is used. The
+ * result therefore does not contain the digits which come from the binary
+ * approximation of the decimal, such as 42.127000000000002 for 42.127.
+ *
+ * ## Algorithm
+ *
+ * The Ryu algorithm by Ulf Adams is used. The interval of decimals which
+ * round to the double is found with 128 bit multiplications by precomputed
+ * powers of 5, and digits are then removed from the decimal while the
+ * interval still contains it. No loops over the digits of the exact binary
+ * value, or arbitrary precision arithmetic, are needed.
+ *
+ * @{
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+
+/**
+ * Decimal representation of a double as significant digits multiplied by a
+ * power of 10.
+ */
+typedef struct fiftyone_degrees_dtoa_decimal_t {
+	uint64_t digits; /**< Significant digits, at most 17 */
+	int32_t exponent; /**< Power of 10 that digits is multiplied by */
+} fiftyoneDegreesDtoaDecimal;
+
+/**
+ * Gets the shortest decimal which converts back to the absolute value of the
+ * double. The sign of the value is ignored.
+ * @param value finite double to convert, must not be zero, NaN or infinite
+ * @return the shortest decimal representation of the absolute value
+ */
+EXTERNAL fiftyoneDegreesDtoaDecimal fiftyoneDegreesDtoaShortest(double value);
+
+/**
+ * @}
+ */
+
+#endif
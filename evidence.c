@@ -276,7 +276,10 @@ fiftyoneDegreesEvidenceKeyValuePairArray*
 fiftyoneDegreesEvidenceCreate(uint32_t capacity) {
 	fiftyoneDegreesEvidenceKeyValuePairArray *evidence;
 	uint32_t i;
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_EVIDENCE);
 	FIFTYONE_DEGREES_ARRAY_CREATE(EvidenceKeyValuePair, evidence, capacity);
+	MemoryAccountingSetTag(tag);
 	if (evidence != NULL) {
 		evidence->next = NULL;
 		evidence->prev = NULL;
@@ -348,6 +351,103 @@ fiftyoneDegreesEvidenceKeyValuePair* fiftyoneDegreesEvidenceAddString(
 	return EvidenceAddPair(evidence, prefix, pair);
 }
 
+// Adds the header to the evidence if it is one of the data set's headers,
+// binding the new pair to the header. Returns true if the header was added.
+static bool addHeader(
+	EvidenceKeyValuePairArray *evidence,
+	Headers *headers,
+	KeyValuePair pair) {
+	EvidenceKeyValuePair *added;
+	int index = HeaderGetIndex(headers, pair.key, pair.keyLength);
+	if (index < 0) {
+		return false;
+	}
+	added = EvidenceAddPair(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		pair);
+	added->header = &headers->items[index];
+	return true;
+}
+
+static bool isWhiteSpace(char c) {
+	return c == ' ' || c == '\t';
+}
+
+// Adds the header on the line if it is valid. The name must not be empty or
+// contain white space, which also excludes request and status lines.
+static bool addHeaderLine(
+	EvidenceKeyValuePairArray *evidence,
+	Headers *headers,
+	const char *line,
+	const char *end) {
+	KeyValuePair pair;
+	const char *colon = (const char*)memchr(line, ':', end - line);
+	if (colon == NULL || colon == line) {
+		return false;
+	}
+	pair.key = line;
+	pair.keyLength = colon - line;
+	if (memchr(pair.key, ' ', pair.keyLength) != NULL ||
+		memchr(pair.key, '\t', pair.keyLength) != NULL) {
+		return false;
+	}
+	
+	// Remove the optional white space around the value.
+	pair.value = colon + 1;
+	while (pair.value < end && isWhiteSpace(*pair.value)) {
+		pair.value++;
+	}
+	while (end > pair.value && isWhiteSpace(end[-1])) {
+		end--;
+	}
+	pair.valueLength = end - pair.value;
+	return addHeader(evidence, headers, pair);
+}
+
+uint32_t fiftyoneDegreesEvidenceAddHeaderBlock(
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	fiftyoneDegreesHeaders *headers,
+	const char *block,
+	size_t length) {
+	uint32_t count = 0;
+	const char *current = block, *end = block + length, *next, *lineEnd;
+	while (current < end) {
+
+		// Find the end of the line using memchr which the C library
+		// implements with vector instructions where available.
+		next = (const char*)memchr(current, '\n', end - current);
+		lineEnd = next == NULL ? end : next;
+		if (lineEnd > current && lineEnd[-1] == '\r') {
+			lineEnd--;
+		}
+
+		// An empty line marks the end of the headers.
+		if (lineEnd == current) {
+			break;
+		}
+		if (addHeaderLine(evidence, headers, current, lineEnd)) {
+			count++;
+		}
+		current = next == NULL ? end : next + 1;
+	}
+	return count;
+}
+
+uint32_t fiftyoneDegreesEvidenceAddHeaderPairs(
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	fiftyoneDegreesHeaders *headers,
+	const fiftyoneDegreesKeyValuePair *pairs,
+	uint32_t count) {
+	uint32_t i, added = 0;
+	for (i = 0; i < count; i++) {
+		if (addHeader(evidence, headers, pairs[i])) {
+			added++;
+		}
+	}
+	return added;
+}
+
 uint32_t fiftyoneDegreesEvidenceIterate(
 	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
 	int prefixes,
@@ -252,6 +252,49 @@ EXTERNAL fiftyoneDegreesEvidenceKeyValuePair* fiftyoneDegreesEvidenceAddPair(
 	fiftyoneDegreesEvidencePrefix prefix,
 	fiftyoneDegreesKeyValuePair pair);
 
+/**
+ * Adds the HTTP headers in a raw HTTP/1.x header block to the evidence. The
+ * block is split into lines, and any line which is not a header, such as the
+ * request or status line, is ignored. Splitting stops at the first empty line
+ * which marks the end of the headers, or at the end of the block.
+ * Only headers present in the headers provided are added. Each new entry has
+ * its header member set so that no further string comparison is needed when
+ * the evidence is processed. This method will NOT copy the values. The key
+ * and value of each entry point into the block, are NOT null terminated and
+ * must be read using their lengths. The block must not be freed until after
+ * the evidence has been freed.
+ * @param evidence pointer to the evidence array to add the entries to
+ * @param headers unique headers of the data set used to filter the headers
+ * @param block pointer to the start of the raw header block
+ * @param length number of characters in the block
+ * @return the number of headers added to the evidence
+ */
+EXTERNAL uint32_t fiftyoneDegreesEvidenceAddHeaderBlock(
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	fiftyoneDegreesHeaders *headers,
+	const char *block,
+	size_t length);
+
+/**
+ * Adds the HTTP headers from an array of name and value spans, as provided
+ * by web servers and proxies which have already parsed the request, to the
+ * evidence. Only headers present in the headers provided are added, with
+ * the header member of the new entry set. This method will NOT copy the
+ * values. The memory referenced by the pairs must not be freed until after
+ * the evidence has been freed.
+ * @param evidence pointer to the evidence array to add the entries to
+ * @param headers unique headers of the data set used to filter the headers
+ * @param pairs array of header names and values where the lengths are used
+ * and the strings need not be null terminated
+ * @param count number of pairs in the array
+ * @return the number of headers added to the evidence
+ */
+EXTERNAL uint32_t fiftyoneDegreesEvidenceAddHeaderPairs(
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	fiftyoneDegreesHeaders *headers,
+	const fiftyoneDegreesKeyValuePair *pairs,
+	uint32_t count);
+
 /**
  * Determines the evidence map prefix from the key.
  * @param key the evidence key including the evidence prefix .i.e. header
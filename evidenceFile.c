@@ -0,0 +1,309 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "evidenceFile.h"
+#include "fiftyone.h"
+
+// Number of sequential characters needed to indicate a control block.
+#define CONTROL_LENGTH 3
+
+// Number of characters of a key needed to map it to a prefix. Longer than
+// any of the prefixes.
+#define PREFIX_KEY_LENGTH 16
+
+typedef struct load_state_t {
+	EvidenceFile *file; // File being populated, or counted if pairs is NULL
+	uint32_t limit; // Maximum number of records
+	uint32_t recordStart; // Index of the first pair in the current record
+	size_t used; // Number of bytes of strings used
+	bool end; // True if the end of the documents has been reached
+	EvidencePrefix prefix; // Prefix for each line of a text file
+	const char *key; // Key for each line of a text file
+} loadState;
+
+// True if the file is being counted rather than populated.
+static bool isCounting(loadState *state) {
+	return state->file->pairs == NULL;
+}
+
+// Copies the characters to the strings adding a null terminator, or only
+// counts the bytes needed if counting.
+static char* addString(loadState *state, const char *value, size_t length) {
+	char *start = NULL;
+	if (isCounting(state) == false) {
+		start = state->file->strings + state->used;
+		memcpy(start, value, length);
+		start[length] = '\0';
+	}
+	state->used += length + 1;
+	return start;
+}
+
+static void addPair(
+	loadState *state,
+	EvidencePrefix prefix,
+	const char *key,
+	const char *value,
+	size_t valueLength) {
+	EvidenceFile *file = state->file;
+	char *copy = addString(state, value, valueLength);
+	if (isCounting(state) == false) {
+		EvidenceKeyValuePair *pair = &file->pairs[file->pairsCount];
+		pair->prefix = prefix;
+		pair->item.key = key;
+		pair->item.keyLength = key == NULL ? 0 : strlen(key);
+		pair->item.value = copy;
+		pair->item.valueLength = valueLength;
+		pair->parsedValue = copy;
+		pair->parsedLength = valueLength;
+		pair->header = NULL;
+	}
+	file->pairsCount++;
+}
+
+// Completes the current record if it contains any pairs, and starts the next.
+static void endRecord(loadState *state) {
+	EvidenceFile *file = state->file;
+	if (file->pairsCount > state->recordStart) {
+		if (isCounting(state) == false) {
+			EvidenceKeyValuePairArray *record = &file->records[file->count];
+			record->count = file->pairsCount - state->recordStart;
+			record->capacity = record->count;
+			record->items = &file->pairs[state->recordStart];
+			record->next = NULL;
+			record->prev = NULL;
+		}
+		file->count++;
+	}
+	state->recordStart = file->pairsCount;
+}
+
+// True if the line starts with the control character repeated.
+static bool isControl(const char *line, size_t length, char control) {
+	if (length < CONTROL_LENGTH) {
+		return false;
+	}
+	for (int i = 0; i < CONTROL_LENGTH; i++) {
+		if (line[i] != control) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Returns the prefix of the key, or NULL if not a known prefix.
+static EvidencePrefixMap* mapPrefix(const char *key, size_t length) {
+	char buffer[PREFIX_KEY_LENGTH + 1];
+	if (length > PREFIX_KEY_LENGTH) {
+		length = PREFIX_KEY_LENGTH;
+	}
+	memcpy(buffer, key, length);
+	buffer[length] = '\0';
+	return EvidenceMapPrefix(buffer);
+}
+
+// True if the value is wrapped in double quotes that a YAML serializer added
+// around a value whose first non-whitespace character is a single quote.
+static bool isDoubleQuoteWrapped(const char *value, size_t length) {
+	if (length < 2 || value[0] != '"' || value[length - 1] != '"') {
+		return false;
+	}
+	for (size_t i = 1; i < length - 1; i++) {
+		if (value[i] != ' ' && value[i] != '\t') {
+			return value[i] == '\'';
+		}
+	}
+	return false;
+}
+
+// Adds a pair from a line of a YAML document. The value starts after the
+// colon and the character following it, and has wrapping quotes removed.
+static void addYamlLine(loadState *state, const char *line, size_t length) {
+	const char *colon = (const char*)memchr(line, ':', length);
+	const char *value;
+	size_t valueLength;
+	if (colon == NULL) {
+		return;
+	}
+	size_t keyLength = (size_t)(colon - line);
+	EvidencePrefixMap *map = mapPrefix(line, keyLength);
+	if (map == NULL) {
+		return;
+	}
+	if (keyLength + 2 < length) {
+		value = colon + 2;
+		valueLength = length - keyLength - 2;
+	}
+	else {
+		value = line + length;
+		valueLength = 0;
+	}
+	if (valueLength > 0 && *value == '\'') {
+		value++;
+		valueLength--;
+		if (valueLength > 0 && value[valueLength - 1] == '\'') {
+			valueLength--;
+		}
+	}
+	else if (isDoubleQuoteWrapped(value, valueLength)) {
+		value++;
+		valueLength -= 2;
+	}
+	const char *key = addString(
+		state,
+		line + map->prefixLength,
+		keyLength - map->prefixLength);
+	addPair(state, map->prefixEnum, key, value, valueLength);
+}
+
+static void addYamlLineOrControl(
+	loadState *state,
+	const char *line,
+	size_t length) {
+	if (isControl(line, length, '-')) {
+		endRecord(state);
+	}
+	else if (isControl(line, length, '.')) {
+		endRecord(state);
+		state->end = true;
+	}
+	else {
+		addYamlLine(state, line, length);
+	}
+}
+
+// Calls the method for each line of the memory which is not empty until the
+// limit is reached, or the method indicates the end has been reached.
+static void iterateLines(
+	loadState *state,
+	const char *current,
+	const char *end,
+	void(*method)(loadState*, const char*, size_t)) {
+	while (current < end &&
+		state->end == false &&
+		state->file->count < state->limit) {
+		const char *line = current;
+		while (current < end && *current != '\n' && *current != '\r') {
+			current++;
+		}
+		if (current > line) {
+			method(state, line, (size_t)(current - line));
+		}
+		current++;
+	}
+	endRecord(state);
+}
+
+// Parses the memory twice. Once to count the records, pairs and strings and
+// then again to populate them once the memory has been allocated.
+static StatusCode load(
+	const char *fileName,
+	int limit,
+	EvidencePrefix prefix,
+	const char *key,
+	EvidenceFile *file,
+	void(*method)(loadState*, const char*, size_t)) {
+	FileMapped mapped;
+	loadState state;
+	memset(file, 0, sizeof(EvidenceFile));
+	StatusCode status = FileMapOpen(fileName, &mapped);
+	if (status != SUCCESS) {
+		// An empty file can not be mapped but contains no records.
+		return status == FILE_FAILURE && FileGetSize(fileName) == 0 ?
+			SUCCESS : status;
+	}
+	const char *start = (const char*)mapped.startByte;
+	const char *end = start + mapped.length;
+	for (int pass = 0; pass < 2 && status == SUCCESS; pass++) {
+		state.file = file;
+		state.limit = limit < 0 ? UINT32_MAX : (uint32_t)limit;
+		state.recordStart = 0;
+		state.used = 0;
+		state.end = false;
+		state.prefix = prefix;
+		file->count = 0;
+		file->pairsCount = 0;
+		state.key = key == NULL ? NULL : addString(&state, key, strlen(key));
+		iterateLines(&state, start, end, method);
+		if (pass == 0) {
+			if (file->count == 0) {
+				// Nothing to populate so leave the file empty.
+				file->pairsCount = 0;
+				break;
+			}
+			file->records = (EvidenceKeyValuePairArray*)Malloc(
+				sizeof(EvidenceKeyValuePairArray) * file->count);
+			file->pairs = (EvidenceKeyValuePair*)Malloc(
+				sizeof(EvidenceKeyValuePair) * file->pairsCount);
+			file->strings = (char*)Malloc(state.used);
+			if (file->records == NULL ||
+				file->pairs == NULL ||
+				file->strings == NULL) {
+				EvidenceFileFree(file);
+				status = INSUFFICIENT_MEMORY;
+			}
+		}
+	}
+	FileMapClose(&mapped);
+	return status;
+}
+
+// Adds a record containing a single pair with the whole line as the value.
+static void addTextLine(loadState *state, const char *line, size_t length) {
+	addPair(state, state->prefix, state->key, line, length);
+	endRecord(state);
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesEvidenceFileLoadYaml(
+	const char *fileName,
+	int limit,
+	fiftyoneDegreesEvidenceFile *file) {
+	return load(
+		fileName,
+		limit,
+		FIFTYONE_DEGREES_EVIDENCE_IGNORE,
+		NULL,
+		file,
+		addYamlLineOrControl);
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesEvidenceFileLoadText(
+	const char *fileName,
+	int limit,
+	fiftyoneDegreesEvidencePrefix prefix,
+	const char *key,
+	fiftyoneDegreesEvidenceFile *file) {
+	return load(fileName, limit, prefix, key, file, addTextLine);
+}
+
+void fiftyoneDegreesEvidenceFileFree(fiftyoneDegreesEvidenceFile *file) {
+	if (file->records != NULL) {
+		Free(file->records);
+	}
+	if (file->pairs != NULL) {
+		Free(file->pairs);
+	}
+	if (file->strings != NULL) {
+		Free(file->strings);
+	}
+	memset(file, 0, sizeof(EvidenceFile));
+}
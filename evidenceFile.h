@@ -0,0 +1,125 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_EVIDENCE_FILE_H_INCLUDED
+#define FIFTYONE_DEGREES_EVIDENCE_FILE_H_INCLUDED
+
+/**
+ * @ingroup FiftyOneDegreesCommon
+ * @defgroup FiftyOneDegreesEvidenceFile EvidenceFile
+ *
+ * Loads all the evidence in a YAML or text file into memory.
+ *
+ * ## Introduction
+ *
+ * The #fiftyoneDegreesYamlFileIterate and #fiftyoneDegreesTextFileIterate
+ * methods read a file through a buffer passing each record to a callback on
+ * the calling thread. When the same evidence is needed many times, such as
+ * when replaying captured evidence in a load test, the cost of reading and
+ * parsing the file dominates. The methods here map the file into memory and
+ * parse it once into an array of evidence records which can then be used
+ * from any number of threads.
+ *
+ * ## Layout
+ *
+ * All the records, pairs and strings are held in three allocations. Each
+ * record is a #fiftyoneDegreesEvidenceKeyValuePairArray whose items point
+ * into the array of all pairs. The keys and values of the pairs are null
+ * terminated strings, with the prefix removed from the key in the same way
+ * as #fiftyoneDegreesEvidenceAddString. The parsed value of each pair is set
+ * when the file is loaded so that iterating the evidence does not modify it,
+ * which means the records can be shared between threads as long as the
+ * consumer treats them as read only.
+ *
+ * YAML files are parsed with the same rules as
+ * #fiftyoneDegreesYamlFileIterate, including the removal of wrapping quotes.
+ * Keys without a known evidence prefix, such as `header.`, are ignored, as
+ * are documents without any evidence.
+ *
+ * @{
+ */
+
+#include "status.h"
+#include "evidence.h"
+#include "common.h"
+
+/**
+ * Evidence records loaded from a file.
+ */
+typedef struct fiftyone_degrees_evidence_file_t {
+	fiftyoneDegreesEvidenceKeyValuePairArray *records; /**< Array of records
+													   each containing the
+													   evidence from one
+													   document or line */
+	uint32_t count; /**< Number of records */
+	fiftyoneDegreesEvidenceKeyValuePair *pairs; /**< All the pairs in the
+												records */
+	uint32_t pairsCount; /**< Number of pairs across all records */
+	char *strings; /**< Keys and values of all the pairs */
+} fiftyoneDegreesEvidenceFile;
+
+/**
+ * Loads the evidence in each document of a YAML file into memory. The file
+ * should be structured as described in yamlfile.h.
+ * @param fileName name of the file to load
+ * @param limit maximum number of records to load, or -1 for all
+ * @param file to populate with the records. Must be freed with
+ * #fiftyoneDegreesEvidenceFileFree if the load succeeds.
+ * @return status code indicating whether the file was loaded
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesEvidenceFileLoadYaml(
+	const char *fileName,
+	int limit,
+	fiftyoneDegreesEvidenceFile *file);
+
+/**
+ * Loads each line of a text file into memory as a record with a single piece
+ * of evidence whose value is the line. Empty lines are ignored in the same way
+ * as #fiftyoneDegreesTextFileIterate.
+ * @param fileName name of the file to load
+ * @param limit maximum number of records to load, or -1 for all
+ * @param prefix of the evidence for each line e.g.
+ * #FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING
+ * @param key of the evidence for each line e.g. User-Agent
+ * @param file to populate with the records. Must be freed with
+ * #fiftyoneDegreesEvidenceFileFree if the load succeeds.
+ * @return status code indicating whether the file was loaded
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesEvidenceFileLoadText(
+	const char *fileName,
+	int limit,
+	fiftyoneDegreesEvidencePrefix prefix,
+	const char *key,
+	fiftyoneDegreesEvidenceFile *file);
+
+/**
+ * Frees the memory used by the records loaded from a file.
+ * @param file to free
+ */
+EXTERNAL void fiftyoneDegreesEvidenceFileFree(
+	fiftyoneDegreesEvidenceFile *file);
+
+/**
+ * @}
+ */
+
+#endif
@@ -85,6 +85,10 @@
 #include "constants.h"
 #include "weightedItem.h"
 #include "propertyValueType.h"
+#include "renderCache.h"
+#include "dtoa.h"
+#include "evidenceFile.h"
+#include "replay.h"
 
 /**
  * Macro used to support synonym implementation. Creates a typedef which 
@@ -122,10 +126,14 @@ MAP_TYPE(FileOffset)
 MAP_TYPE(FileOffsetUnsigned)
 MAP_TYPE(CacheNode)
 MAP_TYPE(FilePool)
+MAP_TYPE(FileMapped)
 MAP_TYPE(CollectionHeader)
 MAP_TYPE(Data)
 MAP_TYPE(Cache)
 MAP_TYPE(MemoryReader)
+MAP_TYPE(MemoryTag)
+MAP_TYPE(MemoryHugePages)
+MAP_TYPE(MemoryAccountingStats)
 MAP_TYPE(CacheShard)
 MAP_TYPE(StatusCode)
 MAP_TYPE(PropertiesRequired)
@@ -153,6 +161,7 @@ MAP_TYPE(DataSetInitFromFileMethod)
 MAP_TYPE(String)
 MAP_TYPE(VarLengthByteArray)
 MAP_TYPE(StoredBinaryValue)
+MAP_TYPE(StoredBinaryValueBuffer)
 MAP_TYPE(Property)
 MAP_TYPE(PropertyTypeRecord)
 MAP_TYPE(Component)
@@ -187,7 +196,11 @@ MAP_TYPE(Float)
 MAP_TYPE(KeyValuePair)
 MAP_TYPE(HeaderID)
 MAP_TYPE(IndicesPropertyProfile)
+MAP_TYPE(IndicesSidecarKey)
+MAP_TYPE(IndicesLazy)
 MAP_TYPE(StringBuilder)
+MAP_TYPE(StringBuilderWriter)
+MAP_TYPE(StringBuilderGrowable)
 MAP_TYPE(Json)
 MAP_TYPE(KeyValuePairArray)
 MAP_TYPE(IpType)
@@ -196,15 +209,23 @@ MAP_TYPE(WkbtotResult)
 MAP_TYPE(WkbtotReductionMode)
 MAP_TYPE(WeightedItem)
 MAP_TYPE(WeightedItemList)
+MAP_TYPE(RenderCache)
+MAP_TYPE(RenderCacheEntry)
+MAP_TYPE(DtoaDecimal)
+MAP_TYPE(EvidenceFile)
+MAP_TYPE(ReplayResult)
+MAP_TYPE(ReplayMethod)
 
 #define ProfileGetFinalSize fiftyoneDegreesProfileGetFinalSize /**< Synonym for #fiftyoneDegreesProfileGetFinalSize function. */
 #define ProfileGetOffsetForProfileId fiftyoneDegreesProfileGetOffsetForProfileId /**< Synonym for #fiftyoneDegreesProfileGetOffsetForProfileId function. */
 #define OverrideValuesAdd fiftyoneDegreesOverrideValuesAdd /**< Synonym for #fiftyoneDegreesOverrideValuesAdd function. */
+#define OverrideValuesCreateWithSlots fiftyoneDegreesOverrideValuesCreateWithSlots /**< Synonym for #fiftyoneDegreesOverrideValuesCreateWithSlots function. */
 #define ExceptionGetMessage fiftyoneDegreesExceptionGetMessage /**< Synonym for #fiftyoneDegreesExceptionGetMessage function. */
 #define ProfileGetByProfileId fiftyoneDegreesProfileGetByProfileId /**< Synonym for #fiftyoneDegreesProfileGetByProfileId function. */
 #define ProfileGetByProfileIdIndirect fiftyoneDegreesProfileGetByProfileIdIndirect /**< Synonym for #fiftyoneDegreesProfileGetByProfileIdIndirect function. */
 #define ProfileGetByIndex fiftyoneDegreesProfileGetByIndex /**< Synonym for #fiftyoneDegreesProfileGetByIndex function. */
 #define OverridesAdd fiftyoneDegreesOverridesAdd /**< Synonym for #fiftyoneDegreesOverridesAdd function. */
+#define OverridesAddReference fiftyoneDegreesOverridesAddReference /**< Synonym for #fiftyoneDegreesOverridesAddReference function. */
 #define OverrideProfileIds fiftyoneDegreesOverrideProfileIds /**< Synonym for #fiftyoneDegreesOverrideProfileIds function. */
 #define OverridePropertiesFree fiftyoneDegreesOverridePropertiesFree /**< Synonym for #fiftyoneDegreesOverridePropertiesFree function. */
 #define ComponentInitList fiftyoneDegreesComponentInitList /**< Synonym for #fiftyoneDegreesComponentInitList function. */
@@ -212,7 +233,12 @@ MAP_TYPE(WeightedItemList)
 #define ComponentGetHeaders fiftyoneDegreesComponentGetHeaders /**< Synonym for #fiftyoneDegreesComponentGetHeaders function. */
 #define CollectionGetInteger32 fiftyoneDegreesCollectionGetInteger32 /**< Synonym for #fiftyoneDegreesCollectionGetInteger32 function. */
 #define PropertyGet fiftyoneDegreesPropertyGet /**< Synonym for #fiftyoneDegreesPropertyGet function. */
+#define PropertyGetDescription fiftyoneDegreesPropertyGetDescription /**< Synonym for #fiftyoneDegreesPropertyGetDescription function. */
+#define PropertyGetCategory fiftyoneDegreesPropertyGetCategory /**< Synonym for #fiftyoneDegreesPropertyGetCategory function. */
+#define PropertyGetUrl fiftyoneDegreesPropertyGetUrl /**< Synonym for #fiftyoneDegreesPropertyGetUrl function. */
 #define ProfileIterateValuesForProperty fiftyoneDegreesProfileIterateValuesForProperty /**< Synonym for #fiftyoneDegreesProfileIterateValuesForProperty function. */
+#define ProfileValueIndexesLowerBound fiftyoneDegreesProfileValueIndexesLowerBound /**< Synonym for #fiftyoneDegreesProfileValueIndexesLowerBound function. */
+#define ProfileGetValueRange fiftyoneDegreesProfileGetValueRange /**< Synonym for #fiftyoneDegreesProfileGetValueRange function. */
 #define ProfileIterateValuesForPropertyWithIndex fiftyoneDegreesProfileIterateValuesForPropertyWithIndex /**< Synonym for #fiftyoneDegreesProfileIterateValuesForPropertyWithIndex function. */
 #define ProfileIterateValueIndexes fiftyoneDegreesProfileIterateValueIndexes /**< Synonym for #fiftyoneDegreesProfileIterateValueIndexes function. */
 #define ProfileIterateProfilesForPropertyAndValue fiftyoneDegreesProfileIterateProfilesForPropertyAndValue /**< Synonym for #fiftyoneDegreesProfileIterateProfilesForPropertyAndValue function. */
@@ -231,6 +257,7 @@ MAP_TYPE(WeightedItemList)
 #define TreeRootInit fiftyoneDegreesTreeRootInit /**< Synonym for #fiftyoneDegreesTreeRootInit function. */
 #define OverridesGetOverridingRequiredPropertyIndex fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex /**< Synonym for #fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex function. */
 #define OverridePropertiesCreate fiftyoneDegreesOverridePropertiesCreate /**< Synonym for #fiftyoneDegreesOverridePropertiesCreate function. */
+#define OverridePropertiesGetOverriding fiftyoneDegreesOverridePropertiesGetOverriding /**< Synonym for #fiftyoneDegreesOverridePropertiesGetOverriding function. */
 #define EvidenceCreate fiftyoneDegreesEvidenceCreate /**< Synonym for #fiftyoneDegreesEvidenceCreate function. */
 #define EvidenceFree fiftyoneDegreesEvidenceFree /**< Synonym for #fiftyoneDegreesEvidenceFree function. */
 #define OverridesGetOverridingRequiredPropertyIndex fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex /**< Synonym for #fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex function. */
@@ -238,6 +265,8 @@ MAP_TYPE(WeightedItemList)
 #define StringCompare fiftyoneDegreesStringCompare /**< Synonym for #fiftyoneDegreesStringCompare function. */
 #define StringSubString fiftyoneDegreesStringSubString /**< Synonym for #fiftyoneDegreesSubString function. */
 #define OverridesExtractFromEvidence fiftyoneDegreesOverridesExtractFromEvidence /**< Synonym for #fiftyoneDegreesOverridesExtractFromEvidence function. */
+#define OverridesAddCookies fiftyoneDegreesOverridesAddCookies /**< Synonym for #fiftyoneDegreesOverridesAddCookies function. */
+#define OverridesAddQueryString fiftyoneDegreesOverridesAddQueryString /**< Synonym for #fiftyoneDegreesOverridesAddQueryString function. */
 #define EvidenceIterate fiftyoneDegreesEvidenceIterate /**< Synonym for #fiftyoneDegreesEvidenceIterate function. */
 #define EvidenceIterateForHeaders fiftyoneDegreesEvidenceIterateForHeaders /**< Synonym for #fiftyoneDegreesEvidenceIterateForHeaders function. */
 #define CacheRelease fiftyoneDegreesCacheRelease /**< Synonym for #fiftyoneDegreesCacheRelease function. */
@@ -254,6 +283,17 @@ MAP_TYPE(WeightedItemList)
 #define MemoryTrackingGetAllocated fiftyoneDegreesMemoryTrackingGetAllocated /**< Synonym for #fiftyoneDegreesMemoryTrackingGetAllocated function. */
 #define SetUpMemoryTracking fiftyoneDegreesSetUpMemoryTracking /**< Synonym for #fiftyoneDegreesSetUpMemoryTracking function. */
 #define UnsetMemoryTracking fiftyoneDegreesUnsetMemoryTracking /**< Synonym for #fiftyoneDegreesUnsetMemoryTracking function. */
+#define SetUpMemoryAccounting fiftyoneDegreesSetUpMemoryAccounting /**< Synonym for #fiftyoneDegreesSetUpMemoryAccounting function. */
+#define UnsetMemoryAccounting fiftyoneDegreesUnsetMemoryAccounting /**< Synonym for #fiftyoneDegreesUnsetMemoryAccounting function. */
+#define MemoryAccountingSetTag fiftyoneDegreesMemoryAccountingSetTag /**< Synonym for #fiftyoneDegreesMemoryAccountingSetTag function. */
+#define MemoryAccountingFlush fiftyoneDegreesMemoryAccountingFlush /**< Synonym for #fiftyoneDegreesMemoryAccountingFlush function. */
+#define MemoryAccountingGet fiftyoneDegreesMemoryAccountingGet /**< Synonym for #fiftyoneDegreesMemoryAccountingGet function. */
+#define MemoryAccountingReset fiftyoneDegreesMemoryAccountingReset /**< Synonym for #fiftyoneDegreesMemoryAccountingReset function. */
+#define MemorySetHugePages fiftyoneDegreesMemorySetHugePages /**< Synonym for #fiftyoneDegreesMemorySetHugePages function. */
+#define MemoryGetHugePages fiftyoneDegreesMemoryGetHugePages /**< Synonym for #fiftyoneDegreesMemoryGetHugePages function. */
+#define MemoryLargeMalloc fiftyoneDegreesMemoryLargeMalloc /**< Synonym for #fiftyoneDegreesMemoryLargeMalloc function. */
+#define MemoryLargeFree fiftyoneDegreesMemoryLargeFree /**< Synonym for #fiftyoneDegreesMemoryLargeFree function. */
+#define MemoryTagGetName fiftyoneDegreesMemoryTagGetName /**< Synonym for #fiftyoneDegreesMemoryTagGetName function. */
 #define Malloc fiftyoneDegreesMalloc /**< Synonym for #fiftyoneDegreesMalloc function. */
 #define MallocAligned fiftyoneDegreesMallocAligned /**< Synonym for #fiftyoneDegreesMallocAligned function. */
 #define Free fiftyoneDegreesFree /**< Synonym for #fiftyoneDegreesFree function. */
@@ -282,7 +322,11 @@ MAP_TYPE(WeightedItemList)
 #define PseudoHeadersAddEvidence fiftyoneDegreesPseudoHeadersAddEvidence /**< Synonym for fiftyoneDegreesPseudoHeadersAddEvidence */
 #define PseudoHeadersRemoveEvidence fiftyoneDegreesPseudoHeadersRemoveEvidence /**< Synonym for fiftyoneDegreesPseudoHeadersRemoveEvidence */
 #define FileReadToByteArray fiftyoneDegreesFileReadToByteArray /**< Synonym for #fiftyoneDegreesFileReadToByteArray function. */
+#define FileMapOpen fiftyoneDegreesFileMapOpen /**< Synonym for #fiftyoneDegreesFileMapOpen function. */
+#define FileMapClose fiftyoneDegreesFileMapClose /**< Synonym for #fiftyoneDegreesFileMapClose function. */
 #define ResourceHandleDecUse fiftyoneDegreesResourceHandleDecUse /**< Synonym for #fiftyoneDegreesResourceHandleDecUse function. */
+#define ResourceHandlePinThread fiftyoneDegreesResourceHandlePinThread /**< Synonym for #fiftyoneDegreesResourceHandlePinThread function. */
+#define ResourceHandleUnpinThread fiftyoneDegreesResourceHandleUnpinThread /**< Synonym for #fiftyoneDegreesResourceHandleUnpinThread function. */
 #define ResourceReplace fiftyoneDegreesResourceReplace /**< Synonym for #fiftyoneDegreesResourceReplace function. */
 #define StatusGetMessage fiftyoneDegreesStatusGetMessage /**< Synonym for #fiftyoneDegreesStatusGetMessage function. */
 #define FileOpen fiftyoneDegreesFileOpen /**< Synonym for #fiftyoneDegreesFileOpen function. */
@@ -297,6 +341,10 @@ MAP_TYPE(WeightedItemList)
 #define MemoryTrackingMallocAligned fiftyoneDegreesMemoryTrackingMallocAligned /**< Synonym for #fiftyoneDegreesMemoryTrackingMallocAligned function. */
 #define MemoryTrackingFree fiftyoneDegreesMemoryTrackingFree /**< Synonym for #fiftyoneDegreesMemoryTrackingFree function. */
 #define MemoryTrackingFreeAligned fiftyoneDegreesMemoryTrackingFreeAligned /**< Synonym for #fiftyoneDegreesMemoryTrackingFreeAligned function. */
+#define MemoryAccountingMalloc fiftyoneDegreesMemoryAccountingMalloc /**< Synonym for #fiftyoneDegreesMemoryAccountingMalloc function. */
+#define MemoryAccountingMallocAligned fiftyoneDegreesMemoryAccountingMallocAligned /**< Synonym for #fiftyoneDegreesMemoryAccountingMallocAligned function. */
+#define MemoryAccountingFree fiftyoneDegreesMemoryAccountingFree /**< Synonym for #fiftyoneDegreesMemoryAccountingFree function. */
+#define MemoryAccountingFreeAligned fiftyoneDegreesMemoryAccountingFreeAligned /**< Synonym for #fiftyoneDegreesMemoryAccountingFreeAligned function. */
 #define MemoryStandardMalloc fiftyoneDegreesMemoryStandardMalloc /**< Synonym for #fiftyoneDegreesMemoryStandardMalloc function. */
 #define MemoryStandardMallocAligned fiftyoneDegreesMemoryStandardMallocAligned /**< Synonym for #fiftyoneDegreesMemoryStandardMallocAligned function. */
 #define MemoryStandardFree fiftyoneDegreesMemoryStandardFree /**< Synonym for #fiftyoneDegreesMemoryStandardFree function. */
@@ -315,6 +363,8 @@ MAP_TYPE(WeightedItemList)
 #define EvidenceMapPrefix fiftyoneDegreesEvidenceMapPrefix /**< Synonym for #fiftyoneDegreesEvidenceMapPrefix function. */
 #define EvidencePrefixString fiftyoneDegreesEvidencePrefixString /**< Synonym for #fiftyoneDegreesEvidencePrefixString function. */
 #define EvidenceAddPair fiftyoneDegreesEvidenceAddPair /**< Synonym for #fiftyoneDegreesEvidenceAddPair function. */
+#define EvidenceAddHeaderBlock fiftyoneDegreesEvidenceAddHeaderBlock /**< Synonym for #fiftyoneDegreesEvidenceAddHeaderBlock function. */
+#define EvidenceAddHeaderPairs fiftyoneDegreesEvidenceAddHeaderPairs /**< Synonym for #fiftyoneDegreesEvidenceAddHeaderPairs function. */
 #define EvidenceAddString fiftyoneDegreesEvidenceAddString /**< Synonym for #fiftyoneDegreesEvidenceAddString function. */
 #define PropertiesGetRequiredPropertyIndexFromName fiftyoneDegreesPropertiesGetRequiredPropertyIndexFromName /**< Synonym for #fiftyoneDegreesPropertiesGetRequiredPropertyIndexFromName function. */
 #define PropertiesGetNameFromRequiredIndex fiftyoneDegreesPropertiesGetNameFromRequiredIndex /**< Synonym for #fiftyoneDegreesPropertiesGetNameFromRequiredIndex function. */
@@ -330,6 +380,8 @@ MAP_TYPE(WeightedItemList)
 #define CollectionReadFilePosition fiftyoneDegreesCollectionReadFilePosition /**< Synonym for #fiftyoneDegreesCollectionReadFilePosition function. */
 #define CollectionReadFileFixed fiftyoneDegreesCollectionReadFileFixed /**< Synonym for #fiftyoneDegreesCollectionReadFileFixed function. */
 #define CollectionGetIsMemoryOnly fiftyoneDegreesCollectionGetIsMemoryOnly /**< Synonym for #fiftyoneDegreesCollectionGetIsMemoryOnly function. */
+#define CollectionGetMemory fiftyoneDegreesCollectionGetMemory /**< Synonym for #fiftyoneDegreesCollectionGetMemory function. */
+#define CollectionFreeThreadBuffers fiftyoneDegreesCollectionFreeThreadBuffers /**< Synonym for #fiftyoneDegreesCollectionFreeThreadBuffers function. */
 #define HeaderGetIndex fiftyoneDegreesHeaderGetIndex /**< Synonym for #fiftyoneDegreesHeaderGetIndex function. */
 #define FileWrite fiftyoneDegreesFileWrite /**< Synonym for #fiftyoneDegreesFileWrite function. */
 #define FilePoolInit fiftyoneDegreesFilePoolInit /**< Synonym for #fiftyoneDegreesFilePoolInit function. */
@@ -342,6 +394,7 @@ MAP_TYPE(WeightedItemList)
 #define DataSetReset fiftyoneDegreesDataSetReset /**< Synonym for #fiftyoneDegreesDataSetReset function. */
 #define DataSetInitProperties fiftyoneDegreesDataSetInitProperties /**< Synonym for #fiftyoneDegreesDataSetInitProperties function. */
 #define DataSetInitHeaders fiftyoneDegreesDataSetInitHeaders /**< Synonym for #fiftyoneDegreesDataSetInitHeaders function. */
+#define DataSetInitIndex fiftyoneDegreesDataSetInitIndex /**< Synonym for #fiftyoneDegreesDataSetInitIndex function. */
 #define DataSetInitFromFile fiftyoneDegreesDataSetInitFromFile /**< Synonym for #fiftyoneDegreesDataSetInitFromFile function. */
 #define DataSetInitInMemory fiftyoneDegreesDataSetInitInMemory /**< Synonym for #fiftyoneDegreesDataSetInitInMemory function. */
 #define DataSetGet fiftyoneDegreesDataSetGet /**< Synonym for #fiftyoneDegreesDataSetGet function. */
@@ -358,6 +411,8 @@ MAP_TYPE(WeightedItemList)
 #define ValueGetIndexByName fiftyoneDegreesValueGetIndexByName /**< Synonym for #fiftyoneDegreesValueGetIndexByName function. */
 #define ValueGetIndexByNameAndType fiftyoneDegreesValueGetIndexByNameAndType /**< Synonym for #fiftyoneDegreesValueGetIndexByNameAndType function. */
 #define ValueGet fiftyoneDegreesValueGet /**< Synonym for #fiftyoneDegreesValueGet function. */
+#define ValueGetDescription fiftyoneDegreesValueGetDescription /**< Synonym for #fiftyoneDegreesValueGetDescription function. */
+#define ValueGetUrl fiftyoneDegreesValueGetUrl /**< Synonym for #fiftyoneDegreesValueGetUrl function. */
 #define CollectionBinarySearch fiftyoneDegreesCollectionBinarySearch /**< Synonym for #fiftyoneDegreesCollectionBinarySearch function. */
 #define PropertyGetName fiftyoneDegreesPropertyGetName /**< Synonym for #fiftyoneDegreesPropertyGetName function. */
 #define PropertyGetStoredType fiftyoneDegreesPropertyGetStoredType /**< Synonym for #fiftyoneDegreesPropertyGetStoredType function. */
@@ -377,9 +432,23 @@ MAP_TYPE(WeightedItemList)
 #define ProcessGetId fiftyoneDegreesProcessGetId /**< Synonym for fiftyoneDegreesProcessGetId */
 #define YamlFileIterate fiftyoneDegreesYamlFileIterate /**< Synonym for fiftyoneDegreesYamlFileIterate */
 #define YamlFileIterateWithLimit fiftyoneDegreesYamlFileIterateWithLimit /**< Synonym for fiftyoneDegreesYamlFileIterateWithLimit */
+#define EvidenceFileLoadYaml fiftyoneDegreesEvidenceFileLoadYaml /**< Synonym for #fiftyoneDegreesEvidenceFileLoadYaml function. */
+#define EvidenceFileLoadText fiftyoneDegreesEvidenceFileLoadText /**< Synonym for #fiftyoneDegreesEvidenceFileLoadText function. */
+#define EvidenceFileFree fiftyoneDegreesEvidenceFileFree /**< Synonym for #fiftyoneDegreesEvidenceFileFree function. */
+#define ReplayRun fiftyoneDegreesReplayRun /**< Synonym for #fiftyoneDegreesReplayRun function. */
 #define IndicesPropertyProfileCreate fiftyoneDegreesIndicesPropertyProfileCreate /**< Synonym for fiftyoneDegreesIndicesPropertyProfileCreate */
 #define IndicesPropertyProfileFree fiftyoneDegreesIndicesPropertyProfileFree /**< Synonym for fiftyoneDegreesIndicesPropertyProfileFree */
 #define IndicesPropertyProfileLookup fiftyoneDegreesIndicesPropertyProfileLookup /**< Synonym for fiftyoneDegreesIndicesPropertyProfileLookup */
+#define IndicesSidecarKeyFromMemory fiftyoneDegreesIndicesSidecarKeyFromMemory /**< Synonym for #fiftyoneDegreesIndicesSidecarKeyFromMemory function. */
+#define IndicesSidecarKeyFromFile fiftyoneDegreesIndicesSidecarKeyFromFile /**< Synonym for #fiftyoneDegreesIndicesSidecarKeyFromFile function. */
+#define IndicesPropertyProfileSave fiftyoneDegreesIndicesPropertyProfileSave /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileSave function. */
+#define IndicesPropertyProfileLoad fiftyoneDegreesIndicesPropertyProfileLoad /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileLoad function. */
+#define IndicesPropertyProfileCreateLazy fiftyoneDegreesIndicesPropertyProfileCreateLazy /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileCreateLazy function. */
+#define IndicesPropertyProfileCreateWithRanges fiftyoneDegreesIndicesPropertyProfileCreateWithRanges /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileCreateWithRanges function. */
+#define IndicesPropertyProfileComplete fiftyoneDegreesIndicesPropertyProfileComplete /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileComplete function. */
+#define IndicesPropertyProfileCompleteStart fiftyoneDegreesIndicesPropertyProfileCompleteStart /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileCompleteStart function. */
+#define IndicesPropertyProfileLookupForValues fiftyoneDegreesIndicesPropertyProfileLookupForValues /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileLookupForValues function. */
+#define IndicesPropertyProfileLookupRange fiftyoneDegreesIndicesPropertyProfileLookupRange /**< Synonym for #fiftyoneDegreesIndicesPropertyProfileLookupRange function. */
 #define JsonDocumentStart fiftyoneDegreesJsonDocumentStart /**< Synonym for fiftyoneDegreesJsonDocumentStart */
 #define JsonDocumentEnd fiftyoneDegreesJsonDocumentEnd /**< Synonym for fiftyoneDegreesJsonDocumentEnd */
 #define JsonPropertyStart fiftyoneDegreesJsonPropertyStart /**< Synonym for fiftyoneDegreesJsonPropertyStart */
@@ -387,6 +456,9 @@ MAP_TYPE(WeightedItemList)
 #define JsonPropertyValues fiftyoneDegreesJsonPropertyValues /**< Synonym for fiftyoneDegreesJsonPropertyValues */
 #define JsonPropertySeparator fiftyoneDegreesJsonPropertySeparator /**< Synonym for fiftyoneDegreesJsonPropertySeparator */
 #define StringBuilderInit fiftyoneDegreesStringBuilderInit /**< Synonym for fiftyoneDegreesStringBuilderInit */
+#define StringBuilderInitWriter fiftyoneDegreesStringBuilderInitWriter /**< Synonym for fiftyoneDegreesStringBuilderInitWriter */
+#define StringBuilderGrowableWrite fiftyoneDegreesStringBuilderGrowableWrite /**< Synonym for fiftyoneDegreesStringBuilderGrowableWrite */
+#define StringBuilderGrowableFree fiftyoneDegreesStringBuilderGrowableFree /**< Synonym for fiftyoneDegreesStringBuilderGrowableFree */
 #define StringBuilderAddChar fiftyoneDegreesStringBuilderAddChar /**< Synonym for fiftyoneDegreesStringBuilderAddChar */
 #define StringBuilderAddInteger fiftyoneDegreesStringBuilderAddInteger /**< Synonym for fiftyoneDegreesStringBuilderAddInteger */
 #define StringBuilderAddDouble fiftyoneDegreesStringBuilderAddDouble /**< Synonym for fiftyoneDegreesStringBuilderAddDouble */
@@ -397,9 +469,11 @@ MAP_TYPE(WeightedItemList)
 #define EvidenceIterateMethod fiftyoneDegreesEvidenceIterateMethod /**< Synonym for fiftyoneDegreesEvidenceIterateMethod */
 #define OverrideHasValueForRequiredPropertyIndex fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex /**< Synonym for fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex */
 #define IpAddressParse fiftyoneDegreesIpAddressParse /**< Synonym for fiftyoneDegreesIpAddressParse */
+#define IpAddressesParse fiftyoneDegreesIpAddressesParse /**< Synonym for fiftyoneDegreesIpAddressesParse */
 #define IpAddressesCompare fiftyoneDegreesIpAddressesCompare /**< Synonym for fiftyoneDegreesIpAddressesCompare */
 #define ConvertWkbToWkt fiftyoneDegreesConvertWkbToWkt /**< Synonym for fiftyoneDegreesConvertWkbToWkt */
 #define WriteWkbAsWktToStringBuilder fiftyoneDegreesWriteWkbAsWktToStringBuilder /**< Synonym for fiftyoneDegreesWriteWkbAsWktToStringBuilder */
+#define WriteWkbAsWktToStringBuilderCached fiftyoneDegreesWriteWkbAsWktToStringBuilderCached /**< Synonym for fiftyoneDegreesWriteWkbAsWktToStringBuilderCached */
 #define WeightedItemListInit fiftyoneDegreesWeightedItemListInit /**< Synonym for fiftyoneDegreesWeightedItemListInit */
 #define WeightedItemListRelease fiftyoneDegreesWeightedItemListRelease /**< Synonym for fiftyoneDegreesWeightedItemListRelease */
 #define WeightedItemListFree fiftyoneDegreesWeightedItemListFree /**< Synonym for fiftyoneDegreesWeightedItemListFree */
@@ -408,6 +482,13 @@ MAP_TYPE(WeightedItemList)
 #define ValueGetWeight fiftyoneDegreesValueGetWeight /**< Synonym for fiftyoneDegreesValueGetWeight */
 #define ValueIsWeighted fiftyoneDegreesValueIsWeighted /**< Synonym for fiftyoneDegreesValueIsWeighted */
 #define PropertyValueTypeGetUnderlyingType fiftyoneDegreesPropertyValueTypeGetUnderlyingType /**< Synonym for fiftyoneDegreesPropertyValueTypeGetUnderlyingType */
+#define RenderCacheCreate fiftyoneDegreesRenderCacheCreate /**< Synonym for #fiftyoneDegreesRenderCacheCreate function. */
+#define RenderCacheFree fiftyoneDegreesRenderCacheFree /**< Synonym for #fiftyoneDegreesRenderCacheFree function. */
+#define RenderCacheGet fiftyoneDegreesRenderCacheGet /**< Synonym for #fiftyoneDegreesRenderCacheGet function. */
+#define RenderCacheAdd fiftyoneDegreesRenderCacheAdd /**< Synonym for #fiftyoneDegreesRenderCacheAdd function. */
+#define RenderCacheAddTooLong fiftyoneDegreesRenderCacheAddTooLong /**< Synonym for #fiftyoneDegreesRenderCacheAddTooLong function. */
+#define RenderCacheIsFull fiftyoneDegreesRenderCacheIsFull /**< Synonym for #fiftyoneDegreesRenderCacheIsFull function. */
+#define DtoaShortest fiftyoneDegreesDtoaShortest /**< Synonym for #fiftyoneDegreesDtoaShortest function. */
 
 /* <-- only one asterisk to avoid inclusion in documentation
  * Shortened constants.
@@ -430,6 +511,8 @@ MAP_TYPE(WeightedItemList)
 #define EXCEPTION_CHECK FIFTYONE_DEGREES_EXCEPTION_CHECK /**< Synonym for #FIFTYONE_DEGREES_EXCEPTION_CHECK macro. */
 #define STRING FIFTYONE_DEGREES_STRING /**< Synonym for #FIFTYONE_DEGREES_STRING macro. */
 #define COLLECTION_RELEASE FIFTYONE_DEGREES_COLLECTION_RELEASE /**< Synonym for #FIFTYONE_DEGREES_COLLECTION_RELEASE macro. */
+#define COLLECTION_MEMORY_INDEX FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX /**< Synonym for #FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX macro. */
+#define COLLECTION_MEMORY_OFFSET FIFTYONE_DEGREES_COLLECTION_MEMORY_OFFSET /**< Synonym for #FIFTYONE_DEGREES_COLLECTION_MEMORY_OFFSET macro. */
 #define FILE_MAX_PATH FIFTYONE_DEGREES_FILE_MAX_PATH /**< Synonym for #FIFTYONE_DEGREES_FILE_MAX_PATH macro. */
 #define THREAD_CREATE FIFTYONE_DEGREES_THREAD_CREATE /**< Synonym for #FIFTYONE_DEGREES_THREAD_CREATE macro. */
 #define THREAD_CLOSE FIFTYONE_DEGREES_THREAD_CLOSE /**< Synonym for #FIFTYONE_DEGREES_THREAD_CLOSE macro. */
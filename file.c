@@ -33,6 +33,15 @@
 #include <unistd.h>
 #endif
 
+#ifdef _WIN32
+#ifndef _MSC_VER
+#include <windows.h>
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
 #ifdef __APPLE__
 #include <libproc.h>
 #include <sys/proc_info.h>
@@ -1112,14 +1121,15 @@ fiftyoneDegreesStatusCode fiftyoneDegreesFileReadToByteArray(
 			status = FILE_TOO_LARGE;
 		} else {
 			size_t const fileSize = (size_t)(reader->length * sizeof(char));
-			reader->current = reader->startByte = (byte*)Malloc(fileSize);
+			reader->current = reader->startByte =
+				(byte*)MemoryLargeMalloc(fileSize);
 			if (reader->current != NULL) {
 				if (FileSeek(sourceFile, 0L, SEEK_SET) != 0 ||
 					fread(reader->current, fileSize, 1, sourceFile) != 1) {
 					// The file could not be loaded into memory. Release the
 					// memory allocated earlier and set the status to file
 					// failure.
-					free(reader->current);
+					MemoryLargeFree(reader->current);
 					reader->startByte = NULL;
 					reader->current = NULL;
 					reader->length = 0;
@@ -1143,6 +1153,101 @@ fiftyoneDegreesStatusCode fiftyoneDegreesFileReadToByteArray(
 	return status;
 }
 
+fiftyoneDegreesStatusCode fiftyoneDegreesFileMapOpen(
+	const char *fileName,
+	fiftyoneDegreesFileMapped *mapped) {
+	mapped->startByte = NULL;
+	mapped->length = 0;
+	mapped->fileHandle = NULL;
+	mapped->mappingHandle = NULL;
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	HANDLE file = CreateFileA(
+		fileName,
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return FILE_NOT_FOUND;
+	}
+	if (GetFileSizeEx(file, &size) == 0 ||
+		size.QuadPart <= 0 ||
+		(uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+		CloseHandle(file);
+		return FILE_FAILURE;
+	}
+	HANDLE mapping = CreateFileMappingA(
+		file,
+		NULL,
+		PAGE_READONLY,
+		0,
+		0,
+		NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return FILE_FAILURE;
+	}
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return FILE_FAILURE;
+	}
+	mapped->startByte = (byte*)view;
+	mapped->length = (size_t)size.QuadPart;
+	mapped->fileHandle = file;
+	mapped->mappingHandle = mapping;
+#else
+	struct stat info;
+	int file = open(fileName, O_RDONLY);
+	if (file < 0) {
+		return errno == ENOENT ? FILE_NOT_FOUND : FILE_FAILURE;
+	}
+	if (fstat(file, &info) != 0 ||
+		info.st_size <= 0 ||
+		(uint64_t)info.st_size > (uint64_t)SIZE_MAX) {
+		close(file);
+		return FILE_FAILURE;
+	}
+	void *view = mmap(
+		NULL,
+		(size_t)info.st_size,
+		PROT_READ,
+		MAP_PRIVATE,
+		file,
+		0);
+
+	// The mapping holds its own reference to the file so the descriptor is
+	// not needed once the mapping exists.
+	close(file);
+	if (view == MAP_FAILED) {
+		return FILE_FAILURE;
+	}
+	mapped->startByte = (byte*)view;
+	mapped->length = (size_t)info.st_size;
+#endif
+	return SUCCESS;
+}
+
+void fiftyoneDegreesFileMapClose(fiftyoneDegreesFileMapped *mapped) {
+	if (mapped->startByte != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(mapped->startByte);
+		CloseHandle((HANDLE)mapped->mappingHandle);
+		CloseHandle((HANDLE)mapped->fileHandle);
+#else
+		munmap(mapped->startByte, mapped->length);
+#endif
+	}
+	mapped->startByte = NULL;
+	mapped->length = 0;
+	mapped->fileHandle = NULL;
+	mapped->mappingHandle = NULL;
+}
+
 void fiftyoneDegreesFilePoolReset(fiftyoneDegreesFilePool *filePool) {
 	PoolReset(&filePool->pool);
 	filePool->length = 0;
@@ -86,6 +86,8 @@
  *
  * **read to byte array** : #fiftyoneDegreesFileReadToByteArray
  *
+ * **map** : #fiftyoneDegreesFileMapOpen
+ *
  * **write** : #fiftyoneDegreesFileWrite
  *
  * ## Usage Example
@@ -483,7 +485,9 @@ EXTERNAL fiftyoneDegreesFileOffset fiftyoneDegreesFileGetSize(const char *fileNa
 /**
  * Reads the contents of a file into memory. The correct amount of memory will
  * be allocated by the method. This memory needs to be freed by the caller
- * after the data has been finished with.
+ * using #fiftyoneDegreesMemoryLargeFree after the data has been finished
+ * with, as it is backed by huge pages if enabled with
+ * #fiftyoneDegreesMemorySetHugePages.
  * @param fileName path to the source file
  * @param reader to contain the pointer to the memory and the size
  * @return status code indicating whether the read was successful
@@ -492,6 +496,38 @@ EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesFileReadToByteArray(
 	const char *fileName,
 	fiftyoneDegreesMemoryReader *reader);
 
+/**
+ * Read only view of an entire file mapped into the address space of the
+ * process. Pages are only loaded by the operating system when they are first
+ * accessed, and are shared between processes mapping the same file.
+ */
+typedef struct fiftyone_degrees_file_mapped_t {
+	byte *startByte; /**< The first byte of the mapped file */
+	size_t length; /**< Length of the mapping in bytes */
+	void *fileHandle; /**< Platform handle to the open file, or NULL if the
+					  platform does not need one once mapped */
+	void *mappingHandle; /**< Platform handle to the mapping object, or NULL if
+						 the platform does not need one */
+} fiftyoneDegreesFileMapped;
+
+/**
+ * Maps the whole of the file into memory as read only. The mapping must be
+ * released with #fiftyoneDegreesFileMapClose when finished with.
+ * @param fileName path to the file to map
+ * @param mapped structure to set with the start and length of the mapping
+ * @return status code indicating whether the file was mapped
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesFileMapOpen(
+	const char *fileName,
+	fiftyoneDegreesFileMapped *mapped);
+
+/**
+ * Releases a mapping created with #fiftyoneDegreesFileMapOpen. Any pointers
+ * into the mapped memory are invalid after this method returns.
+ * @param mapped the mapping to release
+ */
+EXTERNAL void fiftyoneDegreesFileMapClose(fiftyoneDegreesFileMapped *mapped);
+
 /**
  * Resets the pool without releasing any resources.
  * @param filePool to be reset.
@@ -517,7 +517,7 @@ static Headers* trimHeaders(Headers* source, Exception* exception) {
 	return trimmed;
 }
 
-fiftyoneDegreesHeaders* fiftyoneDegreesHeadersCreate(
+static Headers* createHeaders(
 	bool expectUpperPrefixedHeaders,
 	void *state,
 	fiftyoneDegreesHeadersGetMethod get,
@@ -561,6 +561,22 @@ fiftyoneDegreesHeaders* fiftyoneDegreesHeadersCreate(
 	return headers;
 }
 
+fiftyoneDegreesHeaders* fiftyoneDegreesHeadersCreate(
+	bool expectUpperPrefixedHeaders,
+	void *state,
+	fiftyoneDegreesHeadersGetMethod get,
+	fiftyoneDegreesException* exception) {
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_HEADERS);
+	Headers* headers = createHeaders(
+		expectUpperPrefixedHeaders,
+		state,
+		get,
+		exception);
+	MemoryAccountingSetTag(tag);
+	return headers;
+}
+
 int fiftyoneDegreesHeaderGetIndex(
 	fiftyoneDegreesHeaders *headers,
 	const char* httpHeaderName,
@@ -38,33 +38,83 @@ static uint32_t getProfileIdIndex(
 	return profileId - index->minProfileId;
 }
 
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+
+// Reads the state of a row in a lazy index ensuring that the entries of the
+// row written before the state was set to filled are visible. A plain read is
+// not an acquire on all the processors MSVC targets, so a compare exchange
+// which never changes the state is used.
+#if defined(FIFTYONE_DEGREES_NO_THREADING)
+#define ROW_STATE_GET(s) (s)
+#elif defined(_MSC_VER)
+#define ROW_STATE_GET(s) InterlockedCompareExchange(&(s), 0, 0)
+#else
+#define ROW_STATE_GET(s) __atomic_load_n(&(s), __ATOMIC_ACQUIRE)
+#endif
+
+// Adds the number of entries set in a row to the filled count of the index.
+// Rows of a lazy index can be populated by several threads at once.
+#if defined(FIFTYONE_DEGREES_NO_THREADING)
+#define FILLED_ADD(i, n) (i)->filled += (n)
+#elif defined(_MSC_VER)
+#define FILLED_ADD(i, n) \
+	InterlockedExchangeAdd((volatile long*)&(i)->filled, (long)(n))
+#else
+#define FILLED_ADD(i, n) __atomic_add_fetch(&(i)->filled, n, __ATOMIC_RELAXED)
+#endif
+
+// Claims the row for population returning true if the caller must populate
+// the row.
+static bool rowClaim(volatile long* state) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	return INTERLOCK_EXCHANGE(
+		*state,
+		FIFTYONE_DEGREES_INDICES_ROW_FILLING,
+		FIFTYONE_DEGREES_INDICES_ROW_EMPTY) ==
+		FIFTYONE_DEGREES_INDICES_ROW_EMPTY;
+#else
+	if (*state == FIFTYONE_DEGREES_INDICES_ROW_EMPTY) {
+		*state = FIFTYONE_DEGREES_INDICES_ROW_FILLING;
+		return true;
+	}
+	return false;
+#endif
+}
+
+// Releases a row previously claimed setting the new state. The full barrier
+// ensures the entries of the row are visible before the state.
+static void rowRelease(volatile long* state, long newState) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	INTERLOCK_EXCHANGE(
+		*state,
+		newState,
+		FIFTYONE_DEGREES_INDICES_ROW_FILLING);
+#else
+	*state = newState;
+#endif
+}
+
 // Loops through the values associated with the profile setting the index at 
 // the position for the property and profile to the first value index from the
-// profile.
-static void addProfileValuesMethod(
-	IndicesPropertyProfile* index, // index in use or null if not available
+// profile. If the index records ranges then the position after the last value
+// for the property is also set. Returns the number of entries set.
+static uint32_t setProfileRow(
+	IndicesPropertyProfile* index, // index in use
 	map* propertyIndexes, // property indexes in ascending order
 	fiftyoneDegreesCollection* values, // collection of values
-	Profile* profile, 
+	uint32_t profileId, // profile id of the row
+	const uint32_t* first, // first value index for the profile
+	uint32_t valueCount, // number of values for the profile
 	Exception* exception) {
-#ifdef FIFTYONE_DEGREES_REDUCED_FILE
-	// A reduced size data file does not contain profile ids, so this method
-	// cannot be implemented.
-#ifdef _MSC_VER
-	UNREFERENCED_PARAMETER(index);
-	UNREFERENCED_PARAMETER(propertyIndexes);
-	UNREFERENCED_PARAMETER(values);
-	UNREFERENCED_PARAMETER(profile);
-#endif
-	EXCEPTION_SET(NOT_IMPLEMENTED);
-#else
 	uint32_t valueIndex;
+	uint32_t set = 0; // Number of entries set in the row
+	uint32_t lastCell = UINT32_MAX; // Range cell for the last property found
+	int16_t lastProperty = -1; // Property index of lastCell
 	Item valueItem; // The current value memory
 	Value* value; // The current value pointer
 	DataReset(&valueItem.data);
 	
-	uint32_t* first = (uint32_t*)(profile + 1); // First value for the profile
-	uint32_t base = getProfileIdIndex(index, profile->profileId) * 
+	uint32_t base = getProfileIdIndex(index, profileId) * 
 		index->availablePropertyCount;
 
 	CollectionKey valueKey = {
@@ -75,14 +125,25 @@ static void addProfileValuesMethod(
 	// relates to a new property index. If it does then record the first value
 	// index and advance the current index to the next pointer.
 	for (uint32_t i = 0, p = 0;
-		i < profile->valueCount &&
-		p < index->availablePropertyCount &&
+		i < valueCount &&
+		(p < index->availablePropertyCount || lastCell != UINT32_MAX) &&
 		EXCEPTION_OKAY;
 		i++) {
 		valueKey.indexOrOffset.offset = *(first + i);
 		value = values->get(values, &valueKey, &valueItem, exception);
 		if (value != NULL && EXCEPTION_OKAY) {
 
+			// Extend the range of the last property found if the value also
+			// relates to it.
+			if (lastCell != UINT32_MAX) {
+				if (value->propertyIndex == lastProperty) {
+					index->valueEnds[lastCell] = i + 1;
+				}
+				else {
+					lastCell = UINT32_MAX;
+				}
+			}
+
 			// If the value doesn't relate to the next property index then 
 			// move to the next property index.
 			while (p < index->availablePropertyCount && // first check validity 
@@ -98,12 +159,206 @@ static void addProfileValuesMethod(
 				value->propertyIndex == propertyIndexes[p].propertyIndex) {
 				valueIndex = base + propertyIndexes[p].availableProperty;
 				index->valueIndexes[valueIndex] = i;
+				if (index->valueEnds != NULL) {
+					index->valueEnds[valueIndex] = i + 1;
+					lastCell = valueIndex;
+					lastProperty = value->propertyIndex;
+				}
 				p++;
-				index->filled++;
+				set++;
 			}
 			COLLECTION_RELEASE(values, &valueItem);
 		}
 	}
+	return set;
+}
+
+// Populates the row of a lazy index for the profile if no other thread has
+// already claimed it.
+static void fillRow(
+	IndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* first,
+	uint32_t valueCount,
+	Exception* exception) {
+	IndicesLazy* lazy = index->lazy;
+	volatile long* state = 
+		&lazy->rowStates[getProfileIdIndex(index, profileId)];
+	if (rowClaim(state)) {
+		MemoryTag tag = MemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_INDICES);
+		uint32_t set = setProfileRow(
+			index,
+			(map*)lazy->propertyIndexes,
+			lazy->values,
+			profileId,
+			first,
+			valueCount,
+			exception);
+		MemoryAccountingSetTag(tag);
+		if (EXCEPTION_OKAY) {
+			FILLED_ADD(index, set);
+		}
+		rowRelease(
+			state, 
+			EXCEPTION_OKAY ?
+			FIFTYONE_DEGREES_INDICES_ROW_FILLED :
+			FIFTYONE_DEGREES_INDICES_ROW_EMPTY);
+	}
+}
+
+// Scans the values of the profile for the first value of the available
+// property, and if end is not NULL the position after the last value. Used
+// when the row is being populated by another thread.
+static uint32_t scanProfileValues(
+	IndicesPropertyProfile* index,
+	const uint32_t* first,
+	uint32_t valueCount,
+	uint32_t availablePropertyIndex,
+	uint32_t* end,
+	Exception* exception) {
+	uint32_t result = UINT32_MAX;
+	bool done = false;
+	int16_t propertyIndex = -1;
+	Item valueItem;
+	Value* value;
+	map* propertyIndexes = (map*)index->lazy->propertyIndexes;
+	CollectionKey valueKey = {
+		0,
+		CollectionKeyType_Value,
+	};
+	DataReset(&valueItem.data);
+	for (uint32_t p = 0; p < index->availablePropertyCount; p++) {
+		if (propertyIndexes[p].availableProperty == availablePropertyIndex) {
+			propertyIndex = propertyIndexes[p].propertyIndex;
+			break;
+		}
+	}
+	for (uint32_t i = 0; i < valueCount && done == false && EXCEPTION_OKAY; i++) {
+		valueKey.indexOrOffset.offset = first[i];
+		value = index->lazy->values->get(
+			index->lazy->values,
+			&valueKey,
+			&valueItem,
+			exception);
+		if (value != NULL && EXCEPTION_OKAY) {
+			if (value->propertyIndex == propertyIndex) {
+				if (result == UINT32_MAX) {
+					result = i;
+				}
+				if (end != NULL) {
+					*end = i + 1;
+				}
+				else {
+					done = true;
+				}
+			}
+			else if (value->propertyIndex > propertyIndex) {
+				// Values are in ascending order of property.
+				done = true;
+			}
+			COLLECTION_RELEASE(index->lazy->values, &valueItem);
+		}
+	}
+	return result;
+}
+
+// Returns the entry for a row of a lazy index that is not yet populated,
+// populating the row if no other thread is doing so.
+static uint32_t lookupLazy(
+	IndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* first,
+	uint32_t valueCount,
+	uint32_t availablePropertyIndex,
+	uint32_t* end) {
+	uint32_t result = UINT32_MAX;
+	Profile* profile = NULL;
+	Item profileItem;
+	uint32_t row = getProfileIdIndex(index, profileId);
+	EXCEPTION_CREATE
+	DataReset(&profileItem.data);
+
+	// Get the profile values if the caller has not provided them.
+	if (first == NULL) {
+		profile = ProfileGetByProfileId(
+			index->lazy->profileOffsets,
+			index->lazy->profiles,
+			profileId,
+			&profileItem,
+			exception);
+		if (profile == NULL || EXCEPTION_FAILED) {
+			return result;
+		}
+		first = (const uint32_t*)(profile + 1);
+		valueCount = profile->valueCount;
+	}
+
+	fillRow(index, profileId, first, valueCount, exception);
+	if (ROW_STATE_GET(index->lazy->rowStates[row]) == 
+		FIFTYONE_DEGREES_INDICES_ROW_FILLED) {
+		result = index->valueIndexes[
+			row * index->availablePropertyCount + availablePropertyIndex];
+		if (end != NULL) {
+			*end = index->valueEnds[
+				row * index->availablePropertyCount + availablePropertyIndex];
+		}
+	}
+	else {
+		result = scanProfileValues(
+			index,
+			first,
+			valueCount,
+			availablePropertyIndex,
+			end,
+			exception);
+	}
+
+	if (profile != NULL) {
+		COLLECTION_RELEASE(index->lazy->profiles, &profileItem);
+	}
+	return result;
+}
+
+#endif
+
+// Adds the values for the profile to the index. Lazy indexes only populate
+// rows which have not already been claimed.
+static void addProfileValuesMethod(
+	IndicesPropertyProfile* index, // index in use or null if not available
+	map* propertyIndexes, // property indexes in ascending order
+	fiftyoneDegreesCollection* values, // collection of values
+	Profile* profile, 
+	Exception* exception) {
+#ifdef FIFTYONE_DEGREES_REDUCED_FILE
+	// A reduced size data file does not contain profile ids, so this method
+	// cannot be implemented.
+#ifdef _MSC_VER
+	UNREFERENCED_PARAMETER(index);
+	UNREFERENCED_PARAMETER(propertyIndexes);
+	UNREFERENCED_PARAMETER(values);
+	UNREFERENCED_PARAMETER(profile);
+#endif
+	EXCEPTION_SET(NOT_IMPLEMENTED);
+#else
+	if (index->lazy != NULL) {
+		fillRow(
+			index,
+			profile->profileId,
+			(uint32_t*)(profile + 1),
+			profile->valueCount,
+			exception);
+	}
+	else {
+		index->filled += setProfileRow(
+			index,
+			propertyIndexes,
+			values,
+			profile->profileId,
+			(uint32_t*)(profile + 1),
+			profile->valueCount,
+			exception);
+	}
 #endif
 }
 
@@ -129,7 +384,8 @@ static void iterateProfiles(
 		CollectionKeyType_Profile,
 	};
 	for (uint32_t i = 0; 
-		i < index->profileCount && EXCEPTION_OKAY;
+		i < index->profileCount && EXCEPTION_OKAY &&
+		(index->lazy == NULL || index->lazy->stop == 0);
 		i++) {
 		profileOffsetKey.indexOrOffset.offset = i;
 		profileOffset = profileOffsets->get(
@@ -216,19 +472,13 @@ static map* createPropertyIndexes(
 	return index;
 }
 
-fiftyoneDegreesIndicesPropertyProfile*
-fiftyoneDegreesIndicesPropertyProfileCreate(
-	fiftyoneDegreesCollection* profiles,
+// Allocates the index and the value indexes array for the profiles and
+// available properties without populating any of the rows.
+static IndicesPropertyProfile* createIndex(
 	fiftyoneDegreesCollection* profileOffsets,
 	fiftyoneDegreesPropertiesAvailable* available,
-	fiftyoneDegreesCollection* values,
-	fiftyoneDegreesException* exception) {
-
-	// Create the ordered list of property indexes.
-	map* propertyIndexes = createPropertyIndexes(available, exception);
-	if (propertyIndexes == NULL) {
-		return NULL;
-	}
+	bool ranges,
+	Exception* exception) {
 
 	// Allocate memory for the index and set the fields.
 	IndicesPropertyProfile* index = (IndicesPropertyProfile*)Malloc(
@@ -238,11 +488,12 @@ fiftyoneDegreesIndicesPropertyProfileCreate(
 		return NULL;
 	}
 	index->filled = 0;
+	index->mapped = NULL;
+	index->lazy = NULL;
 	index->profileCount = CollectionGetCount(profileOffsets);
 	index->minProfileId = getProfileId(profileOffsets, 0, exception);
 	if (!EXCEPTION_OKAY) {
 		Free(index);
-		Free(propertyIndexes);
 		return NULL;
 	}
 	index->maxProfileId = getProfileId(
@@ -251,18 +502,68 @@ fiftyoneDegreesIndicesPropertyProfileCreate(
 		exception);
 	if (!EXCEPTION_OKAY) {
 		Free(index);
-		Free(propertyIndexes);
 		return NULL;
 	}
 	index->availablePropertyCount = available->count;
 	index->size = (index->maxProfileId - index->minProfileId + 1) * 
 		available->count;
 	
-	// Allocate memory for the values index and set the fields.
+	// Allocate memory for the values index and set the fields. Entries are
+	// initialised to an invalid value index so that profiles without a value
+	// for a property are deterministic and can be persisted to a sidecar.
 	index->valueIndexes =(uint32_t*)Malloc(sizeof(uint32_t) * index->size);
 	if (index->valueIndexes == NULL) {
 		EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_INSUFFICIENT_MEMORY);
 		Free(index);
+		return NULL;
+	}
+	memset(index->valueIndexes, 0xff, sizeof(uint32_t) * index->size);
+
+	// Allocate memory for the end of each range if required.
+	index->valueEnds = NULL;
+	if (ranges) {
+		index->valueEnds = (uint32_t*)Malloc(sizeof(uint32_t) * index->size);
+		if (index->valueEnds == NULL) {
+			EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_INSUFFICIENT_MEMORY);
+			Free(index->valueIndexes);
+			Free(index);
+			return NULL;
+		}
+		memset(index->valueEnds, 0xff, sizeof(uint32_t) * index->size);
+	}
+	return index;
+}
+
+// Frees the arrays of the index which are not memory mapped.
+static void freeValueArrays(IndicesPropertyProfile* index) {
+	Free(index->valueIndexes);
+	if (index->valueEnds != NULL) {
+		Free(index->valueEnds);
+	}
+}
+
+// Creates an index populating all the rows.
+static IndicesPropertyProfile* createEager(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	bool ranges,
+	Exception* exception) {
+
+	// Create the ordered list of property indexes.
+	map* propertyIndexes = createPropertyIndexes(available, exception);
+	if (propertyIndexes == NULL) {
+		return NULL;
+	}
+
+	// Allocate memory for the index.
+	IndicesPropertyProfile* index = createIndex(
+		profileOffsets,
+		available,
+		ranges,
+		exception);
+	if (index == NULL) {
 		Free(propertyIndexes);
 		return NULL;
 	}
@@ -283,15 +584,233 @@ fiftyoneDegreesIndicesPropertyProfileCreate(
 		return index;
 	}
 	else {
-		Free(index->valueIndexes);
+		freeValueArrays(index);
+		Free(index);
+		return NULL;
+	}
+}
+
+// Creates an index where the rows are populated on demand.
+static IndicesPropertyProfile* createLazy(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	bool ranges,
+	Exception* exception) {
+#ifdef FIFTYONE_DEGREES_REDUCED_FILE
+	// A reduced size data file does not contain profile ids, so this method
+	// cannot be implemented.
+#ifdef _MSC_VER
+	UNREFERENCED_PARAMETER(profiles);
+	UNREFERENCED_PARAMETER(profileOffsets);
+	UNREFERENCED_PARAMETER(available);
+	UNREFERENCED_PARAMETER(values);
+	UNREFERENCED_PARAMETER(ranges);
+#endif
+	EXCEPTION_SET(NOT_IMPLEMENTED);
+	return NULL;
+#else
+	IndicesLazy* lazy = (IndicesLazy*)Malloc(sizeof(IndicesLazy));
+	if (lazy == NULL) {
+		EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_INSUFFICIENT_MEMORY);
+		return NULL;
+	}
+	lazy->profiles = profiles;
+	lazy->profileOffsets = profileOffsets;
+	lazy->values = values;
+	lazy->stop = 0;
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	lazy->completerStarted = false;
+#endif
+
+	// Create the ordered list of property indexes which is retained to
+	// populate rows on demand.
+	lazy->propertyIndexes = createPropertyIndexes(available, exception);
+	if (lazy->propertyIndexes == NULL) {
+		Free(lazy);
+		return NULL;
+	}
+
+	// Allocate memory for the index.
+	IndicesPropertyProfile* index = createIndex(
+		profileOffsets,
+		available,
+		ranges,
+		exception);
+	if (index == NULL) {
+		Free(lazy->propertyIndexes);
+		Free(lazy);
+		return NULL;
+	}
+
+	// Allocate the row states with all rows empty.
+	uint32_t rows = index->maxProfileId - index->minProfileId + 1;
+	lazy->rowStates = (volatile long*)Malloc(sizeof(long) * rows);
+	if (lazy->rowStates == NULL) {
+		EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_INSUFFICIENT_MEMORY);
+		freeValueArrays(index);
 		Free(index);
+		Free(lazy->propertyIndexes);
+		Free(lazy);
 		return NULL;
 	}
+	memset((void*)lazy->rowStates, 0, sizeof(long) * rows);
+	index->lazy = lazy;
+	return index;
+#endif
+}
+
+fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileCreate(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	fiftyoneDegreesException* exception) {
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_INDICES);
+	IndicesPropertyProfile* index = createEager(
+		profiles,
+		profileOffsets,
+		available,
+		values,
+		false,
+		exception);
+	MemoryAccountingSetTag(tag);
+	return index;
+}
+
+fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileCreateLazy(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	fiftyoneDegreesException* exception) {
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_INDICES);
+	IndicesPropertyProfile* index = createLazy(
+		profiles,
+		profileOffsets,
+		available,
+		values,
+		false,
+		exception);
+	MemoryAccountingSetTag(tag);
+	return index;
+}
+
+fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileCreateWithRanges(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	bool lazy,
+	fiftyoneDegreesException* exception) {
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_INDICES);
+	IndicesPropertyProfile* index;
+	if (lazy) {
+		index = createLazy(
+			profiles,
+			profileOffsets,
+			available,
+			values,
+			true,
+			exception);
+	}
+	else {
+		index = createEager(
+			profiles,
+			profileOffsets,
+			available,
+			values,
+			true,
+			exception);
+	}
+	MemoryAccountingSetTag(tag);
+	return index;
+}
+
+void fiftyoneDegreesIndicesPropertyProfileComplete(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	fiftyoneDegreesException* exception) {
+	if (index->lazy != NULL) {
+		iterateProfiles(
+			index->lazy->profiles,
+			index->lazy->profileOffsets,
+			index,
+			(map*)index->lazy->propertyIndexes,
+			index->lazy->values,
+			exception);
+	}
+}
+
+// Populates the remaining rows of the lazy index until complete or asked to 
+// stop.
+static void runComplete(void* state) {
+	EXCEPTION_CREATE
+	IndicesPropertyProfileComplete((IndicesPropertyProfile*)state, exception);
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_THREAD_EXIT;
+#endif
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesIndicesPropertyProfileCompleteStart(
+	fiftyoneDegreesIndicesPropertyProfile* index) {
+	if (index->lazy == NULL) {
+		return SUCCESS;
+	}
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	if (index->lazy->completerStarted) {
+		return SUCCESS;
+	}
+#ifdef _MSC_VER
+	FIFTYONE_DEGREES_THREAD_CREATE(
+		index->lazy->completer,
+		(FIFTYONE_DEGREES_THREAD_ROUTINE)&runComplete,
+		index);
+	if (index->lazy->completer == NULL) {
+		return INSUFFICIENT_MEMORY;
+	}
+#else
+	if (FIFTYONE_DEGREES_THREAD_CREATE(
+		index->lazy->completer,
+		(FIFTYONE_DEGREES_THREAD_ROUTINE)&runComplete,
+		index) != 0) {
+		return INSUFFICIENT_MEMORY;
+	}
+#endif
+	index->lazy->completerStarted = true;
+#else
+	runComplete(index);
+#endif
+	return SUCCESS;
 }
 
 void fiftyoneDegreesIndicesPropertyProfileFree(
 	fiftyoneDegreesIndicesPropertyProfile* index) {
-	Free(index->valueIndexes);
+	if (index->lazy != NULL) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+		if (index->lazy->completerStarted) {
+			index->lazy->stop = 1;
+			FIFTYONE_DEGREES_THREAD_JOIN(index->lazy->completer);
+			FIFTYONE_DEGREES_THREAD_CLOSE(index->lazy->completer);
+		}
+#endif
+		Free((void*)index->lazy->rowStates);
+		Free(index->lazy->propertyIndexes);
+		Free(index->lazy);
+	}
+	if (index->mapped != NULL) {
+		FileMapClose(index->mapped);
+		Free(index->mapped);
+	}
+	else {
+		freeValueArrays(index);
+	}
 	Free(index);
 }
 
@@ -299,9 +818,604 @@ uint32_t fiftyoneDegreesIndicesPropertyProfileLookup(
 	fiftyoneDegreesIndicesPropertyProfile* index,
 	uint32_t profileId,
 	uint32_t availablePropertyIndex) {
+	return IndicesPropertyProfileLookupForValues(
+		index,
+		profileId,
+		NULL,
+		0,
+		availablePropertyIndex);
+}
+
+// Returns the first value index for the profile and property, and if end is
+// not NULL the position after the last value.
+static uint32_t lookup(
+	IndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* profileValueIndexes,
+	uint32_t profileValueCount,
+	uint32_t availablePropertyIndex,
+	uint32_t* end) {
 	uint32_t valueIndex = 
 		(getProfileIdIndex(index, profileId) * index->availablePropertyCount) + 
 		availablePropertyIndex;
 	assert(valueIndex < index->size);
+#ifdef FIFTYONE_DEGREES_REDUCED_FILE
+#ifdef _MSC_VER
+	UNREFERENCED_PARAMETER(profileValueIndexes);
+	UNREFERENCED_PARAMETER(profileValueCount);
+#endif
+#else
+	if (index->lazy != NULL &&
+		ROW_STATE_GET(index->lazy->rowStates[
+			getProfileIdIndex(index, profileId)]) != 
+			FIFTYONE_DEGREES_INDICES_ROW_FILLED) {
+		return lookupLazy(
+			index,
+			profileId,
+			profileValueIndexes,
+			profileValueCount,
+			availablePropertyIndex,
+			end);
+	}
+#endif
+	if (end != NULL) {
+		*end = index->valueEnds[valueIndex];
+	}
 	return index->valueIndexes[valueIndex];
 }
+
+uint32_t fiftyoneDegreesIndicesPropertyProfileLookupForValues(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* profileValueIndexes,
+	uint32_t profileValueCount,
+	uint32_t availablePropertyIndex) {
+	return lookup(
+		index,
+		profileId,
+		profileValueIndexes,
+		profileValueCount,
+		availablePropertyIndex,
+		NULL);
+}
+
+uint32_t fiftyoneDegreesIndicesPropertyProfileLookupRange(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* profileValueIndexes,
+	uint32_t profileValueCount,
+	uint32_t availablePropertyIndex,
+	uint32_t* end) {
+	uint32_t start;
+	assert(index->valueEnds != NULL);
+	*end = UINT32_MAX;
+	start = lookup(
+		index,
+		profileId,
+		profileValueIndexes,
+		profileValueCount,
+		availablePropertyIndex,
+		end);
+	if (start == UINT32_MAX) {
+		*end = UINT32_MAX;
+	}
+	return start;
+}
+
+// Number of bytes hashed from the start and end of the data when forming the
+// sidecar key.
+#define SIDECAR_SAMPLE_BYTES (64 * 1024)
+
+// Marker used to detect sidecars written on a platform with a different byte
+// order.
+#define SIDECAR_BYTE_ORDER 0x01020304
+
+// Magic bytes at the start of every sidecar file.
+static const char sidecarMagic[8] = { '5', '1', 'D', 'I', 'D', 'X', 0, 0 };
+
+// Fixed size header at the start of the sidecar file. All fields are
+// naturally aligned so the structure has no padding and the payload which
+// follows is aligned for uint32_t access.
+typedef struct sidecar_header_t {
+	char magic[8]; // sidecarMagic
+	uint32_t version; // FIFTYONE_DEGREES_INDICES_SIDECAR_VERSION
+	uint32_t byteOrder; // SIDECAR_BYTE_ORDER
+	IndicesSidecarKey key; // identity of the data and properties
+	uint64_t checksum; // hash of the payload
+	uint64_t payloadLength; // bytes following the header
+	uint32_t availablePropertyCount; // entries in the property table
+	uint32_t minProfileId; // from the index
+	uint32_t maxProfileId; // from the index
+	uint32_t profileCount; // from the index
+	uint32_t size; // entries in the value indexes array
+	uint32_t filled; // from the index
+	uint32_t headerCount; // number of header records, or zero
+	uint32_t expectUpperPrefixedHeaders; // from the headers
+	uint32_t hasValueEnds; // one if the value ends follow the value indexes
+	uint32_t reserved; // zero, keeps the header a multiple of eight bytes
+} sidecarHeader;
+
+// Fixed part of each header record. Followed by the name padded to a four
+// byte boundary, then the pseudo and segment header indexes.
+typedef struct sidecar_header_record_t {
+	uint32_t index;
+	uint32_t headerId;
+	uint32_t isDataSet;
+	uint32_t nameLength;
+	uint32_t pseudoCount;
+	uint32_t segmentCount;
+} sidecarHeaderRecord;
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+#define PAD4(l) (((l) + 3) & ~(size_t)3)
+
+static uint64_t hashBytes(uint64_t hash, const byte* data, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		hash = (hash ^ data[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+// Hashes 32 bit words rather than bytes as the payload can be large.
+static uint64_t hashWords(const uint32_t* data, size_t count) {
+	uint64_t hash = FNV_OFFSET;
+	for (size_t i = 0; i < count; i++) {
+		hash = (hash ^ data[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+static uint64_t hashProperties(PropertiesAvailable* available) {
+	uint64_t hash = FNV_OFFSET;
+	for (uint32_t i = 0; i < available->count; i++) {
+		uint32_t propertyIndex = available->items[i].propertyIndex;
+		hash = hashBytes(
+			hash, 
+			(const byte*)&propertyIndex, 
+			sizeof(propertyIndex));
+	}
+	return hashBytes(hash, (const byte*)&available->count, sizeof(uint32_t));
+}
+
+void fiftyoneDegreesIndicesSidecarKeyFromMemory(
+	const byte* data,
+	size_t length,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesIndicesSidecarKey* key) {
+	size_t sample = length < SIDECAR_SAMPLE_BYTES ? 
+		length : SIDECAR_SAMPLE_BYTES;
+	key->dataLength = (uint64_t)length;
+	key->dataHash = hashBytes(FNV_OFFSET, data, sample);
+	key->dataHash = hashBytes(key->dataHash, data + length - sample, sample);
+	key->propertiesHash = hashProperties(available);
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesIndicesSidecarKeyFromFile(
+	const char* dataFileName,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesIndicesSidecarKey* key) {
+	FILE* file;
+	byte* buffer;
+	size_t sample, read;
+	StatusCode status = FileOpen(dataFileName, &file);
+	if (status != SUCCESS) {
+		return status;
+	}
+	if (FileSeek(file, 0, SEEK_END) != 0) {
+		fclose(file);
+		return FILE_FAILURE;
+	}
+	FileOffset length = FileTell(file);
+	if (length < 0) {
+		fclose(file);
+		return FILE_FAILURE;
+	}
+	sample = (size_t)length < SIDECAR_SAMPLE_BYTES ? 
+		(size_t)length : SIDECAR_SAMPLE_BYTES;
+	buffer = (byte*)Malloc(sample * 2 + 1);
+	if (buffer == NULL) {
+		fclose(file);
+		return INSUFFICIENT_MEMORY;
+	}
+	read = 0;
+	if (FileSeek(file, 0, SEEK_SET) == 0) {
+		read += fread(buffer, 1, sample, file);
+	}
+	if (FileSeek(file, length - (FileOffset)sample, SEEK_SET) == 0) {
+		read += fread(buffer + sample, 1, sample, file);
+	}
+	fclose(file);
+	if (read != sample * 2) {
+		Free(buffer);
+		return FILE_FAILURE;
+	}
+	key->dataLength = (uint64_t)length;
+	key->dataHash = hashBytes(FNV_OFFSET, buffer, sample * 2);
+	key->propertiesHash = hashProperties(available);
+	Free(buffer);
+	return SUCCESS;
+}
+
+// Returns the number of bytes needed to store the headers.
+static size_t getHeadersLength(Headers* headers) {
+	size_t length = 0;
+	if (headers != NULL) {
+		for (uint32_t i = 0; i < headers->count; i++) {
+			Header* header = &headers->items[i];
+			length += sizeof(sidecarHeaderRecord) +
+				PAD4(header->nameLength) +
+				sizeof(uint32_t) * header->pseudoHeaders->count +
+				sizeof(uint32_t) * header->segmentHeaders->count;
+		}
+	}
+	return length;
+}
+
+static byte* writeHeaderPtrs(byte* current, HeaderPtrs* ptrs) {
+	for (uint32_t i = 0; i < ptrs->count; i++) {
+		*(uint32_t*)current = ptrs->items[i]->index;
+		current += sizeof(uint32_t);
+	}
+	return current;
+}
+
+static byte* writeHeaders(byte* current, Headers* headers) {
+	for (uint32_t i = 0; i < headers->count; i++) {
+		Header* header = &headers->items[i];
+		sidecarHeaderRecord* record = (sidecarHeaderRecord*)current;
+		record->index = header->index;
+		record->headerId = header->headerId;
+		record->isDataSet = header->isDataSet ? 1 : 0;
+		record->nameLength = (uint32_t)header->nameLength;
+		record->pseudoCount = header->pseudoHeaders->count;
+		record->segmentCount = header->segmentHeaders->count;
+		current += sizeof(sidecarHeaderRecord);
+		memset(current, 0, PAD4(header->nameLength));
+		memcpy(current, header->name, header->nameLength);
+		current += PAD4(header->nameLength);
+		current = writeHeaderPtrs(current, header->pseudoHeaders);
+		current = writeHeaderPtrs(current, header->segmentHeaders);
+	}
+	return current;
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesIndicesPropertyProfileSave(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesHeaders* headers,
+	fiftyoneDegreesIndicesSidecarKey* key,
+	const char* fileName) {
+	StatusCode status;
+	byte *buffer, *current;
+	char* tempFileName;
+	size_t fileNameLength = strlen(fileName);
+	size_t payloadLength =
+		sizeof(uint32_t) * available->count +
+		sizeof(uint32_t) * index->size +
+		(index->valueEnds != NULL ? sizeof(uint32_t) * index->size : 0) +
+		getHeadersLength(headers);
+	size_t length = sizeof(sidecarHeader) + payloadLength;
+
+	if (available->count != index->availablePropertyCount) {
+		return INVALID_INPUT;
+	}
+
+	// Lazy indexes must be fully populated before they can be saved.
+	if (index->lazy != NULL) {
+		EXCEPTION_CREATE
+		IndicesPropertyProfileComplete(index, exception);
+		if (EXCEPTION_FAILED) {
+			return CORRUPT_DATA;
+		}
+		for (uint32_t i = 0; 
+			i <= index->maxProfileId - index->minProfileId; 
+			i++) {
+			if (index->lazy->rowStates[i] != 
+				FIFTYONE_DEGREES_INDICES_ROW_FILLED) {
+				return INVALID_INPUT;
+			}
+		}
+	}
+
+	// Build the complete image in memory.
+	buffer = (byte*)Malloc(length);
+	if (buffer == NULL) {
+		return INSUFFICIENT_MEMORY;
+	}
+	sidecarHeader* header = (sidecarHeader*)buffer;
+	memset(header, 0, sizeof(sidecarHeader));
+	memcpy(header->magic, sidecarMagic, sizeof(sidecarMagic));
+	header->version = FIFTYONE_DEGREES_INDICES_SIDECAR_VERSION;
+	header->byteOrder = SIDECAR_BYTE_ORDER;
+	header->key = *key;
+	header->payloadLength = payloadLength;
+	header->availablePropertyCount = index->availablePropertyCount;
+	header->minProfileId = index->minProfileId;
+	header->maxProfileId = index->maxProfileId;
+	header->profileCount = index->profileCount;
+	header->size = index->size;
+	header->filled = index->filled;
+	header->hasValueEnds = index->valueEnds != NULL ? 1 : 0;
+	if (headers != NULL) {
+		header->headerCount = headers->count;
+		header->expectUpperPrefixedHeaders = 
+			headers->expectUpperPrefixedHeaders ? 1 : 0;
+	}
+	current = (byte*)(header + 1);
+	for (uint32_t i = 0; i < available->count; i++) {
+		*(uint32_t*)current = available->items[i].propertyIndex;
+		current += sizeof(uint32_t);
+	}
+	memcpy(current, index->valueIndexes, sizeof(uint32_t) * index->size);
+	current += sizeof(uint32_t) * index->size;
+	if (index->valueEnds != NULL) {
+		memcpy(current, index->valueEnds, sizeof(uint32_t) * index->size);
+		current += sizeof(uint32_t) * index->size;
+	}
+	if (headers != NULL) {
+		current = writeHeaders(current, headers);
+	}
+	assert(current == buffer + length);
+	header->checksum = hashWords(
+		(uint32_t*)(header + 1),
+		payloadLength / sizeof(uint32_t));
+
+	// Write to a temporary file and then move it into place.
+	tempFileName = (char*)Malloc(fileNameLength + sizeof(".tmp"));
+	if (tempFileName == NULL) {
+		Free(buffer);
+		return INSUFFICIENT_MEMORY;
+	}
+	memcpy(tempFileName, fileName, fileNameLength);
+	memcpy(tempFileName + fileNameLength, ".tmp", sizeof(".tmp"));
+	status = FileWrite(tempFileName, buffer, length);
+	Free(buffer);
+	if (status == SUCCESS) {
+#ifdef _WIN32
+		remove(fileName);
+#endif
+		if (rename(tempFileName, fileName) != 0) {
+			remove(tempFileName);
+			status = FILE_FAILURE;
+		}
+	}
+	Free(tempFileName);
+	return status;
+}
+
+// Reads count header indexes into the array checking they are in range. The
+// indexes may refer to headers whose records follow, such as the pseudo
+// headers a header is a segment of, so are checked against the capacity.
+static bool readHeaderPtrs(
+	const uint32_t* source,
+	uint32_t count,
+	HeaderPtrs* ptrs,
+	Headers* headers) {
+	for (uint32_t i = 0; i < count; i++) {
+		if (source[i] >= headers->capacity) {
+			return false;
+		}
+		ptrs->items[ptrs->count++] = &headers->items[source[i]];
+	}
+	return true;
+}
+
+// Recreates the headers from the records in the sidecar. Returns NULL if the
+// records are not consistent.
+static Headers* readHeaders(
+	const byte* current,
+	const byte* last,
+	sidecarHeader* sidecar,
+	Exception* exception) {
+	Headers* headers;
+	FIFTYONE_DEGREES_ARRAY_CREATE(
+		fiftyoneDegreesHeader,
+		headers,
+		sidecar->headerCount);
+	if (headers == NULL) {
+		EXCEPTION_SET(INSUFFICIENT_MEMORY);
+		return NULL;
+	}
+	for (uint32_t i = 0; i < headers->capacity; i++) {
+		Header* h = &headers->items[i];
+		h->index = i;
+		h->headerId = 0;
+		h->isDataSet = false;
+		h->nameLength = 0;
+		h->name = NULL;
+		h->pseudoHeaders = NULL;
+		h->segmentHeaders = NULL;
+	}
+	headers->expectUpperPrefixedHeaders = 
+		sidecar->expectUpperPrefixedHeaders != 0;
+	for (uint32_t i = 0; i < sidecar->headerCount; i++) {
+		const sidecarHeaderRecord* record = (sidecarHeaderRecord*)current;
+		Header* header = &headers->items[i];
+		headers->count++;
+		if (current + sizeof(sidecarHeaderRecord) > last ||
+			record->index != i ||
+			(size_t)(last - current - sizeof(sidecarHeaderRecord)) <
+			PAD4(record->nameLength) + sizeof(uint32_t) *
+			((size_t)record->pseudoCount + record->segmentCount)) {
+			HeadersFree(headers);
+			return NULL;
+		}
+		current += sizeof(sidecarHeaderRecord);
+		char* name = (char*)Malloc(record->nameLength + 1);
+		FIFTYONE_DEGREES_ARRAY_CREATE(
+			fiftyoneDegreesHeaderPtr,
+			header->pseudoHeaders,
+			record->pseudoCount);
+		FIFTYONE_DEGREES_ARRAY_CREATE(
+			fiftyoneDegreesHeaderPtr,
+			header->segmentHeaders,
+			record->segmentCount);
+		header->name = name;
+		if (name == NULL ||
+			header->pseudoHeaders == NULL ||
+			header->segmentHeaders == NULL) {
+			EXCEPTION_SET(INSUFFICIENT_MEMORY);
+			HeadersFree(headers);
+			return NULL;
+		}
+		memcpy(name, current, record->nameLength);
+		name[record->nameLength] = '\0';
+		header->nameLength = record->nameLength;
+		header->headerId = record->headerId;
+		header->isDataSet = record->isDataSet != 0;
+		current += PAD4(record->nameLength);
+		if (readHeaderPtrs(
+				(const uint32_t*)current,
+				record->pseudoCount,
+				header->pseudoHeaders,
+				headers) == false) {
+			HeadersFree(headers);
+			return NULL;
+		}
+		current += sizeof(uint32_t) * record->pseudoCount;
+		if (readHeaderPtrs(
+				(const uint32_t*)current,
+				record->segmentCount,
+				header->segmentHeaders,
+				headers) == false) {
+			HeadersFree(headers);
+			return NULL;
+		}
+		current += sizeof(uint32_t) * record->segmentCount;
+	}
+	if (current != last) {
+		HeadersFree(headers);
+		return NULL;
+	}
+	return headers;
+}
+
+// Returns true if the sidecar header and payload are valid for the key and 
+// available properties.
+static bool isSidecarValid(
+	FileMapped* mapped,
+	IndicesSidecarKey* key,
+	PropertiesAvailable* available) {
+	sidecarHeader* header = (sidecarHeader*)mapped->startByte;
+	if (mapped->length < sizeof(sidecarHeader) ||
+		memcmp(header->magic, sidecarMagic, sizeof(sidecarMagic)) != 0 ||
+		header->version != FIFTYONE_DEGREES_INDICES_SIDECAR_VERSION ||
+		header->byteOrder != SIDECAR_BYTE_ORDER ||
+		header->key.dataLength != key->dataLength ||
+		header->key.dataHash != key->dataHash ||
+		header->key.propertiesHash != key->propertiesHash ||
+		header->payloadLength != mapped->length - sizeof(sidecarHeader) ||
+		header->payloadLength % sizeof(uint32_t) != 0 ||
+		header->availablePropertyCount != available->count ||
+		header->maxProfileId < header->minProfileId ||
+		header->hasValueEnds > 1 ||
+		(uint64_t)header->size != 
+			((uint64_t)header->maxProfileId - header->minProfileId + 1) * 
+			header->availablePropertyCount ||
+		header->payloadLength < sizeof(uint32_t) *
+			((uint64_t)header->availablePropertyCount + 
+			(uint64_t)header->size * (1 + header->hasValueEnds))) {
+		return false;
+	}
+	const uint32_t* propertyIndexes = (const uint32_t*)(header + 1);
+	for (uint32_t i = 0; i < available->count; i++) {
+		if (propertyIndexes[i] != available->items[i].propertyIndex) {
+			return false;
+		}
+	}
+	return header->checksum == hashWords(
+		propertyIndexes,
+		(size_t)(header->payloadLength / sizeof(uint32_t)));
+}
+
+static IndicesPropertyProfile* loadSidecar(
+	const char* fileName,
+	IndicesSidecarKey* key,
+	PropertiesAvailable* available,
+	Headers** headers,
+	Exception* exception) {
+	FileMapped* mapped = (FileMapped*)Malloc(sizeof(FileMapped));
+	if (mapped == NULL) {
+		EXCEPTION_SET(INSUFFICIENT_MEMORY);
+		return NULL;
+	}
+	if (FileMapOpen(fileName, mapped) != SUCCESS) {
+		Free(mapped);
+		return NULL;
+	}
+	if (isSidecarValid(mapped, key, available) == false) {
+		FileMapClose(mapped);
+		Free(mapped);
+		return NULL;
+	}
+	sidecarHeader* header = (sidecarHeader*)mapped->startByte;
+	uint32_t* valueIndexes = 
+		(uint32_t*)(header + 1) + header->availablePropertyCount;
+	uint32_t* valueEnds = header->hasValueEnds ? 
+		valueIndexes + header->size : NULL;
+
+	// Restore the headers if requested and present.
+	if (headers != NULL) {
+		*headers = NULL;
+		if (header->headerCount > 0) {
+			MemoryTag tag = MemoryAccountingSetTag(
+				FIFTYONE_DEGREES_MEMORY_TAG_HEADERS);
+			*headers = readHeaders(
+				(const byte*)(valueIndexes + 
+					header->size * (1 + header->hasValueEnds)),
+				mapped->startByte + mapped->length,
+				header,
+				exception);
+			MemoryAccountingSetTag(tag);
+			if (*headers == NULL) {
+				FileMapClose(mapped);
+				Free(mapped);
+				return NULL;
+			}
+		}
+	}
+
+	IndicesPropertyProfile* index = (IndicesPropertyProfile*)Malloc(
+		sizeof(IndicesPropertyProfile));
+	if (index == NULL) {
+		EXCEPTION_SET(INSUFFICIENT_MEMORY);
+		if (headers != NULL) {
+			HeadersFree(*headers);
+			*headers = NULL;
+		}
+		FileMapClose(mapped);
+		Free(mapped);
+		return NULL;
+	}
+	index->valueIndexes = valueIndexes;
+	index->valueEnds = valueEnds;
+	index->availablePropertyCount = header->availablePropertyCount;
+	index->minProfileId = header->minProfileId;
+	index->maxProfileId = header->maxProfileId;
+	index->profileCount = header->profileCount;
+	index->size = header->size;
+	index->filled = header->filled;
+	index->mapped = mapped;
+	index->lazy = NULL;
+	return index;
+}
+
+fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileLoad(
+	const char* fileName,
+	fiftyoneDegreesIndicesSidecarKey* key,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesHeaders** headers,
+	fiftyoneDegreesException* exception) {
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_INDICES);
+	IndicesPropertyProfile* index = loadSidecar(
+		fileName,
+		key,
+		available,
+		headers,
+		exception);
+	MemoryAccountingSetTag(tag);
+	return index;
+}
@@ -81,6 +81,41 @@
   * the values associated with the profile for the profile id and the required
   * property index.
   * 
+  * ## Lazy
+  * 
+  * fiftyoneDegreesIndicesPropertyProfileCreateLazy returns an index where the
+  * row for each profile is populated the first time the profile is looked up.
+  * Each row has a state which is claimed using a compare and swap so that
+  * exactly one thread populates a row. Other threads looking up a row that is
+  * being populated scan the profile values directly rather than waiting.
+  * fiftyoneDegreesIndicesPropertyProfileCompleteStart can be used to populate
+  * the remaining rows using a background thread once start up has completed.
+  * The collections provided to create a lazy index must remain valid until the
+  * index is freed.
+  * 
+  * ## Ranges
+  * 
+  * fiftyoneDegreesIndicesPropertyProfileCreateWithRanges also records the
+  * position after the last value for each profile and property so that
+  * fiftyoneDegreesIndicesPropertyProfileLookupRange returns the complete
+  * slice of values for the property without searching the values of the 
+  * profile. This doubles the memory used by the index.
+  * 
+  * ## Sidecar
+  * 
+  * Building the index iterates every profile and value in the data set which
+  * is repeated on every start up and reload even when the data file has not
+  * changed. fiftyoneDegreesIndicesPropertyProfileSave writes a built index,
+  * along with the required property indexes and optionally the headers
+  * derived from the data set, to a versioned and checksummed sidecar file.
+  * The file is keyed by a #fiftyoneDegreesIndicesSidecarKey which identifies
+  * the data file and the set of required properties.
+  * 
+  * fiftyoneDegreesIndicesPropertyProfileLoad memory maps the sidecar and
+  * returns an index which references the mapped value indexes directly. If
+  * the sidecar is missing, stale, or corrupt NULL is returned and the caller
+  * should fall back to fiftyoneDegreesIndicesPropertyProfileCreate.
+  * 
   * @{
   */
 
@@ -98,8 +133,52 @@
 #include "collection.h"
 #include "property.h"
 #include "properties.h"
+#include "headers.h"
+#include "file.h"
+#include "threading.h"
 #include "common.h"
 
+/**
+ * Current version of the sidecar file format. Files with any other version
+ * are ignored by fiftyoneDegreesIndicesPropertyProfileLoad.
+ */
+#define FIFTYONE_DEGREES_INDICES_SIDECAR_VERSION 2
+
+/**
+ * Extension appended to the data file name to form the default sidecar file
+ * name.
+ */
+#define FIFTYONE_DEGREES_INDICES_SIDECAR_EXTENSION ".indices"
+
+/**
+ * State of a row in a lazily populated index. Row states are changed with
+ * #FIFTYONE_DEGREES_INTERLOCK_EXCHANGE.
+ */
+typedef enum e_fiftyone_degrees_indices_row_state {
+	FIFTYONE_DEGREES_INDICES_ROW_EMPTY = 0, /**< Row not yet populated */
+	FIFTYONE_DEGREES_INDICES_ROW_FILLING = 1, /**< Row being populated by a 
+											  thread */
+	FIFTYONE_DEGREES_INDICES_ROW_FILLED = 2 /**< Row populated and can be 
+											read */
+} fiftyoneDegreesIndicesRowState;
+
+/**
+ * Data needed to populate the rows of a lazy index on demand.
+ */
+typedef struct fiftyone_degrees_indices_lazy_t {
+	fiftyoneDegreesCollection* profiles; /**< Profiles being indexed */
+	fiftyoneDegreesCollection* profileOffsets; /**< Offsets to the profiles */
+	fiftyoneDegreesCollection* values; /**< Values being indexed */
+	void* propertyIndexes; /**< Property indexes in ascending order */
+	volatile long* rowStates; /**< #fiftyoneDegreesIndicesRowState for each
+							  profile id row */
+	volatile long stop; /**< Set to request the completion thread stops */
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_THREAD completer; /**< Background completion thread */
+	bool completerStarted; /**< True if completer must be joined */
+#endif
+} fiftyoneDegreesIndicesLazy;
+
 /**
  * Maps the profile index and the property index to the first value index of 
  * the profile for the property. Is an array of uint32_t with entries equal to 
@@ -108,14 +187,30 @@
  */
 typedef struct fiftyone_degrees_index_property_profile{
 	uint32_t* valueIndexes; // array of value indexes
+	uint32_t* valueEnds; // array of end positions or NULL if no ranges
 	uint32_t availablePropertyCount; // number of available properties
 	uint32_t minProfileId; // minimum profile id
 	uint32_t maxProfileId; // maximum profile id
 	uint32_t profileCount; // total number of profiles
 	uint32_t size; // number elements in the valueIndexes array
 	uint32_t filled; // number of elements with values
+	fiftyoneDegreesFileMapped* mapped; // sidecar mapping or NULL if created
+	fiftyoneDegreesIndicesLazy* lazy; // lazy state or NULL if fully populated
 } fiftyoneDegreesIndicesPropertyProfile;
 
+/**
+ * Identity of the data and required properties a sidecar file was created
+ * for. A sidecar is only loaded if the key stored in the file matches the key
+ * provided by the caller exactly.
+ */
+typedef struct fiftyone_degrees_indices_sidecar_key_t {
+	uint64_t dataLength; /**< Length of the data file in bytes */
+	uint64_t dataHash; /**< Hash of the leading and trailing bytes of the data
+					   file */
+	uint64_t propertiesHash; /**< Hash of the required property indexes in
+							 available property order */
+} fiftyoneDegreesIndicesSidecarKey;
+
 /**
  * Create an index for the profiles, available properties, and values provided 
  * such that given the index to a property and profile the index of the first 
@@ -136,6 +231,73 @@ fiftyoneDegreesIndicesPropertyProfileCreate(
 	fiftyoneDegreesCollection* values,
 	fiftyoneDegreesException* exception);
 
+/**
+ * Create an index for the profiles, available properties, and values provided
+ * where the rows for each profile are populated when first looked up rather
+ * than during creation. The collections must remain valid until the index is
+ * freed with fiftyoneDegreesIndicesPropertyProfileFree.
+ * @param profiles collection of variable sized profiles to be indexed
+ * @param profileOffsets collection of fixed offsets to profiles to be indexed
+ * @param available properties provided by the caller
+ * @param values collection to be indexed
+ * @param exception pointer to an exception data structure to be used if an
+ * exception occurs. See exceptions.h
+ * @return pointer to the index memory structure
+ */
+EXTERNAL fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileCreateLazy(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	fiftyoneDegreesException* exception);
+
+/**
+ * Create an index as fiftyoneDegreesIndicesPropertyProfileCreate, or 
+ * fiftyoneDegreesIndicesPropertyProfileCreateLazy if lazy is true, which also
+ * records the position after the last value for each profile and property.
+ * Ranges are returned by fiftyoneDegreesIndicesPropertyProfileLookupRange.
+ * @param profiles collection of variable sized profiles to be indexed
+ * @param profileOffsets collection of fixed offsets to profiles to be indexed
+ * @param available properties provided by the caller
+ * @param values collection to be indexed
+ * @param lazy true if the rows should be populated when first looked up
+ * @param exception pointer to an exception data structure to be used if an
+ * exception occurs. See exceptions.h
+ * @return pointer to the index memory structure
+ */
+EXTERNAL fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileCreateWithRanges(
+	fiftyoneDegreesCollection* profiles,
+	fiftyoneDegreesCollection* profileOffsets,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesCollection* values,
+	bool lazy,
+	fiftyoneDegreesException* exception);
+
+/**
+ * Populates all the rows of a lazy index that have not yet been populated on
+ * the calling thread. Has no effect if the index is already fully populated.
+ * @param index to complete
+ * @param exception pointer to an exception data structure to be used if an
+ * exception occurs. See exceptions.h
+ */
+EXTERNAL void fiftyoneDegreesIndicesPropertyProfileComplete(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	fiftyoneDegreesException* exception);
+
+/**
+ * Starts a background thread to populate the rows of a lazy index that have
+ * not yet been populated. The thread is stopped when the index is freed. If
+ * the library is compiled without threading the rows are populated on the
+ * calling thread.
+ * @param index to complete
+ * @return the result of starting the thread
+ */
+EXTERNAL fiftyoneDegreesStatusCode 
+fiftyoneDegreesIndicesPropertyProfileCompleteStart(
+	fiftyoneDegreesIndicesPropertyProfile* index);
+
 /**
  * Frees an index previously created by 
  * fiftyoneDegreesIndicesPropertyProfileCreate.
@@ -163,6 +325,117 @@ EXTERNAL uint32_t fiftyoneDegreesIndicesPropertyProfileLookup(
 	uint32_t profileId,
 	uint32_t availablePropertyIndex);
 
+/**
+ * As fiftyoneDegreesIndicesPropertyProfileLookup but used when the caller
+ * already holds the value indexes of the profile. A lazy index uses these to
+ * populate the row without retrieving the profile again.
+ * @param index from fiftyoneDegreesIndicesPropertyProfileCreate to use
+ * @param profileId the values need to relate to
+ * @param profileValueIndexes value indexes that follow the profile
+ * @param profileValueCount number of entries in profileValueIndexes
+ * @param availablePropertyIndex in the list of required properties
+ * @return the index in the list of values for the profile for the first value 
+ * associated with the property
+ */
+EXTERNAL uint32_t fiftyoneDegreesIndicesPropertyProfileLookupForValues(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* profileValueIndexes,
+	uint32_t profileValueCount,
+	uint32_t availablePropertyIndex);
+
+/**
+ * Returns the range of values for the profile and property as the position of
+ * the first value and the position after the last value. Only valid for 
+ * indexes created with fiftyoneDegreesIndicesPropertyProfileCreateWithRanges.
+ * @param index from fiftyoneDegreesIndicesPropertyProfileCreateWithRanges
+ * @param profileId the values need to relate to
+ * @param profileValueIndexes value indexes that follow the profile, or NULL
+ * @param profileValueCount number of entries in profileValueIndexes
+ * @param availablePropertyIndex in the list of required properties
+ * @param end set to the position after the last value for the property
+ * @return the position of the first value for the property, or UINT32_MAX if
+ * the profile has no values for the property
+ */
+EXTERNAL uint32_t fiftyoneDegreesIndicesPropertyProfileLookupRange(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	uint32_t profileId,
+	const uint32_t* profileValueIndexes,
+	uint32_t profileValueCount,
+	uint32_t availablePropertyIndex,
+	uint32_t* end);
+
+/**
+ * Sets the key for the data held in memory and the available properties. Only
+ * the leading and trailing bytes of the data are hashed along with the length
+ * so the key can be formed quickly for large data sets.
+ * @param data pointer to the first byte of the data set
+ * @param length of the data in bytes
+ * @param available properties provided by the caller
+ * @param key to be set
+ */
+EXTERNAL void fiftyoneDegreesIndicesSidecarKeyFromMemory(
+	const byte* data,
+	size_t length,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesIndicesSidecarKey* key);
+
+/**
+ * Sets the key for the data file and the available properties. Equivalent to
+ * fiftyoneDegreesIndicesSidecarKeyFromMemory with the data file contents.
+ * @param dataFileName path to the data file the index relates to
+ * @param available properties provided by the caller
+ * @param key to be set
+ * @return the result of reading the data file
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesIndicesSidecarKeyFromFile(
+	const char* dataFileName,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesIndicesSidecarKey* key);
+
+/**
+ * Writes the index, the available property indexes, and optionally the
+ * headers to the sidecar file provided. The file is written to a temporary
+ * name and then renamed so that readers never observe a partial file. Lazy
+ * indexes are completed before they are saved.
+ * @param index to be saved
+ * @param available properties the index was created for
+ * @param headers derived from the data set, or NULL if not to be saved
+ * @param key identifying the data and properties
+ * @param fileName path of the sidecar file to write
+ * @return the result of the save operation
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesIndicesPropertyProfileSave(
+	fiftyoneDegreesIndicesPropertyProfile* index,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesHeaders* headers,
+	fiftyoneDegreesIndicesSidecarKey* key,
+	const char* fileName);
+
+/**
+ * Loads an index previously written by
+ * fiftyoneDegreesIndicesPropertyProfileSave. The sidecar is memory mapped and
+ * the value indexes of the returned index refer to the mapped memory. The
+ * index must be freed with fiftyoneDegreesIndicesPropertyProfileFree.
+ * @param fileName path of the sidecar file to load
+ * @param key identifying the data and properties that must match the file
+ * @param available properties the index is required for
+ * @param headers if not NULL set to headers restored from the sidecar, or
+ * NULL if the sidecar does not contain headers. Must be freed with
+ * fiftyoneDegreesHeadersFree.
+ * @param exception pointer to an exception data structure to be used if an
+ * exception occurs. See exceptions.h
+ * @return pointer to the index, or NULL if the sidecar is missing, stale, or
+ * corrupt
+ */
+EXTERNAL fiftyoneDegreesIndicesPropertyProfile*
+fiftyoneDegreesIndicesPropertyProfileLoad(
+	const char* fileName,
+	fiftyoneDegreesIndicesSidecarKey* key,
+	fiftyoneDegreesPropertiesAvailable* available,
+	fiftyoneDegreesHeaders** headers,
+	fiftyoneDegreesException* exception);
+
 /**
  * @}
  */
@@ -23,311 +23,277 @@
 #include "ip.h"
 #include "fiftyone.h"
 
-typedef void(*parseIterator)(
-	void *state,
-	IpType segmentType,
-	const char *start,
-	const char *end);
+/**
+ * Classes of characters which can appear in, or terminate, an IP address.
+ */
+typedef enum {
+	IP_CHAR_INVALID = 0, /**< Not valid anywhere in an IP address */
+	IP_CHAR_DIGIT, /**< Decimal digit 0-9 */
+	IP_CHAR_LETTER, /**< Hexadecimal letter a-f or A-F */
+	IP_CHAR_DOT, /**< IPv4 segment separator */
+	IP_CHAR_COLON, /**< IPv6 segment separator, or IPv4 port separator */
+	IP_CHAR_BREAK, /**< Ends the address */
+} IpCharClass;
+
+#define I IP_CHAR_INVALID
+#define D IP_CHAR_DIGIT
+#define L IP_CHAR_LETTER
+#define B IP_CHAR_BREAK
 
 /**
- * State is an integer which is increased every time the method is called.
+ * Class of every character, so the parser needs a single lookup rather than
+ * a chain of comparisons for each character. Characters above 127 are
+ * invalid and are zero initialised.
  */
-static void callbackIpAddressCount(
-	void * const state,
-	const IpType segmentType,
-	const char * const start,
-	const char * const end) {
-	if (start <= end) {
-		if (segmentType != IP_TYPE_INVALID) {
-			(*(int*)state)++;
-			if (segmentType == IP_TYPE_IPV6) {
-				(*(int*)state)++;
-			}
-		}
-	}
-}
+static const byte ipCharClasses[256] = {
+	B, I, I, I, I, I, I, I, I, I, B, I, I, I, I, I, /* \0 and \n */
+	I, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+	B, I, I, I, I, I, I, I, I, I, I, I, B, I, IP_CHAR_DOT, B, /* ' ' , . / */
+	D, D, D, D, D, D, D, D, D, D, IP_CHAR_COLON, I, I, I, I, I,
+	I, L, L, L, L, L, L, I, I, I, I, I, I, I, I, I, /* A-F */
+	I, I, I, I, I, I, I, I, I, I, I, I, I, B, I, I, /* ] */
+	I, L, L, L, L, L, L, I, I, I, I, I, I, I, I, I, /* a-f */
+	I, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+};
+
+#undef I
+#undef D
+#undef L
+#undef B
 
-/*
- * Make sure each byte in the Ipv4 or Ipv6 address
- * stays within the bound 0,255
- * @parsedValue The value parsed from string
- * @return the adjusted value
- * if the value is out of the range then return
- * the closest boundary value (0 or 255)
+/**
+ * Parses a single IP address in one pass over the characters. The bytes of
+ * each segment are accumulated as the characters are read and written to a
+ * local buffer. When the address ends the position of any "::" abbreviation
+ * is known, so the bytes after it are moved to the end of the address and
+ * the gap filled with zeros.
+ *
+ * Segments ending with '.' are IPv4 bytes, including those embedded at the
+ * end of an IPv6 address. IPv4 values are clamped to 255. The first
+ * separator determines the type of the address.
+ *
+ * @param start of the string containing the IP address
+ * @param postEnd the character after the last one to be considered. Parsing
+ * behaves as though a null terminator were present here
+ * @param address to write the parsed address to
+ * @param stop set to the character which ended parsing, or postEnd
+ * @return true if the address was parsed correctly, otherwise false
  */
-static byte getIpByte(int parsedValue) {
-	if (parsedValue < 0) {
-		parsedValue = 0;
-	}
-	else if (parsedValue > UINT8_MAX) {
-		parsedValue = UINT8_MAX;
+static bool parseIpAddress(
+	const char *start,
+	const char * const postEnd,
+	IpAddress * const address,
+	const char ** const stop) {
+	byte bytes[IPV6_LENGTH];
+	int count = 0, springs = 0, abbreviation = -1, fill, length;
+	uint32_t hex = 0, decimal = 0;
+	bool bracket = false, letters = false, lettersBeforeType = false,
+		emptyIpv4 = false;
+	IpType type = IP_TYPE_INVALID, segmentType = IP_TYPE_INVALID;
+	IpCharClass charClass;
+	const char *current = start, *segment;
+	char c;
+
+	if (current < postEnd && *current == '[') {
+		bracket = true;
+		start = ++current;
 	}
-	return (byte)parsedValue;
-}
 
-typedef struct {
-	IpAddress * const address;
-	byte *current;
-	int bytesPresent;
-	int abbreviationsFilled;
-} fiftyoneDegreeIpAddressBuildState;
-typedef fiftyoneDegreeIpAddressBuildState IpAddressBuildState;
+	for (segment = current;; current++) {
+		c = current < postEnd ? *current : '\0';
+		charClass = (IpCharClass)ipCharClasses[(byte)c];
 
-static void parseIpV6Segment(
-	IpAddressBuildState * const buildState,
-	const char * const start,
-	const char * const end) {
-	int i;
-	char first[3], second[3], val; // "FF" + '\0'
-	if (start > end) {
-		// This is an abbreviation, so fill it in.
-		if (buildState->abbreviationsFilled) {
-			return;
+		// Accumulate both the hexadecimal value and the leading decimal
+		// digits of the segment. Which is used depends on the separator.
+		if (charClass == IP_CHAR_DIGIT) {
+			hex = (hex << 4) | (uint32_t)(c & 0x0F);
+			decimal = letters ? decimal : decimal * 10 + (uint32_t)(c & 0x0F);
+			continue;
 		}
-		buildState->abbreviationsFilled++;
-		for (i = 0; i < IPV6_LENGTH - buildState->bytesPresent; i++) {
-			*buildState->current = (byte)0;
-			buildState->current++;
+		if (charClass == IP_CHAR_LETTER) {
+			if (type == IP_TYPE_IPV4) {
+				*stop = current;
+				return false;
+			}
+			lettersBeforeType |= type == IP_TYPE_INVALID;
+			letters = true;
+			hex = (hex << 4) | (uint32_t)((c & 0x0F) + 9);
+			continue;
 		}
-	}
-	else {
-		// Add the two bytes of the segment.
-		first[2] = '\0';
-		second[2] = '\0';
-		for (i = 0; i < IPV4_LENGTH; i++) {
-			if (end - i >= start) val = end[-i];
-			else val = '0';
-
-			if (i < 2) second[1 - i] = val;
-			else first[3 - i] = val;
+		if (charClass == IP_CHAR_INVALID) {
+			*stop = current;
+			return false;
 		}
-		*buildState->current = getIpByte((int)strtol(first, NULL, 16));
-		buildState->current++;
-		*buildState->current = getIpByte((int)strtol(second, NULL, 16));
-		buildState->current++;
-	}
-}
-
-static void callbackIpAddressBuild(
-	void * const state,
-	const IpType segmentType,
-	const char * const start,
-	const char * const end) {
-	fiftyoneDegreeIpAddressBuildState *const buildState = state;
-	if (segmentType == IP_TYPE_IPV4) {
-		*buildState->current = getIpByte(atoi(start));
-		buildState->current++;
-	}
-	else if (segmentType == IP_TYPE_IPV6) {
-		parseIpV6Segment(buildState, start, end);
-	}
-}
-
-static IpType getIpTypeFromSeparator(const char separator) {
-	switch (separator) {
-		case '.':
-			return IP_TYPE_IPV4;
-		case ':':
-			return IP_TYPE_IPV6;
-		default:
-			return IP_TYPE_INVALID;
-	}
-}
-
-static IpType getSegmentTypeWithSeparator(
-	const char separator,
-	const IpType ipType,
-	const IpType lastSeparatorType) {
-	switch (ipType) {
-		case IP_TYPE_IPV4:
-			return IP_TYPE_IPV4;
-		case IP_TYPE_IPV6:
-			switch (separator) {
-				case ':':
-					return IP_TYPE_IPV6;
-				case '.':
-					return IP_TYPE_IPV4;
-				default:
-					return lastSeparatorType;
-			}
-		default:
-			return getIpTypeFromSeparator(separator);
-	}
-}
-
-typedef enum {
-	FIFTYONE_DEGREES_IP_NON_BREAK_CHAR = 0,
-	FIFTYONE_DEGREES_IP_SEGMENT_BREAK_CHAR,
-	FIFTYONE_DEGREES_IP_ADDRESS_BREAK_CHAR,
-	FIFTYONE_DEGREES_IP_INVALID_CHAR,
-} IpStringSeparatorType;
-
-#define IP_NON_BREAK_CHAR FIFTYONE_DEGREES_IP_NON_BREAK_CHAR
-#define IP_SEGMENT_BREAK_CHAR FIFTYONE_DEGREES_IP_SEGMENT_BREAK_CHAR
-#define IP_ADDRESS_BREAK_CHAR FIFTYONE_DEGREES_IP_ADDRESS_BREAK_CHAR
-#define IP_INVALID_CHAR FIFTYONE_DEGREES_IP_INVALID_CHAR
-
-static IpStringSeparatorType getSeparatorCharType(
-	const char ipChar,
-	const IpType ipType) {
-
-	switch (ipChar) {
-		case ':':
-			return ((ipType == IP_TYPE_IPV4)
-				? IP_ADDRESS_BREAK_CHAR : IP_SEGMENT_BREAK_CHAR);
-		case '.':
-			return IP_SEGMENT_BREAK_CHAR;
-		case ',':
-		case ' ':
-		case ']':
-		case '/':
-		case '\0':
-		case '\n':
-			return IP_ADDRESS_BREAK_CHAR;
-		default:
-			break;
-	}
-	if ('0' <= ipChar && ipChar <= '9') {
-		return IP_NON_BREAK_CHAR;
-	}
-	if (('a' <= ipChar && ipChar <= 'f') || ('A' <= ipChar && ipChar <= 'F')) {
-		return (ipType == IP_TYPE_IPV4
-			? IP_INVALID_CHAR : IP_NON_BREAK_CHAR);
-	}
-	return IP_INVALID_CHAR;
-}
-
-static int8_t getMaxSegmentLengthForIpType(const IpType ipType) {
-	return (ipType == IP_TYPE_IPV4) ? 3 : 4; // "255" or "FFFF"
-}
-
-/**
- * Calls the callback method every time a byte is identified in the value
- * when parsed left to right.
- */
-static IpType iterateIpAddress(
-	const char *start,
-	const char * const end,
-	void * const state,
-	int * const springCount,
-	IpType type,
-	const parseIterator foundSegment) {
-
-	const char * const postEnd = end + 1;
 
-	*springCount = 0;
-	if (*start == '[') {
+		// The character ends the segment. A colon ends an IPv4 address
+		// as it precedes a port number.
+		if (charClass == IP_CHAR_COLON && type == IP_TYPE_IPV4) {
+			charClass = IP_CHAR_BREAK;
+		}
 		if (type == IP_TYPE_IPV4) {
-			return IP_TYPE_INVALID;
+			segmentType = IP_TYPE_IPV4;
 		}
-		start++;
-	}
-
-	IpType currentSegmentType =
-		IP_TYPE_INVALID;
-
-	const char *current = start;
-	const char *nextSegment = current;
-	for (; current <= postEnd && nextSegment <= postEnd; ++current) {
-		char nextChar = 0;
-		if (current < postEnd) {
-			nextChar = *current;
+		else if (charClass == IP_CHAR_DOT) {
+			segmentType = IP_TYPE_IPV4;
 		}
-		IpStringSeparatorType separatorType =
-			getSeparatorCharType(nextChar, type);
-		if (!separatorType) {
-			continue;
+		else if (charClass == IP_CHAR_COLON) {
+			segmentType = IP_TYPE_IPV6;
 		}
-		if (separatorType == IP_INVALID_CHAR) {
-			return IP_TYPE_INVALID;
+		else if (type == IP_TYPE_INVALID) {
+			segmentType = IP_TYPE_INVALID;
 		}
-
-		currentSegmentType = getSegmentTypeWithSeparator(
-			nextChar, type, currentSegmentType);
 		if (type == IP_TYPE_INVALID) {
-			type = currentSegmentType;
+			type = segmentType;
 		}
 
-		if (current - nextSegment > getMaxSegmentLengthForIpType(type)) {
-			return IP_TYPE_INVALID;
+		length = (int)(current - segment);
+		if (length > (type == IP_TYPE_IPV4 ? 3 : 4)) { // "255" or "FFFF"
+			*stop = current;
+			return false;
 		}
-
-		// Check if it is leading abbreviation
-		if (current - 1 >= start) {
-			foundSegment(state, currentSegmentType,
-				nextSegment, current - 1);
+		if (current > start) {
+			if (length > 0) {
+				if (segmentType == IP_TYPE_IPV4) {
+					if (count < IPV6_LENGTH) {
+						bytes[count] = (byte)(decimal > UINT8_MAX ?
+							UINT8_MAX : decimal);
+					}
+					count++;
+				}
+				else if (segmentType == IP_TYPE_IPV6) {
+					if (count < IPV6_LENGTH - 1) {
+						bytes[count] = (byte)(hex >> 8);
+						bytes[count + 1] = (byte)hex;
+					}
+					count += 2;
+				}
+			}
+			else if (segmentType == IP_TYPE_IPV6) {
+				// Only the first abbreviation is filled. Any more are
+				// rejected by the spring count below.
+				if (abbreviation < 0) {
+					abbreviation = count;
+				}
+			}
+			else if (type == IP_TYPE_IPV6) {
+				// An empty IPv4 segment within an IPv6 address is a zero
+				// byte, and counts as the abbreviation. It can't end the
+				// address.
+				if (charClass == IP_CHAR_BREAK) {
+					*stop = current;
+					return false;
+				}
+				if (count < IPV6_LENGTH) {
+					bytes[count] = 0;
+				}
+				count++;
+				emptyIpv4 = true;
+			}
 		}
-		if (separatorType == IP_ADDRESS_BREAK_CHAR) {
-			return type;
+		if (charClass == IP_CHAR_BREAK) {
+			break;
 		}
-		if (current == nextSegment && current != start) {
-			++*springCount;
+		if (length == 0 && current != start) {
+			springs++;
 		}
-		nextSegment = current + 1;
+		segment = current + 1;
+		hex = 0;
+		decimal = 0;
+		letters = false;
 	}
-	if (nextSegment < current
-		&& type != IP_TYPE_INVALID) {
+	*stop = current;
 
-		foundSegment(state, currentSegmentType,
-			nextSegment, current - 1);
+	switch (type) {
+	case IP_TYPE_IPV4:
+		// Letters are only valid before the first separator if it turns out
+		// to be an IPv6 address. IPv4 addresses can't be in brackets.
+		if (count != IPV4_LENGTH ||
+			springs ||
+			bracket ||
+			lettersBeforeType) {
+			return false;
+		}
+		memcpy(address->value, bytes, IPV4_LENGTH);
+		break;
+	case IP_TYPE_IPV6:
+		// Without an abbreviation to fill all 16 bytes must be present.
+		if (count > IPV6_LENGTH ||
+			springs > 1 ||
+			(count < IPV6_LENGTH && !springs) ||
+			(abbreviation < 0 && count != IPV6_LENGTH) ||
+			(abbreviation >= 0 && emptyIpv4)) {
+			return false;
+		}
+		if (abbreviation < 0) {
+			memcpy(address->value, bytes, IPV6_LENGTH);
+		}
+		else {
+			fill = IPV6_LENGTH - count;
+			memcpy(address->value, bytes, (size_t)abbreviation);
+			memset(address->value + abbreviation, 0, (size_t)fill);
+			memcpy(
+				address->value + abbreviation + fill,
+				bytes + abbreviation,
+				(size_t)(count - abbreviation));
+		}
+		break;
+	default:
+		return false;
 	}
-	return type;
+	address->type = (byte)type;
+	return true;
 }
 
 bool fiftyoneDegreesIpAddressParse(
 	const char * const start,
 	const char * const end,
 	IpAddress * const address) {
-
+	const char *stop;
 	if (!start) {
 		return false;
 	}
+	return parseIpAddress(start, end + 1, address, &stop);
+}
 
-	int byteCount = 0;
-	int springCount = 0;
-	IpType type = iterateIpAddress(
-		start,
-		end,
-		&byteCount,
-		&springCount,
-		IP_TYPE_INVALID,
-		callbackIpAddressCount);
+uint32_t fiftyoneDegreesIpAddressesParse(
+	const char * const start,
+	const char * const end,
+	IpAddress * const addresses,
+	const uint32_t capacity) {
+	uint32_t count = 0;
+	const char *current = start, *stop;
+	const char * const postEnd = end + 1;
+	if (!start) {
+		return 0;
+	}
+	while (count < capacity) {
+		while (current < postEnd && (*current == ' ' || *current == '\t')) {
+			current++;
+		}
+		if (current >= postEnd || *current == '\0') {
+			break;
+		}
+		if (*current != ',') {
+			if (parseIpAddress(current, postEnd, &addresses[count], &stop) ==
+				false) {
+				memset(&addresses[count], 0, sizeof(IpAddress));
+				addresses[count].type = IP_TYPE_INVALID;
+			}
+			count++;
 
-	switch (type) {
-		case IP_TYPE_IPV4:
-			if (byteCount != IPV4_LENGTH || springCount) {
-				return false;
+			// Skip anything after the address, such as a port number,
+			// up to the next entry.
+			current = stop;
+			while (current < postEnd && *current != ',' && *current != '\0') {
+				current++;
 			}
-			break;
-		case IP_TYPE_IPV6:
-			if (byteCount > IPV6_LENGTH ||
-				springCount > 1 ||
-				(byteCount < IPV6_LENGTH && !springCount)) {
-				return false;
+			if (current >= postEnd || *current == '\0') {
+				break;
 			}
-			break;
-		default:
-			return false;
+		}
+		current++;
 	}
-
-	address->type = type;
-	IpAddressBuildState buildState = {
-		address,
-		address->value,
-		byteCount,
-		0,
-	};
-
-	// Add the bytes from the source value and get the type of address.
-	iterateIpAddress(
-		start,
-		end,
-		&buildState,
-		&springCount,
-		type,
-		callbackIpAddressBuild);
-
-	return true;
+	return count;
 }
 
 int fiftyoneDegreesIpAddressesCompare(
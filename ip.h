@@ -84,6 +84,26 @@ EXTERNAL bool fiftyoneDegreesIpAddressParse(
 	const char *end,
 	fiftyoneDegreesIpAddress *address);
 
+/**
+ * Parse a comma separated list of IP addresses, such as the value of an
+ * X-Forwarded-For header, in a single pass. Whitespace around each entry is
+ * ignored, as is anything between the end of an address and the next comma
+ * such as a port number. Entries which are not valid addresses are still
+ * written, with the type set to #FIFTYONE_DEGREES_IP_TYPE_INVALID, so the
+ * position of each address in the list is preserved. Empty entries are
+ * skipped.
+ * @param start of the string containing the IP addresses to parse
+ * @param end the last character of the string to be considered for parsing
+ * @param addresses array to write the parsed IP addresses into
+ * @param capacity the number of addresses the array can hold
+ * @return the number of addresses written, at most capacity
+ */
+EXTERNAL uint32_t fiftyoneDegreesIpAddressesParse(
+	const char *start,
+	const char *end,
+	fiftyoneDegreesIpAddress *addresses,
+	uint32_t capacity);
+
 /**
  * Compare two IP addresses in its binary form
  * @param ipAddress1 the first IP address
@@ -29,34 +29,117 @@ static void addTwo(fiftyoneDegreesJson* s, char a, char b) {
 	StringBuilderAddChar(&s->builder, b);
 }
 
-// Adds a string of characters escaping special characters.
+// Word of bytes all set to the value b.
+#define REPEAT_BYTE(b) ((uint64_t)0x0101010101010101ULL * (uint8_t)(b))
+
+// True if the character can be added to a JSON string without escaping.
+#define IS_CLEAN(c) ( \
+	(uint8_t)(c) >= 0x20 && \
+	(c) != '\"' && \
+	(c) != '\\')
+
+/**
+ * Returns a non zero value if any of the 8 bytes in the word might need to be
+ * escaped. Bytes below 0x20 are found by subtracting 0x20 from every byte and
+ * checking for a borrow from bytes that did not already have the high bit
+ * set. Quotes and backslashes are found in the same way as zero bytes after
+ * an exclusive or. Borrows can only flag bytes after a byte which does need
+ * escaping, so a zero result always means the whole word is clean.
+ * @param word 8 bytes to check
+ * @return zero if none of the bytes need to be escaped
+ */
+static uint64_t mightNeedEscape(const uint64_t word) {
+	const uint64_t quote = word ^ REPEAT_BYTE('\"');
+	const uint64_t slash = word ^ REPEAT_BYTE('\\');
+	return (
+		((word - REPEAT_BYTE(0x20)) & ~word) |
+		((quote - REPEAT_BYTE(0x01)) & ~quote) |
+		((slash - REPEAT_BYTE(0x01)) & ~slash)) &
+		REPEAT_BYTE(0x80);
+}
+
+/**
+ * Returns the number of characters at the start of the value which can be
+ * added without escaping. Checks 16 bytes per iteration, then 8, then single
+ * bytes once a word that might need escaping is found.
+ * @param value characters to check
+ * @param length number of characters in value
+ * @return number of clean characters at the start of value
+ */
+static size_t cleanLength(const char* value, const size_t length) {
+	uint64_t a, b;
+	size_t i = 0;
+	while (i + sizeof(a) * 2 <= length) {
+		memcpy(&a, value + i, sizeof(a));
+		memcpy(&b, value + i + sizeof(a), sizeof(b));
+		if ((mightNeedEscape(a) | mightNeedEscape(b)) != 0) {
+			break;
+		}
+		i += sizeof(a) * 2;
+	}
+	while (i + sizeof(a) <= length) {
+		memcpy(&a, value + i, sizeof(a));
+		if (mightNeedEscape(a) != 0) {
+			break;
+		}
+		i += sizeof(a);
+	}
+	while (i < length && IS_CLEAN(value[i])) {
+		i++;
+	}
+	return i;
+}
+
+// Adds a single character which needs escaping.
+static void addEscaped(fiftyoneDegreesJson* s, const char value) {
+	static const char hex[] = "0123456789abcdef";
+	char unicode[6] = { '\\', 'u', '0', '0', 0, 0 };
+	switch (value) {
+	case '\"':
+		addTwo(s, '\\', '\"');
+		break;
+	case '\\':
+		addTwo(s, '\\', '\\');
+		break;
+	case '\b':
+		addTwo(s, '\\', 'b');
+		break;
+	case '\f':
+		addTwo(s, '\\', 'f');
+		break;
+	case '\n':
+		addTwo(s, '\\', 'n');
+		break;
+	case '\r':
+		addTwo(s, '\\', 'r');
+		break;
+	case '\t':
+		addTwo(s, '\\', 't');
+		break;
+	default:
+		unicode[4] = hex[((uint8_t)value >> 4) & 0x0F];
+		unicode[5] = hex[(uint8_t)value & 0x0F];
+		StringBuilderAddChars(&s->builder, unicode, sizeof(unicode));
+		break;
+	}
+}
+
+// Adds a string of characters escaping special characters. Runs of
+// characters which do not need escaping are added in one operation.
 static void addStringEscape(
 	fiftyoneDegreesJson* s,
 	const char* value,
 	size_t valueLength) {
-	for (size_t i = 0; i < valueLength; i++) {
-		switch (value[i]) {
-		case '\"':
-			addTwo(s, '\\', '\"');
-			break;
-		case '\b':
-			addTwo(s, '\\', 'b');
-			break;
-		case '\f':
-			addTwo(s, '\\', 'f');
-			break;
-		case '\n':
-			addTwo(s, '\\', 'n');
-			break;
-		case '\r':
-			addTwo(s, '\\', 'r');
-			break;
-		case '\t':
-			addTwo(s, '\\', 't');
-			break;
-		default:
-			StringBuilderAddChar(&s->builder, value[i]);
-			break;
+	size_t i = 0, clean;
+	while (i < valueLength) {
+		clean = cleanLength(value + i, valueLength - i);
+		if (clean > 0) {
+			StringBuilderAddChars(&s->builder, value + i, clean);
+			i += clean;
+		}
+		if (i < valueLength) {
+			addEscaped(s, value[i]);
+			i++;
 		}
 	}
 }
@@ -46,6 +46,11 @@
   * caller to increase the buffer size if not big enough and call the related
   * methods a subsequent time. 
   * 
+  * Alternatively a writer can be set on the builder with
+  * #fiftyoneDegreesStringBuilderInitWriter before calling
+  * #fiftyoneDegreesJsonDocumentStart. The buffer is then passed to the writer
+  * each time it fills so a document of any size is produced in a single pass.
+  * 
   * Reference data for the property being added, the values being added, and
   * a collection of strings is also provided.
   * 
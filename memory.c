@@ -22,6 +22,12 @@
 
 #include "memory.h"
 #include "fiftyone.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#ifdef MAP_ANONYMOUS
+#define HUGE_PAGES_SUPPORTED
+#endif
+#endif
 
 #ifndef FIFTYONE_DEGREES_MEMORY_TRACKER_SHARDS
 #ifndef FIFTYONE_DEGREES_NO_THREADING
@@ -278,6 +284,384 @@ size_t fiftyoneDegreesUnsetMemoryTracking() {
 	return memAlloced;
 }
 
+/**
+ * Size of the header placed before each allocation made by the accounting
+ * allocator. 16 bytes keeps the caller's pointer aligned to the same boundary
+ * as the pointer returned from malloc.
+ */
+#define ACCOUNTING_HEADER_SIZE 16
+
+typedef struct memory_accounting_header_t {
+	size_t size; /* Bytes requested by the caller */
+	uint32_t tag; /* Tag the bytes are attributed to */
+	uint32_t offset; /* Bytes from the start of the allocation to the pointer
+					 returned to the caller */
+} accountingHeader;
+
+typedef struct memory_accounting_counter_t {
+	volatile int64_t live; /* Bytes currently allocated */
+	volatile int64_t peak; /* Maximum value live has reached */
+} accountingCounter;
+
+typedef struct memory_accounting_thread_t {
+	int64_t pending[FIFTYONE_DEGREES_MEMORY_TAG_COUNT]; /* Bytes not yet added
+														to the counters */
+	fiftyoneDegreesMemoryTag tag; /* Tag for allocations made by the thread */
+} accountingThread;
+
+static accountingCounter accounting[FIFTYONE_DEGREES_MEMORY_TAG_COUNT];
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+static FIFTYONE_DEGREES_THREAD_LOCAL accountingThread accountingLocal;
+#else
+static accountingThread accountingLocal;
+#endif
+
+static const char *memoryTagNames[FIFTYONE_DEGREES_MEMORY_TAG_COUNT] = {
+	"other",
+	"collections",
+	"caches",
+	"indices",
+	"headers",
+	"evidence",
+	"overrides",
+	"dataset"
+};
+
+static void accountingFlushTag(int tag) {
+	int64_t delta = accountingLocal.pending[tag];
+	int64_t live, peak;
+	if (delta == 0) {
+		return;
+	}
+	accountingLocal.pending[tag] = 0;
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	live = FIFTYONE_DEGREES_INTERLOCK_ADD_64(&accounting[tag].live, delta);
+	peak = accounting[tag].peak;
+	while (live > peak) {
+		int64_t previous = FIFTYONE_DEGREES_INTERLOCK_EXCHANGE_64(
+			accounting[tag].peak,
+			live,
+			peak);
+		if (previous == peak) {
+			break;
+		}
+		peak = previous;
+	}
+#else
+	live = accounting[tag].live += delta;
+	peak = accounting[tag].peak;
+	if (live > peak) {
+		accounting[tag].peak = live;
+	}
+#endif
+}
+
+static void account(uint32_t tag, int64_t delta) {
+	int64_t pending = (accountingLocal.pending[tag] += delta);
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	if (pending >= FIFTYONE_DEGREES_MEMORY_ACCOUNTING_BATCH ||
+		pending <= -FIFTYONE_DEGREES_MEMORY_ACCOUNTING_BATCH) {
+		accountingFlushTag(tag);
+	}
+#else
+	// There is no contention so always add to the counters.
+	(void)pending;
+	accountingFlushTag(tag);
+#endif
+}
+
+static void* accountingAdd(byte *start, uint32_t offset, size_t size) {
+	accountingHeader *header;
+	if (start == NULL) {
+		return NULL;
+	}
+	header = (accountingHeader*)(start + offset - ACCOUNTING_HEADER_SIZE);
+	header->size = size;
+	header->tag = (uint32_t)accountingLocal.tag;
+	header->offset = offset;
+	account(header->tag, (int64_t)size);
+	return start + offset;
+}
+
+static byte* accountingRemove(void *pointer) {
+	accountingHeader *header = (accountingHeader*)(
+		(byte*)pointer - ACCOUNTING_HEADER_SIZE);
+	account(header->tag, -(int64_t)header->size);
+	return (byte*)pointer - header->offset;
+}
+
+void* fiftyoneDegreesMemoryAccountingMalloc(size_t size) {
+	return accountingAdd(
+		(byte*)MemoryStandardMalloc(ACCOUNTING_HEADER_SIZE + size),
+		ACCOUNTING_HEADER_SIZE,
+		size);
+}
+
+void* fiftyoneDegreesMemoryAccountingMallocAligned(
+	int alignment,
+	size_t size) {
+	// The header is placed immediately before the returned pointer, which
+	// must remain aligned, so the offset is a whole number of alignments.
+	// The total is rounded up to a whole number of alignments as required by
+	// aligned_alloc.
+	uint32_t offset = alignment > ACCOUNTING_HEADER_SIZE ?
+		(uint32_t)alignment : ACCOUNTING_HEADER_SIZE;
+	size_t total = (offset + size + alignment - 1) & ~((size_t)alignment - 1);
+	return accountingAdd(
+		(byte*)MemoryStandardMallocAligned(alignment, total),
+		offset,
+		size);
+}
+
+void fiftyoneDegreesMemoryAccountingFree(void *pointer) {
+	if (pointer != NULL) {
+		MemoryStandardFree(accountingRemove(pointer));
+	}
+}
+
+void fiftyoneDegreesMemoryAccountingFreeAligned(void *pointer) {
+	if (pointer != NULL) {
+		MemoryStandardFreeAligned(accountingRemove(pointer));
+	}
+}
+
+fiftyoneDegreesMemoryTag fiftyoneDegreesMemoryAccountingSetTag(
+	fiftyoneDegreesMemoryTag tag) {
+	fiftyoneDegreesMemoryTag previous = accountingLocal.tag;
+	accountingLocal.tag = tag;
+	return previous;
+}
+
+void fiftyoneDegreesMemoryAccountingFlush() {
+	int i;
+	for (i = 0; i < FIFTYONE_DEGREES_MEMORY_TAG_COUNT; i++) {
+		accountingFlushTag(i);
+	}
+}
+
+void fiftyoneDegreesMemoryAccountingGet(
+	fiftyoneDegreesMemoryTag tag,
+	fiftyoneDegreesMemoryAccountingStats *stats) {
+	int64_t live, peak;
+	accountingFlushTag(tag);
+	live = accounting[tag].live;
+	peak = accounting[tag].peak;
+	// Frees flushed by one thread can reach the counters before the matching
+	// allocations flushed by another, so the live value can be negative.
+	stats->live = live > 0 ? (size_t)live : 0;
+	stats->peak = peak > 0 ? (size_t)peak : 0;
+}
+
+const char* fiftyoneDegreesMemoryTagGetName(fiftyoneDegreesMemoryTag tag) {
+	if ((int)tag < 0 || (int)tag >= FIFTYONE_DEGREES_MEMORY_TAG_COUNT) {
+		return NULL;
+	}
+	return memoryTagNames[tag];
+}
+
+void fiftyoneDegreesMemoryAccountingReset() {
+	int i;
+	for (i = 0; i < FIFTYONE_DEGREES_MEMORY_TAG_COUNT; i++) {
+		accountingLocal.pending[i] = 0;
+		accounting[i].live = 0;
+		accounting[i].peak = 0;
+	}
+}
+
+void fiftyoneDegreesSetUpMemoryAccounting() {
+	fiftyoneDegreesMemoryAccountingReset();
+	fiftyoneDegreesMalloc = fiftyoneDegreesMemoryAccountingMalloc;
+	fiftyoneDegreesMallocAligned = fiftyoneDegreesMemoryAccountingMallocAligned;
+	fiftyoneDegreesFree = fiftyoneDegreesMemoryAccountingFree;
+	fiftyoneDegreesFreeAligned = fiftyoneDegreesMemoryAccountingFreeAligned;
+}
+
+size_t fiftyoneDegreesUnsetMemoryAccounting() {
+	int i;
+	size_t memAlloced = 0;
+	fiftyoneDegreesMemoryAccountingStats stats;
+	for (i = 0; i < FIFTYONE_DEGREES_MEMORY_TAG_COUNT; i++) {
+		fiftyoneDegreesMemoryAccountingGet((fiftyoneDegreesMemoryTag)i, &stats);
+		memAlloced += stats.live;
+	}
+	fiftyoneDegreesMalloc = fiftyoneDegreesMemoryStandardMalloc;
+	fiftyoneDegreesMallocAligned = fiftyoneDegreesMemoryStandardMallocAligned;
+	fiftyoneDegreesFree = fiftyoneDegreesMemoryStandardFree;
+	fiftyoneDegreesFreeAligned = fiftyoneDegreesMemoryStandardFreeAligned;
+	fiftyoneDegreesMemoryAccountingReset();
+	return memAlloced;
+}
+
+/* Size of a huge page which large allocations are aligned to. */
+#define HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+typedef struct memory_large_t memoryLarge;
+
+/* Memory mapped by a large allocation. */
+struct memory_large_t {
+	void *pointer; /* Start of the mapped memory */
+	size_t length; /* Number of bytes mapped */
+	memoryLarge *next; /* Next mapped allocation or NULL */
+};
+
+static fiftyoneDegreesMemoryHugePages hugePages =
+	FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE;
+
+/* Large allocations which were mapped rather than allocated with Malloc. */
+static memoryLarge *largeAllocations = NULL;
+
+/* Spin lock for the large allocations which are rarely changed. */
+static volatile long largeLock = 0;
+
+static void largeLockEnter() {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	while (FIFTYONE_DEGREES_INTERLOCK_EXCHANGE(largeLock, 1, 0) != 0) {}
+#endif
+}
+
+static void largeLockExit() {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_INTERLOCK_EXCHANGE(largeLock, 0, 1);
+#endif
+}
+
+#ifdef HUGE_PAGES_SUPPORTED
+
+/* Maps memory aligned to the huge page size, trimming the unaligned start
+and end, and advises the kernel to back it with transparent huge pages. */
+static void* mapAdvise(size_t length) {
+	byte *mapped, *aligned;
+	size_t head;
+	mapped = (byte*)mmap(
+		NULL,
+		length + HUGE_PAGE_SIZE,
+		PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS,
+		-1,
+		0);
+	if (mapped == MAP_FAILED) {
+		return NULL;
+	}
+	aligned = (byte*)(((uintptr_t)mapped + HUGE_PAGE_SIZE - 1) &
+		~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+	head = aligned - mapped;
+	if (head > 0) {
+		munmap(mapped, head);
+	}
+	munmap(aligned + length, HUGE_PAGE_SIZE - head);
+#ifdef MADV_HUGEPAGE
+	madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+	return aligned;
+}
+
+/* Maps memory from the reserved huge page pool if available. */
+static void* mapReserved(size_t length) {
+#ifdef MAP_HUGETLB
+	void *mapped = mmap(
+		NULL,
+		length,
+		PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+		-1,
+		0);
+	return mapped == MAP_FAILED ? NULL : mapped;
+#else
+	(void)length;
+	return NULL;
+#endif
+}
+
+static void* mapLarge(size_t size, size_t *length) {
+	void *pointer = NULL;
+	*length = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+	if (hugePages == FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_RESERVED) {
+		pointer = mapReserved(*length);
+	}
+	if (pointer == NULL) {
+		pointer = mapAdvise(*length);
+	}
+	return pointer;
+}
+
+static void unmapLarge(void *pointer, size_t length) {
+	munmap(pointer, length);
+}
+
+#else
+
+static void* mapLarge(size_t size, size_t *length) {
+	(void)size;
+	*length = 0;
+	return NULL;
+}
+
+static void unmapLarge(void *pointer, size_t length) {
+	(void)pointer;
+	(void)length;
+}
+
+#endif
+
+void fiftyoneDegreesMemorySetHugePages(
+	fiftyoneDegreesMemoryHugePages newHugePages) {
+	hugePages = newHugePages;
+}
+
+fiftyoneDegreesMemoryHugePages fiftyoneDegreesMemoryGetHugePages() {
+	return hugePages;
+}
+
+void* fiftyoneDegreesMemoryLargeMalloc(size_t size) {
+	memoryLarge *large;
+	void *pointer = NULL;
+	size_t length = 0;
+	if (hugePages != FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE && size > 0) {
+		pointer = mapLarge(size, &length);
+	}
+	if (pointer == NULL) {
+		return Malloc(size);
+	}
+
+	// Record the mapping so that it can be unmapped when freed. The record is
+	// not allocated with Malloc as the mapping is not tracked.
+	large = (memoryLarge*)malloc(sizeof(memoryLarge));
+	if (large == NULL) {
+		unmapLarge(pointer, length);
+		return Malloc(size);
+	}
+	large->pointer = pointer;
+	large->length = length;
+	largeLockEnter();
+	large->next = largeAllocations;
+	largeAllocations = large;
+	largeLockExit();
+	return pointer;
+}
+
+void fiftyoneDegreesMemoryLargeFree(void *pointer) {
+	memoryLarge *large, **previous;
+	largeLockEnter();
+	previous = &largeAllocations;
+	large = largeAllocations;
+	while (large != NULL && large->pointer != pointer) {
+		previous = &large->next;
+		large = large->next;
+	}
+	if (large != NULL) {
+		*previous = large->next;
+	}
+	largeLockExit();
+	if (large != NULL) {
+		unmapLarge(large->pointer, large->length);
+		free(large);
+	}
+	else {
+		Free(pointer);
+	}
+}
+
 #ifdef FIFTYONE_DEGREES_MEMORY_TRACK_ENABLED
 
 /**
@@ -297,6 +681,25 @@ fiftyoneDegreesMemoryTrackingFree;
 void (FIFTYONE_DEGREES_CALL_CONV *fiftyoneDegreesFreeAligned)(void* pointer) =
 fiftyoneDegreesMemoryTrackingFreeAligned;
 
+#elif defined(FIFTYONE_DEGREES_MEMORY_ACCOUNTING_ENABLED)
+
+/**
+ * Enable memory accounting.
+ */
+
+void* (FIFTYONE_DEGREES_CALL_CONV* fiftyoneDegreesMalloc)(size_t size) =
+fiftyoneDegreesMemoryAccountingMalloc;
+
+void* (FIFTYONE_DEGREES_CALL_CONV* fiftyoneDegreesMallocAligned)(
+	int alignment,
+	size_t size) = fiftyoneDegreesMemoryAccountingMallocAligned;
+
+void (FIFTYONE_DEGREES_CALL_CONV *fiftyoneDegreesFree)(void *pointer) =
+fiftyoneDegreesMemoryAccountingFree;
+
+void (FIFTYONE_DEGREES_CALL_CONV *fiftyoneDegreesFreeAligned)(void* pointer) =
+fiftyoneDegreesMemoryAccountingFreeAligned;
+
 #else
 
 /**
@@ -173,6 +173,195 @@ EXTERNAL void fiftyoneDegreesSetUpMemoryTracking();
  */
 EXTERNAL size_t fiftyoneDegreesUnsetMemoryTracking();
 
+/**
+ * Number of bytes a thread can allocate or free against a tag before its
+ * pending total is added to the shared counters. Larger values reduce
+ * contention on the shared counters at the cost of accuracy. Each thread's
+ * contribution to a tag's live and peak values can lag by up to this many
+ * bytes until #fiftyoneDegreesMemoryAccountingFlush is called from it. Bytes
+ * still pending when a thread exits are lost, so threads which allocate or
+ * free memory should call #fiftyoneDegreesMemoryAccountingFlush before they
+ * exit. The threads started by the library do this.
+ */
+#ifndef FIFTYONE_DEGREES_MEMORY_ACCOUNTING_BATCH
+#define FIFTYONE_DEGREES_MEMORY_ACCOUNTING_BATCH 65536
+#endif
+
+/**
+ * Subsystems which memory allocated with the accounting allocator is
+ * attributed to. The tag used for an allocation is the calling thread's
+ * current tag, set with #fiftyoneDegreesMemoryAccountingSetTag. Memory which
+ * is mapped rather than allocated, such as large allocations backed by huge
+ * pages (see #fiftyoneDegreesMemorySetHugePages) and memory mapped index
+ * files, is not included.
+ */
+typedef enum e_fiftyone_degrees_memory_tag {
+	FIFTYONE_DEGREES_MEMORY_TAG_OTHER = 0, /**< Not attributed to a subsystem */
+	FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS, /**< Data set collections */
+	FIFTYONE_DEGREES_MEMORY_TAG_CACHES, /**< Collection and render caches */
+	FIFTYONE_DEGREES_MEMORY_TAG_INDICES, /**< Property and profile indices */
+	FIFTYONE_DEGREES_MEMORY_TAG_HEADERS, /**< Unique HTTP headers */
+	FIFTYONE_DEGREES_MEMORY_TAG_EVIDENCE, /**< Evidence collections */
+	FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES, /**< Override properties and values */
+	FIFTYONE_DEGREES_MEMORY_TAG_DATA_SET, /**< Data files read into memory */
+	FIFTYONE_DEGREES_MEMORY_TAG_COUNT /**< Number of tags */
+} fiftyoneDegreesMemoryTag;
+
+/**
+ * Live and peak bytes allocated against a single tag.
+ */
+typedef struct fiftyone_degrees_memory_accounting_stats_t {
+	size_t live; /**< Bytes currently allocated */
+	size_t peak; /**< Maximum bytes allocated at any one time */
+} fiftyoneDegreesMemoryAccountingStats;
+
+/**
+ * Allocates memory with a small header recording the size and the calling
+ * thread's current tag so that the bytes can be attributed to the tag without
+ * the lookups used by #fiftyoneDegreesMemoryTrackingMalloc.
+ * @param __size number of bytes to allocate
+ * @return pointer to allocated memory or NULL
+ */
+EXTERNAL void* fiftyoneDegreesMemoryAccountingMalloc(size_t __size);
+
+/**
+ * Allocates aligned memory with an accounting header. See
+ * #fiftyoneDegreesMemoryAccountingMalloc.
+ * @param alignment byte boundary to align the allocation to e.g. 16. Must be
+ * a power of 2.
+ * @param __size number of bytes to allocate
+ * @return pointer to allocation memory or NULL
+ */
+EXTERNAL void* fiftyoneDegreesMemoryAccountingMallocAligned(
+	int alignment,
+	size_t __size);
+
+/**
+ * Frees memory allocated using #fiftyoneDegreesMemoryAccountingMalloc,
+ * removing its size from the tag it was allocated against.
+ * @param __ptr data to free
+ */
+EXTERNAL void fiftyoneDegreesMemoryAccountingFree(void *__ptr);
+
+/**
+ * Frees memory allocated using #fiftyoneDegreesMemoryAccountingMallocAligned,
+ * removing its size from the tag it was allocated against.
+ * @param __ptr data to free
+ */
+EXTERNAL void fiftyoneDegreesMemoryAccountingFreeAligned(void *__ptr);
+
+/**
+ * Sets the tag that memory allocated by the calling thread is attributed to.
+ * Callers should restore the returned tag when they are finished so that
+ * nested subsystems are attributed correctly.
+ * @param tag to attribute subsequent allocations to
+ * @return the tag which was set before the call
+ */
+EXTERNAL fiftyoneDegreesMemoryTag fiftyoneDegreesMemoryAccountingSetTag(
+	fiftyoneDegreesMemoryTag tag);
+
+/**
+ * Adds any bytes pending for the calling thread to the shared counters.
+ */
+EXTERNAL void fiftyoneDegreesMemoryAccountingFlush();
+
+/**
+ * Gets the live and peak bytes allocated against the tag. Pending bytes for
+ * the calling thread are flushed first. Bytes pending for other threads are
+ * not included, see #FIFTYONE_DEGREES_MEMORY_ACCOUNTING_BATCH.
+ * @param tag to get the statistics for
+ * @param stats to populate
+ */
+EXTERNAL void fiftyoneDegreesMemoryAccountingGet(
+	fiftyoneDegreesMemoryTag tag,
+	fiftyoneDegreesMemoryAccountingStats *stats);
+
+/**
+ * Gets a readable name for the tag.
+ * @param tag to get the name of
+ * @return name of the tag, or NULL if the tag is not valid
+ */
+EXTERNAL const char* fiftyoneDegreesMemoryTagGetName(
+	fiftyoneDegreesMemoryTag tag);
+
+/**
+ * Resets the live and peak counters for all tags, and the pending bytes of
+ * the calling thread. Should only be called when no memory allocated with the
+ * accounting allocator is live.
+ */
+EXTERNAL void fiftyoneDegreesMemoryAccountingReset();
+
+/**
+ * Setup memory accounting by resetting the counters and setting all
+ * Malloc/Free function pointers to the AccountingMalloc/Free functions. Must
+ * be called before any memory which will be freed with the accounting
+ * functions is allocated.
+ */
+EXTERNAL void fiftyoneDegreesSetUpMemoryAccounting();
+
+/**
+ * Unset memory accounting by setting all Malloc/Free function pointers to the
+ * standard Malloc/Free functions, then resetting the counters. All memory
+ * allocated while accounting was set up must be freed before calling.
+ * @return 0 if all freed, otherwise the live bytes left unfreed across all
+ * tags as seen by the calling thread
+ */
+EXTERNAL size_t fiftyoneDegreesUnsetMemoryAccounting();
+
+/**
+ * Whether large allocations made with #fiftyoneDegreesMemoryLargeMalloc, such
+ * as data sets and collections loaded entirely into memory, should be backed
+ * by huge pages to reduce TLB misses when the memory is accessed randomly.
+ */
+typedef enum e_fiftyone_degrees_memory_huge_pages {
+	FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE = 0, /**< Use #fiftyoneDegreesMalloc
+												 (the default) */
+	FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_ADVISE = 1, /**< Map memory aligned to
+												   the huge page size and
+												   advise the kernel to use
+												   transparent huge pages */
+	FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_RESERVED = 2, /**< Map memory from the
+													 reserved huge page pool
+													 (MAP_HUGETLB), falling
+													 back to ADVISE if none
+													 are available */
+} fiftyoneDegreesMemoryHugePages;
+
+/**
+ * Sets whether large allocations should be backed by huge pages. Huge pages
+ * are only supported on Linux. On other platforms, or if the memory can not
+ * be mapped, large allocations fall back to #fiftyoneDegreesMalloc. Only
+ * affects allocations made after the call.
+ * @param hugePages how large allocations should use huge pages
+ */
+EXTERNAL void fiftyoneDegreesMemorySetHugePages(
+	fiftyoneDegreesMemoryHugePages hugePages);
+
+/**
+ * Gets whether large allocations are backed by huge pages.
+ * @return how large allocations use huge pages
+ */
+EXTERNAL fiftyoneDegreesMemoryHugePages fiftyoneDegreesMemoryGetHugePages();
+
+/**
+ * Allocates a large block of memory which is backed by huge pages if
+ * enabled with #fiftyoneDegreesMemorySetHugePages, otherwise uses
+ * #fiftyoneDegreesMalloc. Memory mapped for huge pages is not included in
+ * memory tracking or accounting. Must be freed with
+ * #fiftyoneDegreesMemoryLargeFree.
+ * @param __size number of bytes to allocate
+ * @return pointer to allocated memory or NULL
+ */
+EXTERNAL void* fiftyoneDegreesMemoryLargeMalloc(size_t __size);
+
+/**
+ * Frees memory allocated with #fiftyoneDegreesMemoryLargeMalloc. Memory
+ * which was not mapped for huge pages is freed with #fiftyoneDegreesFree, so
+ * this can also be used for memory allocated with #fiftyoneDegreesMalloc.
+ * @param __ptr pointer to free
+ */
+EXTERNAL void fiftyoneDegreesMemoryLargeFree(void *__ptr);
+
 /**
  * Pointer to the method used to allocate memory. By default this maps to
  * #fiftyoneDegreesMemoryStandardMalloc which calls the standard library malloc.
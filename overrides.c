@@ -51,6 +51,16 @@ static void collectionRelease(Item *item) {
 /* Prefix to use when comparing property names. */
 #define OVERRIDE_PREFIX "51D_"
 
+/* Name of the evidence field containing profile ids. */
+#define PROFILE_IDS "ProfileIds"
+
+/* FNV-1a constants used to hash property names. */
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+/* Empty entry in the names hash table or value slots. */
+#define EMPTY 0
+
 /**
  * Checks if the pair (p) have a field name that matches the target (t).
  * The last byte of t is null where as fieldLength is the length of printable
@@ -113,70 +123,185 @@ static const char* skipPrefix(bool prefixed, const char *field) {
 	return result;
 }
 
+/**
+ * Hashes the name ignoring the case of ASCII letters to be consistent with
+ * StringCompare.
+ */
+static uint32_t hashName(const char *name, size_t length) {
+	uint32_t hash = FNV_OFFSET;
+	const unsigned char *c = (const unsigned char*)name;
+	for (const unsigned char *end = c + length; c < end; c++) {
+		unsigned char lower = *c >= 'A' && *c <= 'Z' ? *c | 0x20 : *c;
+		hash = (hash ^ lower) * FNV_PRIME;
+	}
+	return hash;
+}
+
+static const char* getPropertyName(OverrideProperty *property) {
+	return STRING(property->available->name.data.ptr); // name is string
+}
+
+static size_t getPropertyNameLength(OverrideProperty *property) {
+	return ((String*)property->available->name.data.ptr)->size - 1;
+}
+
+/**
+ * Probes the hash table of the properties that can support being overridden
+ * until the name or an empty entry is found. The name need not be null
+ * terminated.
+ */
+static OverrideProperty* getPropertyFromName(
+	OverridePropertyArray *properties,
+	const char *name,
+	size_t length) {
+	uint32_t entry;
+	OverrideProperty *property;
+	uint32_t i = hashName(name, length) & properties->namesMask;
+	while ((entry = properties->names[i]) != EMPTY) {
+		property = &properties->items[entry - 1];
+		if (getPropertyNameLength(property) == length &&
+			StringCompareLength(getPropertyName(property), name, length) == 0) {
+			return property;
+		}
+		i = (i + 1) & properties->namesMask;
+	}
+	return NULL;
+}
+
 static int getRequiredPropertyIndexFromName(
 	OverridePropertyArray *properties,
 	const char *name) {
-	uint32_t i;
-	const char *current;
 	OverrideProperty *property;
 
 	// Skip the field name prefix.
 	name = (const char*)skipPrefix(properties->prefix, name);
 
-	// Search for the property name in the array of properties that can support
-	// being overridden.
-	for (i = 0; i < properties->count; i++) {
-		property = &properties->items[i];
-		current = STRING(property->available->name.data.ptr); // name is string
-		if (StringCompare((char*)current, (char*)name) == 0) {
-			return property->requiredPropertyIndex;
+	property = getPropertyFromName(properties, name, strlen(name));
+	return property != NULL ? property->requiredPropertyIndex : -1;
+}
+
+/**
+ * Returns the index of the value for the required property index, or -1 if
+ * there is no value. Uses the slots if available, otherwise scans the values.
+ */
+static int getValueIndex(
+	OverrideValueArray *values,
+	uint32_t requiredPropertyIndex) {
+	uint32_t i;
+	if (values->slots != NULL && requiredPropertyIndex < values->slotsCount) {
+		return (int)values->slots[requiredPropertyIndex] - 1;
+	}
+	for (i = 0; i < values->count; i++) {
+		if (values->items[i].requiredPropertyIndex == requiredPropertyIndex) {
+			return (int)i;
 		}
 	}
 	return -1;
 }
 
-bool fiftyoneDegreesOverridesAdd(
-	fiftyoneDegreesOverrideValueArray *values,
-	int requiredPropertyIndex,
-	const char *value) {
-	uint32_t currentOverrideIndex = 0;
-	size_t length;
-	String *copy;
-	OverrideValue *override;
+/**
+ * Returns the override value for the required property index either as a new
+ * item, or an existing one if there is already one with the same required
+ * property index. NULL if there is no space for a new item.
+ */
+static OverrideValue* getOrAddValue(
+	OverrideValueArray *values,
+	int requiredPropertyIndex) {
+	int currentOverrideIndex;
+	OverrideValue *override = NULL;
 	if (requiredPropertyIndex >= 0 && values->count < values->capacity) {
-
-		// Set the override either as a new item, or override an existing
-		// one if there is already one with the same required property
-		// index.
-		while (currentOverrideIndex < values->count &&
-			(int)values->items[currentOverrideIndex].requiredPropertyIndex !=
-			requiredPropertyIndex) {
-			currentOverrideIndex++;
-		}
-		override = &values->items[currentOverrideIndex];
-
-		if (currentOverrideIndex == values->count) {
+		currentOverrideIndex = getValueIndex(
+			values,
+			(uint32_t)requiredPropertyIndex);
+		if (currentOverrideIndex < 0) {
 			// Increment the override count and set the required property
 			// index.
-			values->count++;
+			override = &values->items[values->count];
 			override->requiredPropertyIndex = requiredPropertyIndex;
+			if (values->slots != NULL &&
+				(uint32_t)requiredPropertyIndex < values->slotsCount) {
+				values->slots[requiredPropertyIndex] = values->count + 1;
+			}
+			values->count++;
 		}
+		else {
+			override = &values->items[currentOverrideIndex];
+		}
+	}
+	return override;
+}
 
-		// Ensure there is sufficient memory for the string being copied.
-		length = strlen(value);
-		copy = (String*)fiftyoneDegreesDataMalloc(
-			&override->string,
-			sizeof(String) + length);
-
-		// Copy the string from the evidence pair to the override data 
-		// item.
-		memcpy(&copy->value, value, length + 1);
+/**
+ * Copies the characters to the string of the override value.
+ */
+static String* copyString(
+	OverrideValue *override,
+	const char *value,
+	size_t length) {
+	// Ensure there is sufficient memory for the string being copied.
+	String *copy = (String*)fiftyoneDegreesDataMalloc(
+		&override->string,
+		sizeof(String) + length);
+	if (copy != NULL) {
+		// Copy the string from the evidence pair to the override data item.
+		memcpy(&copy->value, value, length);
+		(&copy->value)[length] = '\0';
 		copy->size = (int16_t)(length + 1);
+		override->string.used = (uint32_t)(sizeof(String) + length);
 	}
+	return copy;
+}
+
+/**
+ * Returns the value as a string, copying the characters from the evidence
+ * the first time the string is needed if the value is a reference.
+ */
+static String* getString(OverrideValue *override) {
+	if (override->evidence != NULL && override->string.used == 0) {
+		return copyString(
+			override,
+			override->evidence,
+			override->evidenceLength);
+	}
+	return (String*)override->string.ptr;
+}
 
+static bool addCopy(
+	OverrideValueArray *values,
+	int requiredPropertyIndex,
+	const char *value,
+	size_t length) {
+	OverrideValue *override = getOrAddValue(values, requiredPropertyIndex);
+	if (override != NULL) {
+		override->evidence = NULL;
+		override->evidenceLength = 0;
+		copyString(override, value, length);
+	}
 	return values->count < values->capacity;
 }
 
+bool fiftyoneDegreesOverridesAdd(
+	fiftyoneDegreesOverrideValueArray *values,
+	int requiredPropertyIndex,
+	const char *value) {
+	return addCopy(values, requiredPropertyIndex, value, strlen(value));
+}
+
+bool fiftyoneDegreesOverridesAddReference(
+	fiftyoneDegreesOverrideValueArray *values,
+	int requiredPropertyIndex,
+	const char *value,
+	size_t length) {
+	OverrideValue *override = getOrAddValue(values, requiredPropertyIndex);
+	if (override != NULL) {
+		// Only record where the value is. The string is copied if and when
+		// it is needed.
+		override->evidence = value;
+		override->evidenceLength = length;
+		override->string.used = 0;
+	}
+	return values->count < values->capacity;
+}
 
 static bool addOverrideToResults(void *state, EvidenceKeyValuePair *pair) {
 	addState *add = (addState*)state;
@@ -186,10 +311,18 @@ static bool addOverrideToResults(void *state, EvidenceKeyValuePair *pair) {
 		add->properties,
 		pair->item.key);
 
-	return fiftyoneDegreesOverridesAdd(
+	if (add->values->reference) {
+		return fiftyoneDegreesOverridesAddReference(
+			add->values,
+			requiredPropertyIndex,
+			(const char*)pair->parsedValue,
+			pair->parsedLength);
+	}
+	return addCopy(
 		add->values,
 		requiredPropertyIndex,
-		(const char*)pair->parsedValue);
+		(const char*)pair->parsedValue,
+		pair->parsedLength);
 }
 
 static uint32_t countOverridableProperties(
@@ -222,22 +355,114 @@ static uint32_t addOverridableProperties(
 	return count;
 }
 
-fiftyoneDegreesOverrideValueArray* fiftyoneDegreesOverrideValuesCreate(
-	uint32_t capacity) {
+/**
+ * Adds each overridable property to the hash table of names.
+ */
+static void addNames(OverridePropertyArray *properties) {
+	uint32_t i, entry;
+	for (i = 0; i < properties->count; i++) {
+		entry = hashName(
+			getPropertyName(&properties->items[i]),
+			getPropertyNameLength(&properties->items[i])) &
+			properties->namesMask;
+		while (properties->names[entry] != EMPTY) {
+			entry = (entry + 1) & properties->namesMask;
+		}
+		properties->names[entry] = i + 1;
+	}
+}
+
+/**
+ * Records for each available property the first property whose name starts
+ * with its name. Done once so that finding the overriding property does not
+ * need to compare all the property names.
+ */
+static void addOverriding(
+	PropertiesAvailable *available,
+	OverridePropertyArray *properties) {
+	uint32_t i;
+	for (i = 0; i < available->count; i++) {
+		properties->overriding[i] =
+			OverridesGetOverridingRequiredPropertyIndex(available, i);
+	}
+}
+
+/**
+ * Allocates the routing tables for the properties returning false if there
+ * is insufficient memory.
+ */
+static bool createRouting(
+	PropertiesAvailable *available,
+	OverridePropertyArray *properties) {
+	uint32_t size = 1;
+
+	// Use a table with at least twice as many entries as properties to keep
+	// the probe sequences short.
+	while (size < properties->count * 2) {
+		size <<= 1;
+	}
+	properties->namesMask = size - 1;
+	properties->availableCount = available->count;
+	properties->names = (uint32_t*)Malloc(sizeof(uint32_t) * size);
+	properties->overriding = (int*)Malloc(
+		sizeof(int) * (available->count > 0 ? available->count : 1));
+	if (properties->names == NULL || properties->overriding == NULL) {
+		return false;
+	}
+	memset(properties->names, EMPTY, sizeof(uint32_t) * size);
+	addNames(properties);
+	addOverriding(available, properties);
+	return true;
+}
+
+static fiftyoneDegreesOverrideValueArray* createValues(
+	uint32_t capacity,
+	uint32_t slotsCount) {
 	uint32_t i;
 	OverrideValue *item;
 	fiftyoneDegreesOverrideValueArray* overrides;
+	MemoryTag tag = MemoryAccountingSetTag(
+		FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES);
 	FIFTYONE_DEGREES_ARRAY_CREATE(OverrideValue, overrides, capacity);
 	if (overrides != NULL) {
+		overrides->slots = NULL;
+		overrides->slotsCount = 0;
+		overrides->reference = false;
 		for (i = 0; i < capacity; i++) {
 			item = &overrides->items[i];
 			item->requiredPropertyIndex = 0;
+			item->evidence = NULL;
+			item->evidenceLength = 0;
 			DataReset(&item->string);
 		}
+		if (slotsCount > 0) {
+			overrides->slots = (uint32_t*)Malloc(
+				sizeof(uint32_t) * slotsCount);
+			if (overrides->slots == NULL) {
+				Free(overrides);
+				overrides = NULL;
+			}
+			else {
+				memset(overrides->slots, EMPTY, sizeof(uint32_t) * slotsCount);
+				overrides->slotsCount = slotsCount;
+			}
+		}
 	}
+	MemoryAccountingSetTag(tag);
 	return overrides;
 }
 
+fiftyoneDegreesOverrideValueArray* fiftyoneDegreesOverrideValuesCreate(
+	uint32_t capacity) {
+	return createValues(capacity, 0);
+}
+
+fiftyoneDegreesOverrideValueArray* fiftyoneDegreesOverrideValuesCreateWithSlots(
+	uint32_t capacity,
+	uint32_t slotsCount) {
+	return createValues(capacity, slotsCount);
+}
+
 fiftyoneDegreesOverridePropertyArray* fiftyoneDegreesOverridePropertiesCreate(
 	fiftyoneDegreesPropertiesAvailable *available,
 	bool prefix,
@@ -246,17 +471,32 @@ fiftyoneDegreesOverridePropertyArray* fiftyoneDegreesOverridePropertiesCreate(
 	OverridePropertyArray *properties = NULL;
 	uint32_t count = countOverridableProperties(available, state, filter);
 	if (count > 0) {
+		MemoryTag tag = MemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES);
 		FIFTYONE_DEGREES_ARRAY_CREATE(OverrideProperty, properties, count);
 		if (properties != NULL) {
 			properties->prefix = prefix;
+			properties->names = NULL;
+			properties->overriding = NULL;
 			addOverridableProperties(available, properties, state, filter);
+			if (createRouting(available, properties) == false) {
+				OverridePropertiesFree(properties);
+				properties = NULL;
+			}
 		}
+		MemoryAccountingSetTag(tag);
 	} 
 	return properties;
 }
 
 void fiftyoneDegreesOverridePropertiesFree(
 	fiftyoneDegreesOverridePropertyArray *properties) {
+	if (properties->names != NULL) {
+		Free(properties->names);
+	}
+	if (properties->overriding != NULL) {
+		Free(properties->overriding);
+	}
 	Free(properties);
 }
 
@@ -283,23 +523,21 @@ fiftyoneDegreesString* fiftyoneDegreesOverrideValuesGetFirst(
 	fiftyoneDegreesOverrideValueArray *values,
 	uint32_t requiredPropertyIndex,
 	fiftyoneDegreesCollectionItem *item) {
-	uint32_t i;
+	int i;
 	if (values != NULL) {
-		for (i = 0; i < values->count; i++) {
-			if (values->items[i].requiredPropertyIndex == 
-				requiredPropertyIndex) {
-				item->collection = (Collection*)&dummyCollection;
-
-				// Copy the pointer to the string in the values array. Set
-				// allocated and used to false as the memory must not be
-				// freed until the results the overrides are part of are 
-				// freed.
-				item->data.ptr = values->items[i].string.ptr;
-				item->data.allocated = 0;
-				item->data.used = 0;
-
-				return (String*)item->data.ptr;
-			}
+		i = getValueIndex(values, requiredPropertyIndex);
+		if (i >= 0) {
+			item->collection = (Collection*)&dummyCollection;
+
+			// Copy the pointer to the string in the values array. Set
+			// allocated and used to false as the memory must not be
+			// freed until the results the overrides are part of are 
+			// freed.
+			item->data.ptr = (byte*)getString(&values->items[i]);
+			item->data.allocated = 0;
+			item->data.used = 0;
+
+			return (String*)item->data.ptr;
 		}
 	}
 	return NULL;
@@ -308,53 +546,39 @@ fiftyoneDegreesString* fiftyoneDegreesOverrideValuesGetFirst(
 bool fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex(
 	fiftyoneDegreesOverrideValueArray *values,
 	uint32_t requiredPropertyIndex) {
-	uint32_t i;
-	OverrideValue *current;
-	if (values != NULL) {
-		// Loop through the values available from the overrides checking they
-		// match the required property index.
-		for (i = 0; i < values->count; i++) {
-			current = &values->items[i];
-			if (current->requiredPropertyIndex == requiredPropertyIndex) {
-				return true;
-			}
-		}
-	}
-	return false;
+	return values != NULL && getValueIndex(values, requiredPropertyIndex) >= 0;
 }
 
 uint32_t fiftyoneDegreesOverrideValuesAdd(
 	fiftyoneDegreesOverrideValueArray *values,
 	uint32_t requiredPropertyIndex,
 	fiftyoneDegreesList *list) {
-	uint32_t i, count = 0;
-	OverrideValue *current;
+	int i;
+	uint32_t count = 0;
 	Item valueItem;
-	if (values != NULL && values->count > 0) {
-
-		// Use a dummy collection so that the call to release will work
-		// if the client respects the collection pattern.
-		valueItem.collection = (Collection*)&dummyCollection;
-		valueItem.handle = NULL;
-
-		// Loop through the values available from the overrides checking they
-		// match the required property index.
-		for (i = 0; i < values->count && list->count < list->capacity; i++) {
-			current = &values->items[i];
-			if (current->requiredPropertyIndex == requiredPropertyIndex) {
-
-				// Copy the pointer to the string in the values array. Set
-				// allocated and used to false as the memory must not be
-				// freed until the results the overrides are part of are 
-				// freed.
-				valueItem.data.ptr = current->string.ptr;
-				valueItem.data.allocated = 0;
-				valueItem.data.used = 0;
-
-				// Add the collection item to the list of values.
-				ListAdd(list, &valueItem);
-				count++;
-			}
+	if (values != NULL && values->count > 0 && list->count < list->capacity) {
+
+		// There is at most one value for each required property index as
+		// adding a value for the same property replaces the existing one.
+		i = getValueIndex(values, requiredPropertyIndex);
+		if (i >= 0) {
+
+			// Use a dummy collection so that the call to release will work
+			// if the client respects the collection pattern.
+			valueItem.collection = (Collection*)&dummyCollection;
+			valueItem.handle = NULL;
+
+			// Copy the pointer to the string in the values array. Set
+			// allocated and used to false as the memory must not be
+			// freed until the results the overrides are part of are 
+			// freed.
+			valueItem.data.ptr = (byte*)getString(&values->items[i]);
+			valueItem.data.allocated = 0;
+			valueItem.data.used = 0;
+
+			// Add the collection item to the list of values.
+			ListAdd(list, &valueItem);
+			count++;
 		}
 	}
 	return count;
@@ -379,6 +603,19 @@ int fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex(
 	return -1;
 }
 
+int fiftyoneDegreesOverridePropertiesGetOverriding(
+	fiftyoneDegreesOverridePropertyArray *properties,
+	fiftyoneDegreesPropertiesAvailable *available,
+	uint32_t requiredPropertyIndex) {
+	if (properties != NULL &&
+		requiredPropertyIndex < properties->availableCount) {
+		return properties->overriding[requiredPropertyIndex];
+	}
+	return OverridesGetOverridingRequiredPropertyIndex(
+		available,
+		requiredPropertyIndex);
+}
+
 void fiftyoneDegreesOverrideValuesFree(
 	fiftyoneDegreesOverrideValueArray *overrides) {
 	uint32_t i;
@@ -390,6 +627,9 @@ void fiftyoneDegreesOverrideValuesFree(
 				Free(item->string.ptr);
 			}
 		}
+		if (overrides->slots != NULL) {
+			Free(overrides->slots);
+		}
 		Free(overrides);
 		overrides = NULL;
 	}
@@ -400,44 +640,70 @@ void fiftyoneDegreesOverrideValuesReset(
 	uint32_t i;
 	OverrideValue *item;
 	if (overrides != NULL) {
-		for (i = 0; i < overrides->capacity; i++) {
+		// Clear only the slots which are in use rather than all of them.
+		if (overrides->slots != NULL) {
+			for (i = 0; i < overrides->count; i++) {
+				item = &overrides->items[i];
+				if (item->requiredPropertyIndex < overrides->slotsCount) {
+					overrides->slots[item->requiredPropertyIndex] = EMPTY;
+				}
+			}
+		}
+		// Items beyond the count are either unused or were cleared by a
+		// previous reset. Only the string header needs clearing for the
+		// value to read as an empty string.
+		for (i = 0; i < overrides->count; i++) {
 			item = &overrides->items[i];
 			if (item->string.ptr != NULL && item->string.allocated > 0) {
-				memset(item->string.ptr, 0, item->string.allocated);
-				item->string.used = 0;
-				item->requiredPropertyIndex = 0;
+				memset(item->string.ptr, 0, sizeof(String));
 			}
+			item->string.used = 0;
+			item->requiredPropertyIndex = 0;
+			item->evidence = NULL;
+			item->evidenceLength = 0;
 		}
 		overrides->count = 0;
 	}
 }
 
-static void extractProfileId(char *value, overrideProfileIdsState *state) {
-	if (*value >= 0 && isdigit(*value) != 0) {
-		int profileId = atoi(value);
-		if (profileId >= 0) {
-			state->callback(state->state, profileId);
+static void extractProfileIds(
+	overrideProfileIdsState *state,
+	const char *value,
+	size_t length) {
+	const char *current = value, *end = value + length;
+	uint32_t profileId, digit;
+	bool found, valid;
+	while (current < end) {
+
+		// Each profile id is a sequence of digits, any other character is a
+		// separator. Sequences too long for a profile id are ignored.
+		profileId = 0;
+		found = false;
+		valid = true;
+		while (current < end && *current >= '0' && *current <= '9') {
+			digit = (uint32_t)(*current - '0');
+			if (profileId > (UINT32_MAX - digit) / 10) {
+				valid = false;
+			}
+			else {
+				profileId = profileId * 10 + digit;
+			}
+			found = true;
+			current++;
 		}
-	}
-}
-
-static void extractProfileIds(overrideProfileIdsState *state, char *value) {
-	char *current = value, *previous = value;
-	while (*current != '\0') {
-		if (*current < 0 || isdigit(*current) == 0) {
-			extractProfileId(previous, state);
-			previous = current + 1;
+		if (found && valid) {
+			state->callback(state->state, profileId);
 		}
 		current++;
 	}
-	extractProfileId(previous, state);
 }
 
 static bool iteratorProfileId(void *state, EvidenceKeyValuePair *pair) {
-	if (IS_HEADER_MATCH("ProfileIds", pair)) {
+	if (IS_HEADER_MATCH(PROFILE_IDS, pair)) {
 		extractProfileIds(
 			(overrideProfileIdsState*)state, 
-			(char*)pair->parsedValue);
+			(const char*)pair->parsedValue,
+			pair->parsedLength);
 	}
 	return true;
 }
@@ -454,3 +720,203 @@ void fiftyoneDegreesOverrideProfileIds(
 		&iterateState,
 		iteratorProfileId);
 }
+
+static bool isWhiteSpace(char c) {
+	return c == ' ' || c == '\t';
+}
+
+static int hexValue(char c) {
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+/**
+ * Sets the value of the pair to the characters provided if they are not
+ * encoded. Otherwise the decoded characters are written to the buffer and
+ * the value refers to them. If the buffer is not available or is too small
+ * the encoded characters are used.
+ */
+static void setValue(
+	KeyValuePair *pair,
+	const char *value,
+	size_t length,
+	bool plusIsSpace,
+	StringBuilder *buffer) {
+	const char *current = value, *end = value + length, *start;
+	int high, low;
+	pair->value = value;
+	pair->valueLength = length;
+	if (buffer == NULL ||
+		(memchr(value, '%', length) == NULL &&
+		(plusIsSpace == false || memchr(value, '+', length) == NULL))) {
+		return;
+	}
+	start = buffer->current;
+	while (current < end) {
+		if (*current == '%' &&
+			end - current > 2 &&
+			(high = hexValue(current[1])) >= 0 &&
+			(low = hexValue(current[2])) >= 0) {
+			StringBuilderAddChar(buffer, (char)((high << 4) | low));
+			current += 3;
+		}
+		else {
+			StringBuilderAddChar(
+				buffer,
+				plusIsSpace && *current == '+' ? ' ' : *current);
+			current++;
+		}
+	}
+	StringBuilderAddChar(buffer, '\0');
+	if (buffer->full == false) {
+		pair->value = start;
+		pair->valueLength = buffer->current - start - 1;
+	}
+}
+
+/**
+ * Adds the name and value to the evidence if the name is an overridable
+ * property or the profile ids. The key of the evidence is the null
+ * terminated name of the property rather than the name provided.
+ */
+static bool addParameter(
+	OverridePropertyArray *properties,
+	EvidenceKeyValuePairArray *evidence,
+	EvidencePrefix prefix,
+	const char *name,
+	size_t nameLength,
+	const char *value,
+	size_t valueLength,
+	StringBuilder *buffer) {
+	KeyValuePair pair;
+	EvidenceKeyValuePair *added;
+	OverrideProperty *property = NULL;
+	const size_t prefixLength = sizeof(OVERRIDE_PREFIX) - 1;
+	const char *unprefixed = name;
+	size_t unprefixedLength = nameLength;
+	if (nameLength > prefixLength &&
+		StringCompareLength(name, OVERRIDE_PREFIX, prefixLength) == 0) {
+		unprefixed += prefixLength;
+		unprefixedLength -= prefixLength;
+	}
+
+	// Profile ids can always be prefixed, whereas property names can only be
+	// prefixed if the properties expect it.
+	if (unprefixedLength == sizeof(PROFILE_IDS) - 1 &&
+		StringCompareLength(unprefixed, PROFILE_IDS, unprefixedLength) == 0) {
+		pair.key = PROFILE_IDS;
+		pair.keyLength = unprefixedLength;
+	}
+	else if (properties != NULL && (property = properties->prefix ?
+		getPropertyFromName(properties, unprefixed, unprefixedLength) :
+		getPropertyFromName(properties, name, nameLength)) != NULL) {
+		pair.key = getPropertyName(property);
+		pair.keyLength = getPropertyNameLength(property);
+	}
+	else {
+		return false;
+	}
+
+	// Only decode the values which are going to be used.
+	setValue(
+		&pair,
+		value,
+		valueLength,
+		prefix == FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		buffer);
+	added = EvidenceAddPair(evidence, prefix, pair);
+	added->parsedValue = pair.value;
+	added->parsedLength = pair.valueLength;
+	return true;
+}
+
+/**
+ * Splits the characters into name and value parameters separated by the
+ * separator provided, adding those which are relevant to the evidence.
+ */
+static uint32_t addParameters(
+	OverridePropertyArray *properties,
+	EvidenceKeyValuePairArray *evidence,
+	EvidencePrefix prefix,
+	char separator,
+	const char *chars,
+	size_t length,
+	StringBuilder *buffer) {
+	uint32_t count = 0;
+	const char *current = chars, *end = chars + length, *next, *last, *equals;
+	const char *value;
+	while (current < end) {
+		next = (const char*)memchr(current, separator, end - current);
+		last = next == NULL ? end : next;
+
+		// Remove white space around the parameter.
+		while (current < last && isWhiteSpace(*current)) {
+			current++;
+		}
+		while (last > current && isWhiteSpace(last[-1])) {
+			last--;
+		}
+
+		equals = (const char*)memchr(current, '=', last - current);
+		if (equals != NULL && equals > current) {
+
+			// Remove quotes around the value if present.
+			value = equals + 1;
+			if (last - value >= 2 && *value == '"' && last[-1] == '"') {
+				value++;
+				last--;
+			}
+			if (addParameter(
+				properties,
+				evidence,
+				prefix,
+				current,
+				equals - current,
+				value,
+				last - value,
+				buffer)) {
+				count++;
+			}
+		}
+		current = next == NULL ? end : next + 1;
+	}
+	return count;
+}
+
+uint32_t fiftyoneDegreesOverridesAddCookies(
+	fiftyoneDegreesOverridePropertyArray *properties,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	const char *cookies,
+	size_t length,
+	fiftyoneDegreesStringBuilder *buffer) {
+	return addParameters(
+		properties,
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_COOKIE,
+		';',
+		cookies,
+		length,
+		buffer);
+}
+
+uint32_t fiftyoneDegreesOverridesAddQueryString(
+	fiftyoneDegreesOverridePropertyArray *properties,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	const char *query,
+	size_t length,
+	fiftyoneDegreesStringBuilder *buffer) {
+	if (length > 0 && *query == '?') {
+		query++;
+		length--;
+	}
+	return addParameters(
+		properties,
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		'&',
+		query,
+		length,
+		buffer);
+}
@@ -45,6 +45,20 @@
  * #fiftyoneDegreesOverrideValuesCreate method. This is then ready to be added
  * to and used to override the values in a results structure.
  *
+ * ## Routing
+ *
+ * When the overridable properties are created a hash table of the property
+ * names is built along with a table of the property, if any, which overrides
+ * each available property. Finding the property an item of evidence relates
+ * to, or the property which overrides another, is then a constant time
+ * operation rather than a scan of all the properties.
+ *
+ * Override values created with #fiftyoneDegreesOverrideValuesCreateWithSlots
+ * also hold a slot for each required property index which refers to the
+ * value for the property. Adding, checking for and getting the value for a
+ * property then do not need to scan the values. Values created with
+ * #fiftyoneDegreesOverrideValuesCreate do not have slots and are scanned.
+ *
  * ## Extraction
  *
  * Override values are extracted from an evidence structure using the
@@ -58,6 +72,17 @@
  * #fiftyoneDegreesOverrideValuesAdd methods which add a single or multiple 
  * values respectively to the override values.
  *
+ * ## Zero Copy
+ *
+ * When the values array has the reference flag set the values extracted from
+ * evidence are not copied. Instead each value refers to the characters in
+ * the evidence, which must remain valid for as long as the values are in use.
+ * This is the case when the values are part of results created from the
+ * evidence. The value is only copied into the string form when it is
+ * returned from #fiftyoneDegreesOverrideValuesGetFirst or
+ * #fiftyoneDegreesOverrideValuesAdd. Values can also be added by reference
+ * using #fiftyoneDegreesOverridesAddReference.
+ *
  * ## Free
  *
  * Property and value overrides are freed using the
@@ -74,6 +99,7 @@
 #include "collection.h"
 #include "properties.h"
 #include "evidence.h"
+#include "stringBuilder.h"
 #include "array.h"
 #include "common.h"
 
@@ -93,19 +119,39 @@ typedef struct fiftyone_degrees_override_property_t {
 typedef struct fiftyone_degrees_override_value_t {
 	uint32_t requiredPropertyIndex; /**< Index in the available properties
 									structure */
-	fiftyoneDegreesData string; /**< Overridden value */
+	fiftyoneDegreesData string; /**< Overridden value. Only valid when used
+								is not zero if the value refers to evidence */
+	const char *evidence; /**< Characters of the value in the evidence if
+						  added by reference, otherwise NULL */
+	size_t evidenceLength; /**< Number of characters in evidence */
 } fiftyoneDegreesOverrideValue;
 
 FIFTYONE_DEGREES_ARRAY_TYPE(
 	fiftyoneDegreesOverrideProperty,
 	bool prefix; /**< Flag which when true requires the `51D_` prefix to be
 				 checked for in evidence. */
+	uint32_t *names; /**< Open addressing hash table of the property names.
+					 Each entry is the index of the item plus one, or zero if
+					 the entry is empty */
+	uint32_t namesMask; /**< Number of entries in names minus one */
+	int *overriding; /**< Index of the property which overrides each available
+					 property, or -1 if there is none */
+	uint32_t availableCount; /**< Number of available properties and entries
+							 in overriding */
 );
 
 /**
  * An array of properties and values to use when getting override values.
  */
-FIFTYONE_DEGREES_ARRAY_TYPE(fiftyoneDegreesOverrideValue,);
+FIFTYONE_DEGREES_ARRAY_TYPE(
+	fiftyoneDegreesOverrideValue,
+	uint32_t *slots; /**< Index of the value plus one for each required
+					 property index, or zero if there is no value. NULL if the
+					 values must be scanned */
+	uint32_t slotsCount; /**< Number of entries in slots */
+	bool reference; /**< True if values extracted from evidence should refer
+					to the evidence rather than be copied */
+);
 
 /**
  * Array of overridable properties. These are properties in a data set which
@@ -143,6 +189,20 @@ typedef bool(*fiftyoneDegreesOverridesFilterMethod)(
 EXTERNAL fiftyoneDegreesOverrideValueArray* fiftyoneDegreesOverrideValuesCreate(
 	uint32_t capacity);
 
+/**
+ * Creates a fresh array of override values with the given capacity and a slot
+ * for each required property index so that values can be found without
+ * scanning the array.
+ * @param capacity the number of values the array can contain
+ * @param slotsCount the number of required property indexes, usually the
+ * availableCount of the overridable properties
+ * @return a new array of override values
+ */
+EXTERNAL fiftyoneDegreesOverrideValueArray*
+fiftyoneDegreesOverrideValuesCreateWithSlots(
+	uint32_t capacity,
+	uint32_t slotsCount);
+
 /**
  * Returns a list of the evidence keys that are available to support 
  * overriding property values.
@@ -153,7 +213,7 @@ EXTERNAL fiftyoneDegreesOverrideValueArray* fiftyoneDegreesOverrideValuesCreate(
  * property is eligible to be overridden
  * @return a new override properties array
  */
-fiftyoneDegreesOverridePropertyArray* 
+EXTERNAL fiftyoneDegreesOverridePropertyArray* 
 fiftyoneDegreesOverridePropertiesCreate(
 	fiftyoneDegreesPropertiesAvailable *available,
 	bool prefix,
@@ -164,7 +224,7 @@ fiftyoneDegreesOverridePropertiesCreate(
  * Frees the resources used by the override properties.
  * @param properties pointer to the properties to free
  */
-void fiftyoneDegreesOverridePropertiesFree(
+EXTERNAL void fiftyoneDegreesOverridePropertiesFree(
 	fiftyoneDegreesOverridePropertyArray *properties);
 
 /**
@@ -174,11 +234,58 @@ void fiftyoneDegreesOverridePropertiesFree(
  * @param evidence to extract any overrides from
  * @return the number of override values which have been extracted
  */
- uint32_t fiftyoneDegreesOverridesExtractFromEvidence(
+EXTERNAL uint32_t fiftyoneDegreesOverridesExtractFromEvidence(
 	fiftyoneDegreesOverridePropertyArray *properties,
 	fiftyoneDegreesOverrideValueArray *values,
 	fiftyoneDegreesEvidenceKeyValuePairArray *evidence);
 
+/**
+ * Adds the cookies from a raw `Cookie` header which relate to overridable
+ * properties or profile ids to the evidence. Other cookies are ignored. The
+ * key of each new entry is the null terminated name of the property, or
+ * `ProfileIds`, without any `51D_` prefix. The value refers to the
+ * characters in the header and is NOT null terminated, unless it is percent
+ * encoded in which case the decoded value is written to the buffer. The
+ * header and buffer must not be freed until after the evidence has been
+ * freed.
+ * @param properties which can be overridden, or NULL if only profile ids
+ * are needed
+ * @param evidence to add the cookies to
+ * @param cookies characters of the `Cookie` header value
+ * @param length number of characters in cookies
+ * @param buffer to write decoded values to, or NULL if values should not be
+ * decoded. If the buffer is too small the encoded value is used.
+ * @return the number of cookies added to the evidence
+ */
+EXTERNAL uint32_t fiftyoneDegreesOverridesAddCookies(
+	fiftyoneDegreesOverridePropertyArray *properties,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	const char *cookies,
+	size_t length,
+	fiftyoneDegreesStringBuilder *buffer);
+
+/**
+ * Adds the parameters from a raw URL query string which relate to
+ * overridable properties or profile ids to the evidence. Other parameters
+ * are ignored. The query string can start with a `?`. Behaves as
+ * #fiftyoneDegreesOverridesAddCookies except that a `+` is also decoded as a
+ * space.
+ * @param properties which can be overridden, or NULL if only profile ids
+ * are needed
+ * @param evidence to add the parameters to
+ * @param query characters of the query string
+ * @param length number of characters in query
+ * @param buffer to write decoded values to, or NULL if values should not be
+ * decoded. If the buffer is too small the encoded value is used.
+ * @return the number of parameters added to the evidence
+ */
+EXTERNAL uint32_t fiftyoneDegreesOverridesAddQueryString(
+	fiftyoneDegreesOverridePropertyArray *properties,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence,
+	const char *query,
+	size_t length,
+	fiftyoneDegreesStringBuilder *buffer);
+
 /**
  * Gets whether or not the override values contain an override relating to the
  * property identified by the required property index. Note that the required
@@ -189,7 +296,7 @@ void fiftyoneDegreesOverridePropertiesFree(
  * property to check for values of
  * @return true if there are override values for the requested property
  */
- bool fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex(
+EXTERNAL bool fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex(
 	 fiftyoneDegreesOverrideValueArray *values,
 	 uint32_t requiredPropertyIndex);
 
@@ -200,7 +307,7 @@ void fiftyoneDegreesOverridePropertiesFree(
  * @param list to add the values to
  * @return the number of values which have been added to the list
  */
-uint32_t fiftyoneDegreesOverrideValuesAdd(
+EXTERNAL uint32_t fiftyoneDegreesOverrideValuesAdd(
 	fiftyoneDegreesOverrideValueArray *values,
 	uint32_t requiredPropertyIndex,
 	fiftyoneDegreesList *list);
@@ -218,6 +325,23 @@ EXTERNAL bool fiftyoneDegreesOverridesAdd(
 	int requiredPropertyIndex,
 	const char *value);
 	
+/**
+ * Add a value override to the override values array which refers to the
+ * characters provided rather than copying them. The characters must remain
+ * valid until the values are reset or freed.
+ * @param values the override values array to add the value to
+ * @param requiredPropertyIndex the index in the dataset's required properties
+ * of the property to override the value of
+ * @param value the characters of the value override
+ * @param length number of characters in the value
+ * @return true if the value was added successfully
+ */
+EXTERNAL bool fiftyoneDegreesOverridesAddReference(
+	fiftyoneDegreesOverrideValueArray *values,
+	int requiredPropertyIndex,
+	const char *value,
+	size_t length);
+
 /**
  * Returns the first value for the required property index or NULL of no value
  * exists for the property index.
@@ -226,7 +350,7 @@ EXTERNAL bool fiftyoneDegreesOverridesAdd(
  * @param item to store the result in
  * @return pointer to the value or NULL if none were found
  */
-fiftyoneDegreesString* fiftyoneDegreesOverrideValuesGetFirst(
+EXTERNAL fiftyoneDegreesString* fiftyoneDegreesOverrideValuesGetFirst(
 	fiftyoneDegreesOverrideValueArray *values,
 	uint32_t requiredPropertyIndex,
 	fiftyoneDegreesCollectionItem *item);
@@ -240,7 +364,24 @@ fiftyoneDegreesString* fiftyoneDegreesOverrideValuesGetFirst(
  * @return the positive index of the overriding required property, or -1 it 
  * can't be overridden.
  */
-int fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex(
+EXTERNAL int fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex(
+	fiftyoneDegreesPropertiesAvailable *available,
+	uint32_t requiredPropertyIndex);
+
+/**
+ * Gets the required property index of a property that **MIGHT** override the
+ * value of the required property index provided using the table built when
+ * the overridable properties were created. If there are no overridable
+ * properties then the available properties are searched as
+ * #fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex does.
+ * @param properties which can be overridden, or NULL
+ * @param available list of require properties
+ * @param requiredPropertyIndex of the property to test for being overridden
+ * @return the positive index of the overriding required property, or -1 it
+ * can't be overridden.
+ */
+EXTERNAL int fiftyoneDegreesOverridePropertiesGetOverriding(
+	fiftyoneDegreesOverridePropertyArray *properties,
 	fiftyoneDegreesPropertiesAvailable *available,
 	uint32_t requiredPropertyIndex);
 
@@ -252,8 +393,10 @@ EXTERNAL void fiftyoneDegreesOverrideValuesFree(
 	fiftyoneDegreesOverrideValueArray *values);
 
 /**
- * Reset override array. All existing item memory will not be freed by reset
- * with 0s. Remaining values will be reset to default except the allocateds size..
+ * Reset override array. The memory used by the strings is retained for reuse
+ * and the strings are cleared to empty. Values which refer to evidence no
+ * longer do so. Remaining values will be reset to default except the
+ * allocated size.
  * @param values to be reset
  */
 EXTERNAL void fiftyoneDegreesOverrideValuesReset(
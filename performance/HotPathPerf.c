@@ -0,0 +1,774 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../collectionKeyTypes.h"
+#include "../fiftyone.h"
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// Number of fixed width integers in the synthetic collections.
+#define COLLECTION_COUNT 65536
+
+// Size in bytes of the buffers used to compare random reads from standard
+// and huge page backed memory. Large enough to exceed the reach of the TLB.
+#define LARGE_SIZE (256 * 1024 * 1024)
+
+// Name of the file the synthetic collection is written to for the file and
+// cached file benchmarks.
+#define COLLECTION_FILE "HotPathPerf.dat"
+
+// Minimum time in seconds a calibration run must take to be used to work out
+// the number of iterations for each benchmark.
+#define CALIBRATION_SECONDS 0.05
+
+// Time in seconds each benchmark should run for with a single thread.
+#define TARGET_SECONDS 0.25
+
+// Number of times each measurement is repeated. The fastest is reported.
+#define REPEATS 3
+
+// Default maximum number of threads to run each benchmark with, and the
+// largest maximum which can be requested.
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+#define THREAD_COUNT 4
+#define THREAD_COUNT_LIMIT 64
+#else
+#define THREAD_COUNT 1
+#define THREAD_COUNT_LIMIT 1
+#endif
+
+// Method which performs the operation being measured the number of times
+// requested and returns a value derived from the results so that the
+// operations can not be optimised away.
+typedef uint64_t(*benchmarkMethod)(void *state, long iterations);
+
+// A single benchmark and the state shared by all the threads running it.
+typedef struct benchmark_t {
+	const char *name;
+	benchmarkMethod run;
+	void *state;
+} benchmark;
+
+// State for each thread running a benchmark.
+typedef struct benchmark_thread_t {
+	const benchmark *benchmark;
+	long iterations;
+	uint64_t result;
+} benchmarkThread;
+
+// Synthetic data shared by the benchmarks.
+typedef struct benchmark_data_t {
+	byte *integers; // Length followed by COLLECTION_COUNT sorted integers
+	fiftyoneDegreesCollection *memory; // Collection of the integers in memory
+	fiftyoneDegreesCollection *file; // Collection of the integers read from file
+	fiftyoneDegreesCollection *cached; // Collection of the integers read from file via cache
+	fiftyoneDegreesCollection *reuse; // Collection of the integers read from file reusing buffers
+	FILE *fileHandle; // Handle used to read the collection headers from file
+	FilePool filePool; // Pool of file handles for the file collections
+	byte *strings; // Length followed by the header name strings
+	uint32_t *stringOffsets; // Offset of each header name string
+	fiftyoneDegreesCollection *stringsCollection; // Collection of the header names
+	Headers *headers; // Headers created from the header names
+	HeaderPtrs *iterateHeaders; // Headers which evidence is iterated for
+	EvidenceKeyValuePairArray *evidence; // Evidence with a value for each
+	ResourceManager manager; // Manager of a resource with no data
+	ResourceHandle *resourceHandle; // Handle to the managed resource
+	byte wkb[128]; // Well known binary for a polygon
+	StoredBinaryValue *json; // String value added to JSON
+	uint64_t *large; // LARGE_SIZE buffer allocated without huge pages
+	uint64_t *largeHuge; // LARGE_SIZE buffer allocated with huge pages
+	uint16_t concurrency; // Maximum number of threads
+} benchmarkData;
+
+static volatile uint64_t sink = 0;
+
+static const char *headerNames[] = {
+	"User-Agent",
+	"Sec-CH-UA",
+	"Sec-CH-UA-Mobile",
+	"Sec-CH-UA-Model",
+	"Sec-CH-UA-Platform",
+	"Sec-CH-UA-Platform-Version",
+	"Sec-CH-UA-Full-Version-List",
+	"Sec-CH-UA-Arch",
+	"Sec-CH-UA-Bitness",
+	"Accept-Language",
+	"Referer",
+	"Host"
+};
+
+static const int headerNamesCount = sizeof(headerNames) / sizeof(char*);
+
+static const char *headerLookups[] = {
+	"user-agent",
+	"Sec-CH-UA-Platform",
+	"sec-ch-ua-full-version-list",
+	"Host",
+	"X-Not-Present",
+	"accept-language"
+};
+
+static const int headerLookupsCount = sizeof(headerLookups) / sizeof(char*);
+
+static const char *ipAddresses[] = {
+	"192.168.0.1",
+	"10.0.0.255",
+	"2001:db8:85a3::8a2e:370:7334",
+	"::1",
+	"fe80::1ff:fe23:4567:890a",
+	"::ffff:203.0.113.17",
+	"203.0.113.195",
+	"2001:0db8:0000:0000:0000:ff00:0042:8329"
+};
+
+static const int ipAddressesCount = sizeof(ipAddresses) / sizeof(char*);
+
+static double now() {
+#ifdef _MSC_VER
+	return (double)GetTickCount64() / 1000;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1.0e9;
+#endif
+}
+
+// Returns a pseudo random index for the iteration so that consecutive
+// iterations do not access adjacent items.
+static uint32_t scatter(long i, uint32_t count) {
+	return (uint32_t)(((uint64_t)i * 2654435761u) % count);
+}
+
+static uint64_t collectionGet(fiftyoneDegreesCollection *collection, long iterations) {
+	uint64_t result = 0;
+	Item item;
+	CollectionKey key = { { 0 }, CollectionKeyType_Integer };
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	DataReset(&item.data);
+	for (long i = 0; i < iterations; i++) {
+		key.indexOrOffset.index = scatter(i, COLLECTION_COUNT);
+		const uint32_t *value = (const uint32_t*)collection->get(
+			collection,
+			&key,
+			&item,
+			exception);
+		if (value != NULL && EXCEPTION_OKAY) {
+			result += *value;
+			COLLECTION_RELEASE(collection, &item);
+		}
+	}
+	return result;
+}
+
+static uint64_t runCollectionGetMemory(void *state, long iterations) {
+	return collectionGet(((benchmarkData*)state)->memory, iterations);
+}
+
+static uint64_t runCollectionGetFile(void *state, long iterations) {
+	return collectionGet(((benchmarkData*)state)->file, iterations);
+}
+
+static uint64_t runCollectionGetReuse(void *state, long iterations) {
+	return collectionGet(((benchmarkData*)state)->reuse, iterations);
+}
+
+static uint64_t runCollectionGetCached(void *state, long iterations) {
+	return collectionGet(((benchmarkData*)state)->cached, iterations);
+}
+
+static uint64_t largeRead(const uint64_t *large, long iterations) {
+	uint64_t result = 0;
+	for (long i = 0; i < iterations; i++) {
+		result += large[scatter(i, LARGE_SIZE / sizeof(uint64_t))];
+	}
+	return result;
+}
+
+static uint64_t runLargeRead(void *state, long iterations) {
+	return largeRead(((benchmarkData*)state)->large, iterations);
+}
+
+static uint64_t runLargeReadHugePages(void *state, long iterations) {
+	return largeRead(((benchmarkData*)state)->largeHuge, iterations);
+}
+
+static int compareInteger(
+	void *state,
+	Item *item,
+	CollectionKey key,
+	Exception *exception) {
+	(void)key;
+	(void)exception;
+	uint32_t a = *(uint32_t*)item->data.ptr;
+	uint32_t b = *(uint32_t*)state;
+	return a < b ? -1 : a > b ? 1 : 0;
+}
+
+static uint64_t runCollectionBinarySearch(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	uint64_t result = 0;
+	Item item;
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	DataReset(&item.data);
+	for (long i = 0; i < iterations; i++) {
+		// Integers are stored as twice their index so half are missing.
+		uint32_t target = scatter(i, COLLECTION_COUNT * 2);
+		long index = CollectionBinarySearch(
+			data->memory,
+			&item,
+			(CollectionIndexOrOffset){0},
+			(CollectionIndexOrOffset){COLLECTION_COUNT - 1},
+			CollectionKeyType_Integer,
+			&target,
+			compareInteger,
+			exception);
+		if (index >= 0) {
+			result += index;
+			COLLECTION_RELEASE(data->memory, &item);
+		}
+	}
+	return result;
+}
+
+static bool countPair(void *state, EvidenceKeyValuePair *pair) {
+	*(uint64_t*)state += pair->item.valueLength;
+	return true;
+}
+
+static uint64_t runEvidenceIterateForHeaders(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	uint64_t result = 0;
+	char buffer[512];
+	for (long i = 0; i < iterations; i++) {
+		EvidenceIterateForHeaders(
+			data->evidence,
+			FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+			data->iterateHeaders,
+			buffer,
+			sizeof(buffer),
+			&result,
+			countPair);
+	}
+	return result;
+}
+
+static uint64_t runHeaderGetIndex(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	uint64_t result = 0;
+	for (long i = 0; i < iterations; i++) {
+		const char *name = headerLookups[i % headerLookupsCount];
+		result += HeaderGetIndex(data->headers, name, strlen(name));
+	}
+	return result;
+}
+
+static uint64_t runIpAddressParse(void *state, long iterations) {
+	uint64_t result = 0;
+	IpAddress address;
+	size_t lengths[sizeof(ipAddresses) / sizeof(char*)];
+	(void)state;
+	for (int i = 0; i < ipAddressesCount; i++) {
+		lengths[i] = strlen(ipAddresses[i]);
+	}
+	for (long i = 0; i < iterations; i++) {
+		const char *value = ipAddresses[i % ipAddressesCount];
+		if (IpAddressParse(
+			value,
+			value + lengths[i % ipAddressesCount] - 1,
+			&address)) {
+			result += address.value[0];
+		}
+	}
+	return result;
+}
+
+static uint64_t runConvertWkbToWkt(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	uint64_t result = 0;
+	char buffer[256];
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	for (long i = 0; i < iterations; i++) {
+		WkbtotResult written = ConvertWkbToWkt(
+			data->wkb,
+			FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE,
+			buffer,
+			sizeof(buffer),
+			6,
+			exception);
+		result += written.written;
+	}
+	return result;
+}
+
+static uint64_t runJsonPropertyValues(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	char buffer[256];
+	List values;
+	Item item;
+	uint64_t result = 0;
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	Json json = { { buffer, sizeof(buffer) }, NULL, NULL, &values, exception,
+		FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING };
+	ListInit(&values, 1);
+	DataReset(&item.data);
+	item.data.ptr = (byte*)data->json;
+	values.items[0] = item;
+	values.count = 1;
+	for (long i = 0; i < iterations; i++) {
+		StringBuilderInit(&json.builder);
+		JsonPropertyValues(&json);
+		StringBuilderComplete(&json.builder);
+		result += json.builder.added;
+	}
+	values.count = 0;
+	ListFree(&values);
+	return result;
+}
+
+static uint64_t runResourceHandleUse(void *state, long iterations) {
+	benchmarkData *data = (benchmarkData*)state;
+	uint64_t result = 0;
+	for (long i = 0; i < iterations; i++) {
+		ResourceHandle *handle = ResourceHandleIncUse(&data->manager);
+		result += handle->resource != NULL;
+		ResourceHandleDecUse(handle);
+	}
+	return result;
+}
+
+static void freeNothing(void *resource) {
+	(void)resource;
+}
+
+// Returns the number of bytes in the buffer with the length of the data
+// followed by the strings in the same form as the strings collection.
+static byte* createStrings(uint32_t *offsets, size_t *length) {
+	uint32_t dataLength = 0;
+	for (int i = 0; i < headerNamesCount; i++) {
+		dataLength += (uint32_t)(sizeof(int16_t) + strlen(headerNames[i]) + 1);
+	}
+	byte *strings = (byte*)malloc(sizeof(uint32_t) + dataLength);
+	memcpy(strings, &dataLength, sizeof(uint32_t));
+	byte *current = strings + sizeof(uint32_t);
+	for (int i = 0; i < headerNamesCount; i++) {
+		int16_t size = (int16_t)(strlen(headerNames[i]) + 1);
+		offsets[i] = (uint32_t)(current - (strings + sizeof(uint32_t)));
+		memcpy(current, &size, sizeof(int16_t));
+		memcpy(current + sizeof(int16_t), headerNames[i], size);
+		current += sizeof(int16_t) + size;
+	}
+	*length = sizeof(uint32_t) + dataLength;
+	return strings;
+}
+
+static long getHeaderUniqueId(void *state, uint32_t index, Item *item) {
+	benchmarkData *data = (benchmarkData*)state;
+	CollectionKey key = { { 0 }, CollectionKeyType_String };
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	if (index >= (uint32_t)headerNamesCount) {
+		return -1;
+	}
+	key.indexOrOffset.offset = data->stringOffsets[index];
+	data->stringsCollection->get(data->stringsCollection, &key, item, exception);
+	item->collection = data->stringsCollection;
+	return (long)data->stringOffsets[index];
+}
+
+static fiftyoneDegreesCollection* createFromMemory(byte *buffer, size_t length, uint32_t size) {
+	MemoryReader reader;
+	reader.startByte = buffer;
+	reader.current = buffer;
+	reader.length = (FileOffset)length;
+	reader.lastByte = buffer + length;
+	return CollectionCreateFromMemory(
+		&reader,
+		CollectionHeaderFromMemory(&reader, size, false));
+}
+
+static fiftyoneDegreesCollection* createFromFile(
+	benchmarkData *data,
+	uint32_t capacity,
+	bool reuseBuffers) {
+	fiftyoneDegreesCollectionConfig config = {
+		false,
+		capacity,
+		data->concurrency,
+		reuseBuffers };
+	fseek(data->fileHandle, 0, SEEK_SET);
+	return CollectionCreateFromFile(
+		data->fileHandle,
+		&data->filePool,
+		&config,
+		CollectionHeaderFromFile(data->fileHandle, sizeof(uint32_t), false),
+		CollectionReadFileFixed);
+}
+
+// Writes a square polygon as little endian well known binary.
+static void createWkb(byte *wkb) {
+	const double points[] = { 0, 0, 10.5, 0, 10.5, 10.5, 0, 10.5, 0, 0 };
+	const uint32_t header[] = { 3, 1, 5 };
+	wkb[0] = 1;
+	memcpy(wkb + 1, header, sizeof(header));
+	memcpy(wkb + 1 + sizeof(header), points, sizeof(points));
+}
+
+static StoredBinaryValue* createJsonValue() {
+	const char *value = "Mozilla/5.0 (Linux; Android 14) \"Mobile\"\tSafari";
+	int16_t size = (int16_t)(strlen(value) + 1);
+	StoredBinaryValue *stored = (StoredBinaryValue*)malloc(
+		sizeof(int16_t) + size);
+	stored->stringValue.size = size;
+	memcpy(&stored->stringValue.value, value, size);
+	return stored;
+}
+
+static bool createData(benchmarkData *data, int concurrency) {
+	size_t length = sizeof(uint32_t) * (COLLECTION_COUNT + 1);
+	uint32_t *integers = (uint32_t*)malloc(length);
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	memset(data, 0, sizeof(benchmarkData));
+	data->concurrency = (uint16_t)concurrency;
+
+	// Sorted integers for the memory, file and binary search benchmarks.
+	integers[0] = COLLECTION_COUNT * sizeof(uint32_t);
+	for (uint32_t i = 0; i < COLLECTION_COUNT; i++) {
+		integers[i + 1] = i * 2;
+	}
+	data->integers = (byte*)integers;
+	data->memory = createFromMemory(data->integers, length, sizeof(uint32_t));
+	if (FileWrite(COLLECTION_FILE, data->integers, length) != SUCCESS ||
+		FileOpen(COLLECTION_FILE, &data->fileHandle) != SUCCESS ||
+		FilePoolInit(
+			&data->filePool,
+			COLLECTION_FILE,
+			data->concurrency,
+			exception) != SUCCESS) {
+		printf("Could not create '%s'.\n", COLLECTION_FILE);
+		return false;
+	}
+	data->file = createFromFile(data, 0, false);
+	data->reuse = createFromFile(data, 0, true);
+	data->cached = createFromFile(data, COLLECTION_COUNT, false);
+
+	// Headers and evidence with a value for every header.
+	data->stringOffsets = (uint32_t*)malloc(sizeof(uint32_t) * headerNamesCount);
+	data->strings = createStrings(data->stringOffsets, &length);
+	data->stringsCollection = createFromMemory(data->strings, length, 0);
+	data->headers = HeadersCreate(false, data, getHeaderUniqueId, exception);
+	data->evidence = EvidenceCreate(headerNamesCount);
+	for (int i = 0; i < headerNamesCount; i++) {
+		EvidenceAddString(
+			data->evidence,
+			FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+			headerNames[i],
+			"?0 \"Not A(Brand\";v=\"99\", \"Chromium\";v=\"121\"");
+	}
+	FIFTYONE_DEGREES_ARRAY_CREATE(fiftyoneDegreesHeaderPtr, data->iterateHeaders, 3);
+	for (int i = 0; i < 3; i++) {
+		data->iterateHeaders->items[i] = &data->headers->items[i * 2];
+		data->iterateHeaders->count++;
+	}
+
+	ResourceManagerInit(
+		&data->manager,
+		data,
+		&data->resourceHandle,
+		freeNothing);
+	createWkb(data->wkb);
+	data->json = createJsonValue();
+
+	// Large buffers with and without huge pages. Written so that every page
+	// is resident before the reads are measured.
+	data->large = (uint64_t*)MemoryLargeMalloc(LARGE_SIZE);
+	MemorySetHugePages(FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_RESERVED);
+	data->largeHuge = (uint64_t*)MemoryLargeMalloc(LARGE_SIZE);
+	MemorySetHugePages(FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE);
+	if (data->large == NULL || data->largeHuge == NULL) {
+		printf("Could not allocate large buffers.\n");
+		return false;
+	}
+	for (size_t i = 0; i < LARGE_SIZE / sizeof(uint64_t); i++) {
+		data->large[i] = i;
+		data->largeHuge[i] = i;
+	}
+	return data->memory != NULL && 
+		data->file != NULL &&
+		data->reuse != NULL &&
+		data->cached != NULL &&
+		data->headers != NULL;
+}
+
+static void freeData(benchmarkData *data) {
+	MemoryLargeFree(data->largeHuge);
+	MemoryLargeFree(data->large);
+	ResourceManagerFree(&data->manager);
+	free(data->json);
+	Free(data->iterateHeaders);
+	EvidenceFree(data->evidence);
+	HeadersFree(data->headers);
+	FIFTYONE_DEGREES_COLLECTION_FREE(data->stringsCollection);
+	free(data->strings);
+	free(data->stringOffsets);
+	FIFTYONE_DEGREES_COLLECTION_FREE(data->cached);
+	FIFTYONE_DEGREES_COLLECTION_FREE(data->reuse);
+	FIFTYONE_DEGREES_COLLECTION_FREE(data->file);
+	FIFTYONE_DEGREES_COLLECTION_FREE(data->memory);
+	FilePoolRelease(&data->filePool);
+	if (data->fileHandle != NULL) {
+		fclose(data->fileHandle);
+	}
+	FileDelete(COLLECTION_FILE);
+	free(data->integers);
+}
+
+static void runThread(void *state) {
+	benchmarkThread *thread = (benchmarkThread*)state;
+	thread->result = thread->benchmark->run(
+		thread->benchmark->state,
+		thread->iterations);
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_THREAD_EXIT;
+#endif
+}
+
+// Runs the benchmark with each of the threads performing the iterations and
+// returns the elapsed time in seconds.
+static double runThreads(
+	const benchmark *benchmark,
+	int threadCount,
+	long iterations) {
+	benchmarkThread states[THREAD_COUNT_LIMIT];
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_THREAD threads[THREAD_COUNT_LIMIT];
+#endif
+	for (int i = 0; i < threadCount; i++) {
+		states[i].benchmark = benchmark;
+		states[i].iterations = iterations;
+		states[i].result = 0;
+	}
+	double start = now();
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	for (int i = 0; i < threadCount; i++) {
+		FIFTYONE_DEGREES_THREAD_CREATE(
+			threads[i],
+			(FIFTYONE_DEGREES_THREAD_ROUTINE)&runThread,
+			&states[i]);
+	}
+	for (int i = 0; i < threadCount; i++) {
+		FIFTYONE_DEGREES_THREAD_JOIN(threads[i]);
+		FIFTYONE_DEGREES_THREAD_CLOSE(threads[i]);
+	}
+#else
+	runThread(&states[0]);
+#endif
+	double seconds = now() - start;
+	for (int i = 0; i < threadCount; i++) {
+		sink += states[i].result;
+	}
+	return seconds;
+}
+
+// Returns the number of iterations a single thread needs to perform to run
+// for approximately TARGET_SECONDS.
+static long calibrate(const benchmark *benchmark) {
+	long iterations = 1024;
+	double seconds = runThreads(benchmark, 1, iterations);
+	while (seconds < CALIBRATION_SECONDS) {
+		iterations *= 2;
+		seconds = runThreads(benchmark, 1, iterations);
+	}
+	return (long)(iterations * (TARGET_SECONDS / seconds)) + 1;
+}
+
+// Returns the number of data TLB read misses incurred by a single thread
+// running the benchmark for the number of iterations, or -1 if the counter is
+// not available on this platform or to this process.
+static long long tlbMisses(const benchmark *benchmark, long iterations) {
+#ifdef __linux__
+	long long count = -1;
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_DTLB |
+		(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+		(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	if (fd < 0) {
+		return -1;
+	}
+	ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	sink += benchmark->run(benchmark->state, iterations);
+	ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+		count = -1;
+	}
+	close(fd);
+	return count;
+#else
+	(void)benchmark;
+	(void)iterations;
+	return -1;
+#endif
+}
+
+// Returns the next number of threads to run a benchmark with, doubling each
+// time and ending with the maximum, or 0 if the maximum has been run.
+static int nextThreads(int threads, int maxThreads) {
+	if (threads >= maxThreads) {
+		return 0;
+	}
+	return threads * 2 < maxThreads ? threads * 2 : maxThreads;
+}
+
+/**
+ * Runs each benchmark with 1 thread, then doubling up to the maximum number
+ * of threads, printing the time per operation and the operations per second
+ * across all threads. If an output file is provided then the results are also
+ * written to it as JSON so that they can be compared between builds.
+ */
+void performance(const char *outFile, int maxThreads) {
+	benchmarkData data;
+	bool first = true;
+	FILE *file = NULL;
+	if (createData(&data, maxThreads) == false) {
+		freeData(&data);
+		return;
+	}
+	benchmark benchmarks[] = {
+		{ "CollectionGetMemory", runCollectionGetMemory, &data },
+		{ "CollectionGetFile", runCollectionGetFile, &data },
+		{ "CollectionGetFileReuse", runCollectionGetReuse, &data },
+		{ "CollectionGetCached", runCollectionGetCached, &data },
+		{ "CollectionBinarySearch", runCollectionBinarySearch, &data },
+		{ "EvidenceIterateForHeaders", runEvidenceIterateForHeaders, &data },
+		{ "HeaderGetIndex", runHeaderGetIndex, &data },
+		{ "IpAddressParse", runIpAddressParse, &data },
+		{ "ConvertWkbToWkt", runConvertWkbToWkt, &data },
+		{ "JsonPropertyValues", runJsonPropertyValues, &data },
+		{ "ResourceHandleIncDecUse", runResourceHandleUse, &data },
+		{ "LargeRead", runLargeRead, &data },
+		{ "LargeReadHugePages", runLargeReadHugePages, &data }
+	};
+	const int count = sizeof(benchmarks) / sizeof(benchmark);
+	if (outFile != NULL) {
+		file = fopen(outFile, "w");
+	}
+	if (file != NULL) {
+		fprintf(file, "{\n  \"benchmarks\": [");
+	}
+	printf("    %-28s %8s %12s %10s %16s %12s\n",
+		"benchmark", "threads", "iterations", "ns/op", "ops/s",
+		"dTLB miss/op");
+	for (int b = 0; b < count; b++) {
+		long iterations = calibrate(&benchmarks[b]);
+		long long misses = tlbMisses(&benchmarks[b], iterations);
+		double missesPerOp = misses < 0 ? -1 : (double)misses / iterations;
+		for (int threads = 1; threads > 0; threads = nextThreads(
+			threads,
+			maxThreads)) {
+			double best = 0;
+			for (int r = 0; r < REPEATS; r++) {
+				double seconds = runThreads(
+					&benchmarks[b],
+					threads,
+					iterations);
+				if (r == 0 || seconds < best) {
+					best = seconds;
+				}
+			}
+			double nsPerOp = best * 1.0e9 / iterations;
+			double opsPerSecond = (double)threads * iterations / best;
+			printf("    %-28s %8d %12ld %10.2f %16.0f ",
+				benchmarks[b].name,
+				threads,
+				iterations,
+				nsPerOp,
+				opsPerSecond);
+			if (threads == 1 && missesPerOp >= 0) {
+				printf("%12.4f\n", missesPerOp);
+			}
+			else {
+				printf("%12s\n", "n/a");
+			}
+			if (file != NULL) {
+				fprintf(file,
+					"%s\n    { \"name\": \"%s\", \"threads\": %d, "
+					"\"iterations\": %ld, \"nsPerOp\": %.2f, "
+					"\"opsPerSecond\": %.0f, \"tlbMissesPerOp\": %.4f }",
+					first ? "" : ",",
+					benchmarks[b].name,
+					threads,
+					iterations,
+					nsPerOp,
+					opsPerSecond,
+					threads == 1 ? missesPerOp : -1);
+				first = false;
+			}
+		}
+	}
+	if (file != NULL) {
+		fprintf(file, "\n  ]\n}");
+		fclose(file);
+	}
+	freeData(&data);
+}
+
+/**
+ * The main method used by the command line test routine. The first optional
+ * argument is the file to write the JSON results to, and the second the
+ * maximum number of threads.
+ */
+int main(int argc, char* argv[]) {
+	int maxThreads = THREAD_COUNT;
+	printf("\n");
+	printf("\t#############################################################\n");
+	printf("\t#                                                           #\n");
+	printf("\t#  This program can be used to test the performance of the  #\n");
+	printf("\t#    hot paths of the common library with 1 to N threads.   #\n");
+	printf("\t#                                                           #\n");
+	printf("\t#############################################################\n");
+	printf("\n");
+	if (argc > 2) {
+		maxThreads = atoi(argv[2]);
+		if (maxThreads < 1 || maxThreads > THREAD_COUNT_LIMIT) {
+			maxThreads = THREAD_COUNT;
+		}
+	}
+
+	// Run the performance tests.
+	performance(argc > 1 ? argv[1] : NULL, maxThreads);
+	return 0;
+}
@@ -0,0 +1,218 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../fiftyone.h"
+
+// Number of bytes of string values written for each test.
+#define TOTAL_BYTES (256 * 1024 * 1024)
+
+// Length of each string value. Must fit in the 16 bit size of the value.
+#define VALUE_LENGTH 4096
+
+// Size of the chunk passed to the writer by the string builder.
+#define CHUNK_SIZE 16384
+
+// Number of characters between characters which need escaping for each test.
+// Zero means no characters need escaping.
+static const int escapeIntervals[] = { 0, 1024, 64, 8 };
+
+// Writer which counts the characters written and discards them.
+static bool countWriter(void *state, const char *chars, size_t length) {
+	*(size_t*)state += length;
+	return true;
+}
+
+// Escapes the value one character at a time in the same way json.c did prior
+// to the fast path, to provide a baseline for comparison.
+static void addStringEscapeBaseline(
+	StringBuilder *builder,
+	const char *value,
+	size_t valueLength) {
+	for (size_t i = 0; i < valueLength; i++) {
+		switch (value[i]) {
+		case '\"':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, '\"');
+			break;
+		case '\b':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, 'b');
+			break;
+		case '\f':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, 'f');
+			break;
+		case '\n':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, 'n');
+			break;
+		case '\r':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, 'r');
+			break;
+		case '\t':
+			StringBuilderAddChar(builder, '\\');
+			StringBuilderAddChar(builder, 't');
+			break;
+		default:
+			StringBuilderAddChar(builder, value[i]);
+			break;
+		}
+	}
+}
+
+// Creates a string value of VALUE_LENGTH characters with a character that
+// needs escaping every interval characters.
+static StoredBinaryValue* createValue(int interval) {
+	StoredBinaryValue *value = (StoredBinaryValue*)malloc(
+		sizeof(int16_t) + VALUE_LENGTH + 1);
+	char *chars = &value->stringValue.value;
+	value->stringValue.size = VALUE_LENGTH + 1;
+	for (int i = 0; i < VALUE_LENGTH; i++) {
+		chars[i] = interval > 0 && i % interval == interval - 1 ?
+			'\n' :
+			(char)('a' + i % 26);
+	}
+	chars[VALUE_LENGTH] = '\0';
+	return value;
+}
+
+static double now() {
+#ifdef _MSC_VER
+	return (double)GetTickCount() / 1000;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1.0e9;
+#endif
+}
+
+// Returns the MB/s of string values escaped by the JSON methods.
+static double runJson(StoredBinaryValue *value, size_t *written) {
+	char *chunk = (char*)malloc(CHUNK_SIZE);
+	List values;
+	Item item;
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	StringBuilder builder = { chunk, CHUNK_SIZE };
+	Json json = { builder, NULL, NULL, &values, exception,
+		FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING };
+	ListInit(&values, 1);
+	DataReset(&item.data);
+	item.data.ptr = (byte*)value;
+	values.items[0] = item;
+	values.count = 1;
+	*written = 0;
+	StringBuilderInitWriter(&json.builder, countWriter, written);
+	double start = now();
+	for (int i = 0; i < TOTAL_BYTES / VALUE_LENGTH; i++) {
+		JsonPropertyValues(&json);
+	}
+	StringBuilderComplete(&json.builder);
+	double seconds = now() - start;
+	values.count = 0;
+	ListFree(&values);
+	free(chunk);
+	return TOTAL_BYTES / seconds / (1024 * 1024);
+}
+
+// Returns the MB/s of string values escaped by the baseline.
+static double runBaseline(StoredBinaryValue *value, size_t *written) {
+	char *chunk = (char*)malloc(CHUNK_SIZE);
+	StringBuilder builder = { chunk, CHUNK_SIZE };
+	*written = 0;
+	StringBuilderInitWriter(&builder, countWriter, written);
+	double start = now();
+	for (int i = 0; i < TOTAL_BYTES / VALUE_LENGTH; i++) {
+		StringBuilderAddChar(&builder, '\"');
+		addStringEscapeBaseline(
+			&builder,
+			&value->stringValue.value,
+			VALUE_LENGTH);
+		StringBuilderAddChar(&builder, '\"');
+	}
+	StringBuilderComplete(&builder);
+	double seconds = now() - start;
+	free(chunk);
+	return TOTAL_BYTES / seconds / (1024 * 1024);
+}
+
+/**
+ * Compares the throughput of JSON string escaping with the character at a
+ * time baseline for values with different densities of characters that need
+ * escaping.
+ */
+void performance(const char *outFile) {
+	size_t jsonWritten, baselineWritten;
+	const int count = sizeof(escapeIntervals) / sizeof(int);
+	FILE *file = outFile != NULL ? fopen(outFile, "w") : NULL;
+	if (file != NULL) {
+		fprintf(file, "{\n");
+	}
+	printf("    %8s %12s %12s %8s\n", "interval", "base MB/s", "json MB/s", "ratio");
+	for (int i = 0; i < count; i++) {
+		StoredBinaryValue *value = createValue(escapeIntervals[i]);
+		double baseline = runBaseline(value, &baselineWritten);
+		double json = runJson(value, &jsonWritten);
+		if (baselineWritten != jsonWritten) {
+			printf("Output differs for interval %d\n", escapeIntervals[i]);
+		}
+		printf("    %8d %12.1f %12.1f %8.2f\n",
+			escapeIntervals[i],
+			baseline,
+			json,
+			json / baseline);
+		if (file != NULL) {
+			fprintf(file, "  \"EscapeMBs%d\": %.1f%s\n",
+				escapeIntervals[i],
+				json,
+				i + 1 < count ? "," : "");
+		}
+		free(value);
+	}
+	if (file != NULL) {
+		fprintf(file, "}");
+		fclose(file);
+	}
+}
+
+/**
+ * The main method used by the command line test routine.
+ */
+int main(int argc, char* argv[]) {
+	printf("\n");
+	printf("\t#############################################################\n");
+	printf("\t#                                                           #\n");
+	printf("\t#  This program can be used to test the performance of the  #\n");
+	printf("\t#          escaping of string values in JSON output.        #\n");
+	printf("\t#                                                           #\n");
+	printf("\t#############################################################\n");
+	printf("\n");
+
+	// Run the performance tests.
+	performance(argc > 1 ? argv[1] : NULL);
+	return 0;
+}
@@ -0,0 +1,205 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../profile.h"
+#include "../fiftyone.h"
+
+// Number of searches performed for each profile size.
+#define SEARCHES 4000000
+
+// Number of properties the value indexes of each profile are spread across.
+#define PROPERTIES 8
+
+// Number of profiles generated for each size so searches do not always hit
+// the same memory.
+#define PROFILES 256
+
+// Value counts typical of profiles in device detection data sets.
+static const uint32_t valueCounts[] = { 8, 32, 64, 128, 256, 512, 1024 };
+
+static int compareValueToProperty(const void *p, const void *v) {
+	Property *property = (Property*)p;
+	uint32_t valueIndex = *(uint32_t*)v;
+	if (valueIndex < property->firstValueIndex) {
+		return 1;
+	}
+	if (valueIndex > property->lastValueIndex) {
+		return -1;
+	}
+	return 0;
+}
+
+// Search used prior to ProfileGetValueRange. A bsearch finds any value for
+// the property, then the values before and after it are walked.
+static uint32_t bsearchRange(Profile *profile, Property *property) {
+	uint32_t *values = (uint32_t*)(profile + 1);
+	uint32_t *first = (uint32_t*)bsearch(
+		property,
+		values,
+		profile->valueCount,
+		sizeof(uint32_t),
+		compareValueToProperty);
+	uint32_t *last;
+	if (first == NULL) {
+		return 0;
+	}
+	while (first > values && *(first - 1) >= property->firstValueIndex) {
+		first--;
+	}
+	last = first;
+	while (last < values + profile->valueCount &&
+		*last <= property->lastValueIndex) {
+		last++;
+	}
+	return (uint32_t)(last - first);
+}
+
+static uint32_t lowerBoundRange(Profile *profile, Property *property) {
+	uint32_t first, last;
+	return ProfileGetValueRange(profile, property, &first, &last);
+}
+
+// Creates profiles with valueCount values spread across the properties, 
+// which are also initialised.
+static Profile** createProfiles(uint32_t valueCount, Property *properties) {
+	uint32_t perProperty = valueCount / PROPERTIES * 4;
+	Profile **profiles = (Profile**)malloc(sizeof(Profile*) * PROFILES);
+	for (uint32_t p = 0; p < PROPERTIES; p++) {
+		*(uint32_t*)&properties[p].firstValueIndex = p * perProperty;
+		*(uint32_t*)&properties[p].lastValueIndex = (p + 1) * perProperty - 1;
+	}
+	for (uint32_t i = 0; i < PROFILES; i++) {
+		Profile *profile = (Profile*)malloc(
+			sizeof(Profile) + sizeof(uint32_t) * valueCount);
+		uint32_t *values = (uint32_t*)(profile + 1);
+		uint32_t next = rand() % 4;
+		*(uint32_t*)&profile->valueCount = valueCount;
+		for (uint32_t v = 0; v < valueCount; v++) {
+			values[v] = next;
+			next += 1 + rand() % 7;
+		}
+		profiles[i] = profile;
+	}
+	return profiles;
+}
+
+static void freeProfiles(Profile **profiles) {
+	for (uint32_t i = 0; i < PROFILES; i++) {
+		free(profiles[i]);
+	}
+	free(profiles);
+}
+
+static double now() {
+#ifdef _MSC_VER
+	return (double)GetTickCount() / 1000;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1.0e9;
+#endif
+}
+
+// Returns the average nanoseconds per search using the method provided.
+static double run(
+	uint32_t(*method)(Profile*, Property*),
+	Profile **profiles,
+	Property *properties,
+	uint32_t *checksum) {
+	uint32_t total = 0;
+	double start = now();
+	for (uint32_t i = 0; i < SEARCHES; i++) {
+		total += method(
+			profiles[i % PROFILES],
+			&properties[(i / PROFILES) % PROPERTIES]);
+	}
+	*checksum = total;
+	return (now() - start) * 1e9 / SEARCHES;
+}
+
+/**
+ * Compares the time to find the range of values for a property in profiles
+ * of different sizes using bsearch and the branch free lower bound.
+ */
+void performance(const char *outFile) {
+	Property properties[PROPERTIES];
+	uint32_t bsearchChecksum, lowerBoundChecksum;
+	FILE *file = outFile != NULL ? fopen(outFile, "w") : NULL;
+	if (file != NULL) {
+		fprintf(file, "{\n");
+	}
+	printf("    %8s %12s %12s %8s\n", "values", "bsearch ns", "range ns", "ratio");
+	for (uint32_t i = 0; i < sizeof(valueCounts) / sizeof(uint32_t); i++) {
+		Profile **profiles = createProfiles(valueCounts[i], properties);
+		double bsearchTime = run(
+			bsearchRange,
+			profiles,
+			properties,
+			&bsearchChecksum);
+		double lowerBoundTime = run(
+			lowerBoundRange,
+			profiles,
+			properties,
+			&lowerBoundChecksum);
+		if (bsearchChecksum != lowerBoundChecksum) {
+			printf("Results differ for %d values\n", valueCounts[i]);
+		}
+		printf("    %8d %12.2f %12.2f %8.2f\n",
+			valueCounts[i],
+			bsearchTime,
+			lowerBoundTime,
+			bsearchTime / lowerBoundTime);
+		if (file != NULL) {
+			fprintf(file, "  \"RangeNs%d\": %.2f%s\n",
+				valueCounts[i],
+				lowerBoundTime,
+				i + 1 < sizeof(valueCounts) / sizeof(uint32_t) ? "," : "");
+		}
+		freeProfiles(profiles);
+	}
+	if (file != NULL) {
+		fprintf(file, "}");
+		fclose(file);
+	}
+}
+
+/**
+ * The main method used by the command line test routine.
+ */
+int main(int argc, char* argv[]) {
+	printf("\n");
+	printf("\t#############################################################\n");
+	printf("\t#                                                           #\n");
+	printf("\t#  This program can be used to test the performance of the  #\n");
+	printf("\t#      search for the values of a property in a profile.    #\n");
+	printf("\t#                                                           #\n");
+	printf("\t#############################################################\n");
+	printf("\n");
+
+	// Run the performance tests.
+	performance(argc > 1 ? argv[1] : NULL);
+	return 0;
+}
@@ -140,54 +140,79 @@ static int compareProfileIdIndirect(
 #endif
 }
 
-static int compareValueToProperty(const void *p, const void *v) {
-	Property *property = (Property*)p;
-	uint32_t valueIndex = *(uint32_t*)v;
-	if (valueIndex < property->firstValueIndex) {
-		return 1;
+// Arrays of value indexes at or below this length are searched by counting
+// the entries less than the key. The loop has no data dependent branches and
+// is vectorised by the compiler.
+#define LINEAR_SEARCH_MAX 16
+
+uint32_t fiftyoneDegreesProfileValueIndexesLowerBound(
+	const uint32_t *valueIndexes,
+	uint32_t count,
+	uint32_t valueIndex) {
+	const uint32_t *base = valueIndexes;
+	uint32_t length = count, result = 0, half;
+
+	// Halve the range without branching on the comparison until the linear
+	// search is faster.
+	while (length > LINEAR_SEARCH_MAX) {
+		half = length / 2;
+		base += (base[half - 1] < valueIndex) ? half : 0;
+		length -= half;
 	}
-	if (valueIndex > property->lastValueIndex) {
-		return -1;
+
+	// Count the remaining entries that are less than the value index.
+	for (uint32_t i = 0; i < length; i++) {
+		result += base[i] < valueIndex;
 	}
-	return 0;
+	return (uint32_t)(base - valueIndexes) + result;
 }
 
-static uint32_t* getFirstValueForProfileAndProperty(
+uint32_t fiftyoneDegreesProfileGetValueRange(
 	const fiftyoneDegreesProfile *profile,
-	const fiftyoneDegreesProperty *property) {
-
-	// Search to find a value that is equal to or between the first and last
-	// value indexes for the property.
-	uint32_t *valueIndex = (uint32_t*)bsearch(
-		property,
-		profile + 1,
-		profile->valueCount,
-		sizeof(uint32_t),
-		compareValueToProperty);
-
-	if (valueIndex != NULL) {
-
-		// Move back through the values until the first one for the property is 
-		// found.
-		while ((void*)valueIndex > (void*)(profile + 1) &&
-			*(valueIndex - 1) >= property->firstValueIndex) {
-			valueIndex--;
+	const fiftyoneDegreesProperty *property,
+	uint32_t *first,
+	uint32_t *last) {
+	const uint32_t *valueIndexes = (const uint32_t*)(profile + 1);
+
+	// Short arrays are counted for both bounds in a single pass.
+	if (profile->valueCount <= LINEAR_SEARCH_MAX) {
+		uint32_t before = 0, upTo = 0;
+		for (uint32_t i = 0; i < profile->valueCount; i++) {
+			before += valueIndexes[i] < property->firstValueIndex;
+			upTo += valueIndexes[i] <= property->lastValueIndex;
 		}
+		*first = before;
+		*last = upTo;
+		return upTo - before;
 	}
-
-	return valueIndex;
+	*first = ProfileValueIndexesLowerBound(
+		valueIndexes,
+		profile->valueCount,
+		property->firstValueIndex);
+	if (property->lastValueIndex == UINT32_MAX) {
+		*last = profile->valueCount;
+	}
+	else {
+		*last = *first + ProfileValueIndexesLowerBound(
+			valueIndexes + *first,
+			profile->valueCount - *first,
+			property->lastValueIndex + 1);
+	}
+	return *last - *first;
 }
 
 /**
  * Starting at the value index pointed to by valIndexPtr iterates over the 
- * value indexes checking that they relate to the property. maxValIndexPtr is
- * used to prevent overrunning the memory used for values associated with the 
- * profile. The value items are passed to the callback method which is 
- * responsible for freeing these items.
+ * value indexes checking that they are not greater than lastValueIndex, the
+ * last value index of the property. maxValIndexPtr is used to prevent
+ * overrunning the memory used for values associated with the profile. Where
+ * the caller already knows the slice of value indexes for the property
+ * UINT32_MAX is provided so that no check is performed. The value items are
+ * passed to the callback method which is responsible for freeing these items.
  */
 static uint32_t iterateValues(
 	const Collection *values,
-	const Property *property,
+	uint32_t lastValueIndex,
 	void *state,
 	ProfileIterateMethod callback,
 	const uint32_t *valIndexPtr,
@@ -206,7 +231,7 @@ static uint32_t iterateValues(
 		// Check that the value index could relate to the property. Saves 
 		// having to retrieve the value item if it will never relate to the
 		// property.
-        *valIndexPtr <= property->lastValueIndex &&
+        *valIndexPtr <= lastValueIndex &&
 		EXCEPTION_OKAY) {
 
 		// Reset the items as they should never share the same memory.
@@ -460,18 +485,17 @@ uint32_t fiftyoneDegreesProfileIterateValuesForProperty(
 	void *state,
 	fiftyoneDegreesProfileIterateMethod callback,
 	fiftyoneDegreesException *exception) {
-	uint32_t *firstValueIndex  = getFirstValueForProfileAndProperty(
-		profile, 
-		property);
+	uint32_t first, last;
 	uint32_t count = 0;
-	if (firstValueIndex != NULL) {
+	if (ProfileGetValueRange(profile, property, &first, &last) > 0) {
+		// The range only contains values for the property.
 		count = iterateValues(
 			values, 
-			property, 
+			UINT32_MAX, 
 			state, 
 			callback, 
-			firstValueIndex,
-			((uint32_t*)(profile + 1)) + profile->valueCount,
+			((uint32_t*)(profile + 1)) + first,
+			((uint32_t*)(profile + 1)) + last,
 			exception);
 	}
 	return count;
@@ -501,19 +525,37 @@ uint32_t fiftyoneDegreesProfileIterateValuesForPropertyWithIndex(
 	EXCEPTION_SET(NOT_IMPLEMENTED);
 	return 0;
 #else
-	uint32_t i = IndicesPropertyProfileLookup(
-		index,
-		profile->profileId,
-		availablePropertyIndex);
-	if (i < profile->valueCount) {
+	uint32_t i, end = profile->valueCount;
+	uint32_t lastValueIndex = property->lastValueIndex;
+	if (index->valueEnds != NULL) {
+		// The index records the slice of values for the property so the
+		// iteration is bounded without checking each value.
+		lastValueIndex = UINT32_MAX;
+		i = IndicesPropertyProfileLookupRange(
+			index,
+			profile->profileId,
+			(const uint32_t*)(profile + 1),
+			profile->valueCount,
+			availablePropertyIndex,
+			&end);
+	}
+	else {
+		i = IndicesPropertyProfileLookupForValues(
+			index,
+			profile->profileId,
+			(const uint32_t*)(profile + 1),
+			profile->valueCount,
+			availablePropertyIndex);
+	}
+	if (i < profile->valueCount && end <= profile->valueCount) {
 		uint32_t* firstValueIndex = (uint32_t*)(profile + 1) + i;
 		return iterateValues(
 			values,
-			property,
+			lastValueIndex,
 			state,
 			callback,
 			firstValueIndex,
-			((uint32_t*)(profile + 1)) + profile->valueCount,
+			((uint32_t*)(profile + 1)) + end,
 			exception);
 	}
 	return 0;
@@ -595,7 +637,7 @@ uint32_t fiftyoneDegreesProfileIterateProfilesForPropertyWithTypeAndValueAndOffs
 	fiftyoneDegreesException * const exception) {
 	uint32_t i, count = 0;
 	Item propertyItem, offsetItem, profileItem;
-	uint32_t *profileValueIndex, *maxProfileValueIndex;
+	uint32_t *profileValueIndex, valuePosition;
 	const Property *property;
 	Profile *profile;
 	DataReset(&propertyItem.data);
@@ -646,23 +688,16 @@ uint32_t fiftyoneDegreesProfileIterateProfilesForPropertyWithTypeAndValueAndOffs
 						&profileItem,
 						exception);
 					if (profile != NULL && EXCEPTION_OKAY) {
-						profileValueIndex = getFirstValueForProfileAndProperty(
-							profile,
-							property);
-						if (profileValueIndex != NULL) {
-							maxProfileValueIndex = ((uint32_t*)(profile + 1)) +
-								profile->valueCount;
-							while (*profileValueIndex <=
-								property->lastValueIndex &&
-								profileValueIndex < maxProfileValueIndex) {
-								if ((uint32_t)valueIndex ==
-									*profileValueIndex) {
-									callback(state, &profileItem);
-									count++;
-									break;
-								}
-								profileValueIndex++;
-							}
+						profileValueIndex = (uint32_t*)(profile + 1);
+						valuePosition = ProfileValueIndexesLowerBound(
+							profileValueIndex,
+							profile->valueCount,
+							(uint32_t)valueIndex);
+						if (valuePosition < profile->valueCount &&
+							profileValueIndex[valuePosition] ==
+							(uint32_t)valueIndex) {
+							callback(state, &profileItem);
+							count++;
 						}
 						COLLECTION_RELEASE(profiles, &profileItem);
 					}
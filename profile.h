@@ -263,6 +263,37 @@ EXTERNAL uint32_t fiftyoneDegreesProfileIterateValuesForProperty(
 	fiftyoneDegreesProfileIterateMethod callback,
 	fiftyoneDegreesException *exception);
 
+/**
+ * Returns the position of the first entry in the ascending array of value
+ * indexes which is not less than the value index provided, or count if all
+ * the entries are less. The search avoids data dependent branches so that
+ * performance is consistent for the short arrays associated with profiles.
+ * @param valueIndexes ascending array of value indexes
+ * @param count number of entries in valueIndexes
+ * @param valueIndex to search for
+ * @return position of the lower bound of the value index
+ */
+EXTERNAL uint32_t fiftyoneDegreesProfileValueIndexesLowerBound(
+	const uint32_t *valueIndexes,
+	uint32_t count,
+	uint32_t valueIndex);
+
+/**
+ * Gets the range of positions in the value indexes which follow the profile
+ * that relate to the property provided. The range is [first, last) and is
+ * empty if the profile has no values for the property.
+ * @param profile pointer to the profile
+ * @param property the values must relate to
+ * @param first set to the position of the first value for the property
+ * @param last set to the position after the last value for the property
+ * @return the number of values for the property in the profile
+ */
+EXTERNAL uint32_t fiftyoneDegreesProfileGetValueRange(
+	const fiftyoneDegreesProfile *profile,
+	const fiftyoneDegreesProperty *property,
+	uint32_t *first,
+	uint32_t *last);
+
 /**
  * Iterate over all values contained in the profile which relate to the
  * specified property and profile, calling the callback method for each.
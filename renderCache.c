@@ -0,0 +1,259 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "renderCache.h"
+
+#include "fiftyone.h"
+
+// Reads the entry in a slot ensuring the entry written before it was 
+// published is visible.
+#if defined(FIFTYONE_DEGREES_NO_THREADING)
+#define SLOT_GET(s) (s)
+#elif defined(_MSC_VER)
+#define SLOT_GET(s) (RenderCacheEntry*)InterlockedCompareExchangePointer( \
+	(PVOID volatile*)&(s), \
+	NULL, \
+	NULL)
+#else
+#define SLOT_GET(s) __atomic_load_n(&(s), __ATOMIC_ACQUIRE)
+#endif
+
+// Forms the key from the profile id and required property index.
+static uint64_t getKey(uint32_t profileId, uint32_t requiredPropertyIndex) {
+	return ((uint64_t)profileId << 32) | requiredPropertyIndex;
+}
+
+// Mixes the bits of the key so that consecutive profile ids and property 
+// indexes are spread across the slots.
+static uint32_t getSlot(RenderCache* cache, uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	return (uint32_t)key & cache->mask;
+}
+
+// Reserves space for a new entry returning false if the cache is full.
+static bool reserve(RenderCache* cache) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	if (INTERLOCK_INC(&cache->count) > (long)cache->capacity) {
+		INTERLOCK_DEC(&cache->count);
+		return false;
+	}
+	return true;
+#else
+	if (cache->count >= (long)cache->capacity) {
+		return false;
+	}
+	cache->count++;
+	return true;
+#endif
+}
+
+// Returns space reserved for an entry that was not added.
+static void unreserve(RenderCache* cache) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	INTERLOCK_DEC(&cache->count);
+#else
+	cache->count--;
+#endif
+}
+
+// Publishes the entry in the slot if the slot is empty returning the entry
+// now in the slot.
+static RenderCacheEntry* publish(
+	RenderCacheEntry* volatile* slot,
+	RenderCacheEntry* entry) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	RenderCacheEntry* previous = (RenderCacheEntry*)INTERLOCK_EXCHANGE_PTR(
+		*slot,
+		entry,
+		NULL);
+	return previous == NULL ? entry : previous;
+#else
+	if (*slot == NULL) {
+		*slot = entry;
+	}
+	return *slot;
+#endif
+}
+
+static RenderCache* createCache(
+	uint32_t slots,
+	uint32_t capacity,
+	uint32_t maxLength) {
+	RenderCache* cache = (RenderCache*)Malloc(sizeof(RenderCache));
+	if (cache == NULL) {
+		return NULL;
+	}
+	cache->slots = (RenderCacheEntry* volatile*)Malloc(
+		sizeof(RenderCacheEntry*) * slots);
+	if (cache->slots == NULL) {
+		Free(cache);
+		return NULL;
+	}
+	memset((void*)cache->slots, 0, sizeof(RenderCacheEntry*) * slots);
+	cache->mask = slots - 1;
+	cache->capacity = capacity;
+	cache->maxLength = maxLength;
+	cache->count = 0;
+	return cache;
+}
+
+fiftyoneDegreesRenderCache* fiftyoneDegreesRenderCacheCreate(
+	uint32_t capacity,
+	uint32_t maxLength) {
+	uint32_t slots = 2;
+	if (capacity == 0 || capacity > UINT32_MAX / 4) {
+		return NULL;
+	}
+	while (slots < capacity * 2) {
+		slots <<= 1;
+	}
+	MemoryTag tag = MemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_CACHES);
+	RenderCache* cache = createCache(slots, capacity, maxLength);
+	MemoryAccountingSetTag(tag);
+	return cache;
+}
+
+void fiftyoneDegreesRenderCacheFree(fiftyoneDegreesRenderCache* cache) {
+	if (cache == NULL) {
+		return;
+	}
+	for (uint32_t i = 0; i <= cache->mask; i++) {
+		if (cache->slots[i] != NULL) {
+			Free(cache->slots[i]);
+		}
+	}
+	Free((void*)cache->slots);
+	Free(cache);
+}
+
+const fiftyoneDegreesRenderCacheEntry* fiftyoneDegreesRenderCacheGet(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex) {
+	RenderCacheEntry* entry;
+	uint64_t key = getKey(profileId, requiredPropertyIndex);
+	uint32_t i = getSlot(cache, key);
+	while ((entry = SLOT_GET(cache->slots[i])) != NULL) {
+		if (entry->key == key) {
+			return entry;
+		}
+		i = (i + 1) & cache->mask;
+	}
+	return NULL;
+}
+
+bool fiftyoneDegreesRenderCacheIsFull(fiftyoneDegreesRenderCache* cache) {
+	return cache->count >= (long)cache->capacity;
+}
+
+// Adds the entry for the profile and property with the characters provided,
+// or returns the existing entry if there is one. length is the value stored
+// in the entry which may be the too long marker.
+static const RenderCacheEntry* add(
+	RenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex,
+	const char* value,
+	size_t valueLength,
+	uint32_t length) {
+	RenderCacheEntry *entry, *current;
+	uint64_t key = getKey(profileId, requiredPropertyIndex);
+	uint32_t i = getSlot(cache, key);
+
+	// Return any existing entry without using a reservation.
+	current = (RenderCacheEntry*)RenderCacheGet(
+		cache,
+		profileId,
+		requiredPropertyIndex);
+	if (current != NULL) {
+		return current;
+	}
+	if (reserve(cache) == false) {
+		return NULL;
+	}
+
+	// Create the entry with the string following it.
+	MemoryTag tag = MemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_CACHES);
+	entry = (RenderCacheEntry*)Malloc(
+		sizeof(RenderCacheEntry) + valueLength + 1);
+	MemoryAccountingSetTag(tag);
+	if (entry == NULL) {
+		unreserve(cache);
+		return NULL;
+	}
+	entry->key = key;
+	entry->length = length;
+	memcpy((char*)(entry + 1), value, valueLength);
+	((char*)(entry + 1))[valueLength] = '\0';
+
+	// Publish the entry in the first empty slot unless another thread adds
+	// the same key first. As the number of slots is at least twice the
+	// capacity an empty slot will always be found.
+	while (true) {
+		current = SLOT_GET(cache->slots[i]);
+		if (current == NULL) {
+			current = publish(&cache->slots[i], entry);
+		}
+		if (current == entry) {
+			return entry;
+		}
+		if (current->key == key) {
+			Free(entry);
+			unreserve(cache);
+			return current;
+		}
+		i = (i + 1) & cache->mask;
+	}
+}
+
+const fiftyoneDegreesRenderCacheEntry* fiftyoneDegreesRenderCacheAdd(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex,
+	const char* value,
+	size_t length) {
+	if (length > cache->maxLength) {
+		return NULL;
+	}
+	return add(
+		cache,
+		profileId,
+		requiredPropertyIndex,
+		value,
+		length,
+		(uint32_t)length);
+}
+
+const fiftyoneDegreesRenderCacheEntry* fiftyoneDegreesRenderCacheAddTooLong(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex) {
+	return add(
+		cache,
+		profileId,
+		requiredPropertyIndex,
+		"",
+		0,
+		FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG);
+}
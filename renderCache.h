@@ -0,0 +1,202 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_RENDER_CACHE_H_INCLUDED
+#define FIFTYONE_DEGREES_RENDER_CACHE_H_INCLUDED
+
+/**
+ * @ingroup FiftyOneDegreesCommon
+ * @defgroup FiftyOneDegreesRenderCache Render Cache
+ *
+ * Bounded cache of the string representations of property values.
+ *
+ * ## Introduction
+ *
+ * Rendering the values of a property for a profile as a string involves
+ * retrieving each value from the values collection, converting any typed
+ * value to text, and joining multiple values with a separator. The same
+ * profile and property combinations are rendered repeatedly, so the render
+ * cache stores the rendered string keyed by the profile id and the required
+ * property index.
+ *
+ * ## Lifetime
+ *
+ * Entries are never evicted or modified once added. A pointer to an entry, 
+ * and the string which follows it, remains valid until the cache is freed.
+ * The cache is owned by the data set and freed with it, so a consumer holding
+ * a reference to the data set can use the strings without copying them. When
+ * the data set is replaced the new data set starts with an empty cache.
+ *
+ * ## Bounds
+ *
+ * The cache holds at most the number of entries it was created with. Strings
+ * longer than the maximum length, and strings added once the cache is full,
+ * are not cached and the caller must render them itself. A caller which can
+ * only find the length by rendering the string can record that it is too
+ * long so that it renders the string directly next time.
+ *
+ * ## Concurrency
+ *
+ * Get does not take any locks. Add publishes new entries using a compare and
+ * swap so that concurrent adds for the same key result in a single entry.
+ *
+ * @{
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 5105) 
+#include <windows.h>
+#pragma warning (default: 5105) 
+#pragma warning (pop)
+#endif
+#include "threading.h"
+#include "common.h"
+
+/**
+ * Default maximum length of a string held in the render cache.
+ */
+#define FIFTYONE_DEGREES_RENDER_CACHE_MAX_LENGTH_DEFAULT 1024
+
+/**
+ * Length of an entry which records that the string for the key is longer than
+ * the maximum length, see #fiftyoneDegreesRenderCacheAddTooLong.
+ */
+#define FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG UINT32_MAX
+
+/**
+ * Returns a pointer to the null terminated string which follows the entry.
+ * @param e pointer to a #fiftyoneDegreesRenderCacheEntry
+ */
+#define FIFTYONE_DEGREES_RENDER_CACHE_VALUE(e) ((const char*)((e) + 1))
+
+/**
+ * Entry in the render cache. Followed immediately by the rendered string and
+ * a null terminator.
+ */
+typedef struct fiftyone_degrees_render_cache_entry_t {
+	uint64_t key; /**< Profile id and required property index */
+	uint32_t length; /**< Number of characters excluding the terminator */
+} fiftyoneDegreesRenderCacheEntry;
+
+/**
+ * Open addressing hash table of render cache entries. The number of slots is
+ * a power of two at least twice the capacity so that a probe always reaches
+ * an empty slot.
+ */
+typedef struct fiftyone_degrees_render_cache_t {
+	fiftyoneDegreesRenderCacheEntry* volatile* slots; /**< Hash table */
+	uint32_t mask; /**< Number of slots minus one */
+	uint32_t capacity; /**< Maximum number of entries */
+	uint32_t maxLength; /**< Maximum length of a cached string */
+	volatile long count; /**< Number of entries added, or reserved */
+} fiftyoneDegreesRenderCache;
+
+/**
+ * Creates a new render cache which must be freed with 
+ * #fiftyoneDegreesRenderCacheFree.
+ * @param capacity maximum number of entries the cache will hold
+ * @param maxLength maximum length of a string that will be cached
+ * @return pointer to the new cache, or NULL if the capacity is zero or there
+ * is insufficient memory
+ */
+EXTERNAL fiftyoneDegreesRenderCache* fiftyoneDegreesRenderCacheCreate(
+	uint32_t capacity,
+	uint32_t maxLength);
+
+/**
+ * Frees the cache and all the entries. Any pointers returned from the cache
+ * are invalid after this call.
+ * @param cache to free, or NULL
+ */
+EXTERNAL void fiftyoneDegreesRenderCacheFree(
+	fiftyoneDegreesRenderCache* cache);
+
+/**
+ * Gets the rendered string for the profile and property if present.
+ * @param cache to get the entry from
+ * @param profileId of the profile the string was rendered from
+ * @param requiredPropertyIndex of the property the string was rendered for
+ * @return pointer to the entry, or NULL if not in the cache
+ */
+EXTERNAL const fiftyoneDegreesRenderCacheEntry* fiftyoneDegreesRenderCacheGet(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex);
+
+/**
+ * Adds the rendered string for the profile and property. If another thread
+ * has already added the key then the existing entry is returned and the 
+ * value provided is ignored.
+ * @param cache to add the entry to
+ * @param profileId of the profile the string was rendered from
+ * @param requiredPropertyIndex of the property the string was rendered for
+ * @param value characters of the rendered string which need not be null
+ * terminated
+ * @param length number of characters in value
+ * @return pointer to the entry for the key, or NULL if the string could not
+ * be cached because it is too long, the cache is full, or there is 
+ * insufficient memory
+ */
+EXTERNAL const fiftyoneDegreesRenderCacheEntry* fiftyoneDegreesRenderCacheAdd(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex,
+	const char* value,
+	size_t length);
+
+/**
+ * Records that the string for the profile and property is longer than the
+ * maximum length so that a later get returns an entry with a length of
+ * #FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG and an empty string. The entry uses
+ * the capacity of the cache like any other. If the key has already been added
+ * then the existing entry is returned.
+ * @param cache to add the entry to
+ * @param profileId of the profile the string was rendered from
+ * @param requiredPropertyIndex of the property the string was rendered for
+ * @return pointer to the entry for the key, or NULL if the cache is full or
+ * there is insufficient memory
+ */
+EXTERNAL const fiftyoneDegreesRenderCacheEntry*
+fiftyoneDegreesRenderCacheAddTooLong(
+	fiftyoneDegreesRenderCache* cache,
+	uint32_t profileId,
+	uint32_t requiredPropertyIndex);
+
+/**
+ * Returns true if the cache holds as many entries as its capacity, in which
+ * case no more strings will be added. Callers can use this to avoid rendering
+ * a string into separate memory to add it.
+ * @param cache to check
+ * @return true if the cache is full, otherwise false
+ */
+EXTERNAL bool fiftyoneDegreesRenderCacheIsFull(
+	fiftyoneDegreesRenderCache* cache);
+
+/**
+ * @}
+ */
+
+#endif
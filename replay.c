@@ -0,0 +1,260 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "replay.h"
+#include "fiftyone.h"
+#include <time.h>
+
+// Latencies below this value are recorded in their own bucket.
+#define LINEAR_BUCKETS 64
+
+// Number of bits of precision for latencies above the linear buckets.
+#define SUB_BUCKET_BITS 5
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+
+// Bit index of the most significant bit of the first latency which is not
+// recorded in a linear bucket.
+#define FIRST_LOG_BIT 6
+
+// Total number of buckets needed to record any 64 bit latency.
+#define BUCKETS (LINEAR_BUCKETS + (64 - FIRST_LOG_BIT) * SUB_BUCKETS)
+
+typedef struct replay_shared_t {
+	const EvidenceFile *file; // Records being replayed
+	uint64_t total; // Number of records to process across all passes
+	volatile int64_t next; // Number of records taken by the threads
+	void *state; // State passed to the method
+	ReplayMethod method; // Method to call for each record
+} replayShared;
+
+typedef struct replay_thread_t {
+	replayShared *shared; // State shared between all the threads
+	uint16_t index; // Index of the thread
+	uint64_t *buckets; // Histogram of latencies for the thread
+	uint64_t minimum; // Lowest latency recorded by the thread
+	uint64_t maximum; // Highest latency recorded by the thread
+} replayThread;
+
+// Returns the current time in nanoseconds.
+static uint64_t now() {
+	struct timespec time;
+#ifdef _MSC_VER
+	timespec_get(&time, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &time);
+#endif
+	return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+// Returns the index of the histogram bucket for the latency.
+static int getBucket(uint64_t latency) {
+	int bit = FIRST_LOG_BIT;
+	if (latency < LINEAR_BUCKETS) {
+		return (int)latency;
+	}
+	while (bit < 63 && (latency >> (bit + 1)) != 0) {
+		bit++;
+	}
+	return LINEAR_BUCKETS +
+		(bit - FIRST_LOG_BIT) * SUB_BUCKETS +
+		(int)((latency >> (bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+}
+
+// Returns the lowest latency which is recorded in the bucket.
+static uint64_t getLatency(int bucket) {
+	if (bucket < LINEAR_BUCKETS) {
+		return (uint64_t)bucket;
+	}
+	int bit = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + FIRST_LOG_BIT;
+	uint64_t sub = (uint64_t)((bucket - LINEAR_BUCKETS) % SUB_BUCKETS);
+	return (SUB_BUCKETS + sub) << (bit - SUB_BUCKET_BITS);
+}
+
+// Returns the latency which the percentage of records did not exceed.
+static uint64_t getPercentile(
+	const uint64_t *buckets,
+	uint64_t count,
+	double percentile,
+	uint64_t maximum) {
+	uint64_t rank = (uint64_t)(count * percentile);
+	uint64_t total = 0;
+	if (rank < count) {
+		rank++;
+	}
+	for (int i = 0; i < BUCKETS; i++) {
+		total += buckets[i];
+		if (total >= rank) {
+			uint64_t latency = getLatency(i);
+			return latency < maximum ? latency : maximum;
+		}
+	}
+	return maximum;
+}
+
+static void runThread(replayThread *thread) {
+	replayShared *shared = thread->shared;
+	const EvidenceFile *file = shared->file;
+	int64_t index;
+	while ((index = FIFTYONE_DEGREES_INTERLOCK_ADD_64(
+		&shared->next, 1) - 1) < (int64_t)shared->total) {
+		EvidenceKeyValuePairArray *record =
+			&file->records[(uint64_t)index % file->count];
+		uint64_t start = now();
+		shared->method(shared->state, thread->index, record);
+		uint64_t latency = now() - start;
+		thread->buckets[getBucket(latency)]++;
+		if (latency < thread->minimum) {
+			thread->minimum = latency;
+		}
+		if (latency > thread->maximum) {
+			thread->maximum = latency;
+		}
+	}
+}
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+static void* runThreadRoutine(void *state) {
+	runThread((replayThread*)state);
+
+	// Add any memory accounted to the thread before it exits.
+	MemoryAccountingFlush();
+	FIFTYONE_DEGREES_THREAD_EXIT;
+	return NULL;
+}
+#endif
+
+// Runs all the threads returning when they have all completed.
+static StatusCode runThreads(replayThread *threads, uint16_t concurrency) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	FIFTYONE_DEGREES_THREAD *handles = (FIFTYONE_DEGREES_THREAD*)Malloc(
+		sizeof(FIFTYONE_DEGREES_THREAD) * concurrency);
+	if (handles == NULL) {
+		return INSUFFICIENT_MEMORY;
+	}
+	for (uint16_t i = 0; i < concurrency; i++) {
+		FIFTYONE_DEGREES_THREAD_CREATE(
+			handles[i],
+			(FIFTYONE_DEGREES_THREAD_ROUTINE)&runThreadRoutine,
+			&threads[i]);
+	}
+	for (uint16_t i = 0; i < concurrency; i++) {
+		FIFTYONE_DEGREES_THREAD_JOIN(handles[i]);
+		FIFTYONE_DEGREES_THREAD_CLOSE(handles[i]);
+	}
+	Free(handles);
+#else
+	for (uint16_t i = 0; i < concurrency; i++) {
+		runThread(&threads[i]);
+	}
+#endif
+	return SUCCESS;
+}
+
+// Combines the histograms from all the threads into the first thread's and
+// sets the latencies in the result.
+static void setLatencies(
+	replayThread *threads,
+	uint16_t concurrency,
+	ReplayResult *result) {
+	uint64_t *buckets = threads[0].buckets;
+	result->minimum = threads[0].minimum;
+	result->maximum = threads[0].maximum;
+	for (uint16_t t = 1; t < concurrency; t++) {
+		for (int i = 0; i < BUCKETS; i++) {
+			buckets[i] += threads[t].buckets[i];
+		}
+		if (threads[t].minimum < result->minimum) {
+			result->minimum = threads[t].minimum;
+		}
+		if (threads[t].maximum > result->maximum) {
+			result->maximum = threads[t].maximum;
+		}
+	}
+	result->median = getPercentile(
+		buckets, result->count, 0.5, result->maximum);
+	result->p90 = getPercentile(
+		buckets, result->count, 0.9, result->maximum);
+	result->p99 = getPercentile(
+		buckets, result->count, 0.99, result->maximum);
+	result->p999 = getPercentile(
+		buckets, result->count, 0.999, result->maximum);
+}
+
+fiftyoneDegreesStatusCode fiftyoneDegreesReplayRun(
+	const fiftyoneDegreesEvidenceFile *file,
+	uint16_t concurrency,
+	uint32_t passes,
+	void *state,
+	fiftyoneDegreesReplayMethod method,
+	fiftyoneDegreesReplayResult *result) {
+	StatusCode status = SUCCESS;
+	replayShared shared;
+	memset(result, 0, sizeof(ReplayResult));
+	if (file->count == 0 || passes == 0) {
+		return SUCCESS;
+	}
+	if (concurrency == 0) {
+		concurrency = 1;
+	}
+	shared.file = file;
+	shared.total = (uint64_t)file->count * passes;
+	shared.next = 0;
+	shared.state = state;
+	shared.method = method;
+
+	// Allocate the threads and a histogram for each.
+	replayThread *threads = (replayThread*)Malloc(
+		sizeof(replayThread) * concurrency);
+	uint64_t *buckets = (uint64_t*)Malloc(
+		sizeof(uint64_t) * BUCKETS * concurrency);
+	if (threads == NULL || buckets == NULL) {
+		status = INSUFFICIENT_MEMORY;
+	}
+	else {
+		memset(buckets, 0, sizeof(uint64_t) * BUCKETS * concurrency);
+		for (uint16_t i = 0; i < concurrency; i++) {
+			threads[i].shared = &shared;
+			threads[i].index = i;
+			threads[i].buckets = buckets + (size_t)BUCKETS * i;
+			threads[i].minimum = UINT64_MAX;
+			threads[i].maximum = 0;
+		}
+
+		// Process the records and record the results.
+		uint64_t start = now();
+		status = runThreads(threads, concurrency);
+		if (status == SUCCESS) {
+			result->count = shared.total;
+			result->seconds = (double)(now() - start) / 1.0e9;
+			result->perSecond = result->seconds > 0 ?
+				(double)result->count / result->seconds : 0;
+			setLatencies(threads, concurrency, result);
+		}
+	}
+	if (buckets != NULL) {
+		Free(buckets);
+	}
+	if (threads != NULL) {
+		Free(threads);
+	}
+	return status;
+}
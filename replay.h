@@ -0,0 +1,128 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#ifndef FIFTYONE_DEGREES_REPLAY_H_INCLUDED
+#define FIFTYONE_DEGREES_REPLAY_H_INCLUDED
+
+/**
+ * @ingroup FiftyOneDegreesCommon
+ * @defgroup FiftyOneDegreesReplay Replay
+ *
+ * Replays evidence loaded from a file across many threads.
+ *
+ * ## Introduction
+ *
+ * Measuring the throughput of a detection engine needs the evidence to be
+ * presented to the engine as quickly as possible from several threads. The
+ * evidence is loaded into memory with the methods in evidenceFile.h and then
+ * replayed by #fiftyoneDegreesReplayRun which calls a method for each record
+ * from the number of threads requested.
+ *
+ * ## Operation
+ *
+ * Each thread takes the next record from a shared counter so that the threads
+ * remain busy until all the records have been processed the number of times
+ * requested. The time taken by each call to the method is recorded in a
+ * histogram for the thread. When all the threads have finished the histograms
+ * are combined to provide the percentiles of the latency alongside the total
+ * throughput. Latencies are recorded with a precision of approximately 3%.
+ *
+ * The records are shared between the threads and must not be modified by the
+ * method. If the library is compiled with FIFTYONE_DEGREES_NO_THREADING then
+ * all the records are processed on the calling thread.
+ *
+ * ## Example Usage
+ *
+ * ```
+ * EvidenceFile file;
+ * ReplayResult result;
+ *
+ * // Load the evidence from the YAML file
+ * StatusCode status = EvidenceFileLoadYaml("evidence.yml", -1, &file);
+ *
+ * // Process all the evidence twice from four threads
+ * if (status == SUCCESS) {
+ *     status = ReplayRun(&file, 4, 2, engine, process, &result);
+ *     EvidenceFileFree(&file);
+ * }
+ * ```
+ *
+ * @{
+ */
+
+#include <stdint.h>
+#include "status.h"
+#include "evidence.h"
+#include "evidenceFile.h"
+#include "common.h"
+
+/**
+ * Method called for each record being replayed.
+ * @param state pointer provided to #fiftyoneDegreesReplayRun
+ * @param thread index of the thread making the call starting at 0
+ * @param evidence record to process which must not be modified
+ */
+typedef void(*fiftyoneDegreesReplayMethod)(
+	void *state,
+	uint16_t thread,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence);
+
+/**
+ * Throughput and latencies measured when replaying evidence. Latencies are in
+ * nanoseconds.
+ */
+typedef struct fiftyone_degrees_replay_result_t {
+	uint64_t count; /**< Number of records processed */
+	double seconds; /**< Time taken to process all the records */
+	double perSecond; /**< Records processed per second */
+	uint64_t minimum; /**< Lowest latency */
+	uint64_t median; /**< 50th percentile latency */
+	uint64_t p90; /**< 90th percentile latency */
+	uint64_t p99; /**< 99th percentile latency */
+	uint64_t p999; /**< 99.9th percentile latency */
+	uint64_t maximum; /**< Highest latency */
+} fiftyoneDegreesReplayResult;
+
+/**
+ * Calls the method for every record in the file the number of passes
+ * requested, sharing the records between the threads requested.
+ * @param file containing the records to replay
+ * @param concurrency number of threads to use
+ * @param passes number of times to process each record
+ * @param state pointer passed to the method
+ * @param method called for each record
+ * @param result populated with the throughput and latencies
+ * @return status code indicating whether the records were replayed
+ */
+EXTERNAL fiftyoneDegreesStatusCode fiftyoneDegreesReplayRun(
+	const fiftyoneDegreesEvidenceFile *file,
+	uint16_t concurrency,
+	uint32_t passes,
+	void *state,
+	fiftyoneDegreesReplayMethod method,
+	fiftyoneDegreesReplayResult *result);
+
+/**
+ * @}
+ */
+
+#endif
@@ -96,6 +96,21 @@ static InterlockDoubleWidth emptyCounter() {
 #define HANDLE ResourceHandle
 #endif
 
+/**
+ * Handle the calling thread is pinned to, and the number of uses added to it
+ * which have not yet been returned by IncUse.
+ */
+typedef struct pinned_thread_t {
+	ResourceHandle *handle;
+	int32_t reserved;
+} pinnedThread;
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+static FIFTYONE_DEGREES_THREAD_LOCAL pinnedThread pinnedLocal;
+#else
+static pinnedThread pinnedLocal;
+#endif
+
 static void add(VOLATILE InterlockDoubleWidth* counter, int32_t value) {
 	((Counter*)counter)->inUse += value;
 }
@@ -194,8 +209,9 @@ void fiftyoneDegreesResourceManagerFree(
 	}
 }
 
-void fiftyoneDegreesResourceHandleDecUse(
-	fiftyoneDegreesResourceHandle *handle) {
+// Removes count uses from the handle, freeing it if they were the last uses
+// and the handle is no longer active.
+static void decUse(ResourceHandle *handle, int32_t count) {
 	// When modifying this method, it is important to note the reason for using
 	// two separate compareand swaps. The first compare and swap ensures that
 	// we are certain the handle is ready to be released i.e. the inUse counter
@@ -207,9 +223,9 @@ void fiftyoneDegreesResourceHandleDecUse(
 	COUNTER compare;
 	do {
 		compare = handle->counter;
-		assert(getInUse(&compare) > 0);
+		assert(getInUse(&compare) >= count);
 		decremented = compare;
-		add(&decremented, -1);
+		add(&decremented, -count);
 		assert((uintptr_t)&handle->counter % ALIGN_SIZE == 0);
 		assert((uintptr_t)&decremented % ALIGN_SIZE == 0);
 		assert((uintptr_t)&compare % ALIGN_SIZE == 0);
@@ -227,7 +243,7 @@ void fiftyoneDegreesResourceHandleDecUse(
 #pragma warning (default: 4090)
 #endif
 #else
-	add(&handle->counter, -1);
+	add(&handle->counter, -count);
 	decremented = handle->counter;
 #endif
 	assert(getInUse(&decremented) >= 0);
@@ -269,8 +285,55 @@ void fiftyoneDegreesResourceHandleDecUse(
 	}
 }
 
+void fiftyoneDegreesResourceHandleDecUse(
+	fiftyoneDegreesResourceHandle *handle) {
+	decUse(handle, 1);
+}
+
+// Adds count uses to a handle which the caller already holds so it can not be
+// freed.
+static void addUse(ResourceHandle *handle, int32_t count) {
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+	COUNTER incremented;
+	COUNTER compare;
+	do {
+		compare = handle->counter;
+		assert(getInUse(&compare) > 0);
+		incremented = compare;
+		add(&incremented, count);
+#ifdef _MSC_VER
+// Disable warning against the difference in the use of 'volatile' qualifier.
+// Casting won't resolve the issue which is described above with the definitions 
+// of COUNTER and HANDLE macros.
+#pragma warning (disable: 4090)
+#endif
+	} while (FIFTYONE_DEGREES_INTERLOCK_EXCHANGE_DW(
+		handle->counter,
+		incremented,
+		compare) == false);
+#ifdef _MSC_VER
+#pragma warning (default: 4090)
+#endif
+#else
+	add(&handle->counter, count);
+#endif
+}
+
 fiftyoneDegreesResourceHandle* fiftyoneDegreesResourceHandleIncUse(
 	fiftyoneDegreesResourceManager *manager) {
+
+	// Threads pinned to a handle for the manager take one of the uses already
+	// added to it, adding another batch when none remain.
+	if (pinnedLocal.handle != NULL &&
+		pinnedLocal.handle->manager == manager) {
+		if (pinnedLocal.reserved == 0) {
+			addUse(pinnedLocal.handle, FIFTYONE_DEGREES_RESOURCE_PIN_BATCH);
+			pinnedLocal.reserved = FIFTYONE_DEGREES_RESOURCE_PIN_BATCH;
+		}
+		pinnedLocal.reserved--;
+		return pinnedLocal.handle;
+	}
+
 	COUNTER incremented;
 #ifndef FIFTYONE_DEGREES_NO_THREADING
 	COUNTER compare;
@@ -303,6 +366,21 @@ fiftyoneDegreesResourceHandle* fiftyoneDegreesResourceHandleIncUse(
 	return getHandle(&incremented);
 }
 
+void fiftyoneDegreesResourceHandlePinThread(
+	fiftyoneDegreesResourceHandle *handle) {
+	fiftyoneDegreesResourceHandleUnpinThread();
+	pinnedLocal.handle = handle;
+	pinnedLocal.reserved = 0;
+}
+
+void fiftyoneDegreesResourceHandleUnpinThread() {
+	if (pinnedLocal.handle != NULL && pinnedLocal.reserved > 0) {
+		decUse(pinnedLocal.handle, pinnedLocal.reserved);
+	}
+	pinnedLocal.handle = NULL;
+	pinnedLocal.reserved = 0;
+}
+
 int32_t fiftyoneDegreesResourceHandleGetUse(
 	fiftyoneDegreesResourceHandle *handle) {
 	if (handle != NULL) {
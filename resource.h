@@ -229,6 +229,37 @@ EXTERNAL fiftyoneDegreesResourceHandle* fiftyoneDegreesResourceHandleIncUse(
 EXTERNAL void fiftyoneDegreesResourceHandleDecUse(
 	fiftyoneDegreesResourceHandle *handle);
 
+/**
+ * Number of uses a thread pinned with #fiftyoneDegreesResourceHandlePinThread
+ * adds to the handle at a time.
+ */
+#ifndef FIFTYONE_DEGREES_RESOURCE_PIN_BATCH
+#define FIFTYONE_DEGREES_RESOURCE_PIN_BATCH 64
+#endif
+
+/**
+ * Pins the calling thread to a handle it already holds. Until
+ * #fiftyoneDegreesResourceHandleUnpinThread is called, calls to
+ * #fiftyoneDegreesResourceHandleIncUse from the thread for the same manager
+ * return the pinned handle, even if the manager's resource has been
+ * replaced. The uses are added to the handle in batches of
+ * #FIFTYONE_DEGREES_RESOURCE_PIN_BATCH so that most calls do not need an
+ * interlocked operation. Each handle returned must still be released with
+ * #fiftyoneDegreesResourceHandleDecUse, from any thread. A thread can only be
+ * pinned to one handle at a time.
+ * @param handle held by the calling thread until it is unpinned
+ */
+EXTERNAL void fiftyoneDegreesResourceHandlePinThread(
+	fiftyoneDegreesResourceHandle *handle);
+
+/**
+ * Unpins the calling thread from the handle set with
+ * #fiftyoneDegreesResourceHandlePinThread, releasing any uses which were
+ * added to the handle but not returned by
+ * #fiftyoneDegreesResourceHandleIncUse.
+ */
+EXTERNAL void fiftyoneDegreesResourceHandleUnpinThread();
+
 /**
  * Return the current usage counter.
  * WARNING: This call is not thread-safe and is suitable for using in
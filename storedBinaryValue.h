@@ -88,6 +88,18 @@ typedef union fiftyone_degrees_stored_binary_value_t {
 } fiftyoneDegreesStoredBinaryValue;
 #pragma pack(pop)
 
+/**
+ * Memory large enough to hold a copy of any numeric binary value, or of an IP
+ * address, so that the value can be used once the item it was read from has
+ * been released.
+ */
+typedef union fiftyone_degrees_stored_binary_value_buffer_t {
+ fiftyoneDegreesStoredBinaryValue value; /**< The copied value */
+ byte bytes[sizeof(int16_t) + FIFTYONE_DEGREES_IPV6_LENGTH]; /**< Space for
+                                                              the largest
+                                                              copied value */
+} fiftyoneDegreesStoredBinaryValueBuffer;
+
 #ifndef FIFTYONE_DEGREES_MEMORY_ONLY
 
 /**
@@ -20,11 +20,8 @@
  * such notice(s) shall fulfill the requirements of that article.
  * ********************************************************************* */
 
-#define __STDC_FORMAT_MACROS
-
 #include "stringBuilder.h"
 #include "fiftyone.h"
-#include <inttypes.h>
 
 /**
  * Add IPv4 address (raw bytes) to string builder (as text)
@@ -97,6 +94,56 @@ void fiftyoneDegreesStringBuilderAddIpAddress(
 	}
 }
 
+/**
+ * True if the characters in the buffer can be passed to the builder's writer.
+ */
+#define CAN_WRITE(b) ((b)->writer != NULL && (b)->full == false)
+
+/**
+ * Passes the characters in the buffer to the writer and empties the buffer.
+ * @param builder with a writer
+ * @return true if the buffer is now empty, otherwise false and the builder is
+ * marked as full
+ */
+static bool flush(StringBuilder * const builder) {
+	const size_t length = (size_t)(builder->current - builder->ptr);
+	if (length > 0 &&
+		builder->writer(builder->writerState, builder->ptr, length) == false) {
+		builder->full = true;
+		return false;
+	}
+	builder->current = builder->ptr;
+	builder->remaining = builder->length;
+	return true;
+}
+
+/**
+ * Adds characters which do not fit in the remaining buffer by passing the
+ * buffer to the writer. Characters that do not fit into the empty buffer are
+ * passed straight to the writer.
+ * @param builder with a writer
+ * @param value characters to add
+ * @param length of the characters to add
+ */
+static void addWithWriter(
+	StringBuilder * const builder,
+	const char * const value,
+	size_t const length) {
+	if (flush(builder)) {
+		if (length < builder->remaining) {
+			memcpy(builder->current, value, length);
+			builder->current += length;
+			builder->remaining -= length;
+		}
+		else if (builder->writer(
+			builder->writerState,
+			value,
+			length) == false) {
+			builder->full = true;
+		}
+	}
+}
+
 fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderInit(
 	fiftyoneDegreesStringBuilder* builder) {
 	builder->current = builder->ptr;
@@ -106,6 +153,53 @@ fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderInit(
 	return builder;
 }
 
+fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderInitWriter(
+	fiftyoneDegreesStringBuilder* builder,
+	fiftyoneDegreesStringBuilderWriter writer,
+	void *writerState) {
+	builder->writer = writer;
+	builder->writerState = writerState;
+	return StringBuilderInit(builder);
+}
+
+bool fiftyoneDegreesStringBuilderGrowableWrite(
+	void *state,
+	const char *chars,
+	size_t length) {
+	StringBuilderGrowable * const growable = (StringBuilderGrowable*)state;
+	const size_t required = growable->length + length + 1;
+	if (required > growable->capacity) {
+		size_t capacity = growable->capacity > 0 ? growable->capacity : 256;
+		while (capacity < required) {
+			capacity *= 2;
+		}
+		char * const ptr = (char*)Malloc(capacity);
+		if (ptr == NULL) {
+			return false;
+		}
+		if (growable->ptr != NULL) {
+			memcpy(ptr, growable->ptr, growable->length);
+			Free(growable->ptr);
+		}
+		growable->ptr = ptr;
+		growable->capacity = capacity;
+	}
+	memcpy(growable->ptr + growable->length, chars, length);
+	growable->length += length;
+	growable->ptr[growable->length] = '\0';
+	return true;
+}
+
+void fiftyoneDegreesStringBuilderGrowableFree(
+	fiftyoneDegreesStringBuilderGrowable *growable) {
+	if (growable->ptr != NULL) {
+		Free(growable->ptr);
+	}
+	growable->ptr = NULL;
+	growable->length = 0;
+	growable->capacity = 0;
+}
+
 fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddChar(
 	fiftyoneDegreesStringBuilder* builder,
 	char const value) {
@@ -114,6 +208,9 @@ fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddChar(
 		builder->current++;
 		builder->remaining--;
 	}
+	else if (CAN_WRITE(builder)) {
+		addWithWriter(builder, &value, 1);
+	}
 	else {
 		builder->full = true;
 	}
@@ -121,112 +218,156 @@ fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddChar(
 	return builder;
 }
 
+// Pairs of decimal digits for each value between 0 and 99.
+static const char DIGIT_PAIRS[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// Powers of 10 which fit in 64 bits.
+static const uint64_t POWERS_OF_10[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL,
+	10000000000000000000ULL };
+
+/**
+ * Writes the decimal digits of the value to the end of the buffer two at a
+ * time.
+ * @param value to write
+ * @param end of the buffer which must have space for 20 characters before it
+ * @return pointer to the first digit written
+ */
+static char* writeDigits(uint64_t value, char *end) {
+	while (value >= 100) {
+		const size_t pair = (size_t)(value % 100) * 2;
+		value /= 100;
+		*--end = DIGIT_PAIRS[pair + 1];
+		*--end = DIGIT_PAIRS[pair];
+	}
+	if (value >= 10) {
+		*--end = DIGIT_PAIRS[value * 2 + 1];
+		*--end = DIGIT_PAIRS[value * 2];
+	}
+	else {
+		*--end = (char)('0' + value);
+	}
+	return end;
+}
+
 fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddInteger(
 	fiftyoneDegreesStringBuilder* builder,
 	int64_t const value) {
-    // 64-bit INT_MIN is  -9,223,372,036,854,775,807 => 21 characters
-	char temp[22];
-	if (snprintf(temp, sizeof(temp), "%" PRId64, value) > 0) {
-		StringBuilderAddChars(
-			builder,
-			temp,
-			strlen(temp));
+	// 64-bit INT_MIN is -9,223,372,036,854,775,808 => 20 characters
+	char temp[20];
+	char * const end = temp + sizeof(temp);
+	char *start = writeDigits(
+		value < 0 ? 0 - (uint64_t)value : (uint64_t)value,
+		end);
+	if (value < 0) {
+		*--start = '-';
 	}
+	StringBuilderAddChars(builder, start, (size_t)(end - start));
 	return builder;
 }
 
+/**
+ * Adds the given number of '0' characters.
+ */
+static void addZeros(StringBuilder * const builder, int32_t count) {
+	static const char zeros[] = "0000000000000000";
+	while (count > 0) {
+		const int32_t length = count < (int32_t)sizeof(zeros) - 1 ?
+			count : (int32_t)sizeof(zeros) - 1;
+		StringBuilderAddChars(builder, zeros, (size_t)length);
+		count -= length;
+	}
+}
+
 StringBuilder* fiftyoneDegreesStringBuilderAddDouble(
 	fiftyoneDegreesStringBuilder * const builder,
 	const double value,
 	const uint8_t decimalPlaces) {
-	bool addNegative = false;
-	const int digitPlaces = MAX_DOUBLE_DECIMAL_PLACES < decimalPlaces
+	char temp[20];
+	char * const end = temp + sizeof(temp);
+	const int32_t places = MAX_DOUBLE_DECIMAL_PLACES < decimalPlaces
 		? MAX_DOUBLE_DECIMAL_PLACES : decimalPlaces;
-	int remDigits = digitPlaces;
-
-	int intPart = (int)value;
-	double fracPart = value - intPart;
 
-	if (fracPart < 0) {
-		if (intPart == 0) {
-			// Handle negative numbers <1. The integer part will just be zero,
-			// which is neither positive or negative. So the negative must be
-			// added.
-			addNegative = true;
-		}
-		fracPart = -fracPart;
+	if (value != value) {
+		StringBuilderAddChars(builder, "NaN", 3);
+		return builder;
 	}
-
-	if (!fracPart || remDigits <= 0) {
-		if (fracPart >= 0.5) {
-			if (value < 0) {
-				intPart--;
-			} else {
-				intPart++;
-			}
-		}
-		StringBuilderAddInteger(builder, intPart);
+	if (value == 0) {
+		StringBuilderAddChar(builder, '0');
 		return builder;
 	}
-
-	char floatTail[MAX_DOUBLE_DECIMAL_PLACES + 2];
-	floatTail[0] = '.';
-	char *digits = floatTail + 1;
-
-	char *nextDigit = digits;
-	while (remDigits > 0 && fracPart) {
-		remDigits--;
-		fracPart *= 10;
-		*nextDigit = (char)fracPart;
-		fracPart -= *nextDigit;
-		if (!remDigits && fracPart >= 0.5) {
-			// find last non-9
-			while (nextDigit > floatTail && *nextDigit == 9) {
-				--nextDigit;
-				++remDigits;
-			}
-			if (nextDigit > floatTail) {
-				(*nextDigit)++;
-				++nextDigit;
-				break;
-			} else {
-				// tail collapsed into 1
-				if (value < 0) {
-					intPart--;
-				} else {
-					intPart++;
-				}
-				StringBuilderAddInteger(builder, intPart);
-				return builder;
-			}
+	if (value - value != 0) {
+		if (value < 0) {
+			StringBuilderAddChar(builder, '-');
 		}
-		++nextDigit;
+		StringBuilderAddChars(builder, "Infinity", 8);
+		return builder;
 	}
-	*nextDigit = '\0';
-
-	int digitsToAdd = digitPlaces - remDigits;
-	for (nextDigit = digits + digitsToAdd - 1;
-		nextDigit >= digits;
-		--nextDigit) {
 
-		if (*nextDigit) {
-			break;
+	// Get the shortest decimal which converts back to the value, and round
+	// it half away from zero if it has more decimal places than required.
+	DtoaDecimal decimal = DtoaShortest(value);
+	if (-decimal.exponent > places) {
+		const int32_t remove = -decimal.exponent - places;
+		if (remove >= (int32_t)(sizeof(POWERS_OF_10) / sizeof(uint64_t))) {
+			// The digits are all less than half of the last place.
+			decimal.digits = 0;
+		}
+		else {
+			const uint64_t divisor = POWERS_OF_10[remove];
+			const uint64_t remainder = decimal.digits % divisor;
+			decimal.digits = decimal.digits / divisor +
+				(remainder >= divisor - remainder ? 1 : 0);
 		}
-		--digitsToAdd;
+		decimal.exponent = -places;
 	}
-	if (digitsToAdd <= 0) {
-		// tail collapsed to 0
-		StringBuilderAddInteger(builder, intPart);
+	if (decimal.digits == 0) {
+		StringBuilderAddChar(builder, '0');
 		return builder;
 	}
-	for (; nextDigit >= digits; --nextDigit) {
-		*nextDigit += '0';
+	while (decimal.exponent < 0 && decimal.digits % 10 == 0) {
+		decimal.digits /= 10;
+		decimal.exponent++;
 	}
-	if (addNegative) {
+
+	// Add the digits with the decimal point in the right place.
+	const char * const digits = writeDigits(decimal.digits, end);
+	const int32_t length = (int32_t)(end - digits);
+	if (value < 0) {
 		StringBuilderAddChar(builder, '-');
 	}
-	StringBuilderAddInteger(builder, intPart);
-	StringBuilderAddChars(builder, floatTail, digitsToAdd + 1);
+	if (decimal.exponent >= 0) {
+		StringBuilderAddChars(builder, digits, (size_t)length);
+		addZeros(builder, decimal.exponent);
+	}
+	else if (length > -decimal.exponent) {
+		const int32_t integerLength = length + decimal.exponent;
+		StringBuilderAddChars(builder, digits, (size_t)integerLength);
+		StringBuilderAddChar(builder, '.');
+		StringBuilderAddChars(
+			builder,
+			digits + integerLength,
+			(size_t)(length - integerLength));
+	}
+	else {
+		StringBuilderAddChars(builder, "0.", 2);
+		addZeros(builder, -decimal.exponent - length);
+		StringBuilderAddChars(builder, digits, (size_t)length);
+	}
 	return builder;
 }
 
@@ -235,6 +376,11 @@ fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddChars(
 	const char * const value,
 	size_t const length) {
 	const bool fitsIn = length < builder->remaining;
+	if (fitsIn == false && CAN_WRITE(builder)) {
+		addWithWriter(builder, value, length);
+		builder->added += length;
+		return builder;
+	}
 	const size_t clippedLength = (
 		fitsIn ? length : (builder->remaining ? builder->remaining - 1 : 0));
 	if (0 < clippedLength &&
@@ -344,6 +490,12 @@ StringBuilder* fiftyoneDegreesStringBuilderAddStringValue(
 fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderComplete(
 	fiftyoneDegreesStringBuilder* builder) {
 
+	// Pass any characters in the buffer to the writer so that the buffer is
+	// empty before the terminator is added.
+	if (CAN_WRITE(builder)) {
+		flush(builder);
+	}
+
 	// Always ensures that the string is null terminated even if that means
 	// overwriting the last character to turn it into a null.
 	if (builder->remaining >= 1) {
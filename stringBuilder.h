@@ -60,6 +60,30 @@
  * insensitively up to the length required. Any characters after this point are
  * ignored
  *
+ * ## Writers
+ *
+ * A string builder writes into a fixed buffer and, by default, truncates the
+ * output and sets the full flag when the buffer runs out. If a writer is set
+ * with #fiftyoneDegreesStringBuilderInitWriter then the buffer is used as a
+ * chunk which is passed to the writer whenever it fills, and once more when
+ * the builder is completed. Output of any size is then produced in a single
+ * pass. The writer can stream the characters to a destination, or append
+ * them to a #fiftyoneDegreesStringBuilderGrowable using
+ * #fiftyoneDegreesStringBuilderGrowableWrite.
+ * ```
+ * char chunk[256];
+ * fiftyoneDegreesStringBuilderGrowable output = { NULL, 0, 0 };
+ * fiftyoneDegreesStringBuilder builder = { chunk, sizeof(chunk) };
+ * fiftyoneDegreesStringBuilderInitWriter(
+ *     &builder,
+ *     fiftyoneDegreesStringBuilderGrowableWrite,
+ *     &output);
+ * // Add characters to the builder
+ * fiftyoneDegreesStringBuilderComplete(&builder);
+ * // Use output.ptr
+ * fiftyoneDegreesStringBuilderGrowableFree(&output);
+ * ```
+ *
  * @{
  */
 
@@ -78,6 +102,19 @@ typedef union fiftyone_degrees_stored_binary_value_t fiftyoneDegreesStoredBinary
 struct fiftyone_degrees_var_length_byte_array_t;
 typedef struct fiftyone_degrees_var_length_byte_array_t fiftyoneDegreesVarLengthByteArray;
 
+/**
+ * Writes characters from a string builder's buffer to a destination.
+ * @param state pointer provided to #fiftyoneDegreesStringBuilderInitWriter
+ * @param chars characters to write, not NUL terminated
+ * @param length number of characters to write
+ * @return true if the characters were written, otherwise false in which case
+ * the builder stops calling the writer and behaves as if full
+ */
+typedef bool(*fiftyoneDegreesStringBuilderWriter)(
+	void *state,
+	const char *chars,
+	size_t length);
+
 /** String buffer for building strings with memory checks */
 typedef struct fiftyone_degrees_string_builder_t {
 	char* const ptr; /**< Pointer to the memory used by the buffer */
@@ -87,8 +124,23 @@ typedef struct fiftyone_degrees_string_builder_t {
 	size_t added; /**< Characters added to the buffer or that would be
 					  added if the buffer were long enough */
 	bool full; /**< True if the buffer is full, otherwise false */
+	fiftyoneDegreesStringBuilderWriter writer; /**< Writer the buffer is
+											   passed to when full, or NULL
+											   to truncate */
+	void *writerState; /**< State passed to the writer */
 } fiftyoneDegreesStringBuilder;
 
+/**
+ * Memory which grows to hold all the characters written to it by
+ * #fiftyoneDegreesStringBuilderGrowableWrite. Initialize all the fields to
+ * zero before use and free with #fiftyoneDegreesStringBuilderGrowableFree.
+ */
+typedef struct fiftyone_degrees_string_builder_growable_t {
+	char *ptr; /**< NUL terminated characters written, or NULL if none */
+	size_t length; /**< Number of characters written excluding the NUL */
+	size_t capacity; /**< Bytes allocated at ptr */
+} fiftyoneDegreesStringBuilderGrowable;
+
 /**
  * Initializes the buffer.
  * @param builder to initialize
@@ -97,6 +149,43 @@ typedef struct fiftyone_degrees_string_builder_t {
 EXTERNAL fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderInit(
 	fiftyoneDegreesStringBuilder* builder);
 
+/**
+ * Initializes the buffer so that characters are passed to the writer each
+ * time the buffer is full and when the builder is completed. The buffer must
+ * have a length of at least 2 to hold any characters, otherwise all the
+ * characters are passed directly to the writer.
+ * @param builder to initialize
+ * @param writer to pass the characters in the buffer to
+ * @param writerState passed to the writer
+ * @return pointer to the builder passed
+ */
+EXTERNAL fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderInitWriter(
+	fiftyoneDegreesStringBuilder* builder,
+	fiftyoneDegreesStringBuilderWriter writer,
+	void *writerState);
+
+/**
+ * Writer which appends the characters to the
+ * #fiftyoneDegreesStringBuilderGrowable passed as the state, growing its
+ * memory as needed.
+ * @param state pointer to a #fiftyoneDegreesStringBuilderGrowable
+ * @param chars characters to append
+ * @param length number of characters to append
+ * @return true if the characters were appended, or false if memory could not
+ * be allocated
+ */
+EXTERNAL bool fiftyoneDegreesStringBuilderGrowableWrite(
+	void *state,
+	const char *chars,
+	size_t length);
+
+/**
+ * Frees the memory used by the growable output and resets it to empty.
+ * @param growable to free
+ */
+EXTERNAL void fiftyoneDegreesStringBuilderGrowableFree(
+	fiftyoneDegreesStringBuilderGrowable *growable);
+
 /**
  * Adds the character to the buffer.
  * @param builder to add the character to
@@ -118,10 +207,15 @@ EXTERNAL fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddInteger(
 	int64_t const value);
 
 /**
- * Adds the double to the buffer.
+ * Adds the double to the buffer. The shortest decimal which converts back to
+ * the value is used, see #fiftyoneDegreesDtoaShortest. If it has more than
+ * decimalPlaces digits after the decimal point then it is rounded half away
+ * from zero. Trailing zeros after the decimal point are never added.
+ * Exponent notation is not used.
  * @param builder to add the character to
  * @param value floating-point number to add
- * @param decimalPlaces precision (places after decimal dot)
+ * @param decimalPlaces precision (places after decimal dot), at most
+ * #FIFTYONE_DEGREES_MAX_DOUBLE_DECIMAL_PLACES
  * @return pointer to the buffer passed
  */
 EXTERNAL fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddDouble(
@@ -170,7 +264,9 @@ EXTERNAL fiftyoneDegreesStringBuilder* fiftyoneDegreesStringBuilderAddStringValu
 	fiftyoneDegreesException *exception);
 
 /**
- * Adds a null terminating character to the buffer.
+ * Adds a null terminating character to the buffer. If the builder has a
+ * writer then any characters in the buffer are passed to it first, so the
+ * buffer only contains the terminator.
  * @param builder to terminate
  * @return pointer to the buffer passed
  */
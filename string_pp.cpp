@@ -27,12 +27,34 @@
 
 #include "string_pp.hpp"
 
-#include <memory>
-
 #include "fiftyone.h"
 
 namespace FiftyoneDegrees::Common {
 
+    bool writeToString(
+        void * const state,
+        const char * const chars,
+        const size_t length) {
+        static_cast<std::string*>(state)->append(chars, length);
+        return true;
+    }
+
+    void completeToStringStream(
+        StringBuilder * const builder,
+        const std::string &pending,
+        std::stringstream &stream) {
+        stream.write(
+            pending.data(),
+            static_cast<std::streamsize>(pending.size()));
+        stream.write(
+            builder->ptr,
+            static_cast<std::streamsize>(builder->current - builder->ptr));
+
+        // The characters have been written so only the terminator is added.
+        builder->writer = nullptr;
+        StringBuilderComplete(builder);
+    }
+
     void writeStoredBinaryValueToStringStream(
         const StoredBinaryValue * const binaryValue,
         const PropertyValueType valueType,
@@ -40,60 +62,27 @@ namespace FiftyoneDegrees::Common {
         const uint8_t decimalPlaces,
         Exception * const exception) {
 
-        WkbtotResult toWktResult = {
-            0,
-            false,
-        };
-
         if (!binaryValue || !exception) {
             EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_NULL_POINTER);
             return;
         }
 
-        {
-            char buffer[REASONABLE_WKT_STRING_LENGTH];
-            StringBuilder builder = { buffer, REASONABLE_WKT_STRING_LENGTH };
-            StringBuilderInit(&builder);
-            StringBuilderAddStringValue(
-                &builder,
-                binaryValue,
-                valueType,
-                decimalPlaces,
-                exception
-                );
-            StringBuilderComplete(&builder);
-            toWktResult = {
-                builder.added,
-                builder.full,
-            };
-            if (EXCEPTION_OKAY && !toWktResult.bufferTooSmall) {
-                stream << buffer;
-                return;
-            }
-        }
-        if (toWktResult.bufferTooSmall) {
-            EXCEPTION_CLEAR;
-            const size_t requiredSize = toWktResult.written + 1;
-            const std::unique_ptr<char[]> buffer = std::make_unique<char[]>(requiredSize);
-            StringBuilder builder = { buffer.get(), requiredSize };
-            StringBuilderInit(&builder);
-            StringBuilderAddStringValue(
-                &builder,
-                binaryValue,
-                valueType,
-                decimalPlaces,
-                exception
-                );
-            StringBuilderComplete(&builder);
-            toWktResult = {
-                builder.added,
-                builder.full,
-            };
-            if (EXCEPTION_OKAY && !toWktResult.bufferTooSmall) {
-                stream << buffer.get();
-                return;
-            }
+        // The text is rendered once whatever its length. Short text stays in
+        // the chunk, and longer text is kept until it is complete, so that
+        // the stream is only written to if there is no exception.
+        char chunk[REASONABLE_WKT_STRING_LENGTH];
+        std::string pending;
+        StringBuilder builder = { chunk, REASONABLE_WKT_STRING_LENGTH };
+        StringBuilderInitWriter(&builder, writeToString, &pending);
+        StringBuilderAddStringValue(
+            &builder,
+            binaryValue,
+            valueType,
+            decimalPlaces,
+            exception
+            );
+        if (EXCEPTION_OKAY) {
+            completeToStringStream(&builder, pending, stream);
         }
-        return;
     }
 }
@@ -25,12 +25,43 @@
 
 #include "string.h"
 #include <sstream>
+#include <string>
 
 #include "storedBinaryValue.h"
 
 namespace FiftyoneDegrees::Common {
+    /**
+     * String builder writer which appends the characters to the std::string
+     * provided as the state. Used to keep text that does not fit in the
+     * builder until it is known whether the text is complete. See
+     * #fiftyoneDegreesStringBuilderInitWriter.
+     * @param state pointer to the std::string
+     * @param chars characters to write
+     * @param length number of characters to write
+     * @return true
+     */
+    bool writeToString(
+        void *state,
+        const char *chars,
+        size_t length);
+
+    /**
+     * Writes the characters kept by #writeToString followed by those still
+     * in the builder to the stream, then completes the builder. Only called
+     * once the text has been rendered without an exception so that the
+     * stream never holds part of a value.
+     * @param builder initialized with #writeToString and pending
+     * @param pending characters passed to #writeToString by the builder
+     * @param stream string stream to push the text into
+     */
+    void completeToStringStream(
+        fiftyoneDegreesStringBuilder *builder,
+        const std::string &pending,
+        std::stringstream &stream);
+
     /**
      * Converts stored binary value to text and pushes into a string stream.
+     * Nothing is pushed if an exception occurs.
      * @param binaryValue stored binary value from data file
      * @param stream string stream to push WKT into.
      * @param decimalPlaces precision for numbers (places after the decimal dot).
@@ -26,13 +26,15 @@
 static fiftyoneDegreesCollectionConfig testValues = {
 	true, /* Loaded */
 	1, /* Capacity */
-	2 /* Concurrency */
+	2, /* Concurrency */
+	false /* Reuse buffers */
 };
 
 static fiftyoneDegreesCollectionConfig otherTestValues = {
 	true, /* Loaded */
 	4, /* Capacity */
-	5 /* Concurrency */
+	5, /* Concurrency */
+	true /* Reuse buffers */
 };
 
 TEST_CLASS(CollectionConfig, &testValues)
@@ -44,12 +46,15 @@ public:
 		instance->setCapacity(otherTestValues.capacity);
 		instance->setConcurrency(otherTestValues.concurrency);
 		instance->setLoaded(otherTestValues.loaded);
+		instance->setReuseBuffers(otherTestValues.reuseBuffers);
 	};
 };
 
 TEST_PROPERTY_EQUAL(CollectionConfigTest, Capacity, , testValues.capacity)
 TEST_PROPERTY_EQUAL(CollectionConfigTest, Concurrency, , testValues.concurrency)
 TEST_PROPERTY_EQUAL(CollectionConfigTest, Loaded, , testValues.loaded)
+TEST_PROPERTY_EQUAL(CollectionConfigTest, ReuseBuffers, , testValues.reuseBuffers)
 TEST_PROPERTY_EQUAL(CollectionConfigTestSet, Capacity, , otherTestValues.capacity)
 TEST_PROPERTY_EQUAL(CollectionConfigTestSet, Concurrency, , otherTestValues.concurrency)
-TEST_PROPERTY_EQUAL(CollectionConfigTestSet, Loaded, , otherTestValues.loaded)
\ No newline at end of file
+TEST_PROPERTY_EQUAL(CollectionConfigTestSet, Loaded, , otherTestValues.loaded)
+TEST_PROPERTY_EQUAL(CollectionConfigTestSet, ReuseBuffers, , otherTestValues.reuseBuffers)
\ No newline at end of file
@@ -194,6 +194,7 @@ public:
 			collection->freeCollection(collection);
 			collection = NULL;
 		}
+		fiftyoneDegreesCollectionFreeThreadBuffers();
 		Base::TearDown();
 	}
 
@@ -758,6 +759,9 @@ fiftyoneDegreesCollectionConfig CacheConf = {
 fiftyoneDegreesCollectionConfig StreamConf = {
 	false, 0, COLLECTION_TEST_THREADS
 };
+fiftyoneDegreesCollectionConfig ReuseConf = {
+	false, 0, COLLECTION_TEST_THREADS, true
+};
 fiftyoneDegreesCollectionConfig MixedCacheConf = {
 	true,
 	((uint32_t)TEST_STRINGS_COUNT / 2) / 2,
@@ -784,6 +788,39 @@ COLLECTION_TEST(File, Fixed, Count, StreamConf, TEST_STRINGS_COUNT)
 COLLECTION_TEST(File, Fixed, Size, StreamConf, TEST_STRINGS_COUNT)
 COLLECTION_TEST(File, Variable, Size, StreamConf, TEST_STRINGS_COUNT)
 
+COLLECTION_TEST(File, Fixed, Count, ReuseConf, TEST_STRINGS_COUNT)
+COLLECTION_TEST(File, Fixed, Size, ReuseConf, TEST_STRINGS_COUNT)
+COLLECTION_TEST(File, Variable, Size, ReuseConf, TEST_STRINGS_COUNT)
+
+/**
+ * Check that when buffers are reused the memory an item was read into is
+ * used again for the next item once the first has been released.
+ */
+TEST_F(CollectionTestFileFixedCountReuseConf, ReusesMemory) {
+	if (fiftyoneDegreesCollectionGetIsMemoryOnly()) {
+		return;
+	}
+	FIFTYONE_DEGREES_EXCEPTION_CREATE
+	fiftyoneDegreesCollectionItem item;
+	fiftyoneDegreesDataReset(&item.data);
+	for (uint32_t i = 0; i < 2; i++) {
+		const fiftyoneDegreesCollectionKey key {
+			data->map[i],
+			&data->keyType,
+		};
+		void *first = collection->get(collection, &key, &item, exception);
+		FIFTYONE_DEGREES_EXCEPTION_THROW
+		data->verify(&item.data, i);
+		FIFTYONE_DEGREES_COLLECTION_RELEASE(collection, &item);
+		EXPECT_EQ(nullptr, item.data.ptr);
+		void *second = collection->get(collection, &key, &item, exception);
+		FIFTYONE_DEGREES_EXCEPTION_THROW
+		EXPECT_EQ(first, second);
+		data->verify(&item.data, i);
+		FIFTYONE_DEGREES_COLLECTION_RELEASE(collection, &item);
+	}
+}
+
 COLLECTION_TEST(File, Fixed, Count, CacheConf, TEST_STRINGS_COUNT)
 COLLECTION_TEST(File, Fixed, Size, CacheConf, TEST_STRINGS_COUNT)
 COLLECTION_TEST(File, Variable, Size, CacheConf, TEST_STRINGS_COUNT)
@@ -0,0 +1,261 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "Base.hpp"
+#include "../EngineBase.hpp"
+#include "../fiftyone.h"
+
+using namespace FiftyoneDegrees::Common;
+
+/**
+ * Results which record the evidence value and the data set used to create
+ * them.
+ */
+class BatchResults : public ResultsBase {
+public:
+	BatchResults(
+		fiftyoneDegreesResultsBase *results,
+		string value)
+		: ResultsBase(results, nullptr),
+		dataSet((void*)results->dataSet),
+		value(value) {}
+	void *dataSet;
+	string value;
+	int reused = 0;
+protected:
+	void getValuesInternal(int, vector<string> &values) {
+		values.push_back(value);
+	}
+	bool hasValuesInternal(int) { return true; }
+	const char* getNoValueMessageInternal(
+		fiftyoneDegreesResultsNoValueReason) {
+		return "none";
+	}
+	fiftyoneDegreesResultsNoValueReason getNoValueReasonInternal(int) {
+		return FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_UNKNOWN;
+	}
+};
+
+/**
+ * Engine which returns the value of the "value" evidence key as the results.
+ * The active data set is refreshed after the first item to check the pin
+ * holds. When pinned is set the engine processes batch items against the data
+ * set pinned for the batch directly, reusing previous results.
+ */
+class BatchEngine : public EngineBase {
+public:
+	BatchEngine(bool pinned) : EngineBase(nullptr, nullptr), pinned(pinned) {
+		fiftyoneDegreesResourceManagerInit(
+			manager.get(),
+			&dataSets[0],
+			&dataSets[0].handle,
+			freeDataSet);
+	}
+	ResultsBase* processBase(EvidenceBase *evidence) const {
+		fiftyoneDegreesResourceHandle *handle =
+			fiftyoneDegreesResourceHandleIncUse(manager.get());
+		ResultsBase *results = createResults(
+			(fiftyoneDegreesDataSetBase*)handle->resource,
+			evidence);
+		fiftyoneDegreesResourceHandleDecUse(handle);
+		return results;
+	}
+	void refreshData() const {
+		fiftyoneDegreesResourceReplace(
+			manager.get(),
+			(void*)&dataSets[1],
+			(fiftyoneDegreesResourceHandle**)&dataSets[1].handle);
+	}
+	void refreshData(const char*) const {}
+	void refreshData(void*, fiftyoneDegreesFileOffset) const {}
+	void refreshData(unsigned char[], fiftyoneDegreesFileOffset) const {}
+	string getDataFilePath() const { return ""; }
+	string getDataFileTempPath() const { return ""; }
+	Date getPublishedTime() const { return Date(); }
+	Date getUpdateAvailableTime() const { return Date(); }
+	string getProduct() const { return "Batch"; }
+	string getType() const { return "Test"; }
+	fiftyoneDegreesDataSetBase dataSets[2] {};
+	bool pinned;
+protected:
+	ResultsBase* processBatchItem(
+		fiftyoneDegreesResourceHandle *handle,
+		EvidenceBase *evidence,
+		ResultsBase *previous) const {
+		if (evidence->at("value") == "0") {
+			refreshData();
+		}
+		if (pinned == false) {
+			return EngineBase::processBatchItem(handle, evidence, previous);
+		}
+		BatchResults *results = (BatchResults*)previous;
+		if (results == nullptr) {
+			return createResults(
+				(fiftyoneDegreesDataSetBase*)handle->resource,
+				evidence);
+		}
+		results->dataSet = (void*)handle->resource;
+		results->value = evidence->at("value");
+		results->reused++;
+		return results;
+	}
+private:
+	ResultsBase* createResults(
+		fiftyoneDegreesDataSetBase *dataSet,
+		EvidenceBase *evidence) const {
+		fiftyoneDegreesResultsBase results;
+		fiftyoneDegreesResultsInit(&results, dataSet);
+		return new BatchResults(&results, evidence->at("value"));
+	}
+	static void freeDataSet(void*) {}
+};
+
+class EngineBaseTests : public Base {
+public:
+	void SetUp() {
+		Base::SetUp();
+		for (int i = 0; i < 1000; i++) {
+			evidence[i]["value"] = std::to_string(i);
+			pointers.push_back(&evidence[i]);
+		}
+	}
+	void TearDown() {
+		for (ResultsBase *item : results) {
+			delete item;
+		}
+		results.clear();
+		Base::TearDown();
+	}
+	/**
+	 * Check that every item of evidence has results with the same value in
+	 * the same position.
+	 */
+	void verifyOrder() {
+		ASSERT_EQ(pointers.size(), results.size());
+		for (size_t i = 0; i < results.size(); i++) {
+			ASSERT_NE(nullptr, results[i]);
+			EXPECT_EQ(
+				evidence[i]["value"],
+				((BatchResults*)results[i])->value);
+		}
+	}
+	/**
+	 * Check that the throughput accounts for every item of evidence.
+	 */
+	void verifyThroughput(
+		vector<BatchThroughput> &throughput,
+		size_t workers) {
+		size_t total = 0;
+		EXPECT_EQ(workers, throughput.size());
+		for (size_t i = 0; i < throughput.size(); i++) {
+			EXPECT_EQ(i, throughput[i].thread);
+			EXPECT_GE(throughput[i].seconds, 0);
+			total += throughput[i].count;
+		}
+		EXPECT_EQ(pointers.size(), total);
+	}
+	EvidenceBase evidence[1000];
+	vector<EvidenceBase*> pointers;
+	vector<ResultsBase*> results;
+};
+
+/**
+ * Check that a batch processed on the calling thread returns results in the
+ * same order as the evidence.
+ */
+TEST_F(EngineBaseTests, BatchSingleThread) {
+	BatchEngine engine(false);
+	vector<BatchThroughput> throughput = engine.processBatchBase(
+		pointers.data(),
+		pointers.size(),
+		results);
+	verifyOrder();
+	verifyThroughput(throughput, 1);
+}
+
+/**
+ * Check that a batch processed by several workers returns results in the
+ * same order as the evidence, and reports throughput for each worker.
+ */
+TEST_F(EngineBaseTests, BatchMultiThread) {
+	BatchEngine engine(false);
+	vector<BatchThroughput> throughput = engine.processBatchBase(
+		pointers.data(),
+		pointers.size(),
+		results,
+		4);
+	verifyOrder();
+	verifyThroughput(throughput, engine.getIsThreadSafe() ? 4 : 1);
+}
+
+/**
+ * Check that all the items in a batch use the data set pinned at the start
+ * of the batch even when the engine is refreshed, and that results from a
+ * previous batch are reused.
+ */
+TEST_F(EngineBaseTests, BatchPinnedAndReused) {
+	BatchEngine engine(true);
+	engine.processBatchBase(pointers.data(), pointers.size(), results, 4);
+	verifyOrder();
+	for (ResultsBase *item : results) {
+		EXPECT_EQ(&engine.dataSets[0], ((BatchResults*)item)->dataSet);
+		EXPECT_EQ(0, ((BatchResults*)item)->reused);
+	}
+	engine.processBatchBase(pointers.data(), pointers.size(), results, 4);
+	verifyOrder();
+	for (ResultsBase *item : results) {
+		EXPECT_EQ(&engine.dataSets[1], ((BatchResults*)item)->dataSet);
+		EXPECT_EQ(1, ((BatchResults*)item)->reused);
+	}
+}
+
+/**
+ * Check that items processed by the default processBatchItem also use the
+ * data set pinned at the start of the batch, and that no uses of the data
+ * set remain once the batch has finished.
+ */
+TEST_F(EngineBaseTests, BatchDefaultPinned) {
+	BatchEngine engine(false);
+	engine.processBatchBase(pointers.data(), pointers.size(), results, 4);
+	verifyOrder();
+	for (ResultsBase *item : results) {
+		EXPECT_EQ(&engine.dataSets[0], ((BatchResults*)item)->dataSet);
+	}
+	EXPECT_EQ(0, fiftyoneDegreesResourceHandleGetUse(
+		(fiftyoneDegreesResourceHandle*)engine.dataSets[1].handle));
+}
+
+/**
+ * Check that results beyond the end of a smaller batch are freed, and that
+ * an empty batch returns no results.
+ */
+TEST_F(EngineBaseTests, BatchShrinks) {
+	BatchEngine engine(false);
+	engine.processBatchBase(pointers.data(), pointers.size(), results, 2);
+	engine.processBatchBase(pointers.data(), 10, results, 2);
+	EXPECT_EQ(10u, results.size());
+	vector<BatchThroughput> throughput =
+		engine.processBatchBase(pointers.data(), 0, results, 2);
+	EXPECT_EQ(0u, results.size());
+	EXPECT_EQ(1u, throughput.size());
+}
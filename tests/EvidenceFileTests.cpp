@@ -0,0 +1,283 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include "../fiftyone.h"
+
+using namespace std;
+
+#define TEST_FILE "./evidenceFile_tmp"
+
+class EvidenceFileTests : public testing::Test {
+protected:
+	fiftyoneDegreesEvidenceFile file;
+	void SetUp() {
+		memset(&file, 0, sizeof(file));
+	}
+	void TearDown() {
+		EvidenceFileFree(&file);
+		remove(TEST_FILE);
+	}
+	void write(const char *contents) {
+		FILE *handle = fopen(TEST_FILE, "wb");
+		ASSERT_NE(nullptr, handle);
+		fwrite(contents, 1, strlen(contents), handle);
+		fclose(handle);
+	}
+	void assertPair(
+		uint32_t record,
+		uint32_t index,
+		EvidencePrefix prefix,
+		const char *key,
+		const char *value) {
+		ASSERT_LT(record, file.count);
+		ASSERT_LT(index, file.records[record].count);
+		EvidenceKeyValuePair *pair = &file.records[record].items[index];
+		EXPECT_EQ(prefix, pair->prefix);
+		EXPECT_STREQ(key, pair->item.key);
+		EXPECT_EQ(strlen(key), pair->item.keyLength);
+		EXPECT_STREQ(value, (const char*)pair->item.value);
+		EXPECT_EQ(strlen(value), pair->item.valueLength);
+		EXPECT_EQ(pair->item.value, pair->parsedValue);
+		EXPECT_EQ(pair->item.valueLength, pair->parsedLength);
+	}
+};
+
+/**
+ * Check that each document becomes a record with the prefix removed from the
+ * keys and the quotes removed from the values in the same way as
+ * YamlFileIterate.
+ */
+TEST_F(EvidenceFileTests, LoadYaml) {
+	write(
+		"---\n"
+		"header.User-Agent: 'Mozilla/5.0'\n"
+		"query.value: plain\n"
+		"---\n"
+		"---\r\n"
+		"header.Sec-CH-UA: \"Chromium\";v=\"8\"\r\n"
+		"header.Quoted: \"'wrapped\"\r\n"
+		"unknown.key: ignored\r\n"
+		"---\n"
+		"unknown.key: ignored\n"
+		"---\n"
+		"cookie.name: last");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, -1, &file));
+	ASSERT_EQ(3u, file.count);
+	EXPECT_EQ(5u, file.pairsCount);
+	ASSERT_EQ(2u, file.records[0].count);
+	assertPair(0, 0,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"User-Agent",
+		"Mozilla/5.0");
+	assertPair(0, 1, FIFTYONE_DEGREES_EVIDENCE_QUERY, "value", "plain");
+	ASSERT_EQ(2u, file.records[1].count);
+	assertPair(1, 0,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"Sec-CH-UA",
+		"\"Chromium\";v=\"8\"");
+	assertPair(1, 1,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"Quoted",
+		"'wrapped");
+	ASSERT_EQ(1u, file.records[2].count);
+	assertPair(2, 0, FIFTYONE_DEGREES_EVIDENCE_COOKIE, "name", "last");
+}
+
+/**
+ * Check that the records loaded match those returned by YamlFileIterate.
+ */
+static void yamlCallback(KeyValuePair *pairs, uint16_t size, void *state) {
+	vector<vector<string>> *documents = (vector<vector<string>>*)state;
+	vector<string> document;
+	for (uint16_t i = 0; i < size; i++) {
+		document.push_back(string(pairs[i].key) + "=" + pairs[i].value);
+	}
+	documents->push_back(document);
+}
+TEST_F(EvidenceFileTests, LoadYamlMatchesIterate) {
+	char buffer[1024];
+	char keys[4][50], values[4][100];
+	KeyValuePair pairs[4];
+	for (int i = 0; i < 4; i++) {
+		pairs[i].key = keys[i];
+		pairs[i].keyLength = sizeof(keys[i]);
+		pairs[i].value = values[i];
+		pairs[i].valueLength = sizeof(values[i]);
+	}
+	vector<vector<string>> expected;
+	write(
+		"header.a: 'one'\n"
+		"header.b: two words\n"
+		"---\n"
+		"query.c: \"  'three\"\n"
+		"server.client-ip: 1.2.3.4\n"
+		"---\n"
+		"header.d: 'four\n"
+		"...\n"
+		"header.e: after\n");
+	YamlFileIterate(TEST_FILE, buffer, sizeof(buffer), pairs, 4,
+		&expected, yamlCallback);
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, -1, &file));
+	ASSERT_EQ(expected.size(), file.count);
+	for (uint32_t r = 0; r < file.count; r++) {
+		ASSERT_EQ(expected[r].size(), file.records[r].count);
+		for (uint32_t p = 0; p < file.records[r].count; p++) {
+			EvidenceKeyValuePair *pair = &file.records[r].items[p];
+			string prefix = EvidencePrefixString(pair->prefix);
+			EXPECT_EQ(
+				expected[r][p],
+				prefix + pair->item.key + "=" +
+				(const char*)pair->item.value);
+		}
+	}
+}
+
+/**
+ * Check that no more records than the limit are loaded.
+ */
+TEST_F(EvidenceFileTests, LoadYamlLimit) {
+	write(
+		"header.a: 1\n---\nheader.b: 2\n---\nheader.c: 3\nheader.d: 4\n");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, 2, &file));
+	EXPECT_EQ(2u, file.count);
+	EXPECT_EQ(2u, file.pairsCount);
+	EvidenceFileFree(&file);
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, 0, &file));
+	EXPECT_EQ(0u, file.count);
+}
+
+/**
+ * Check that an empty file loads without any records.
+ */
+TEST_F(EvidenceFileTests, LoadEmpty) {
+	write("");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, -1, &file));
+	EXPECT_EQ(0u, file.count);
+	EXPECT_EQ(nullptr, file.records);
+	write("---\n---\n");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadYaml(TEST_FILE, -1, &file));
+	EXPECT_EQ(0u, file.count);
+}
+
+/**
+ * Check that a missing file returns the status code from the file methods.
+ */
+TEST_F(EvidenceFileTests, LoadMissing) {
+	EXPECT_EQ(FILE_NOT_FOUND,
+		EvidenceFileLoadYaml("./evidenceFileMissing_tmp", -1, &file));
+	EXPECT_EQ(0u, file.count);
+}
+
+/**
+ * Check that each line of a text file becomes a record with the key provided.
+ */
+TEST_F(EvidenceFileTests, LoadText) {
+	write("first line\r\n\r\nsecond\n\nthird");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadText(
+		TEST_FILE,
+		-1,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"User-Agent",
+		&file));
+	ASSERT_EQ(3u, file.count);
+	const char *expected[] = { "first line", "second", "third" };
+	for (uint32_t i = 0; i < file.count; i++) {
+		ASSERT_EQ(1u, file.records[i].count);
+		assertPair(i, 0,
+			FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+			"User-Agent",
+			expected[i]);
+	}
+	EvidenceFileFree(&file);
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadText(
+		TEST_FILE,
+		2,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"User-Agent",
+		&file));
+	EXPECT_EQ(2u, file.count);
+}
+
+typedef struct replay_test_state_t {
+	atomic<uint64_t> calls;
+	atomic<uint64_t> length;
+	atomic<uint32_t> threads;
+} replayTestState;
+
+static void replayMethod(
+	void *state,
+	uint16_t thread,
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence) {
+	replayTestState *test = (replayTestState*)state;
+	test->calls++;
+	test->threads |= 1 << thread;
+	for (uint32_t i = 0; i < evidence->count; i++) {
+		test->length += evidence->items[i].item.valueLength;
+	}
+}
+
+/**
+ * Check that every record is passed to the method for each pass and the
+ * latencies are ordered.
+ */
+TEST_F(EvidenceFileTests, Replay) {
+	ReplayResult result;
+	replayTestState state;
+	state.calls = 0;
+	state.length = 0;
+	state.threads = 0;
+	write("a\nbb\nccc\ndddd\n");
+	ASSERT_EQ(SUCCESS, EvidenceFileLoadText(
+		TEST_FILE,
+		-1,
+		FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING,
+		"User-Agent",
+		&file));
+	ASSERT_EQ(SUCCESS, ReplayRun(&file, 4, 1000, &state, replayMethod, &result));
+	EXPECT_EQ(4000u, result.count);
+	EXPECT_EQ(4000u, state.calls.load());
+	EXPECT_EQ(10000u, state.length.load());
+	EXPECT_NE(0u, state.threads.load());
+	EXPECT_EQ(0u, state.threads.load() & ~0xFu);
+	EXPECT_LE(result.minimum, result.median);
+	EXPECT_LE(result.median, result.p90);
+	EXPECT_LE(result.p90, result.p99);
+	EXPECT_LE(result.p99, result.p999);
+	EXPECT_LE(result.p999, result.maximum);
+	EXPECT_GT(result.perSecond, 0);
+}
+
+/**
+ * Check that replaying a file without records returns an empty result.
+ */
+TEST_F(EvidenceFileTests, ReplayEmpty) {
+	ReplayResult result;
+	replayTestState state;
+	state.calls = 0;
+	ASSERT_EQ(SUCCESS, ReplayRun(&file, 2, 10, &state, replayMethod, &result));
+	EXPECT_EQ(0u, result.count);
+	EXPECT_EQ(0u, state.calls.load());
+}
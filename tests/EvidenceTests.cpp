@@ -502,3 +502,96 @@ TEST_F(Evidence, IterateForHeaders_PseudoHeader_Lengths) {
     EXPECT_EQ(results[0].parsedLength, strlen(results[0].parsedValue.c_str()));
     EXPECT_EQ(results[0].parsedLength, 9);
 }
+
+/**
+ * Check that only the known headers in a raw header block are added, that
+ * the request line, continuation lines and anything after the empty line
+ * are ignored, and that the values point into the block.
+ */
+TEST_F(Evidence, AddHeaderBlock) {
+    const char *headers[] = { "User-Agent", "Accept" };
+    const char block[] =
+        "GET /index.html?a=b:c HTTP/1.1\r\n"
+        "Host: example.com\r\n"
+        "user-agent:  Mozilla/5.0 (Test)  \r\n"
+        " folded: line\r\n"
+        "Accept:\ttext/html\n"
+        "Bad Name: value\r\n"
+        "\r\n"
+        "Accept: body\r\n";
+    headersContainer.CreateHeaders(headers, 2, false);
+    CreateEvidence(1);
+    uint32_t count = fiftyoneDegreesEvidenceAddHeaderBlock(
+        evidence,
+        headersContainer.headers,
+        block,
+        sizeof(block) - 1);
+    ASSERT_EQ(2u, count);
+    ASSERT_EQ(1u, evidence->count);
+    ASSERT_NE(nullptr, evidence->next);
+    fiftyoneDegreesEvidenceKeyValuePair *agent = &evidence->items[0];
+    fiftyoneDegreesEvidenceKeyValuePair *accept = &evidence->next->items[0];
+    EXPECT_EQ(FIFTYONE_DEGREES_EVIDENCE_HTTP_HEADER_STRING, agent->prefix);
+    EXPECT_EQ("user-agent", std::string(agent->item.key, agent->item.keyLength));
+    EXPECT_EQ("Mozilla/5.0 (Test)",
+        std::string(agent->item.value, agent->item.valueLength));
+    EXPECT_EQ(&headersContainer.headers->items[0], agent->header);
+    EXPECT_EQ("text/html",
+        std::string(accept->item.value, accept->item.valueLength));
+    EXPECT_EQ(&headersContainer.headers->items[1], accept->header);
+    EXPECT_TRUE(accept->item.value > block &&
+        accept->item.value < block + sizeof(block));
+}
+
+/**
+ * Check that a block without an empty line or a final line break is read to
+ * the end, and that an empty block adds nothing.
+ */
+TEST_F(Evidence, AddHeaderBlock_Unterminated) {
+    const char *headers[] = { "Accept" };
+    const char block[] = "Accept: text/html";
+    headersContainer.CreateHeaders(headers, 1, false);
+    CreateEvidence(2);
+    EXPECT_EQ(0u, fiftyoneDegreesEvidenceAddHeaderBlock(
+        evidence,
+        headersContainer.headers,
+        block,
+        0));
+    EXPECT_EQ(1u, fiftyoneDegreesEvidenceAddHeaderBlock(
+        evidence,
+        headersContainer.headers,
+        block,
+        sizeof(block) - 1));
+    EXPECT_EQ("text/html", std::string(
+        evidence->items[0].item.value,
+        evidence->items[0].item.valueLength));
+}
+
+/**
+ * Check that only the known headers in an array of spans are added and
+ * bound to their header.
+ */
+TEST_F(Evidence, AddHeaderPairs) {
+    const char *headers[] = { "User-Agent", "Accept" };
+    const char names[] = "AcceptHostUser-Agent";
+    const char values[] = "text/htmlexample.comMozilla";
+    fiftyoneDegreesKeyValuePair pairs[] = {
+        { names, 6, values, 9 },
+        { names + 6, 4, values + 9, 11 },
+        { names + 10, 10, values + 20, 7 }
+    };
+    headersContainer.CreateHeaders(headers, 2, false);
+    CreateEvidence(3);
+    EXPECT_EQ(2u, fiftyoneDegreesEvidenceAddHeaderPairs(
+        evidence,
+        headersContainer.headers,
+        pairs,
+        3));
+    ASSERT_EQ(2u, evidence->count);
+    EXPECT_EQ(&headersContainer.headers->items[1], evidence->items[0].header);
+    EXPECT_EQ(values, evidence->items[0].item.value);
+    EXPECT_EQ(&headersContainer.headers->items[0], evidence->items[1].header);
+    EXPECT_EQ("Mozilla", std::string(
+        evidence->items[1].item.value,
+        evidence->items[1].item.valueLength));
+}
@@ -0,0 +1,548 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "../ip.h"
+#include "../fiftyone.h"
+#include <random>
+#include <string>
+
+/**
+ * Fuzz tests which check the single pass IP address parser gives the same
+ * results as the original two pass parser. The original parser is retained
+ * here as the reference implementation.
+ */
+namespace ReferenceIpParser {
+
+	typedef void(*parseIterator)(
+		void *state,
+		IpType segmentType,
+		const char *start,
+		const char *end);
+
+	static void callbackIpAddressCount(
+		void * const state,
+		const IpType segmentType,
+		const char * const start,
+		const char * const end) {
+		if (start <= end) {
+			if (segmentType != IP_TYPE_INVALID) {
+				(*(int*)state)++;
+				if (segmentType == IP_TYPE_IPV6) {
+					(*(int*)state)++;
+				}
+			}
+		}
+	}
+
+	static byte getIpByte(int parsedValue) {
+		if (parsedValue < 0) {
+			parsedValue = 0;
+		}
+		else if (parsedValue > UINT8_MAX) {
+			parsedValue = UINT8_MAX;
+		}
+		return (byte)parsedValue;
+	}
+
+	typedef struct {
+		IpAddress * const address;
+		byte *current;
+		int bytesPresent;
+		int abbreviationsFilled;
+		bool readPastEnd;
+	} IpAddressBuildState;
+
+	static void parseIpV6Segment(
+		IpAddressBuildState * const buildState,
+		const char * const start,
+		const char * const end) {
+		int i;
+		char first[3], second[3], val;
+		if (start > end) {
+			if (buildState->abbreviationsFilled) {
+				return;
+			}
+			buildState->abbreviationsFilled++;
+			for (i = 0; i < IPV6_LENGTH - buildState->bytesPresent; i++) {
+				*buildState->current = (byte)0;
+				buildState->current++;
+			}
+		}
+		else {
+			first[2] = '\0';
+			second[2] = '\0';
+			for (i = 0; i < IPV4_LENGTH; i++) {
+				if (end - i >= start) val = end[-i];
+				else val = '0';
+
+				if (i < 2) second[1 - i] = val;
+				else first[3 - i] = val;
+			}
+			*buildState->current = getIpByte((int)strtol(first, NULL, 16));
+			buildState->current++;
+			*buildState->current = getIpByte((int)strtol(second, NULL, 16));
+			buildState->current++;
+		}
+	}
+
+	static void callbackIpAddressBuild(
+		void * const state,
+		const IpType segmentType,
+		const char * const start,
+		const char * const end) {
+		IpAddressBuildState *const buildState = (IpAddressBuildState*)state;
+		if (segmentType == IP_TYPE_IPV4) {
+			// An empty segment at the end of an IPv6 address reads the
+			// characters after the address.
+			if (start > end && *start != '.' &&
+				buildState->address->type == IP_TYPE_IPV6) {
+				buildState->readPastEnd = true;
+			}
+			*buildState->current = getIpByte(atoi(start));
+			buildState->current++;
+		}
+		else if (segmentType == IP_TYPE_IPV6) {
+			parseIpV6Segment(buildState, start, end);
+		}
+	}
+
+	static IpType getIpTypeFromSeparator(const char separator) {
+		switch (separator) {
+		case '.':
+			return IP_TYPE_IPV4;
+		case ':':
+			return IP_TYPE_IPV6;
+		default:
+			return IP_TYPE_INVALID;
+		}
+	}
+
+	static IpType getSegmentTypeWithSeparator(
+		const char separator,
+		const IpType ipType,
+		const IpType lastSeparatorType) {
+		switch (ipType) {
+		case IP_TYPE_IPV4:
+			return IP_TYPE_IPV4;
+		case IP_TYPE_IPV6:
+			switch (separator) {
+			case ':':
+				return IP_TYPE_IPV6;
+			case '.':
+				return IP_TYPE_IPV4;
+			default:
+				return lastSeparatorType;
+			}
+		default:
+			return getIpTypeFromSeparator(separator);
+		}
+	}
+
+	enum SeparatorType {
+		NON_BREAK_CHAR = 0,
+		SEGMENT_BREAK_CHAR,
+		ADDRESS_BREAK_CHAR,
+		INVALID_CHAR,
+	};
+
+	static SeparatorType getSeparatorCharType(
+		const char ipChar,
+		const IpType ipType) {
+		switch (ipChar) {
+		case ':':
+			return ((ipType == IP_TYPE_IPV4)
+				? ADDRESS_BREAK_CHAR : SEGMENT_BREAK_CHAR);
+		case '.':
+			return SEGMENT_BREAK_CHAR;
+		case ',':
+		case ' ':
+		case ']':
+		case '/':
+		case '\0':
+		case '\n':
+			return ADDRESS_BREAK_CHAR;
+		default:
+			break;
+		}
+		if ('0' <= ipChar && ipChar <= '9') {
+			return NON_BREAK_CHAR;
+		}
+		if (('a' <= ipChar && ipChar <= 'f') ||
+			('A' <= ipChar && ipChar <= 'F')) {
+			return (ipType == IP_TYPE_IPV4
+				? INVALID_CHAR : NON_BREAK_CHAR);
+		}
+		return INVALID_CHAR;
+	}
+
+	static int8_t getMaxSegmentLengthForIpType(const IpType ipType) {
+		return (ipType == IP_TYPE_IPV4) ? 3 : 4;
+	}
+
+	static IpType iterateIpAddress(
+		const char *start,
+		const char * const end,
+		void * const state,
+		int * const springCount,
+		IpType type,
+		const parseIterator foundSegment) {
+
+		const char * const postEnd = end + 1;
+
+		*springCount = 0;
+		if (*start == '[') {
+			if (type == IP_TYPE_IPV4) {
+				return IP_TYPE_INVALID;
+			}
+			start++;
+		}
+
+		IpType currentSegmentType = IP_TYPE_INVALID;
+
+		const char *current = start;
+		const char *nextSegment = current;
+		for (; current <= postEnd && nextSegment <= postEnd; ++current) {
+			char nextChar = 0;
+			if (current < postEnd) {
+				nextChar = *current;
+			}
+			SeparatorType separatorType =
+				getSeparatorCharType(nextChar, type);
+			if (!separatorType) {
+				continue;
+			}
+			if (separatorType == INVALID_CHAR) {
+				return IP_TYPE_INVALID;
+			}
+
+			currentSegmentType = getSegmentTypeWithSeparator(
+				nextChar, type, currentSegmentType);
+			if (type == IP_TYPE_INVALID) {
+				type = currentSegmentType;
+			}
+
+			if (current - nextSegment > getMaxSegmentLengthForIpType(type)) {
+				return IP_TYPE_INVALID;
+			}
+
+			if (current - 1 >= start) {
+				foundSegment(state, currentSegmentType,
+					nextSegment, current - 1);
+			}
+			if (separatorType == ADDRESS_BREAK_CHAR) {
+				return type;
+			}
+			if (current == nextSegment && current != start) {
+				++*springCount;
+			}
+			nextSegment = current + 1;
+		}
+		if (nextSegment < current && type != IP_TYPE_INVALID) {
+			foundSegment(state, currentSegmentType,
+				nextSegment, current - 1);
+		}
+		return type;
+	}
+
+	static bool parse(
+		const char * const start,
+		const char * const end,
+		IpAddress * const address,
+		bool * const undefined) {
+
+		int byteCount = 0;
+		int springCount = 0;
+		IpType type = iterateIpAddress(
+			start,
+			end,
+			&byteCount,
+			&springCount,
+			IP_TYPE_INVALID,
+			callbackIpAddressCount);
+
+		switch (type) {
+		case IP_TYPE_IPV4:
+			if (byteCount != IPV4_LENGTH || springCount) {
+				return false;
+			}
+			break;
+		case IP_TYPE_IPV6:
+			if (byteCount > IPV6_LENGTH ||
+				springCount > 1 ||
+				(byteCount < IPV6_LENGTH && !springCount)) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+
+		address->type = type;
+		IpAddressBuildState buildState = {
+			address,
+			address->value,
+			byteCount,
+			0,
+			false,
+		};
+		iterateIpAddress(
+			start,
+			end,
+			&buildState,
+			&springCount,
+			type,
+			callbackIpAddressBuild);
+
+		// Empty IPv4 segments write a byte which was not counted, so more
+		// than 16 bytes can be written, overwriting the type. At the end of
+		// an IPv6 address the byte depends on the following characters.
+		*undefined = buildState.current > address->value + IPV6_LENGTH ||
+			buildState.readPastEnd;
+		return true;
+	}
+}
+
+static size_t addressLength(const IpAddress &address) {
+	return address.type == IP_TYPE_IPV4 ? IPV4_LENGTH : IPV6_LENGTH;
+}
+
+static bool sameAddress(const IpAddress &a, const IpAddress &b) {
+	return a.type == b.type &&
+		memcmp(a.value, b.value, addressLength(a)) == 0;
+}
+
+/**
+ * Outcome of the reference parser for an input.
+ */
+enum ReferenceResult {
+	REFERENCE_INVALID, /**< The reference parser rejected the input */
+	REFERENCE_VALID, /**< The reference parser gave a complete address */
+	REFERENCE_UNDEFINED /**< The reference parser returned true but the
+						address depends on the memory it was given, or the
+						type was overwritten. These inputs are rejected by
+						the single pass parser. */
+};
+
+static ReferenceResult parseReference(
+	const char *start,
+	const char *end,
+	IpAddress *address) {
+	IpAddress other;
+	bool undefined = false, undefinedOther = false;
+	memset(address, 0x00, sizeof(IpAddress));
+	memset(&other, 0xFF, sizeof(IpAddress));
+	bool parsed = ReferenceIpParser::parse(start, end, address, &undefined);
+	bool parsedOther = ReferenceIpParser::parse(
+		start,
+		end,
+		&other,
+		&undefinedOther);
+	if (parsed == false && parsedOther == false) {
+		return REFERENCE_INVALID;
+	}
+	if (parsed != parsedOther ||
+		undefined ||
+		undefinedOther ||
+		(address->type != IP_TYPE_IPV4 && address->type != IP_TYPE_IPV6) ||
+		sameAddress(*address, other) == false) {
+		return REFERENCE_UNDEFINED;
+	}
+	return REFERENCE_VALID;
+}
+
+class IpParserFuzz : public ::testing::Test {
+protected:
+	std::mt19937 random{ 51 };
+	int valid = 0;
+	int invalid = 0;
+	int undefined = 0;
+
+	int next(int max) {
+		return std::uniform_int_distribution<int>(0, max - 1)(random);
+	}
+
+	/**
+	 * Checks the single pass parser against the reference for the input
+	 * with end being the last character considered.
+	 */
+	void check(const std::string &input, size_t endIndex) {
+		const char *start = input.c_str();
+		const char *end = start + endIndex;
+		IpAddress expected, actual;
+		memset(&actual, 0xAA, sizeof(IpAddress));
+
+		// The reference parser reads the last IPv4 segment with atoi which
+		// can run past the end, so give it a copy which is terminated after
+		// the last character to be considered.
+		std::string truncated = input.substr(0, endIndex + 1);
+		ReferenceResult reference = parseReference(
+			truncated.c_str(),
+			truncated.c_str() + endIndex,
+			&expected);
+		bool parsed = IpAddressParse(start, end, &actual);
+		switch (reference) {
+		case REFERENCE_VALID:
+			valid++;
+			ASSERT_TRUE(parsed) << "Expected '" << input <<
+				"' ending at " << endIndex << " to parse";
+			ASSERT_TRUE(sameAddress(expected, actual)) <<
+				"Different address for '" << input << "' ending at " <<
+				endIndex;
+			break;
+		case REFERENCE_INVALID:
+			invalid++;
+			ASSERT_FALSE(parsed) << "Expected '" << input << "' to fail";
+			break;
+		case REFERENCE_UNDEFINED:
+			undefined++;
+			ASSERT_FALSE(parsed) << "Expected '" << input << "' to fail";
+			break;
+		}
+	}
+
+	void check(const std::string &input) {
+		check(input, input.size());
+		if (input.empty() == false) {
+			check(input, (size_t)next((int)input.size()));
+		}
+	}
+
+	std::string hexSegment() {
+		static const char hex[] = "0123456789abcdefABCDEF";
+		std::string segment;
+		int length = 1 + next(4);
+		for (int i = 0; i < length; i++) {
+			segment += hex[next(sizeof(hex) - 1)];
+		}
+		return segment;
+	}
+
+	std::string ipv4() {
+		std::string address;
+		for (int i = 0; i < 4; i++) {
+			if (i > 0) address += '.';
+			address += std::to_string(next(3) == 0 ? next(10) : next(256));
+		}
+		return address;
+	}
+
+	std::string ipv6() {
+		bool embedded = next(4) == 0;
+		int groups = embedded ? 6 : 8;
+		int springAt = next(3) == 0 ? -1 : next(groups);
+		int springLength = springAt < 0 ? 0 : 1 + next(groups - springAt);
+		std::string address;
+		for (int i = 0; i < groups; i++) {
+			if (i == springAt) {
+				address += "::";
+				i += springLength - 1;
+				continue;
+			}
+			if (address.empty() == false && address.back() != ':') {
+				address += ':';
+			}
+			address += hexSegment();
+		}
+		if (embedded) {
+			if (address.empty() == false && address.back() != ':') {
+				address += ':';
+			}
+			address += ipv4();
+		}
+		if (next(4) == 0) {
+			address = "[" + address + "]";
+			if (next(2) == 0) address += ":" + std::to_string(next(65536));
+		}
+		return address;
+	}
+
+	std::string address() {
+		std::string address = next(2) == 0 ? ipv4() : ipv6();
+		switch (next(6)) {
+		case 0: address += ":" + std::to_string(next(65536)); break;
+		case 1: address += "/" + std::to_string(next(129)); break;
+		case 2: address += ", " + ipv4(); break;
+		default: break;
+		}
+		return address;
+	}
+
+	std::string mutate(std::string input) {
+		static const char alphabet[] = "0123456789abcdefABCDEF.:[]/, \ng%";
+		int mutations = 1 + next(3);
+		for (int i = 0; i < mutations; i++) {
+			size_t position = input.empty() ? 0 : next((int)input.size());
+			char c = alphabet[next(sizeof(alphabet) - 1)];
+			switch (next(3)) {
+			case 0: input.insert(position, 1, c); break;
+			case 1: if (input.empty() == false) input.erase(position, 1); break;
+			default: if (input.empty() == false) input[position] = c; break;
+			}
+		}
+		return input;
+	}
+
+	std::string randomString() {
+		static const char alphabet[] = "0123456789abcdefABCDEF.:::...[], ";
+		std::string input;
+		int length = next(40);
+		for (int i = 0; i < length; i++) {
+			input += alphabet[next(sizeof(alphabet) - 1)];
+		}
+		return input;
+	}
+};
+
+TEST_F(IpParserFuzz, WellFormed) {
+	for (int i = 0; i < 20000 && !HasFatalFailure(); i++) {
+		check(address());
+	}
+	EXPECT_GT(valid, 20000);
+}
+
+TEST_F(IpParserFuzz, Mutated) {
+	for (int i = 0; i < 50000 && !HasFatalFailure(); i++) {
+		check(mutate(address()));
+	}
+	EXPECT_GT(valid, 1000);
+	EXPECT_GT(invalid, 1000);
+}
+
+TEST_F(IpParserFuzz, Random) {
+	for (int i = 0; i < 50000 && !HasFatalFailure(); i++) {
+		check(randomString());
+	}
+	EXPECT_GT(invalid, 1000);
+}
+
+TEST_F(IpParserFuzz, Quirks) {
+	const char *inputs[] = {
+		"256.256.256.256", "1.2.3.4.", ".1.2.3.4", "1.2.3.4:80",
+		"1:2:3:4:5:6:7::8", "1:2:3:4:5:6:7:8:", ":1::2", "::1.2",
+		"::a.1.2.3", "::1a.2", "1::2.3.", "1:.2", "a1.2.3.4", "[1.2.3.4]",
+		"[::1]", "::ffff:1.2.3.4", "9999::1.2.3.4"
+	};
+	for (const char *input : inputs) {
+		check(input);
+	}
+}
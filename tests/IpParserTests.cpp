@@ -344,6 +344,100 @@ TEST(ParseIp, ParseIp_Invalid_ipv6TooFew)
 	EXPECT_FALSE(result);
 }
 // ------------------------------------------------------------------------------
+// Multiple addresses
+// ------------------------------------------------------------------------------
+static uint32_t parseIpAddresses(
+	const char * const ipString,
+	IpAddress * const addresses,
+	const uint32_t capacity) {
+	return IpAddressesParse(
+		ipString,
+		ipString + strlen(ipString),
+		addresses,
+		capacity);
+}
+TEST(ParseIps, ParseIps_ForwardedFor)
+{
+	IpAddress addresses[4];
+	const uint32_t count = parseIpAddresses(
+		"203.0.113.195, 2001:db8:85a3::8a2e:370:7334,150.172.238.178",
+		addresses,
+		4);
+	const byte expected0[] = { 203, 0, 113, 195 };
+	const byte expected1[] = {
+		0x20, 0x01, 0x0d, 0xb8, 0x85, 0xa3, 0, 0,
+		0, 0, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x34 };
+	const byte expected2[] = { 150, 172, 238, 178 };
+	ASSERT_EQ(3u, count);
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[0].type);
+	EXPECT_TRUE(CheckResult(addresses[0].value, expected0, sizeof(expected0)));
+	EXPECT_EQ(IP_TYPE_IPV6, addresses[1].type);
+	EXPECT_TRUE(CheckResult(addresses[1].value, expected1, sizeof(expected1)));
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[2].type);
+	EXPECT_TRUE(CheckResult(addresses[2].value, expected2, sizeof(expected2)));
+}
+TEST(ParseIps, ParseIps_PortsAndBrackets)
+{
+	IpAddress addresses[4];
+	const uint32_t count = parseIpAddresses(
+		"1.2.3.4:80 , [2001::1]:443,5.6.7.8/32",
+		addresses,
+		4);
+	const byte expected1[] = { 32, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+	ASSERT_EQ(3u, count);
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[0].type);
+	EXPECT_EQ(IP_TYPE_IPV6, addresses[1].type);
+	EXPECT_TRUE(CheckResult(addresses[1].value, expected1, sizeof(expected1)));
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[2].type);
+	EXPECT_EQ(8, addresses[2].value[3]);
+}
+TEST(ParseIps, ParseIps_InvalidEntryKeepsPosition)
+{
+	IpAddress addresses[4];
+	const uint32_t count = parseIpAddresses(
+		"unknown, 1.2.3.4",
+		addresses,
+		4);
+	ASSERT_EQ(2u, count);
+	EXPECT_EQ(IP_TYPE_INVALID, addresses[0].type);
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[1].type);
+	EXPECT_EQ(4, addresses[1].value[3]);
+}
+TEST(ParseIps, ParseIps_EmptyEntries)
+{
+	IpAddress addresses[4];
+	EXPECT_EQ(0u, parseIpAddresses("", addresses, 4));
+	EXPECT_EQ(0u, parseIpAddresses(" , ,", addresses, 4));
+	EXPECT_EQ(2u, parseIpAddresses(",1.2.3.4,, ::1 ,", addresses, 4));
+	EXPECT_EQ(IP_TYPE_IPV4, addresses[0].type);
+	EXPECT_EQ(IP_TYPE_IPV6, addresses[1].type);
+	EXPECT_EQ(1, addresses[1].value[15]);
+}
+TEST(ParseIps, ParseIps_Capacity)
+{
+	IpAddress addresses[2];
+	EXPECT_EQ(2u, parseIpAddresses("1.1.1.1, 2.2.2.2, 3.3.3.3", addresses, 2));
+	EXPECT_EQ(2, addresses[1].value[0]);
+	EXPECT_EQ(0u, parseIpAddresses("1.1.1.1", addresses, 0));
+}
+TEST(ParseIps, ParseIps_MatchesSingle)
+{
+	const char *header = "10.0.0.1, ::ffff:192.0.2.1, fe80::1:2, 255.255.255.255";
+	const char *entries[] = {
+		"10.0.0.1", "::ffff:192.0.2.1", "fe80::1:2", "255.255.255.255" };
+	IpAddress addresses[4];
+	ASSERT_EQ(4u, parseIpAddresses(header, addresses, 4));
+	for (int i = 0; i < 4; i++) {
+		auto const single = parseIpAddressString(entries[i]);
+		ASSERT_TRUE(single);
+		EXPECT_EQ(single->type, addresses[i].type);
+		EXPECT_TRUE(CheckResult(
+			single->value,
+			addresses[i].value,
+			single->type == IP_TYPE_IPV4 ? IPV4_LENGTH : IPV6_LENGTH));
+	}
+}
+// ------------------------------------------------------------------------------
 // Comparison
 // ------------------------------------------------------------------------------
 TEST(CompareIp, CompareIp_Ipv4_Bigger) {
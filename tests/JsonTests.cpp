@@ -30,6 +30,9 @@ public:
     JsonTests();
     virtual ~JsonTests();
     void CreateObjects();
+    void WriteDocument(
+        fiftyoneDegreesJson *json,
+        fiftyoneDegreesException *exception);
     
     StringCollection *stringsCollectionHelper;
     FixedSizeCollection<fiftyoneDegreesProperty> *propertiesCollectionHelper;
@@ -51,7 +54,7 @@ const char *JsonTests::strings[] = {
     "Color",        "Black", "Blue", "Green", "Red", "Yellow",   //6
     "Condition",    "\"Bro\\ken\"", "New", "Old", "Pristine", "Worn",  //12
     "Flexibility",  "\t\r\f\bBendable\n", "Flexible", "Pliable", "Rigid", "Stiff", //18 - some special characters
-    "Material",     "Fabric", "Glass", "Metal", "Plastic", "Wood", //24
+    "Material",     "Fabric with a run of clean characters \x01\x1f\\ and more clean characters\x7f\u00e9", "Glass", "Metal", "Plastic", "Wood", //24
     "Opacity",      "Opaque", "Semi-opaque", "Semi-transparent", "Translucent", "Transparent", //30
     "Pattern",      "Checkered", "Dotted", "Floral", "Plain", "Striped", //36
     "Position",     "Diagonal", "Horizontal", "Tilted", "Upside-down", "Vertical", //42
@@ -126,20 +129,10 @@ void JsonTests::CreateObjects() {
     propertiesCollection = propertiesCollectionHelper->getState()->collection;
 }
 
-TEST_F(JsonTests, basicJsonForming) {
-    FIFTYONE_DEGREES_EXCEPTION_CREATE;
-    fiftyoneDegreesStringBuilder builder {(char * const)fiftyoneDegreesMalloc(BUFFER_SIZE), BUFFER_SIZE};
-    
-    fiftyoneDegreesJson json {
-        builder, /**< Output buffer */
-        stringsCollection, /**< Collection of strings */
-        NULL, /**< The property being added */
-        NULL, /**< The values for the property */
-        exception, /**< Exception */
-        FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING, /**< Stored property type */
-    };
-    
-    fiftyoneDegreesJsonDocumentStart(&json);
+void JsonTests::WriteDocument(
+    fiftyoneDegreesJson *json,
+    fiftyoneDegreesException *exception) {
+    fiftyoneDegreesJsonDocumentStart(json);
         for (uint32_t propIdx = 0; propIdx < 4; ++propIdx) {
             fiftyoneDegreesProperty *property =  fiftyoneDegreesPropertyGet(propertiesCollection, propIdx, &item, exception);
             fiftyoneDegreesList valuesList;
@@ -158,22 +151,38 @@ TEST_F(JsonTests, basicJsonForming) {
                 fiftyoneDegreesListAdd(&valuesList, &valueItem2);
             }
             
-            json.property = property;
-            json.values = &valuesList;
+            json->property = property;
+            json->values = &valuesList;
             
             if (propIdx > 0) {
-                fiftyoneDegreesJsonPropertySeparator(&json);
+                fiftyoneDegreesJsonPropertySeparator(json);
             }
             
-            fiftyoneDegreesJsonPropertyStart(&json);
-                fiftyoneDegreesJsonPropertyValues(&json);
-            fiftyoneDegreesJsonPropertyEnd(&json);
+            fiftyoneDegreesJsonPropertyStart(json);
+                fiftyoneDegreesJsonPropertyValues(json);
+            fiftyoneDegreesJsonPropertyEnd(json);
             fiftyoneDegreesListFree(&valuesList);
         }
 
-    fiftyoneDegreesJsonDocumentEnd(&json);
+    fiftyoneDegreesJsonDocumentEnd(json);
+}
 
-    EXPECT_STREQ(json.builder.ptr, "{\"Brightness\":\"Bright\",\"Color\":[\"Black\",\"Blue\"],\"Condition\":\"\\\"Bro\\ken\\\"\",\"Flexibility\":\"\\t\\r\\f\\bBendable\\n\"}");
+TEST_F(JsonTests, basicJsonForming) {
+    FIFTYONE_DEGREES_EXCEPTION_CREATE;
+    fiftyoneDegreesStringBuilder builder {(char * const)fiftyoneDegreesMalloc(BUFFER_SIZE), BUFFER_SIZE};
+    
+    fiftyoneDegreesJson json {
+        builder, /**< Output buffer */
+        stringsCollection, /**< Collection of strings */
+        NULL, /**< The property being added */
+        NULL, /**< The values for the property */
+        exception, /**< Exception */
+        FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING, /**< Stored property type */
+    };
+    
+    WriteDocument(&json, exception);
+
+    EXPECT_STREQ(json.builder.ptr, "{\"Brightness\":\"Bright\",\"Color\":[\"Black\",\"Blue\"],\"Condition\":\"\\\"Bro\\\\ken\\\"\",\"Flexibility\":\"\\t\\r\\f\\bBendable\\n\"}");
 
     fiftyoneDegreesFree(builder.ptr);
 }
@@ -216,3 +225,68 @@ TEST_F(JsonTests, unhappyPaths) {
     
     fiftyoneDegreesFree(builder.ptr);
 }
+
+TEST_F(JsonTests, writerJsonForming) {
+    FIFTYONE_DEGREES_EXCEPTION_CREATE;
+    char chunk[8];
+    fiftyoneDegreesStringBuilderGrowable output = { NULL, 0, 0 };
+    fiftyoneDegreesStringBuilder builder { chunk, sizeof(chunk) };
+    fiftyoneDegreesStringBuilderInitWriter(
+        &builder,
+        fiftyoneDegreesStringBuilderGrowableWrite,
+        &output);
+
+    fiftyoneDegreesJson json {
+        builder, /**< Output buffer */
+        stringsCollection, /**< Collection of strings */
+        NULL, /**< The property being added */
+        NULL, /**< The values for the property */
+        exception, /**< Exception */
+        FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING, /**< Stored property type */
+    };
+    WriteDocument(&json, exception);
+
+    EXPECT_FALSE(json.builder.full);
+    EXPECT_EQ(output.length + 1, json.builder.added);
+    EXPECT_STREQ(output.ptr, "{\"Brightness\":\"Bright\",\"Color\":[\"Black\",\"Blue\"],\"Condition\":\"\\\"Bro\\\\ken\\\"\",\"Flexibility\":\"\\t\\r\\f\\bBendable\\n\"}");
+
+    fiftyoneDegreesStringBuilderGrowableFree(&output);
+}
+
+TEST_F(JsonTests, escapeControlCharacters) {
+    FIFTYONE_DEGREES_EXCEPTION_CREATE;
+    fiftyoneDegreesStringBuilder builder {(char * const)fiftyoneDegreesMalloc(BUFFER_SIZE), BUFFER_SIZE};
+
+    fiftyoneDegreesJson json {
+        builder, /**< Output buffer */
+        stringsCollection, /**< Collection of strings */
+        NULL, /**< The property being added */
+        NULL, /**< The values for the property */
+        exception, /**< Exception */
+        FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING, /**< Stored property type */
+    };
+
+    fiftyoneDegreesList valuesList;
+    fiftyoneDegreesListInit(&valuesList, 1);
+    fiftyoneDegreesCollectionItem valueItem;
+    const uint32_t propIdx = 4;
+    json.property = fiftyoneDegreesPropertyGet(propertiesCollection, propIdx, &item, exception);
+    const fiftyoneDegreesValue *value = fiftyoneDegreesValueGet(valuesCollection, propIdx * (N_PER_PROPERTY - 1), &valueItem, exception);
+    fiftyoneDegreesValueGetName(stringsCollection, value, &valueItem, exception);
+    fiftyoneDegreesListAdd(&valuesList, &valueItem);
+    json.values = &valuesList;
+
+    fiftyoneDegreesJsonDocumentStart(&json);
+    fiftyoneDegreesJsonPropertyStart(&json);
+    fiftyoneDegreesJsonPropertyValues(&json);
+    fiftyoneDegreesJsonPropertyEnd(&json);
+    fiftyoneDegreesJsonDocumentEnd(&json);
+    fiftyoneDegreesListFree(&valuesList);
+
+    // Control characters are escaped as unicode, other characters including
+    // DEL and multi-byte UTF-8 sequences are unchanged.
+    EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+    EXPECT_STREQ(json.builder.ptr, "{\"Material\":\"Fabric with a run of clean characters \\u0001\\u001f\\\\ and more clean characters\x7f\u00e9\"}");
+
+    fiftyoneDegreesFree(builder.ptr);
+}
@@ -0,0 +1,264 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "Base.hpp"
+#include "../fiftyone.h"
+
+#define ACCOUNTING_THREADS 4
+#define ACCOUNTING_ALLOCATIONS 200
+#define ACCOUNTING_SIZE 1000
+
+/**
+ * Unit tests for the accounting allocator. The allocator is set up for the
+ * duration of each test so that the subsystem create methods allocate with
+ * it.
+ */
+class MemoryAccounting : public Base {
+public:
+	void SetUp() {
+		Base::SetUp();
+		fiftyoneDegreesSetUpMemoryAccounting();
+	}
+	void TearDown() {
+		fiftyoneDegreesMemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_OTHER);
+		EXPECT_EQ(0u, fiftyoneDegreesUnsetMemoryAccounting()) <<
+			"Memory allocated while accounting was not freed.";
+		Base::TearDown();
+	}
+	fiftyoneDegreesMemoryAccountingStats get(fiftyoneDegreesMemoryTag tag) {
+		fiftyoneDegreesMemoryAccountingStats stats;
+		fiftyoneDegreesMemoryAccountingGet(tag, &stats);
+		return stats;
+	}
+	static void* runThread(void* state) {
+		void *pointers[ACCOUNTING_ALLOCATIONS];
+		(void)state;
+		fiftyoneDegreesMemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
+		for (int i = 0; i < ACCOUNTING_ALLOCATIONS; i++) {
+			pointers[i] = fiftyoneDegreesMalloc(ACCOUNTING_SIZE);
+		}
+		fiftyoneDegreesMemoryAccountingFlush();
+		for (int i = 0; i < ACCOUNTING_ALLOCATIONS; i++) {
+			fiftyoneDegreesFree(pointers[i]);
+		}
+		fiftyoneDegreesMemoryAccountingFlush();
+		FIFTYONE_DEGREES_THREAD_EXIT;
+#if defined(__MINGW32__) || defined(__MINGW64__)
+		return NULL;
+#endif
+	}
+};
+
+/**
+ * Check that allocations are attributed to the current tag and that the peak
+ * is retained after the memory is freed.
+ */
+TEST_F(MemoryAccounting, LiveAndPeak) {
+	fiftyoneDegreesMemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_CACHES);
+	void *first = fiftyoneDegreesMalloc(100);
+	void *second = fiftyoneDegreesMalloc(50);
+	ASSERT_NE(nullptr, first);
+	ASSERT_NE(nullptr, second);
+	EXPECT_EQ(150u, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	fiftyoneDegreesFree(first);
+	EXPECT_EQ(50u, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live);
+	EXPECT_EQ(150u, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).peak);
+
+	// Memory is removed from the tag it was allocated against, not the
+	// current tag.
+	fiftyoneDegreesMemoryAccountingSetTag(FIFTYONE_DEGREES_MEMORY_TAG_OTHER);
+	fiftyoneDegreesFree(second);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+}
+
+/**
+ * Check that aligned allocations are aligned and accounted for.
+ */
+TEST_F(MemoryAccounting, Aligned) {
+	int alignments[] = { 8, 16, 32, 64, 128 };
+	for (int alignment : alignments) {
+		void *pointer = fiftyoneDegreesMallocAligned(alignment, 100);
+		ASSERT_NE(nullptr, pointer);
+		EXPECT_EQ(0u, (uintptr_t)pointer % alignment);
+		memset(pointer, 0xFF, 100);
+		EXPECT_EQ(100u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+		fiftyoneDegreesFreeAligned(pointer);
+		EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	}
+}
+
+/**
+ * Check that setting the tag returns the previous one so it can be restored.
+ */
+TEST_F(MemoryAccounting, SetTagRestore) {
+	EXPECT_EQ(
+		FIFTYONE_DEGREES_MEMORY_TAG_OTHER,
+		fiftyoneDegreesMemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_HEADERS));
+	EXPECT_EQ(
+		FIFTYONE_DEGREES_MEMORY_TAG_HEADERS,
+		fiftyoneDegreesMemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_OTHER));
+}
+
+/**
+ * Check that the subsystem create methods attribute their memory to the
+ * subsystem's tag and restore the caller's tag.
+ */
+TEST_F(MemoryAccounting, Subsystems) {
+	fiftyoneDegreesEvidenceKeyValuePairArray *evidence =
+		fiftyoneDegreesEvidenceCreate(10);
+	ASSERT_NE(nullptr, evidence);
+	EXPECT_LT(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_EVIDENCE).live);
+
+	fiftyoneDegreesOverrideValueArray *overrides =
+		fiftyoneDegreesOverrideValuesCreate(10);
+	ASSERT_NE(nullptr, overrides);
+	EXPECT_LT(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES).live);
+
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(4, 16);
+	ASSERT_NE(nullptr, cache);
+	size_t cacheLive = get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live;
+	EXPECT_LT(0u, cacheLive);
+	ASSERT_NE(nullptr, fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "Value", 5));
+	EXPECT_LT(cacheLive, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live);
+
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	EXPECT_EQ(
+		FIFTYONE_DEGREES_MEMORY_TAG_OTHER,
+		fiftyoneDegreesMemoryAccountingSetTag(
+			FIFTYONE_DEGREES_MEMORY_TAG_OTHER));
+
+	fiftyoneDegreesRenderCacheFree(cache);
+	fiftyoneDegreesOverrideValuesFree(overrides);
+	fiftyoneDegreesEvidenceFree(evidence);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_CACHES).live);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES).live);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_EVIDENCE).live);
+}
+
+/**
+ * Check that the counters are consistent when several threads allocate and
+ * free against the same tag, and that the peak includes each thread's
+ * allocations once flushed.
+ */
+TEST_F(MemoryAccounting, MultiThreaded) {
+	if (fiftyoneDegreesThreadingGetIsThreadSafe() == false) {
+		return;
+	}
+	runThreads(
+		ACCOUNTING_THREADS,
+		(FIFTYONE_DEGREES_THREAD_ROUTINE)runThread);
+	fiftyoneDegreesMemoryAccountingStats stats =
+		get(FIFTYONE_DEGREES_MEMORY_TAG_COLLECTIONS);
+	EXPECT_EQ(0u, stats.live);
+	EXPECT_LE(
+		(size_t)ACCOUNTING_ALLOCATIONS * ACCOUNTING_SIZE,
+		stats.peak);
+	EXPECT_GE(
+		(size_t)ACCOUNTING_THREADS * ACCOUNTING_ALLOCATIONS * ACCOUNTING_SIZE,
+		stats.peak);
+}
+
+/**
+ * Check the names of the tags.
+ */
+TEST_F(MemoryAccounting, TagNames) {
+	EXPECT_STREQ("other",
+		fiftyoneDegreesMemoryTagGetName(FIFTYONE_DEGREES_MEMORY_TAG_OTHER));
+	EXPECT_STREQ("overrides",
+		fiftyoneDegreesMemoryTagGetName(
+			FIFTYONE_DEGREES_MEMORY_TAG_OVERRIDES));
+	EXPECT_STREQ("dataset",
+		fiftyoneDegreesMemoryTagGetName(
+			FIFTYONE_DEGREES_MEMORY_TAG_DATA_SET));
+	EXPECT_EQ(nullptr,
+		fiftyoneDegreesMemoryTagGetName(FIFTYONE_DEGREES_MEMORY_TAG_COUNT));
+}
+
+/**
+ * Check that large allocations use Malloc unless huge pages are enabled, in
+ * which case on Linux they are mapped outside the accounting and aligned to
+ * the huge page size. Either way they can be freed with MemoryLargeFree.
+ */
+TEST_F(MemoryAccounting, LargeHugePages) {
+	const size_t size = 3 * 1024 * 1024;
+	EXPECT_EQ(FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE,
+		fiftyoneDegreesMemoryGetHugePages());
+	byte *standard = (byte*)fiftyoneDegreesMemoryLargeMalloc(size);
+	ASSERT_NE(nullptr, standard);
+	EXPECT_EQ(size, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	fiftyoneDegreesMemoryLargeFree(standard);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+
+	for (fiftyoneDegreesMemoryHugePages hugePages : {
+		FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_ADVISE,
+		FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_RESERVED }) {
+		fiftyoneDegreesMemorySetHugePages(hugePages);
+		byte *huge = (byte*)fiftyoneDegreesMemoryLargeMalloc(size);
+		ASSERT_NE(nullptr, huge);
+		memset(huge, 0x51, size);
+		EXPECT_EQ(0x51, huge[size - 1]);
+#ifdef __linux__
+		EXPECT_EQ(0u, (uintptr_t)huge % (2 * 1024 * 1024));
+		EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+#endif
+		fiftyoneDegreesMemoryLargeFree(huge);
+		EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	}
+	fiftyoneDegreesMemorySetHugePages(FIFTYONE_DEGREES_MEMORY_HUGE_PAGES_NONE);
+}
+
+/**
+ * Check that a data file read into memory is attributed to the data set tag.
+ */
+TEST_F(MemoryAccounting, DataSetInMemory) {
+	const char *fileName = "MemoryAccountingTests.dat";
+	const size_t size = 1000;
+	FILE *file = fopen(fileName, "wb");
+	ASSERT_NE(nullptr, file);
+	for (size_t i = 0; i < size; i++) {
+		fputc((int)(i & 0xFF), file);
+	}
+	fclose(file);
+
+	fiftyoneDegreesDataSetBase *dataSet =
+		(fiftyoneDegreesDataSetBase*)malloc(sizeof(fiftyoneDegreesDataSetBase));
+	ASSERT_NE(nullptr, dataSet);
+	memset((void*)dataSet, 0, sizeof(fiftyoneDegreesDataSetBase));
+	strcpy((char*)dataSet->fileName, fileName);
+	fiftyoneDegreesMemoryReader reader;
+	EXPECT_EQ(
+		FIFTYONE_DEGREES_STATUS_SUCCESS,
+		fiftyoneDegreesDataSetInitInMemory(dataSet, &reader));
+	EXPECT_EQ(size, get(FIFTYONE_DEGREES_MEMORY_TAG_DATA_SET).live);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_OTHER).live);
+	fiftyoneDegreesMemoryLargeFree(dataSet->memoryToFree);
+	EXPECT_EQ(0u, get(FIFTYONE_DEGREES_MEMORY_TAG_DATA_SET).live);
+	free(dataSet);
+	remove(fileName);
+}
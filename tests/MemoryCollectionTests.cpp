@@ -0,0 +1,111 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "Base.hpp"
+#include "FixedSizeCollection.hpp"
+#include "StringCollection.hpp"
+#include "../MemoryCollection.hpp"
+#include "../fiftyone.h"
+
+using namespace FiftyoneDegrees::Common;
+
+typedef struct memory_collection_test_t {
+	uint32_t id;
+	int16_t weight;
+} memoryCollectionTest;
+
+class MemoryCollectionTests : public Base {};
+
+/**
+ * Check that fixed size elements accessed directly are the same as those
+ * returned by the collection's get method, including via iteration.
+ */
+TEST_F(MemoryCollectionTests, Fixed) {
+	std::vector<memoryCollectionTest> values;
+	for (uint32_t i = 0; i < 100; i++) {
+		values.push_back({ i * 3, (int16_t)(i % 7) });
+	}
+	FixedSizeCollection<memoryCollectionTest> collection(values);
+	fiftyoneDegreesCollection *c = collection.getState()->collection;
+	MemoryCollection<memoryCollectionTest> memory(c);
+	ASSERT_TRUE(memory.isValid());
+	ASSERT_EQ(values.size(), memory.getCount());
+	for (uint32_t i = 0; i < memory.getCount(); i++) {
+		FIFTYONE_DEGREES_EXCEPTION_CREATE;
+		fiftyoneDegreesCollectionItem item;
+		fiftyoneDegreesDataReset(&item.data);
+		fiftyoneDegreesCollectionKey key = { { i }, nullptr };
+		memoryCollectionTest *expected = (memoryCollectionTest*)c->get(
+			c,
+			&key,
+			&item,
+			exception);
+		FIFTYONE_DEGREES_EXCEPTION_THROW;
+		EXPECT_EQ(expected, &memory[i]);
+		EXPECT_EQ(expected, memory.getByIndex(i));
+		EXPECT_EQ(expected, FIFTYONE_DEGREES_COLLECTION_MEMORY_INDEX(
+			fiftyoneDegreesCollectionGetMemory(c),
+			memoryCollectionTest,
+			i));
+		TEST_COLLECTION_RELEASE(c, item);
+	}
+	uint32_t total = 0;
+	for (const memoryCollectionTest &value : memory) {
+		total += value.id;
+	}
+	EXPECT_EQ(3u * 99u * 100u / 2u, total);
+	EXPECT_EQ(nullptr, memory.getByIndex(memory.getCount()));
+}
+
+/**
+ * Check that variable size elements can be accessed by offset, and that
+ * they can not be accessed by index.
+ */
+TEST_F(MemoryCollectionTests, Variable) {
+	const char *strings[] = { "Red", "Green", "Blue" };
+	StringCollection collection(strings, 3);
+	stringCollectionState *state = collection.getState();
+	MemoryCollection<fiftyoneDegreesString> memory(state->collection);
+	ASSERT_TRUE(memory.isValid());
+	EXPECT_EQ(0u, memory.getCount());
+	for (uint32_t i = 0; i < 3; i++) {
+		const fiftyoneDegreesString *string =
+			memory.getByOffset(state->offsets[i]);
+		ASSERT_NE(nullptr, string);
+		EXPECT_STREQ(strings[i], &string->value);
+	}
+	EXPECT_EQ(nullptr, memory.getByOffset(memory.getSize()));
+}
+
+/**
+ * Check that a collection which is not held in memory is not valid.
+ */
+TEST_F(MemoryCollectionTests, NotMemory) {
+	fiftyoneDegreesCollection collection {};
+	MemoryCollection<uint32_t> memory(&collection);
+	EXPECT_FALSE(memory.isValid());
+	EXPECT_EQ(0u, memory.getCount());
+	EXPECT_EQ(nullptr, memory.getByOffset(0));
+	EXPECT_EQ(nullptr, fiftyoneDegreesCollectionGetMemory(&collection));
+	EXPECT_EQ(nullptr, fiftyoneDegreesCollectionGetMemory(nullptr));
+}
@@ -0,0 +1,298 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "../MetaDataView.hpp"
+#include "../fiftyone.h"
+#include "Base.hpp"
+#include "StringCollection.hpp"
+#include "FixedSizeCollection.hpp"
+#include "VariableSizeCollection.hpp"
+#include <memory>
+#include <vector>
+
+using namespace FiftyoneDegrees::Common;
+
+#pragma pack(push, 1)
+typedef struct {
+	fiftyoneDegreesProfile profile;
+	uint32_t valueIndexes[2];
+} MetaDataViewProfile;
+#pragma pack(pop)
+
+// Weight in the URL offset field of a value.
+#define WEIGHTED(w) ((int32_t)(0xFF000000u | (w)))
+
+static const char *metaDataViewStrings[] = {
+	"Colour", "Colour of the thing", "Appearance", "https://colour",
+	"Size", "Size of the thing", "Dimensions", "https://size",
+	"Red", "Blue", "Small", "Large", "https://value" };
+
+class MetaDataViewTests : public Base {
+protected:
+	StringCollection *strings;
+	FixedSizeCollection<fiftyoneDegreesProperty> *properties;
+	FixedSizeCollection<fiftyoneDegreesValue> *values;
+	VariableSizeCollection<MetaDataViewProfile> *profiles;
+	FixedSizeCollection<fiftyoneDegreesProfileOffset> *profileOffsets;
+	MetaDataCollections collections;
+	shared_ptr<fiftyoneDegreesResourceManager> manager;
+
+	void SetUp() {
+		Base::SetUp();
+		strings = new StringCollection(
+			metaDataViewStrings,
+			sizeof(metaDataViewStrings) / sizeof(metaDataViewStrings[0]));
+		uint32_t *offsets = strings->getState()->offsets;
+
+		std::vector<fiftyoneDegreesProperty> propertyRecords;
+		for (byte i = 0; i < 2; i++) {
+			propertyRecords.push_back({
+				i, // componentIndex
+				i, // displayOrder
+				1, // isMandatory
+				i, // isList
+				1, // showValues
+				0, // isObsolete
+				1, // show
+				FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING, // valueType
+				(uint32_t)(i * 2), // defaultValueIndex
+				offsets[i * 4], // nameOffset
+				offsets[i * 4 + 1], // descriptionOffset
+				offsets[i * 4 + 2], // categoryOffset
+				offsets[i * 4 + 3], // urlOffset
+				(uint32_t)(i * 2), // firstValueIndex
+				(uint32_t)(i * 2 + 1), // lastValueIndex
+				0, // mapCount
+				0 // firstMapIndex
+			});
+		}
+		properties = new FixedSizeCollection<fiftyoneDegreesProperty>(
+			propertyRecords);
+
+		std::vector<fiftyoneDegreesValue> valueRecords;
+		for (int i = 0; i < 4; i++) {
+			valueRecords.push_back({
+				(int16_t)(i / 2), // propertyIndex
+				(int32_t)offsets[8 + i], // nameOffset
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+				(int32_t)offsets[8 + i], // descriptionOffset
+#endif
+				// The last value is weighted rather than having a URL
+				i == 3 ? WEIGHTED(300) : (int32_t)offsets[12]
+			});
+		}
+		values = new FixedSizeCollection<fiftyoneDegreesValue>(valueRecords);
+
+		std::vector<MetaDataViewProfile> profileRecords;
+		for (uint32_t i = 0; i < 2; i++) {
+			profileRecords.push_back({{
+				0, // componentIndex
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+				100 + i, // profileId
+#endif
+				2 }, // valueCount
+				{ i, 2 + i } });
+		}
+		profiles = new VariableSizeCollection<MetaDataViewProfile>(
+			profileRecords);
+		std::vector<fiftyoneDegreesProfileOffset> offsetRecords;
+		for (uint32_t i = 0; i < 2; i++) {
+			offsetRecords.push_back({
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+				100 + i,
+#endif
+				profiles->getState()->offsets[i] });
+		}
+		profileOffsets = new FixedSizeCollection<fiftyoneDegreesProfileOffset>(
+			offsetRecords);
+
+		collections.strings = strings->getState()->collection;
+		collections.properties = properties->getState()->collection;
+		collections.values = values->getState()->collection;
+		collections.profiles = profiles->getState()->collection;
+		collections.profileOffsets = profileOffsets->getState()->collection;
+
+		fiftyoneDegreesResourceHandle *handle;
+		manager = std::make_shared<fiftyoneDegreesResourceManager>();
+		fiftyoneDegreesResourceManagerInit(
+			manager.get(),
+			&collections,
+			&handle,
+			freeCollections);
+	}
+
+	void TearDown() {
+		fiftyoneDegreesResourceManagerFree(manager.get());
+		manager.reset();
+		delete profileOffsets;
+		delete profiles;
+		delete values;
+		delete properties;
+		delete strings;
+		Base::TearDown();
+	}
+
+	// The collections are freed by the test.
+	static void freeCollections(void*) {}
+
+	static MetaDataCollections getCollections(const void *dataSet) {
+		return *(const MetaDataCollections*)dataSet;
+	}
+};
+
+/**
+ * Check that the properties and their values can be enumerated with range
+ * based for loops and the strings match those in the collection.
+ */
+TEST_F(MetaDataViewTests, Properties) {
+	MetaDataViews views(manager, getCollections);
+	EXPECT_EQ(2u, views.getProperties().size());
+	uint32_t index = 0;
+	std::vector<string> valueNames;
+	for (auto property : views.getProperties()) {
+		EXPECT_EQ(index, property.getIndex());
+		EXPECT_EQ(metaDataViewStrings[index * 4], property.getName().view());
+		EXPECT_EQ(
+			metaDataViewStrings[index * 4 + 1],
+			property.getDescription().view());
+		EXPECT_EQ(
+			metaDataViewStrings[index * 4 + 2],
+			property.getCategory().view());
+		EXPECT_EQ(metaDataViewStrings[index * 4 + 3], property.getUrl().view());
+		EXPECT_EQ(index, property.getDisplayOrder());
+		EXPECT_EQ(index == 1, property.getIsList());
+		EXPECT_TRUE(property.getIsMandatory());
+		EXPECT_FALSE(property.getIsObsolete());
+		EXPECT_EQ(2u, property.getValues().size());
+		for (auto value : property.getValues()) {
+			EXPECT_EQ(index, value.getPropertyIndex());
+			valueNames.push_back(value.getName().str());
+		}
+		index++;
+	}
+	EXPECT_EQ(2u, index);
+	std::vector<string> expected = { "Red", "Blue", "Small", "Large" };
+	EXPECT_EQ(expected, valueNames);
+}
+
+/**
+ * Check the value views including weighted values which have no URL.
+ */
+TEST_F(MetaDataViewTests, Values) {
+	MetaDataViews views(manager, getCollections);
+	EXPECT_EQ(4u, views.getValues().size());
+	ValueView red = views.getValue(0);
+	EXPECT_EQ("Red", red.getName().view());
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+	EXPECT_EQ("Red", red.getDescription().view());
+#endif
+	EXPECT_EQ("https://value", red.getUrl().view());
+	EXPECT_FALSE(red.getIsWeighted());
+	EXPECT_EQ("Colour", red.getProperty().getName().view());
+	ValueView large = views.getValue(3);
+	EXPECT_TRUE(large.getIsWeighted());
+	EXPECT_EQ(300, large.getWeight());
+	EXPECT_TRUE(large.getUrl().empty());
+	EXPECT_EQ("Size", large.getProperty().getName().view());
+}
+
+/**
+ * Check that profiles and their values can be enumerated.
+ */
+TEST_F(MetaDataViewTests, Profiles) {
+	MetaDataViews views(manager, getCollections);
+	EXPECT_EQ(2u, views.getProfiles().size());
+	uint32_t index = 0;
+	for (auto profile : views.getProfiles()) {
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+		EXPECT_EQ(100 + index, profile.getProfileId());
+#endif
+		EXPECT_EQ(2u, profile.getValueCount());
+		std::vector<uint32_t> indexes;
+		for (auto value : profile.getValues()) {
+			indexes.push_back(value.getIndex());
+		}
+		std::vector<uint32_t> expected = { index, 2 + index };
+		EXPECT_EQ(expected, indexes);
+		index++;
+	}
+	EXPECT_EQ(2u, index);
+}
+
+/**
+ * Check that the data set is pinned while the views exist and strings can be
+ * moved between instances.
+ */
+TEST_F(MetaDataViewTests, Pinned) {
+	fiftyoneDegreesResourceHandle *handle =
+		(fiftyoneDegreesResourceHandle*)manager->active;
+	{
+		MetaDataViews views(manager, getCollections);
+		EXPECT_EQ(1, fiftyoneDegreesResourceHandleGetUse(handle));
+		PinnedString name = views.getProperty(1).getName();
+		PinnedString moved(std::move(name));
+		EXPECT_TRUE(name.empty());
+		EXPECT_EQ("Size", moved.view());
+		name = std::move(moved);
+		EXPECT_EQ("Size", name.view());
+	}
+	EXPECT_EQ(0, fiftyoneDegreesResourceHandleGetUse(handle));
+}
+
+/**
+ * Check that values which are not stored as strings have no name, and that
+ * their content is read in the stored type.
+ */
+TEST_F(MetaDataViewTests, StoredTypes) {
+	uint32_t *offsets = strings->getState()->offsets;
+	std::vector<fiftyoneDegreesPropertyTypeRecord> typeRecords = {
+		{ offsets[0], FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING },
+		{ offsets[4], FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_INTEGER } };
+	FixedSizeCollection<fiftyoneDegreesPropertyTypeRecord> propertyTypes(
+		typeRecords);
+	collections.propertyTypes = propertyTypes.getState()->collection;
+	{
+		MetaDataViews views(manager, getCollections);
+		ValueView red = views.getValue(0);
+		EXPECT_EQ(FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING,
+			red.getStoredType());
+		EXPECT_EQ("Red", red.getName().view());
+		EXPECT_EQ("Red", red.getContent().str());
+
+		// The integer is read from the bytes at the value's name offset.
+		FIFTYONE_DEGREES_EXCEPTION_CREATE;
+		int32_t expected = fiftyoneDegreesCollectionGetInteger32(
+			collections.strings,
+			offsets[10],
+			exception);
+		ASSERT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+		ValueView small = views.getValue(2);
+		EXPECT_EQ(FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_INTEGER,
+			small.getStoredType());
+		EXPECT_TRUE(small.getName().empty());
+		PinnedBinaryValue content = small.getContent();
+		ASSERT_NE(nullptr, content.get());
+		EXPECT_EQ(expected, content.get()->intValue);
+		EXPECT_EQ(std::to_string(expected), content.str());
+	}
+	collections.propertyTypes = nullptr;
+}
@@ -23,6 +23,7 @@
 #include "pch.h"
 #include "../overrides.h"
 #include "../string.h"
+#include "../fiftyone.h"
 
 #ifdef _MSC_VER
 // This is a mock implementation of the method
@@ -104,3 +105,297 @@ TEST(OverrideValuesResetTests, Positive) {
 TEST(OverrideValuesResetTests, Negative) {
 	fiftyoneDegreesOverrideValuesReset(NULL);
 }
+
+static const char *routingNames[] = {
+	"ScreenPixelsWidth",
+	"ScreenPixelsWidthJavaScript",
+	"IsMobile",
+	"ScreenPixelsHeight",
+	"ScreenPixelsHeightJavaScript" };
+#define ROUTING_COUNT (sizeof(routingNames) / sizeof(const char*))
+
+// Test fixture with available properties where some properties can be
+// overridden by others which start with the same name.
+class OverrideRoutingTests : public testing::Test {
+protected:
+	fiftyoneDegreesPropertiesAvailable *available = nullptr;
+	fiftyoneDegreesOverridePropertyArray *properties = nullptr;
+	fiftyoneDegreesOverrideValueArray *values = nullptr;
+	void SetUp() {
+		FIFTYONE_DEGREES_ARRAY_CREATE(
+			fiftyoneDegreesPropertyAvailable,
+			available,
+			ROUTING_COUNT);
+		for (uint32_t i = 0; i < ROUTING_COUNT; i++) {
+			size_t length = strlen(routingNames[i]);
+			fiftyoneDegreesString *name = (fiftyoneDegreesString*)malloc(
+				sizeof(fiftyoneDegreesString) + length);
+			name->size = (int16_t)(length + 1);
+			memcpy(&name->value, routingNames[i], length + 1);
+			fiftyoneDegreesPropertyAvailable *property =
+				&available->items[available->count++];
+			memset(property, 0, sizeof(*property));
+			property->propertyIndex = i;
+			property->name.data.ptr = (byte*)name;
+		}
+		properties = fiftyoneDegreesOverridePropertiesCreate(
+			available,
+			true,
+			available,
+			isNotJavaScript);
+		ASSERT_NE(nullptr, properties);
+		values = fiftyoneDegreesOverrideValuesCreateWithSlots(
+			properties->count,
+			properties->availableCount);
+		ASSERT_NE(nullptr, values);
+	}
+	void TearDown() {
+		fiftyoneDegreesOverrideValuesFree(values);
+		fiftyoneDegreesOverridePropertiesFree(properties);
+		for (uint32_t i = 0; i < available->count; i++) {
+			free(available->items[i].name.data.ptr);
+		}
+		fiftyoneDegreesFree(available);
+	}
+	static bool isNotJavaScript(void *state, uint32_t index) {
+		fiftyoneDegreesPropertiesAvailable *available =
+			(fiftyoneDegreesPropertiesAvailable*)state;
+		return strstr(
+			FIFTYONE_DEGREES_STRING(available->items[index].name.data.ptr),
+			"JavaScript") == NULL;
+	}
+	void expectValue(uint32_t requiredPropertyIndex, const char *expected) {
+		fiftyoneDegreesCollectionItem item;
+		fiftyoneDegreesString *value = fiftyoneDegreesOverrideValuesGetFirst(
+			values,
+			requiredPropertyIndex,
+			&item);
+		if (expected == nullptr) {
+			EXPECT_EQ(nullptr, value);
+			EXPECT_FALSE(fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex(
+				values,
+				requiredPropertyIndex));
+		}
+		else {
+			ASSERT_NE(nullptr, value);
+			EXPECT_STREQ(expected, &value->value);
+			EXPECT_TRUE(fiftyoneDegreesOverrideHasValueForRequiredPropertyIndex(
+				values,
+				requiredPropertyIndex));
+		}
+	}
+};
+
+// Check that evidence is routed to the property with the same name ignoring
+// case and the override prefix.
+TEST_F(OverrideRoutingTests, ExtractFromEvidence) {
+	fiftyoneDegreesEvidenceKeyValuePairArray* evidence =
+		fiftyoneDegreesEvidenceCreate(4);
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		"51D_screenpixelswidth",
+		"1080");
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_COOKIE,
+		"51D_IsMobile",
+		"True");
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		"51D_Unknown",
+		"Ignored");
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		"51D_ScreenPixelsWidthJavaScript",
+		"Ignored");
+	fiftyoneDegreesOverridesExtractFromEvidence(properties, values, evidence);
+	EXPECT_EQ(2u, values->count);
+	expectValue(0, "1080");
+	expectValue(1, nullptr);
+	expectValue(2, "True");
+	expectValue(3, nullptr);
+	fiftyoneDegreesEvidenceFree(evidence);
+}
+
+// Check that the overriding property table matches the search of the
+// available properties.
+TEST_F(OverrideRoutingTests, Overriding) {
+	EXPECT_EQ(1, fiftyoneDegreesOverridePropertiesGetOverriding(
+		properties, available, 0));
+	EXPECT_EQ(-1, fiftyoneDegreesOverridePropertiesGetOverriding(
+		properties, available, 2));
+	EXPECT_EQ(4, fiftyoneDegreesOverridePropertiesGetOverriding(
+		properties, available, 3));
+	for (uint32_t i = 0; i < available->count; i++) {
+		EXPECT_EQ(
+			fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex(
+				available, i),
+			fiftyoneDegreesOverridePropertiesGetOverriding(
+				properties, available, i));
+		EXPECT_EQ(
+			fiftyoneDegreesOverridesGetOverridingRequiredPropertyIndex(
+				available, i),
+			fiftyoneDegreesOverridePropertiesGetOverriding(
+				NULL, available, i));
+	}
+}
+
+// Check that adding a value for the same property replaces the existing value
+// and that reset clears the slots.
+TEST_F(OverrideRoutingTests, Slots) {
+	fiftyoneDegreesList list;
+	fiftyoneDegreesListInit(&list, 2);
+	fiftyoneDegreesOverridesAdd(values, 3, "First");
+	fiftyoneDegreesOverridesAdd(values, 0, "Second");
+	fiftyoneDegreesOverridesAdd(values, 3, "Replaced");
+	EXPECT_EQ(2u, values->count);
+	expectValue(3, "Replaced");
+	expectValue(0, "Second");
+	EXPECT_EQ(1u, fiftyoneDegreesOverrideValuesAdd(values, 3, &list));
+	EXPECT_EQ(0u, fiftyoneDegreesOverrideValuesAdd(values, 2, &list));
+	EXPECT_EQ(1u, list.count);
+	fiftyoneDegreesListRelease(&list);
+	fiftyoneDegreesListFree(&list);
+
+	fiftyoneDegreesOverrideValuesReset(values);
+	EXPECT_EQ(0u, values->count);
+	expectValue(3, nullptr);
+	expectValue(0, nullptr);
+	fiftyoneDegreesOverridesAdd(values, 2, "After");
+	expectValue(2, "After");
+	expectValue(0, nullptr);
+}
+
+// Check that values extracted by reference point at the evidence until they
+// are needed as strings, and that the strings are then copied.
+TEST_F(OverrideRoutingTests, Reference) {
+	fiftyoneDegreesEvidenceKeyValuePairArray* evidence =
+		fiftyoneDegreesEvidenceCreate(2);
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		"51D_ScreenPixelsHeight",
+		"1920");
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_COOKIE,
+		"51D_IsMobile",
+		"False");
+	values->reference = true;
+	fiftyoneDegreesOverridesExtractFromEvidence(properties, values, evidence);
+	ASSERT_EQ(2u, values->count);
+	for (uint32_t i = 0; i < values->count; i++) {
+		EXPECT_EQ(evidence->items[i].item.value, values->items[i].evidence);
+		EXPECT_EQ(0u, values->items[i].string.allocated);
+	}
+	expectValue(2, "False");
+	EXPECT_NE(0u, values->items[1].string.used);
+	EXPECT_EQ(0u, values->items[0].string.allocated);
+	expectValue(3, "1920");
+
+	// Adding by reference to a property with a copied value replaces it.
+	const char *replacement = "720px";
+	fiftyoneDegreesOverridesAddReference(values, 3, replacement, 3);
+	expectValue(3, "720");
+
+	fiftyoneDegreesOverrideValuesReset(values);
+	EXPECT_EQ(0u, values->count);
+	EXPECT_EQ(nullptr, values->items[0].evidence);
+	expectValue(3, nullptr);
+	fiftyoneDegreesEvidenceFree(evidence);
+}
+
+static void collectProfileId(void *state, uint32_t profileId) {
+	((std::vector<uint32_t>*)state)->push_back(profileId);
+}
+
+// Check that only the cookies for overridable properties and profile ids are
+// added, that they can be extracted as overrides and profile ids, and that
+// only encoded values use the buffer.
+TEST_F(OverrideRoutingTests, AddCookies) {
+	const char cookies[] =
+		"session=abc; 51D_ScreenPixelsWidth=1080;51D_Unknown=1; "
+		" 51D_IsMobile=\"True\" ; 51D_ProfileIds=12-34%2D56; empty";
+	char chars[32];
+	fiftyoneDegreesStringBuilder buffer = { chars, sizeof(chars) };
+	fiftyoneDegreesStringBuilderInit(&buffer);
+	fiftyoneDegreesEvidenceKeyValuePairArray* evidence =
+		fiftyoneDegreesEvidenceCreate(4);
+	EXPECT_EQ(3u, fiftyoneDegreesOverridesAddCookies(
+		properties,
+		evidence,
+		cookies,
+		sizeof(cookies) - 1,
+		&buffer));
+	ASSERT_EQ(3u, evidence->count);
+	EXPECT_STREQ("ScreenPixelsWidth", evidence->items[0].item.key);
+	EXPECT_EQ(FIFTYONE_DEGREES_EVIDENCE_COOKIE, evidence->items[0].prefix);
+	EXPECT_TRUE(evidence->items[0].item.value > cookies &&
+		evidence->items[0].item.value < cookies + sizeof(cookies));
+	EXPECT_EQ(4u, evidence->items[0].item.valueLength);
+	EXPECT_EQ(chars, evidence->items[2].item.value);
+	EXPECT_STREQ("12-34-56", evidence->items[2].item.value);
+
+	fiftyoneDegreesOverridesExtractFromEvidence(properties, values, evidence);
+	EXPECT_EQ(2u, values->count);
+	expectValue(0, "1080");
+	expectValue(2, "True");
+
+	std::vector<uint32_t> profileIds;
+	fiftyoneDegreesOverrideProfileIds(evidence, &profileIds, collectProfileId);
+	EXPECT_EQ((std::vector<uint32_t>{ 12, 34, 56 }), profileIds);
+	fiftyoneDegreesEvidenceFree(evidence);
+}
+
+// Check that query string parameters are decoded including spaces, that a
+// leading question mark is skipped, and that the encoded value is used when
+// the buffer is too small.
+TEST_F(OverrideRoutingTests, AddQueryString) {
+	const char query[] =
+		"?a=b&51D_screenpixelsheight=12%3&ProfileIds=1+2&IsMobile=Fa%6Cse";
+	char chars[10];
+	fiftyoneDegreesStringBuilder buffer = { chars, sizeof(chars) };
+	fiftyoneDegreesStringBuilderInit(&buffer);
+	fiftyoneDegreesEvidenceKeyValuePairArray* evidence =
+		fiftyoneDegreesEvidenceCreate(3);
+	EXPECT_EQ(3u, fiftyoneDegreesOverridesAddQueryString(
+		properties,
+		evidence,
+		query,
+		sizeof(query) - 1,
+		&buffer));
+	ASSERT_EQ(3u, evidence->count);
+	EXPECT_STREQ("ScreenPixelsHeight", evidence->items[0].item.key);
+	EXPECT_EQ(FIFTYONE_DEGREES_EVIDENCE_QUERY, evidence->items[0].prefix);
+	EXPECT_EQ("12%3", std::string(
+		evidence->items[0].item.value,
+		evidence->items[0].item.valueLength));
+	EXPECT_STREQ("1 2", evidence->items[1].item.value);
+	EXPECT_EQ("Fa%6Cse", std::string(
+		evidence->items[2].item.value,
+		evidence->items[2].item.valueLength));
+
+	fiftyoneDegreesOverridesExtractFromEvidence(properties, values, evidence);
+	expectValue(3, "12%3");
+	expectValue(2, "Fa%6Cse");
+	fiftyoneDegreesEvidenceFree(evidence);
+}
+
+// Check that profile ids too large for a uint32_t are ignored rather than
+// wrapping around, and that the ids either side of them are still returned.
+TEST(OverrideProfileIdsTests, Overflow) {
+	fiftyoneDegreesEvidenceKeyValuePairArray* evidence =
+		fiftyoneDegreesEvidenceCreate(1);
+	fiftyoneDegreesEvidenceAddString(
+		evidence,
+		FIFTYONE_DEGREES_EVIDENCE_QUERY,
+		"51D_ProfileIds",
+		"12-4294967295-4294967296-99999999999999999999-34");
+	std::vector<uint32_t> profileIds;
+	fiftyoneDegreesOverrideProfileIds(evidence, &profileIds, collectProfileId);
+	EXPECT_EQ((std::vector<uint32_t>{ 12, 4294967295u, 34 }), profileIds);
+	fiftyoneDegreesEvidenceFree(evidence);
+}
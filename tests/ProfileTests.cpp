@@ -28,6 +28,7 @@
 #include "Base.hpp"
 #include "limits.h"
 #include "StringCollection.hpp"
+#include "HeadersContainer.hpp"
 #include "FixedSizeCollection.hpp"
 #include "VariableSizeCollection.hpp"
 #include <algorithm>
@@ -582,3 +583,481 @@ TEST_F(ProfileTests, unhappyPaths) {
 #endif
     EXPECT_EQ(profileOffsetPtr, (uint32_t *) NULL);
 }
+
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+static const char *sidecarFileName = "ProfileTests.indices";
+static const byte sidecarData[] = "data file contents used to key the sidecar";
+
+TEST_F(ProfileTests, indicesSidecarRoundTrip) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Volume","Position","Texture","Weight"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    fiftyoneDegreesIndicesPropertyProfile *created = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, created);
+    fiftyoneDegreesIndicesSidecarKey key;
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData), availableProperties, &key);
+    ASSERT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesIndicesPropertyProfileSave(created, availableProperties, NULL, &key, sidecarFileName));
+
+    fiftyoneDegreesHeaders *headers = NULL;
+    fiftyoneDegreesIndicesPropertyProfile *loaded = fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, &headers, exception);
+    ASSERT_NE((void*)NULL, loaded);
+    EXPECT_TRUE(EXCEPTION_OKAY);
+    EXPECT_EQ((void*)NULL, headers);
+    EXPECT_EQ(created->size, loaded->size);
+    EXPECT_EQ(created->filled, loaded->filled);
+    EXPECT_EQ(created->minProfileId, loaded->minProfileId);
+    EXPECT_EQ(created->maxProfileId, loaded->maxProfileId);
+    for (int i=0;i<N_PROFILES;++i) {
+        uint32_t profileId = profileIdFromProfileIndex(i);
+        for (uint32_t j=0;j<availableProperties->count;j++) {
+            EXPECT_EQ(
+                fiftyoneDegreesIndicesPropertyProfileLookup(created, profileId, j),
+                fiftyoneDegreesIndicesPropertyProfileLookup(loaded, profileId, j));
+        }
+    }
+
+    fiftyoneDegreesIndicesPropertyProfileFree(loaded);
+    fiftyoneDegreesIndicesPropertyProfileFree(created);
+    fiftyoneDegreesFree(availableProperties);
+    fiftyoneDegreesFileDelete(sidecarFileName);
+}
+
+TEST_F(ProfileTests, indicesSidecarStale) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Volume","Position","Texture","Weight"};
+    std::vector<std::string> otherNames {"Volume","Position","Texture"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    fiftyoneDegreesPropertiesAvailable *otherProperties = createAvailableProperties(otherNames);
+    fiftyoneDegreesIndicesPropertyProfile *created = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, created);
+    fiftyoneDegreesIndicesSidecarKey key;
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData), availableProperties, &key);
+    ASSERT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesIndicesPropertyProfileSave(created, availableProperties, NULL, &key, sidecarFileName));
+
+    // A different data file must not match.
+    fiftyoneDegreesIndicesSidecarKey staleKey;
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData) - 1, availableProperties, &staleKey);
+    EXPECT_EQ((void*)NULL, fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &staleKey, availableProperties, NULL, exception));
+
+    // A different set of required properties must not match.
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData), otherProperties, &staleKey);
+    EXPECT_NE(key.propertiesHash, staleKey.propertiesHash);
+    EXPECT_EQ((void*)NULL, fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &staleKey, otherProperties, NULL, exception));
+
+    // A corrupted payload must fail the checksum.
+    FILE *file = fopen(sidecarFileName, "r+b");
+    ASSERT_NE((void*)NULL, file);
+    fseek(file, -1L, SEEK_END);
+    fputc(0x5a, file);
+    fclose(file);
+    EXPECT_EQ((void*)NULL, fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, NULL, exception));
+
+    // A missing sidecar is not an exception.
+    fiftyoneDegreesFileDelete(sidecarFileName);
+    EXPECT_EQ((void*)NULL, fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, NULL, exception));
+    EXPECT_TRUE(EXCEPTION_OKAY);
+
+    fiftyoneDegreesIndicesPropertyProfileFree(created);
+    fiftyoneDegreesFree(otherProperties);
+    fiftyoneDegreesFree(availableProperties);
+}
+
+static const char *sidecarHeaderNames[] = {
+    "User-Agent",
+    "Sec-CH-UA",
+    "Sec-CH-UA-Platform",
+    "Sec-CH-UA\x1FSec-CH-UA-Platform"
+};
+
+// Checks the headers restored from a sidecar match those saved.
+static void compareHeaders(
+    fiftyoneDegreesHeaders *expected,
+    fiftyoneDegreesHeaders *actual) {
+    ASSERT_NE((void*)NULL, actual);
+    ASSERT_EQ(expected->count, actual->count);
+    EXPECT_EQ(expected->expectUpperPrefixedHeaders, actual->expectUpperPrefixedHeaders);
+    for (uint32_t i = 0; i < expected->count; i++) {
+        fiftyoneDegreesHeader *e = &expected->items[i];
+        fiftyoneDegreesHeader *a = &actual->items[i];
+        EXPECT_EQ(e->index, a->index);
+        EXPECT_EQ(e->headerId, a->headerId);
+        EXPECT_EQ(e->isDataSet, a->isDataSet);
+        EXPECT_EQ(e->nameLength, a->nameLength);
+        EXPECT_STREQ(e->name, a->name);
+        ASSERT_EQ(e->pseudoHeaders->count, a->pseudoHeaders->count);
+        for (uint32_t j = 0; j < e->pseudoHeaders->count; j++) {
+            EXPECT_EQ(e->pseudoHeaders->items[j]->index, a->pseudoHeaders->items[j]->index);
+            EXPECT_EQ(&actual->items[a->pseudoHeaders->items[j]->index], a->pseudoHeaders->items[j]);
+        }
+        ASSERT_EQ(e->segmentHeaders->count, a->segmentHeaders->count);
+        for (uint32_t j = 0; j < e->segmentHeaders->count; j++) {
+            EXPECT_EQ(e->segmentHeaders->items[j]->index, a->segmentHeaders->items[j]->index);
+            EXPECT_EQ(&actual->items[a->segmentHeaders->items[j]->index], a->segmentHeaders->items[j]);
+        }
+    }
+}
+
+TEST_F(ProfileTests, indicesSidecarHeadersRoundTrip) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Volume","Position","Texture","Weight"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    HeadersContainer container;
+    container.CreateHeaders(sidecarHeaderNames, 4, true);
+    ASSERT_NE((void*)NULL, container.headers);
+    ASSERT_GT(container.headers->items[3].segmentHeaders->count, 0u);
+    fiftyoneDegreesIndicesPropertyProfile *created = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, created);
+    fiftyoneDegreesIndicesSidecarKey key;
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData), availableProperties, &key);
+    ASSERT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesIndicesPropertyProfileSave(created, availableProperties, container.headers, &key, sidecarFileName));
+
+    // The headers and the index are both restored.
+    fiftyoneDegreesHeaders *headers = NULL;
+    fiftyoneDegreesIndicesPropertyProfile *loaded = fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, &headers, exception);
+    ASSERT_NE((void*)NULL, loaded);
+    EXPECT_TRUE(EXCEPTION_OKAY);
+    compareHeaders(container.headers, headers);
+    for (int i=0;i<N_PROFILES;++i) {
+        uint32_t profileId = profileIdFromProfileIndex(i);
+        for (uint32_t j=0;j<availableProperties->count;j++) {
+            EXPECT_EQ(
+                fiftyoneDegreesIndicesPropertyProfileLookup(created, profileId, j),
+                fiftyoneDegreesIndicesPropertyProfileLookup(loaded, profileId, j));
+        }
+    }
+    fiftyoneDegreesHeadersFree(headers);
+    fiftyoneDegreesIndicesPropertyProfileFree(loaded);
+
+    // The headers are not needed when the pointer is NULL.
+    loaded = fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, NULL, exception);
+    ASSERT_NE((void*)NULL, loaded);
+    fiftyoneDegreesIndicesPropertyProfileFree(loaded);
+
+    // The property table must match the available properties even if the
+    // key does.
+    uint32_t propertyIndex = availableProperties->items[1].propertyIndex;
+    availableProperties->items[1].propertyIndex = availableProperties->items[0].propertyIndex;
+    EXPECT_EQ((void*)NULL, fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, &headers, exception));
+    EXPECT_TRUE(EXCEPTION_OKAY);
+    availableProperties->items[1].propertyIndex = propertyIndex;
+
+    fiftyoneDegreesIndicesPropertyProfileFree(created);
+    fiftyoneDegreesFree(availableProperties);
+    container.Dealloc();
+    fiftyoneDegreesFileDelete(sidecarFileName);
+}
+
+static const char *dataSetFileName = "ProfileTests.dat";
+
+// Initialises the data set with the configuration and available properties
+// ready for the index to be initialised.
+static void initDataSet(
+    fiftyoneDegreesDataSetBase *dataSet,
+    fiftyoneDegreesConfigBase *config,
+    fiftyoneDegreesPropertiesAvailable *available) {
+    memset((void*)dataSet, 0, sizeof(fiftyoneDegreesDataSetBase));
+    strcpy((char*)dataSet->masterFileName, dataSetFileName);
+    dataSet->config = config;
+    dataSet->available = available;
+}
+
+TEST_F(ProfileTests, dataSetInitIndex) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Taste","Position","Material","Size","Color", "Temperature"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    HeadersContainer container;
+    container.CreateHeaders(sidecarHeaderNames, 4, false);
+    ASSERT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesFileWrite(dataSetFileName, sidecarData, sizeof(sidecarData)));
+    char indexFileName[FIFTYONE_DEGREES_FILE_MAX_PATH];
+    snprintf(indexFileName, sizeof(indexFileName), "%s%s", dataSetFileName, FIFTYONE_DEGREES_INDICES_SIDECAR_EXTENSION);
+    fiftyoneDegreesIndicesPropertyProfile *expected = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, expected);
+    fiftyoneDegreesConfigBase config;
+    memset(&config, 0, sizeof(config));
+    // The data set has const members so is allocated rather than declared.
+    fiftyoneDegreesDataSetBase &dataSet = *(fiftyoneDegreesDataSetBase*)
+        malloc(sizeof(fiftyoneDegreesDataSetBase));
+
+    // No index is created unless configured.
+    initDataSet(&dataSet, &config, availableProperties);
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesDataSetInitIndex(&dataSet, profilesCollection, profileOffsetsCollection, valuesCollection, exception));
+    EXPECT_EQ((void*)NULL, dataSet.indexPropertyProfile);
+
+    // The first initialisation creates the index and saves the sidecar with
+    // the headers of the data set.
+    config.propertyValueIndex = true;
+    config.propertyValueIndexSidecar = true;
+    initDataSet(&dataSet, &config, availableProperties);
+    dataSet.uniqueHeaders = container.headers;
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesDataSetInitIndex(&dataSet, profilesCollection, profileOffsetsCollection, valuesCollection, exception));
+    ASSERT_NE((void*)NULL, dataSet.indexPropertyProfile);
+    EXPECT_EQ((void*)NULL, dataSet.indexPropertyProfile->mapped);
+    FILE *file = fopen(indexFileName, "rb");
+    ASSERT_NE((void*)NULL, file);
+    fclose(file);
+    fiftyoneDegreesIndicesPropertyProfileFree(dataSet.indexPropertyProfile);
+
+    // The second initialisation loads the index and restores the headers
+    // from the sidecar.
+    initDataSet(&dataSet, &config, availableProperties);
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesDataSetInitIndex(&dataSet, profilesCollection, profileOffsetsCollection, valuesCollection, exception));
+    ASSERT_NE((void*)NULL, dataSet.indexPropertyProfile);
+    EXPECT_NE((void*)NULL, dataSet.indexPropertyProfile->mapped);
+    compareHeaders(container.headers, dataSet.uniqueHeaders);
+    for (int i=0;i<N_PROFILES;++i) {
+        uint32_t profileId = profileIdFromProfileIndex(i);
+        for (uint32_t j=0;j<availableProperties->count;j++) {
+            EXPECT_EQ(
+                fiftyoneDegreesIndicesPropertyProfileLookup(expected, profileId, j),
+                fiftyoneDegreesIndicesPropertyProfileLookup(dataSet.indexPropertyProfile, profileId, j));
+        }
+    }
+    fiftyoneDegreesHeadersFree(dataSet.uniqueHeaders);
+    fiftyoneDegreesIndicesPropertyProfileFree(dataSet.indexPropertyProfile);
+
+    // A sidecar without ranges is not used when ranges are configured.
+    config.propertyValueIndexRanges = true;
+    initDataSet(&dataSet, &config, availableProperties);
+    dataSet.uniqueHeaders = container.headers;
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesDataSetInitIndex(&dataSet, profilesCollection, profileOffsetsCollection, valuesCollection, exception));
+    ASSERT_NE((void*)NULL, dataSet.indexPropertyProfile);
+    EXPECT_EQ((void*)NULL, dataSet.indexPropertyProfile->mapped);
+    EXPECT_NE((void*)NULL, dataSet.indexPropertyProfile->valueEnds);
+    fiftyoneDegreesIndicesPropertyProfileFree(dataSet.indexPropertyProfile);
+
+    // Without a sidecar a lazy index is created when configured.
+    config.propertyValueIndexSidecar = false;
+    config.propertyValueIndexRanges = false;
+    config.propertyValueIndexLazy = true;
+    initDataSet(&dataSet, &config, availableProperties);
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesDataSetInitIndex(&dataSet, profilesCollection, profileOffsetsCollection, valuesCollection, exception));
+    ASSERT_NE((void*)NULL, dataSet.indexPropertyProfile);
+    EXPECT_NE((void*)NULL, dataSet.indexPropertyProfile->lazy);
+    EXPECT_EQ((void*)NULL, dataSet.uniqueHeaders);
+    for (int i=0;i<N_PROFILES;++i) {
+        uint32_t profileId = profileIdFromProfileIndex(i);
+        for (uint32_t j=0;j<availableProperties->count;j++) {
+            EXPECT_EQ(
+                fiftyoneDegreesIndicesPropertyProfileLookup(expected, profileId, j),
+                fiftyoneDegreesIndicesPropertyProfileLookup(dataSet.indexPropertyProfile, profileId, j));
+        }
+    }
+    fiftyoneDegreesIndicesPropertyProfileFree(dataSet.indexPropertyProfile);
+
+    free(&dataSet);
+    fiftyoneDegreesIndicesPropertyProfileFree(expected);
+    fiftyoneDegreesFree(availableProperties);
+    container.Dealloc();
+    fiftyoneDegreesFileDelete(indexFileName);
+    fiftyoneDegreesFileDelete(dataSetFileName);
+}
+#endif
+
+#ifndef FIFTYONE_DEGREES_REDUCED_FILE
+static fiftyoneDegreesIndicesPropertyProfile *lazyIndex = NULL;
+static fiftyoneDegreesIndicesPropertyProfile *eagerIndex = NULL;
+static uint32_t lazyProfileIds[5];
+static volatile long lazyMismatches = 0;
+
+static void compareLazyIndex() {
+    for (uint32_t i = 0; i < sizeof(lazyProfileIds) / sizeof(lazyProfileIds[0]); i++) {
+        for (uint32_t j = 0; j < lazyIndex->availablePropertyCount; j++) {
+            if (fiftyoneDegreesIndicesPropertyProfileLookup(lazyIndex, lazyProfileIds[i], j) !=
+                fiftyoneDegreesIndicesPropertyProfileLookup(eagerIndex, lazyProfileIds[i], j)) {
+                FIFTYONE_DEGREES_INTERLOCK_INC(&lazyMismatches);
+            }
+        }
+    }
+}
+
+static void runLazyLookups(void *) {
+    compareLazyIndex();
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+    FIFTYONE_DEGREES_THREAD_EXIT;
+#endif
+}
+
+TEST_F(ProfileTests, indicesLazy) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Volume","Position","Texture","Flexibility","Weight", "Brightness"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    eagerIndex = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    lazyIndex = fiftyoneDegreesIndicesPropertyProfileCreateLazy(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, lazyIndex);
+    ASSERT_NE((void*)NULL, eagerIndex);
+    for (int i = 0; i < N_PROFILES; i++) {
+        lazyProfileIds[i] = profileIdFromProfileIndex(i);
+    }
+
+    // No rows are populated until they are used.
+    for (uint32_t i = 0; i <= lazyIndex->maxProfileId - lazyIndex->minProfileId; i++) {
+        EXPECT_EQ(FIFTYONE_DEGREES_INDICES_ROW_EMPTY, lazyIndex->lazy->rowStates[i]);
+    }
+    EXPECT_EQ(0u, lazyIndex->filled);
+    lazyMismatches = 0;
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+    runThreads(4, (FIFTYONE_DEGREES_THREAD_ROUTINE)runLazyLookups);
+#else
+    compareLazyIndex();
+#endif
+    EXPECT_EQ(0, lazyMismatches);
+    for (int i = 0; i < N_PROFILES; i++) {
+        EXPECT_EQ(
+            FIFTYONE_DEGREES_INDICES_ROW_FILLED,
+            lazyIndex->lazy->rowStates[lazyProfileIds[i] - lazyIndex->minProfileId]);
+    }
+    EXPECT_EQ(eagerIndex->filled, lazyIndex->filled);
+
+    fiftyoneDegreesIndicesPropertyProfileFree(lazyIndex);
+    fiftyoneDegreesIndicesPropertyProfileFree(eagerIndex);
+    fiftyoneDegreesFree(availableProperties);
+}
+
+TEST_F(ProfileTests, indicesLazyComplete) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Taste","Position","Material","Size","Color", "Temperature"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    eagerIndex = fiftyoneDegreesIndicesPropertyProfileCreate(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    lazyIndex = fiftyoneDegreesIndicesPropertyProfileCreateLazy(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, exception);
+    ASSERT_NE((void*)NULL, lazyIndex);
+    EXPECT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesIndicesPropertyProfileCompleteStart(lazyIndex));
+
+    // Completing on the calling thread as well must not conflict with the
+    // background thread.
+    fiftyoneDegreesIndicesPropertyProfileComplete(lazyIndex, exception);
+    EXPECT_TRUE(EXCEPTION_OKAY);
+    for (int i = 0; i < N_PROFILES; i++) {
+        lazyProfileIds[i] = profileIdFromProfileIndex(i);
+    }
+    lazyMismatches = 0;
+    compareLazyIndex();
+    EXPECT_EQ(0, lazyMismatches);
+    EXPECT_EQ(eagerIndex->filled, lazyIndex->filled);
+
+    fiftyoneDegreesIndicesPropertyProfileFree(lazyIndex);
+    fiftyoneDegreesIndicesPropertyProfileFree(eagerIndex);
+    fiftyoneDegreesFree(availableProperties);
+}
+
+// Checks the ranges in the index match those found by searching the values of
+// each profile.
+static void checkRanges(
+    fiftyoneDegreesIndicesPropertyProfile *index,
+    fiftyoneDegreesPropertiesAvailable *available,
+    fiftyoneDegreesCollection *profiles,
+    fiftyoneDegreesCollection *profileOffsets,
+    fiftyoneDegreesCollection *properties,
+    int profileCount,
+    bool withValues) {
+    EXCEPTION_CREATE
+    fiftyoneDegreesCollectionItem profileItem, propertyItem;
+    fiftyoneDegreesDataReset(&profileItem.data);
+    fiftyoneDegreesDataReset(&propertyItem.data);
+    uint32_t first, last, start, end;
+    for (int i = 0; i < profileCount; i++) {
+        const fiftyoneDegreesProfile *profile = fiftyoneDegreesProfileGetByIndex(profileOffsets, profiles, i, &profileItem, exception);
+        ASSERT_NE((void*)NULL, profile);
+        for (uint32_t j = 0; j < available->count; j++) {
+            const fiftyoneDegreesProperty *property = fiftyoneDegreesPropertyGet(properties, available->items[j].propertyIndex, &propertyItem, exception);
+            uint32_t count = fiftyoneDegreesProfileGetValueRange(profile, property, &first, &last);
+            COLLECTION_RELEASE(propertyItem.collection, &propertyItem);
+            start = fiftyoneDegreesIndicesPropertyProfileLookupRange(
+                index,
+                profile->profileId,
+                withValues ? (const uint32_t *)(profile + 1) : NULL,
+                withValues ? profile->valueCount : 0,
+                j,
+                &end);
+            if (count == 0) {
+                EXPECT_EQ(UINT32_MAX, start);
+                EXPECT_EQ(UINT32_MAX, end);
+            }
+            else {
+                EXPECT_EQ(first, start);
+                EXPECT_EQ(last, end);
+            }
+        }
+        COLLECTION_RELEASE(profileItem.collection, &profileItem);
+    }
+}
+
+TEST_F(ProfileTests, indicesRanges) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Taste","Position","Material","Size","Color", "Temperature"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    fiftyoneDegreesIndicesPropertyProfile *index = fiftyoneDegreesIndicesPropertyProfileCreateWithRanges(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, false, exception);
+    ASSERT_NE((void*)NULL, index);
+    ASSERT_NE((void*)NULL, index->valueEnds);
+    checkRanges(index, availableProperties, profilesCollection, profileOffsetsCollection, propertiesCollection, N_PROFILES, false);
+
+    // Ranges must survive a round trip through the sidecar.
+    fiftyoneDegreesIndicesSidecarKey key;
+    fiftyoneDegreesIndicesSidecarKeyFromMemory(sidecarData, sizeof(sidecarData), availableProperties, &key);
+    ASSERT_EQ(FIFTYONE_DEGREES_STATUS_SUCCESS, fiftyoneDegreesIndicesPropertyProfileSave(index, availableProperties, NULL, &key, sidecarFileName));
+    fiftyoneDegreesIndicesPropertyProfile *loaded = fiftyoneDegreesIndicesPropertyProfileLoad(sidecarFileName, &key, availableProperties, NULL, exception);
+    ASSERT_NE((void*)NULL, loaded);
+    ASSERT_NE((void*)NULL, loaded->valueEnds);
+    checkRanges(loaded, availableProperties, profilesCollection, profileOffsetsCollection, propertiesCollection, N_PROFILES, false);
+
+    fiftyoneDegreesIndicesPropertyProfileFree(loaded);
+    fiftyoneDegreesIndicesPropertyProfileFree(index);
+    fiftyoneDegreesFree(availableProperties);
+    fiftyoneDegreesFileDelete(sidecarFileName);
+}
+
+TEST_F(ProfileTests, indicesRangesLazy) {
+    EXCEPTION_CREATE
+    std::vector<std::string> propertyNames {"Volume","Position","Texture","Flexibility","Weight", "Brightness"};
+    fiftyoneDegreesPropertiesAvailable *availableProperties = createAvailableProperties(propertyNames);
+    fiftyoneDegreesIndicesPropertyProfile *index = fiftyoneDegreesIndicesPropertyProfileCreateWithRanges(profilesCollection, profileOffsetsCollection, availableProperties, valuesCollection, true, exception);
+    ASSERT_NE((void*)NULL, index);
+    ASSERT_NE((void*)NULL, index->lazy);
+
+    // The first pass populates the rows and the second reads them.
+    checkRanges(index, availableProperties, profilesCollection, profileOffsetsCollection, propertiesCollection, N_PROFILES, true);
+    checkRanges(index, availableProperties, profilesCollection, profileOffsetsCollection, propertiesCollection, N_PROFILES, true);
+
+    fiftyoneDegreesIndicesPropertyProfileFree(index);
+    fiftyoneDegreesFree(availableProperties);
+}
+#endif
+
+TEST_F(ProfileTests, valueIndexesLowerBound) {
+    std::vector<uint32_t> valueIndexes;
+    uint32_t next = 0;
+    for (uint32_t count = 0; count < 300; count++) {
+        for (uint32_t key = 0; key <= next + 1; key++) {
+            uint32_t expected = (uint32_t)(std::lower_bound(
+                valueIndexes.begin(),
+                valueIndexes.end(),
+                key) - valueIndexes.begin());
+            EXPECT_EQ(expected, fiftyoneDegreesProfileValueIndexesLowerBound(
+                valueIndexes.data(),
+                (uint32_t)valueIndexes.size(),
+                key)) << "count " << count << " key " << key;
+        }
+        next += 1 + (count % 3);
+        valueIndexes.push_back(next);
+    }
+}
+
+TEST_F(ProfileTests, valueRange) {
+    EXCEPTION_CREATE
+    uint32_t first, last;
+    for (int i = 0; i < N_PROFILES; i++) {
+        const fiftyoneDegreesProfile *profile = fiftyoneDegreesProfileGetByIndex(profileOffsetsCollection, profilesCollection, i, &item, exception);
+        COLLECTION_RELEASE(item.collection, &item);
+        const uint32_t *valueIndexes = (const uint32_t *)(profile + 1);
+        for (uint32_t p = 0; p < N_PROPERTIES; p++) {
+            const fiftyoneDegreesProperty *property = fiftyoneDegreesPropertyGet(propertiesCollection, p, &item, exception);
+            COLLECTION_RELEASE(item.collection, &item);
+            uint32_t count = fiftyoneDegreesProfileGetValueRange(profile, property, &first, &last);
+            EXPECT_EQ(last - first, count);
+            for (uint32_t k = 0; k < profile->valueCount; k++) {
+                bool inProperty = valueIndexes[k] >= property->firstValueIndex &&
+                    valueIndexes[k] <= property->lastValueIndex;
+                EXPECT_EQ(inProperty, k >= first && k < last);
+            }
+        }
+    }
+}
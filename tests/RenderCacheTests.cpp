@@ -0,0 +1,276 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "Base.hpp"
+#include "../ResultsBase.hpp"
+#include "../fiftyone.h"
+
+using namespace FiftyoneDegrees::Common;
+
+/**
+ * Unit tests for the render cache and its use by ResultsBase.
+ */
+class RenderCacheTests : public Base {
+public:
+	void SetUp() {
+		Base::SetUp();
+		cache = NULL;
+	}
+	void TearDown() {
+		fiftyoneDegreesRenderCacheFree(cache);
+		cache = NULL;
+		Base::TearDown();
+	}
+	fiftyoneDegreesRenderCache *cache;
+};
+
+TEST_F(RenderCacheTests, AddGet) {
+	cache = fiftyoneDegreesRenderCacheCreate(4, 16);
+	ASSERT_NE((void*)NULL, cache);
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheGet(cache, 1, 0));
+	const fiftyoneDegreesRenderCacheEntry *added = 
+		fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "Value|Other", 5);
+	ASSERT_NE((void*)NULL, added);
+	EXPECT_STREQ("Value", FIFTYONE_DEGREES_RENDER_CACHE_VALUE(added));
+	EXPECT_EQ(5u, added->length);
+	EXPECT_EQ(added, fiftyoneDegreesRenderCacheGet(cache, 1, 0));
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheGet(cache, 0, 1));
+
+	// Adding an existing key returns the original entry.
+	EXPECT_EQ(added, fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "Other", 5));
+	EXPECT_STREQ("Value", FIFTYONE_DEGREES_RENDER_CACHE_VALUE(added));
+}
+
+TEST_F(RenderCacheTests, Bounds) {
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheCreate(0, 16));
+	cache = fiftyoneDegreesRenderCacheCreate(3, 4);
+	ASSERT_NE((void*)NULL, cache);
+
+	// Strings longer than the maximum length are not cached.
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "12345", 5));
+	EXPECT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "", 0));
+
+	// Once full no more entries are added, but existing ones are returned.
+	EXPECT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(cache, 2, 0, "a", 1));
+	EXPECT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(cache, 3, 0, "b", 1));
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheAdd(cache, 4, 0, "c", 1));
+	EXPECT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(cache, 2, 0, "a", 1));
+	EXPECT_EQ(3, cache->count);
+	EXPECT_TRUE(fiftyoneDegreesRenderCacheIsFull(cache));
+}
+
+TEST_F(RenderCacheTests, TooLong) {
+	cache = fiftyoneDegreesRenderCacheCreate(2, 4);
+	EXPECT_FALSE(fiftyoneDegreesRenderCacheIsFull(cache));
+
+	// The too long marker is returned by get and uses the capacity.
+	const fiftyoneDegreesRenderCacheEntry *marker =
+		fiftyoneDegreesRenderCacheAddTooLong(cache, 1, 0);
+	ASSERT_NE((void*)NULL, marker);
+	EXPECT_EQ(FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG, marker->length);
+	EXPECT_STREQ("", FIFTYONE_DEGREES_RENDER_CACHE_VALUE(marker));
+	EXPECT_EQ(marker, fiftyoneDegreesRenderCacheGet(cache, 1, 0));
+	EXPECT_EQ(marker, fiftyoneDegreesRenderCacheAdd(cache, 1, 0, "a", 1));
+	EXPECT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(cache, 2, 0, "b", 1));
+	EXPECT_TRUE(fiftyoneDegreesRenderCacheIsFull(cache));
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheAddTooLong(cache, 3, 0));
+}
+
+TEST_F(RenderCacheTests, ManyKeys) {
+	char value[16];
+	cache = fiftyoneDegreesRenderCacheCreate(1000, 16);
+	ASSERT_NE((void*)NULL, cache);
+	for (uint32_t profileId = 0; profileId < 100; profileId++) {
+		for (uint32_t property = 0; property < 10; property++) {
+			int length = snprintf(value, sizeof(value), "%u-%u", profileId, property);
+			ASSERT_NE((void*)NULL, fiftyoneDegreesRenderCacheAdd(
+				cache, profileId, property, value, (size_t)length));
+		}
+	}
+	for (uint32_t profileId = 0; profileId < 100; profileId++) {
+		for (uint32_t property = 0; property < 10; property++) {
+			snprintf(value, sizeof(value), "%u-%u", profileId, property);
+			const fiftyoneDegreesRenderCacheEntry *entry =
+				fiftyoneDegreesRenderCacheGet(cache, profileId, property);
+			ASSERT_NE((void*)NULL, entry);
+			EXPECT_STREQ(value, FIFTYONE_DEGREES_RENDER_CACHE_VALUE(entry));
+		}
+	}
+}
+
+#ifndef FIFTYONE_DEGREES_NO_THREADING
+static fiftyoneDegreesRenderCache *sharedCache = NULL;
+static const fiftyoneDegreesRenderCacheEntry *firstEntries[4][64];
+static volatile long threadIndex = 0;
+
+static void addConcurrently(void*) {
+	long thread = FIFTYONE_DEGREES_INTERLOCK_INC(&threadIndex) - 1;
+	for (uint32_t i = 0; i < 64; i++) {
+		firstEntries[thread][i] = fiftyoneDegreesRenderCacheAdd(
+			sharedCache, i, 1, "shared", 6);
+	}
+	FIFTYONE_DEGREES_THREAD_EXIT;
+}
+
+TEST_F(RenderCacheTests, ConcurrentAdd) {
+	cache = fiftyoneDegreesRenderCacheCreate(64, 16);
+	ASSERT_NE((void*)NULL, cache);
+	sharedCache = cache;
+	threadIndex = 0;
+	runThreads(4, (FIFTYONE_DEGREES_THREAD_ROUTINE)addConcurrently);
+
+	// Every thread must see the same single entry for each key.
+	for (uint32_t i = 0; i < 64; i++) {
+		ASSERT_NE((void*)NULL, firstEntries[0][i]);
+		for (int t = 1; t < 4; t++) {
+			EXPECT_EQ(firstEntries[0][i], firstEntries[t][i]);
+		}
+	}
+	EXPECT_EQ(64, cache->count);
+}
+#endif
+
+/**
+ * Results returning a fixed list of values for each property which all relate
+ * to profile 42 unless the profile is disabled. Property 0 has no values.
+ */
+class RenderResults : public ResultsBase {
+public:
+	RenderResults(
+		fiftyoneDegreesResultsBase *results,
+		bool hasProfile)
+		: ResultsBase(results, nullptr), hasProfile(hasProfile), renders(0) {}
+	bool hasProfile;
+	int renders;
+protected:
+	void getValuesInternal(
+		int requiredPropertyIndex,
+		vector<string> &values) {
+		renders++;
+		if (requiredPropertyIndex == 0) {
+			return;
+		}
+		values.push_back("A" + std::to_string(requiredPropertyIndex));
+		values.push_back("B");
+	}
+	bool hasValuesInternal(int requiredPropertyIndex) {
+		return requiredPropertyIndex >= 0;
+	}
+	const char* getNoValueMessageInternal(
+		fiftyoneDegreesResultsNoValueReason) {
+		return "none";
+	}
+	fiftyoneDegreesResultsNoValueReason getNoValueReasonInternal(int) {
+		return FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_INVALID_PROPERTY;
+	}
+	bool getProfileIdInternal(int, uint32_t &profileId) {
+		profileId = 42;
+		return hasProfile;
+	}
+};
+
+TEST_F(RenderCacheTests, ResultsShareCache) {
+	fiftyoneDegreesDataSetBase dataSet {};
+	cache = fiftyoneDegreesRenderCacheCreate(8, 64);
+	dataSet.renderCache = cache;
+	fiftyoneDegreesResultsBase results;
+	fiftyoneDegreesResultsInit(&results, &dataSet);
+
+	RenderResults first(&results, true);
+	string_view view = *first.getValueAsStringView(1);
+	EXPECT_EQ("A1|B", view);
+	EXPECT_EQ("A1|B", *first.getValueAsString(1));
+	EXPECT_EQ(1, first.renders);
+
+	// A second results instance uses the string rendered by the first.
+	RenderResults second(&results, true);
+	EXPECT_EQ(view.data(), (*second.getValueAsStringView(1)).data());
+	EXPECT_EQ(0, second.renders);
+
+	// Results without a profile render every time and own the string.
+	RenderResults uncached(&results, false);
+	string_view own = *uncached.getValueAsStringView(1);
+	EXPECT_EQ("A1|B", own);
+	EXPECT_NE(view.data(), own.data());
+	EXPECT_EQ("A1|B", *uncached.getValueAsString(1));
+	EXPECT_EQ(2, uncached.renders);
+
+	EXPECT_FALSE(first.getValueAsStringView(-1).hasValue());
+}
+
+TEST_F(RenderCacheTests, ResultsNoCache) {
+	fiftyoneDegreesDataSetBase dataSet {};
+	fiftyoneDegreesResultsBase results;
+	fiftyoneDegreesResultsInit(&results, &dataSet);
+
+	// Repeat views of the same property share the string held by the
+	// results.
+	RenderResults first(&results, true);
+	string_view view = *first.getValueAsStringView(2);
+	EXPECT_EQ("A2|B", view);
+	EXPECT_EQ(view.data(), (*first.getValueAsStringView(2)).data());
+	EXPECT_EQ(1, first.renders);
+	first.reset(&results);
+	EXPECT_EQ("A2|B", *first.getValueAsStringView(2));
+	EXPECT_EQ(2, first.renders);
+}
+
+TEST_F(RenderCacheTests, ResultsNoValues) {
+	fiftyoneDegreesDataSetBase dataSet {};
+	cache = fiftyoneDegreesRenderCacheCreate(8, 64);
+	dataSet.renderCache = cache;
+	fiftyoneDegreesResultsBase results;
+	fiftyoneDegreesResultsInit(&results, &dataSet);
+
+	// Properties without values have no value rather than an empty string
+	// and are not added to the cache.
+	RenderResults first(&results, true);
+	EXPECT_FALSE(first.getValueAsString(0).hasValue());
+	EXPECT_FALSE(first.getValueAsStringView(0).hasValue());
+	EXPECT_EQ(0, cache->count);
+}
+
+/**
+ * Results overriding getValueAsString.
+ */
+class OverrideResults : public RenderResults {
+public:
+	OverrideResults(fiftyoneDegreesResultsBase *results)
+		: RenderResults(results, false) {}
+	FiftyoneDegrees::Common::Value<string> getValueAsString(
+		int requiredPropertyIndex) {
+		FiftyoneDegrees::Common::Value<string> result;
+		result.setValue("O" + std::to_string(requiredPropertyIndex));
+		return result;
+	}
+};
+
+TEST_F(RenderCacheTests, ResultsOverride) {
+	fiftyoneDegreesDataSetBase dataSet {};
+	fiftyoneDegreesResultsBase results;
+	fiftyoneDegreesResultsInit(&results, &dataSet);
+
+	// Views of values which can not be cached use the overridden method.
+	OverrideResults first(&results);
+	EXPECT_EQ("O3", *first.getValueAsStringView(3));
+}
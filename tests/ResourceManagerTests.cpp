@@ -185,6 +185,46 @@ TEST_F(ResourceManager, ResourceReplace_HandleInUse) {
 		"The new resource was not closed.";
 }
 
+/**
+ * Check that a thread pinned to a handle gets that handle from IncUse even
+ * after the resource is replaced, and that uses which were added but not
+ * taken are released when the thread is unpinned.
+ */
+TEST_F(ResourceManager, PinThread) {
+	fiftyoneDegreesResourceHandle *newHandle;
+	fiftyoneDegreesResourceHandle *handles[100];
+	bool newResource = false;
+	fiftyoneDegreesResourceHandle *pinned =
+		fiftyoneDegreesResourceHandleIncUse(&manager);
+	fiftyoneDegreesResourceHandlePinThread(pinned);
+	fiftyoneDegreesResourceReplace(&manager, (void*)&newResource, &newHandle);
+	for (int i = 0; i < 100; i++) {
+		handles[i] = fiftyoneDegreesResourceHandleIncUse(&manager);
+		ASSERT_EQ(pinned, handles[i]) <<
+			"The handle the thread is pinned to was not returned.";
+	}
+	EXPECT_LE(101, fiftyoneDegreesResourceHandleGetUse(pinned));
+	fiftyoneDegreesResourceHandleUnpinThread();
+	EXPECT_EQ(101, fiftyoneDegreesResourceHandleGetUse(pinned));
+	for (int i = 0; i < 100; i++) {
+		fiftyoneDegreesResourceHandleDecUse(handles[i]);
+	}
+	ASSERT_FALSE(resource) <<
+		"The old resource was closed prematurely.";
+	fiftyoneDegreesResourceHandleDecUse(pinned);
+	ASSERT_TRUE(resource) <<
+		"The old resource was not closed.";
+
+	// Once unpinned the active handle is returned.
+	fiftyoneDegreesResourceHandle *active =
+		fiftyoneDegreesResourceHandleIncUse(&manager);
+	EXPECT_EQ(newHandle, active);
+	fiftyoneDegreesResourceHandleDecUse(active);
+	disposeManager();
+	ASSERT_TRUE(newResource) <<
+		"The new resource was not closed.";
+}
+
 // Number of threads
 #define THREAD_COUNT 8
 // Number of Inc/Dec per thread
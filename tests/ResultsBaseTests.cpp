@@ -0,0 +1,222 @@
+/* *********************************************************************
+ * This Original Work is copyright of 51 Degrees Mobile Experts Limited.
+ * Copyright 2026 51 Degrees Mobile Experts Limited, Davidson House,
+ * Forbury Square, Reading, Berkshire, United Kingdom RG1 3EU.
+ *
+ * This Original Work is licensed under the European Union Public Licence
+ * (EUPL) v.1.2 and is subject to its terms as set out below.
+ *
+ * If a copy of the EUPL was not distributed with this file, You can obtain
+ * one at https://opensource.org/licenses/EUPL-1.2.
+ *
+ * The 'Compatible Licences' set out in the Appendix to the EUPL (as may be
+ * amended by the European Commission) shall be deemed incompatible for
+ * the purposes of the Work and the provisions of the compatibility
+ * clause in Article 5 of the EUPL shall not apply.
+ *
+ * If using the Work as, or as part of, a network application, by
+ * including the attribution notice(s) required under Article 5 of the EUPL
+ * in the end user terms of the application under an appropriate heading,
+ * such notice(s) shall fulfill the requirements of that article.
+ * ********************************************************************* */
+
+#include "pch.h"
+#include "Base.hpp"
+#include "../ResultsBase.hpp"
+#include "../ResultsPool.hpp"
+#include "../fiftyone.h"
+
+using namespace FiftyoneDegrees::Common;
+
+/**
+ * Results with a single value for each property. Property 0 is an integer,
+ * property 1 a float, property 2 a single byte and property 3 has two
+ * integer values. Typed values can be disabled to force the string values to
+ * be used.
+ */
+class TypedResults : public ResultsBase {
+public:
+	TypedResults(fiftyoneDegreesResultsBase *results, bool typed)
+		: ResultsBase(results, nullptr), typed(typed), renders(0) {}
+	bool typed;
+	int renders;
+protected:
+	void getValuesInternal(
+		int requiredPropertyIndex,
+		vector<string> &values) {
+		renders++;
+		switch (requiredPropertyIndex) {
+		case 0: values.push_back("-42"); break;
+		case 1: values.push_back("2.5"); break;
+		case 2: values.push_back("1"); break;
+		default: values.push_back("1"); values.push_back("2"); break;
+		}
+	}
+	bool hasValuesInternal(int requiredPropertyIndex) {
+		return requiredPropertyIndex >= 0;
+	}
+	const char* getNoValueMessageInternal(
+		fiftyoneDegreesResultsNoValueReason) {
+		return "none";
+	}
+	fiftyoneDegreesResultsNoValueReason getNoValueReasonInternal(int) {
+		return FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_INVALID_PROPERTY;
+	}
+	int getStoredValueInternal(
+		int requiredPropertyIndex,
+		fiftyoneDegreesStoredBinaryValueBuffer &value,
+		fiftyoneDegreesPropertyValueType &valueType) {
+		if (typed == false) {
+			return -1;
+		}
+		switch (requiredPropertyIndex) {
+		case 0:
+			valueType = FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_INTEGER;
+			value.value.intValue = -42;
+			return 1;
+		case 1:
+			valueType = FIFTYONE_DEGREES_PROPERTY_VALUE_SINGLE_PRECISION_FLOAT;
+			value.value.floatValue = FIFTYONE_DEGREES_NATIVE_TO_FLOAT(2.5f);
+			return 1;
+		case 2:
+			valueType = FIFTYONE_DEGREES_PROPERTY_VALUE_SINGLE_BYTE;
+			value.value.byteValue = 1;
+			return 1;
+		default:
+			valueType = FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_INTEGER;
+			value.value.intValue = 1;
+			return 2;
+		}
+	}
+};
+
+/**
+ * Results which can be reset with a new value for every property, and which
+ * count the instances alive so the pool tests can check for deletion.
+ */
+class PooledResults : public ResultsBase {
+public:
+	PooledResults(fiftyoneDegreesResultsBase *results, string value)
+		: ResultsBase(results), value(value) {
+		alive++;
+	}
+	~PooledResults() { alive--; }
+	void reset(fiftyoneDegreesResultsBase *results, string newValue) {
+		ResultsBase::reset(results);
+		value = newValue;
+	}
+	fiftyoneDegreesPropertiesAvailable* getAvailable() { return available; }
+	string value;
+	static int alive;
+protected:
+	void getValuesInternal(int, vector<string> &values) {
+		values.push_back(value);
+	}
+	bool hasValuesInternal(int) { return true; }
+	const char* getNoValueMessageInternal(
+		fiftyoneDegreesResultsNoValueReason) {
+		return "none";
+	}
+	fiftyoneDegreesResultsNoValueReason getNoValueReasonInternal(int) {
+		return FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_UNKNOWN;
+	}
+};
+
+int PooledResults::alive = 0;
+
+class ResultsBaseTests : public Base {
+public:
+	void SetUp() {
+		Base::SetUp();
+		fiftyoneDegreesResultsInit(&results, &dataSet);
+	}
+	fiftyoneDegreesDataSetBase dataSet {};
+	fiftyoneDegreesResultsBase results;
+};
+
+/**
+ * Check that the typed getters return the same values from the stored binary
+ * values as from the string values, and only render strings when the stored
+ * values are not available.
+ */
+TEST_F(ResultsBaseTests, TypedGetters) {
+	TypedResults typed(&results, true);
+	TypedResults strings(&results, false);
+	for (TypedResults *r : { &typed, &strings }) {
+		EXPECT_EQ(-42, *r->getValueAsInteger(0));
+		EXPECT_EQ(-42.0, *r->getValueAsDouble(0));
+		EXPECT_EQ(2, *r->getValueAsInteger(1));
+		EXPECT_EQ(2.5, *r->getValueAsDouble(1));
+		EXPECT_EQ(1, *r->getValueAsInteger(2));
+		EXPECT_FALSE(r->getValueAsInteger(3).hasValue());
+		EXPECT_EQ(
+			FIFTYONE_DEGREES_RESULTS_NO_VALUE_REASON_TOO_MANY_VALUES,
+			r->getValueAsDouble(3).getNoValueReason());
+		EXPECT_FALSE(r->getValueAsBool(3).hasValue());
+		EXPECT_FALSE(r->getValueAsInteger(-1).hasValue());
+	}
+	EXPECT_EQ(0, typed.renders);
+	EXPECT_EQ(8, strings.renders);
+}
+
+/**
+ * Check that boolean values stored in binary form are true when non zero.
+ */
+TEST_F(ResultsBaseTests, TypedBool) {
+	TypedResults typed(&results, true);
+	EXPECT_TRUE(*typed.getValueAsBool(0));
+	EXPECT_TRUE(*typed.getValueAsBool(2));
+	EXPECT_EQ(0, typed.renders);
+}
+
+/**
+ * Check that resetting results for a new data set and evidence replaces the
+ * available properties and the rendered values.
+ */
+TEST_F(ResultsBaseTests, Reset) {
+	fiftyoneDegreesPropertiesAvailable available {};
+	fiftyoneDegreesDataSetBase other {};
+	fiftyoneDegreesResultsBase otherResults;
+	other.available = &available;
+	fiftyoneDegreesResultsInit(&otherResults, &other);
+	PooledResults pooled(&results, "first");
+	EXPECT_EQ("first", *pooled.getValueAsStringView(0));
+	EXPECT_EQ(nullptr, pooled.getAvailable());
+	pooled.reset(&otherResults, "second");
+	EXPECT_EQ("second", *pooled.getValueAsStringView(0));
+	EXPECT_EQ("second", *pooled.getValueAsString(0));
+	EXPECT_EQ(&available, pooled.getAvailable());
+}
+
+/**
+ * Check that results released to the pool are reused, that the pool rather
+ * than the results holds the manager, and that results beyond the capacity
+ * or left in the pool are deleted.
+ */
+TEST_F(ResultsBaseTests, Pool) {
+	shared_ptr<fiftyoneDegreesResourceManager> manager =
+		std::make_shared<fiftyoneDegreesResourceManager>();
+	{
+		ResultsPool<PooledResults> pool(manager, 2);
+		EXPECT_EQ(manager.get(), pool.getManager());
+		EXPECT_EQ(2, manager.use_count());
+		EXPECT_EQ(nullptr, pool.acquire());
+		PooledResults *items[3];
+		for (int i = 0; i < 3; i++) {
+			items[i] = new PooledResults(&results, std::to_string(i));
+		}
+		EXPECT_EQ(2, manager.use_count());
+		for (int i = 0; i < 3; i++) {
+			pool.release(items[i]);
+		}
+		EXPECT_EQ(2u, pool.getCount());
+		EXPECT_EQ(2, PooledResults::alive);
+		PooledResults *reused = pool.acquire();
+		EXPECT_EQ(items[1], reused);
+		reused->reset(&results, "reused");
+		EXPECT_EQ("reused", *reused->getValueAsString(0));
+		pool.release(reused);
+	}
+	EXPECT_EQ(0, PooledResults::alive);
+	EXPECT_EQ(1, manager.use_count());
+}
@@ -24,6 +24,10 @@
 #include "../string.h"
 #include "Base.hpp"
 #include "limits.h"
+#include <cfloat>
+#include <cinttypes>
+#include <cmath>
+#include <random>
 
 constexpr size_t bufferSize = 512;
 
@@ -200,6 +204,59 @@ TEST_F(Strings, StringBuilder_OneChar) {
     builder = prev;
 }
 
+static bool failingWriter(void *state, const char *, size_t) {
+    (*(int *)state)++;
+    return false;
+}
+
+TEST_F(Strings, StringBuilder_Writer_Growable) {
+    char chunk[4];
+    char expected[bufferSize];
+    StringBuilderGrowable output = { NULL, 0, 0 };
+    StringBuilder local = { chunk, sizeof(chunk) };
+    fiftyoneDegreesStringBuilderInitWriter(
+        &local,
+        fiftyoneDegreesStringBuilderGrowableWrite,
+        &output);
+    fiftyoneDegreesStringBuilderInit(builder);
+    for (int i = 0; i < 20; i++) {
+        for (StringBuilder *b : { builder, &local }) {
+            fiftyoneDegreesStringBuilderAddChar(b, 'a');
+            fiftyoneDegreesStringBuilderAddInteger(b, i * 997);
+            fiftyoneDegreesStringBuilderAddChars(b, "longer than a chunk", 19);
+        }
+    }
+    fiftyoneDegreesStringBuilderComplete(builder);
+    fiftyoneDegreesStringBuilderComplete(&local);
+    strcpy(expected, builder->ptr);
+    ASSERT_FALSE(builder->full);
+    EXPECT_FALSE(local.full);
+    EXPECT_STREQ(expected, output.ptr);
+    EXPECT_EQ(strlen(expected), output.length);
+    EXPECT_EQ(builder->added, local.added);
+    EXPECT_STREQ("", local.ptr);
+    fiftyoneDegreesStringBuilderGrowableFree(&output);
+    EXPECT_EQ(NULL, output.ptr);
+    EXPECT_EQ(0, output.capacity);
+}
+
+TEST_F(Strings, StringBuilder_Writer_Fails) {
+    char chunk[4];
+    int calls = 0;
+    StringBuilder local = { chunk, sizeof(chunk) };
+    fiftyoneDegreesStringBuilderInitWriter(&local, failingWriter, &calls);
+    fiftyoneDegreesStringBuilderAddChars(&local, "abcdef", 6);
+    EXPECT_TRUE(local.full);
+    EXPECT_EQ(1, calls);
+
+    // Once the writer fails the builder truncates as if there is no writer.
+    fiftyoneDegreesStringBuilderAddChars(&local, "ghi", 3);
+    fiftyoneDegreesStringBuilderComplete(&local);
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(10, local.added);
+    EXPECT_EQ(3, strlen(local.ptr));
+}
+
 TEST_F(Strings, StringBuilder_AddDouble_TripleZero) {
     StringBuilderInit(builder);
     StringBuilderAddDouble(builder, -101.00039674062319, 3);
@@ -283,7 +340,7 @@ TEST_F(Strings, StringBuilder_AddDouble) {
         StringBuilderInit(builder);
         StringBuilderAddDouble(builder, 42.127, 30);
         StringBuilderComplete(builder);
-        EXPECT_STREQ(builder->ptr, "42.127000000000002");
+        EXPECT_STREQ(builder->ptr, "42.127");
     }
 }
 
@@ -779,3 +836,175 @@ TEST_F(Strings, String_CompareLength) {
         EXPECT_NE(0, fiftyoneDegreesStringCompareLength(str1, str2, n));
     }
 }
+
+// Returns the characters added to the builder for the integer.
+static std::string addInteger(StringBuilder *builder, int64_t value) {
+    StringBuilderInit(builder);
+    StringBuilderAddInteger(builder, value);
+    StringBuilderComplete(builder);
+    return std::string(builder->ptr);
+}
+
+static void checkInteger(StringBuilder *builder, int64_t value) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "%" PRId64, value);
+    ASSERT_EQ(std::string(expected), addInteger(builder, value));
+}
+
+TEST_F(Strings, StringBuilder_AddInteger_MatchesSnprintf) {
+    for (int64_t i = -100000; i <= 100000; i++) {
+        checkInteger(builder, i);
+    }
+    int64_t power = 1;
+    for (int i = 0; i < 19; i++) {
+        power *= 10;
+        for (int64_t delta = -1; delta <= 1; delta++) {
+            checkInteger(builder, power + delta);
+            checkInteger(builder, -power + delta);
+        }
+    }
+    checkInteger(builder, INT64_MAX);
+    checkInteger(builder, INT64_MIN);
+    checkInteger(builder, INT64_MIN + 1);
+    std::mt19937_64 random(42);
+    for (int i = 0; i < 1000000; i++) {
+        checkInteger(builder, (int64_t)random() >> (random() % 64));
+    }
+}
+
+/**
+ * Checks that the decimal from DtoaShortest converts back to the value, that
+ * no decimal with fewer digits does, and that the digits match the correctly
+ * rounded digits from snprintf where they also convert back to the value.
+ */
+static void checkShortest(double value) {
+    char text[64];
+    DtoaDecimal decimal = DtoaShortest(value);
+    value = fabs(value);
+    snprintf(text, sizeof(text), "%" PRIu64 "e%d",
+        decimal.digits, (int)decimal.exponent);
+    ASSERT_EQ(value, strtod(text, NULL)) << text;
+    int length = snprintf(text, sizeof(text), "%" PRIu64, decimal.digits);
+    ASSERT_NE('0', text[length - 1]) << text;
+    if (length > 1) {
+        snprintf(text, sizeof(text), "%.*e", length - 2, value);
+        ASSERT_NE(value, strtod(text, NULL)) << text;
+    }
+
+    // Get the digits and exponent from snprintf with the same number of
+    // significant digits. These are the closest to the value, but might not
+    // convert back to it when the value is a power of 2 as the gap to the
+    // next lower double is half the gap to the next higher.
+    snprintf(text, sizeof(text), "%.*e", length - 1, value);
+    if (strtod(text, NULL) != value) {
+        return;
+    }
+    uint64_t digits = 0;
+    const char *c = text;
+    for (; *c != 'e'; c++) {
+        if (*c != '.') {
+            digits = digits * 10 + (uint64_t)(*c - '0');
+        }
+    }
+    int exponent = atoi(c + 1) - (length - 1);
+    ASSERT_EQ(digits, decimal.digits) << text;
+    ASSERT_EQ(exponent, decimal.exponent) << text;
+}
+
+TEST_F(Strings, Dtoa_Shortest_MatchesSnprintf) {
+    const double special[] = {
+        DBL_MIN, DBL_MAX, DBL_TRUE_MIN, DBL_EPSILON, 1, 0.1, 0.3, 1e22, 1e23,
+        5e-324, 2.2250738585072009e-308, 9007199254740993.0, 123456789012345678.0,
+        1.7976931348623157e308, 4.9406564584124654e-324, 2.98023223876953125E-8,
+        -21.0, 42.127, 5.0999999999999996, 739.997, 1e15, 1e16, 1e17, 1e-5 };
+    for (double value : special) {
+        checkShortest(value);
+    }
+    for (int e = -1074; e <= 1023; e++) {
+        checkShortest(ldexp(1, e));
+    }
+    for (int e = -300; e <= 300; e++) {
+        checkShortest(strtod(("1e" + std::to_string(e)).c_str(), NULL));
+    }
+    std::mt19937_64 random(42);
+    for (int i = 0; i < 1000000; i++) {
+        uint64_t bits = random();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value) && value != 0) {
+            checkShortest(value);
+        }
+    }
+}
+
+// Removes trailing zeros after a decimal point, and the decimal point, from
+// the snprintf output, and any negative sign from a zero.
+static std::string trimFixed(const char *text) {
+    std::string result(text);
+    if (result.find('.') != std::string::npos) {
+        while (result.back() == '0') {
+            result.pop_back();
+        }
+        if (result.back() == '.') {
+            result.pop_back();
+        }
+    }
+    if (result == "-0") {
+        result = "0";
+    }
+    return result;
+}
+
+/**
+ * Values with at most 15 significant digits convert back to the same digits
+ * and so must match snprintf for every number of decimal places, except where
+ * the digits removed are exactly half of the last place which are rounded
+ * away from zero.
+ */
+TEST_F(Strings, StringBuilder_AddDouble_MatchesSnprintf) {
+    char text[64];
+    std::mt19937_64 random(42);
+    for (int i = 0; i < 200000; i++) {
+        const int64_t digits = (int64_t)(random() % 1000000000000000ULL) *
+            (random() % 2 ? 1 : -1);
+        const int places = (int)(random() % 16);
+        const double value = (double)digits / pow(10, places);
+        for (uint8_t decimalPlaces = 0; decimalPlaces <= 15; decimalPlaces++) {
+            snprintf(text, sizeof(text), "%.*f",
+                decimalPlaces < places ? decimalPlaces : places, value);
+            std::string expected = trimFixed(text);
+            if (decimalPlaces < places) {
+                const int64_t divisor = (int64_t)pow(10, places - decimalPlaces);
+                const int64_t remainder = std::llabs(digits % divisor);
+                if (remainder * 2 == divisor) {
+                    // Round half away from zero.
+                    const int64_t rounded = digits / divisor +
+                        (digits < 0 ? -1 : 1);
+                    snprintf(text, sizeof(text), "%.*f", decimalPlaces,
+                        (double)rounded / pow(10, decimalPlaces));
+                    expected = trimFixed(text);
+                }
+            }
+            StringBuilderInit(builder);
+            StringBuilderAddDouble(builder, value, decimalPlaces);
+            StringBuilderComplete(builder);
+            ASSERT_EQ(expected, std::string(builder->ptr)) <<
+                digits << "e-" << places << " to " << (int)decimalPlaces;
+        }
+    }
+}
+
+TEST_F(Strings, StringBuilder_AddDouble_Large) {
+    StringBuilderInit(builder);
+    StringBuilderAddDouble(builder, 1e22, 2);
+    StringBuilderAddChar(builder, ' ');
+    StringBuilderAddDouble(builder, -12345678901234567890.0, 2);
+    StringBuilderAddChar(builder, ' ');
+    StringBuilderAddDouble(builder, 0.000001234, 15);
+    StringBuilderAddChar(builder, ' ');
+    StringBuilderAddDouble(builder, 1e-300, 15);
+    StringBuilderComplete(builder);
+    EXPECT_STREQ(
+        "10000000000000000000000 -12345678901234567000 0.000001234 0",
+        builder->ptr);
+}
@@ -23,6 +23,8 @@
 #include "pch.h"
 #include "../fiftyone.h"
 #include "../wkbtot.h"
+#include "../wkbtot_pp.hpp"
+#include "../string_pp.hpp"
 
 static bool CheckResult(const char *result, const char *expected, size_t const size) {
 	bool match = true;
@@ -73,6 +75,57 @@ static void convertAndCompare_base(
 		CheckResult(buffer, expected, strlen(expected))) <<
 		"The value of " << comment << " is not correctly converted:\n -- '" << buffer <<
 		"'\nvs expected\n -- '" << expected << "'" << std::endl;
+
+	// The same text must be produced in a single pass when the output is
+	// passed to a writer in small chunks.
+	if (statusCode < 0) {
+		char chunk[5];
+		fiftyoneDegreesStringBuilderGrowable output = { NULL, 0, 0 };
+		fiftyoneDegreesStringBuilder builder = { chunk, sizeof(chunk) };
+		fiftyoneDegreesStringBuilderInitWriter(
+			&builder,
+			fiftyoneDegreesStringBuilderGrowableWrite,
+			&output);
+		FIFTYONE_DEGREES_EXCEPTION_CLEAR;
+		fiftyoneDegreesWriteWkbAsWktToStringBuilder(
+			wkbBytes,
+			reductionMode,
+			decimalPlaces,
+			&builder,
+			exception);
+		fiftyoneDegreesStringBuilderComplete(&builder);
+		EXPECT_FALSE(builder.full);
+		EXPECT_EQ(result.written, builder.added);
+		EXPECT_STREQ(buffer, output.ptr == NULL ? "" : output.ptr) <<
+			"The value of " << comment << " is not correctly streamed";
+		fiftyoneDegreesStringBuilderGrowableFree(&output);
+
+		// The cached text must be the same when first rendered and when
+		// read from the cache.
+		fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(
+			1,
+			FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+		for (int i = 0; i < 2; i++) {
+			char cached[DEFAULT_BUFFER_SIZE];
+			fiftyoneDegreesStringBuilder cachedBuilder = {
+				cached, sizeof(cached) };
+			fiftyoneDegreesStringBuilderInit(&cachedBuilder);
+			fiftyoneDegreesWriteWkbAsWktToStringBuilderCached(
+				cache,
+				42,
+				wkbBytes,
+				reductionMode,
+				decimalPlaces,
+				&cachedBuilder,
+				exception);
+			fiftyoneDegreesStringBuilderComplete(&cachedBuilder);
+			EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+			EXPECT_STREQ(buffer, cached) <<
+				"The value of " << comment << " is not correctly cached";
+			EXPECT_EQ(1, cache->count);
+		}
+		fiftyoneDegreesRenderCacheFree(cache);
+	}
 }
 
 static void convertAndCompare_withDecimalPlaces(
@@ -829,7 +882,7 @@ TEST(WKBToT, WKBToT_SampleWKB_OpenLayers)
 		0x54,0xE3,0xA5,0x9B,0xC4,0x60,0x25,0x40,
 		0x64,0x3B,0xDF,0x4F,0x8D,0x17,0x39,0xC0,
 	};
-	const char * const expected = "POLYGON((10.689 -25.091999999999999,34.594999999999999 -20.170000000000002,38.814 -35.639000000000003,13.502000000000001 -39.155000000000001,10.689 -25.091999999999999))";
+	const char * const expected = "POLYGON((10.689 -25.092,34.595 -20.17,38.814 -35.639,13.502 -39.155,10.689 -25.092))";
 
 	convertAndCompare(wkbBytes, expected, "SampleWKB from OpenLayers");
 }
@@ -1055,3 +1108,278 @@ TEST(WKBToT, WKBToT_String_Multipolygon_Broken1)
 		3,
 		FIFTYONE_DEGREES_WKBToT_REDUCTION_SHORT);
 }
+
+// ------------------------------------------------------------------------------
+// Cache of WKT strings
+// ------------------------------------------------------------------------------
+static const byte cachePointWkb[] = {
+	0x00,
+	0x00, 0x00, 0x00, 0x01,
+	0x40, 0x31, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x8b, 0xe0, 0xc0, 0x00, 0x00, 0x00, 0x00,
+};
+
+static std::string writeCached(
+	fiftyoneDegreesRenderCache * const cache,
+	const uint32_t offset,
+	const byte * const wkbBytes,
+	const uint8_t decimalPlaces,
+	WkbtotReductionMode reductionMode = FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE) {
+	char buffer[DEFAULT_BUFFER_SIZE];
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	fiftyoneDegreesStringBuilder builder = { buffer, sizeof(buffer) };
+	fiftyoneDegreesStringBuilderInit(&builder);
+	fiftyoneDegreesWriteWkbAsWktToStringBuilderCached(
+		cache,
+		offset,
+		wkbBytes,
+		reductionMode,
+		decimalPlaces,
+		&builder,
+		exception);
+	fiftyoneDegreesStringBuilderComplete(&builder);
+	EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+	return std::string(buffer);
+}
+
+TEST(WKBToT, WKBToT_Cache_KeyedByFormat)
+{
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(
+		8,
+		FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 1, cachePointWkb, 3));
+	EXPECT_EQ("POINT(17.3 892.1)", writeCached(cache, 1, cachePointWkb, 1));
+	EXPECT_EQ(2, cache->count);
+
+	// The same offset and format always returns the first text cached, as
+	// the offset identifies the value.
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 1, cachePointWkb, 3));
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 2, cachePointWkb, 3));
+	EXPECT_EQ(3, cache->count);
+	fiftyoneDegreesRenderCacheFree(cache);
+}
+
+TEST(WKBToT, WKBToT_Cache_NotCached)
+{
+	// Without a cache the text is always rendered.
+	EXPECT_EQ(
+		"POINT(17.25 892.094)",
+		writeCached(nullptr, 1, cachePointWkb, 3));
+
+	// Text longer than the maximum length is rendered but not cached. The
+	// cache records that it is too long.
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(1, 4);
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 1, cachePointWkb, 3));
+	EXPECT_EQ(1, cache->count);
+	EXPECT_EQ(
+		FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG,
+		fiftyoneDegreesRenderCacheGet(cache, 1, 3)->length);
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 1, cachePointWkb, 3));
+	fiftyoneDegreesRenderCacheFree(cache);
+
+	// Once the cache is full text is rendered but not cached.
+	cache = fiftyoneDegreesRenderCacheCreate(
+		1,
+		FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 1, cachePointWkb, 3));
+	EXPECT_EQ("POINT(17.3 892.1)", writeCached(cache, 2, cachePointWkb, 1));
+	EXPECT_EQ("POINT(17.3 892.1)", writeCached(cache, 2, cachePointWkb, 1));
+	EXPECT_EQ(1, cache->count);
+	fiftyoneDegreesRenderCacheFree(cache);
+}
+
+// Returns the WKB of a line string with the number of points, and the WKT
+// expected from it.
+static std::vector<byte> lineStringWkb(uint32_t points, std::string &wkt) {
+	std::vector<byte> wkb = { 0x01, 0x02, 0x00, 0x00, 0x00 };
+	std::stringstream expected;
+	for (int i = 0; i < 4; i++) {
+		wkb.push_back((byte)(points >> (i * 8)));
+	}
+	expected << "LINESTRING(";
+	for (uint32_t i = 0; i < points; i++) {
+		const double coordinate = i;
+		for (int j = 0; j < 2; j++) {
+			const byte *bytes = (const byte*)&coordinate;
+			wkb.insert(wkb.end(), bytes, bytes + sizeof(double));
+		}
+		expected << (i > 0 ? "," : "") << i << " " << i;
+	}
+	expected << ")";
+	wkt = expected.str();
+	return wkb;
+}
+
+TEST(WKBToT, WKBToT_Cache_Full)
+{
+	std::string longWkt;
+	const std::vector<byte> longWkb = lineStringWkb(40, longWkt);
+	EXPECT_GT(longWkt.size(), (size_t)FIFTYONE_DEGREES_REASONABLE_WKT_STRING_LENGTH);
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(
+		2,
+		FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+
+	// Text longer than the chunk used to render it is still cached.
+	EXPECT_EQ(longWkt, writeCached(cache, 1, longWkb.data(), 3));
+	EXPECT_EQ(longWkt, writeCached(cache, 1, longWkb.data(), 3));
+	EXPECT_EQ("POINT(17.25 892.094)", writeCached(cache, 2, cachePointWkb, 3));
+	EXPECT_TRUE(fiftyoneDegreesRenderCacheIsFull(cache));
+
+	// Once full, misses of any length are rendered correctly every time and
+	// the entries already cached are still used.
+	for (int i = 0; i < 3; i++) {
+		EXPECT_EQ("POINT(17.3 892.1)", writeCached(cache, 3, cachePointWkb, 1));
+		EXPECT_EQ(longWkt, writeCached(cache, 4, longWkb.data(), 3));
+		EXPECT_EQ(longWkt, writeCached(cache, 1, longWkb.data(), 3));
+		EXPECT_EQ(
+			"POINT(17.25 892.094)",
+			writeCached(cache, 2, cachePointWkb, 3));
+	}
+	EXPECT_EQ(2, cache->count);
+	EXPECT_EQ(NULL, fiftyoneDegreesRenderCacheGet(cache, 3, 1));
+	fiftyoneDegreesRenderCacheFree(cache);
+
+	// Text longer than the chunk and the maximum length is rendered directly
+	// once it is known to be too long.
+	cache = fiftyoneDegreesRenderCacheCreate(2, 64);
+	for (int i = 0; i < 3; i++) {
+		EXPECT_EQ(longWkt, writeCached(cache, 1, longWkb.data(), 3));
+	}
+	EXPECT_EQ(1, cache->count);
+	fiftyoneDegreesRenderCacheFree(cache);
+}
+
+TEST(WKBToT, WKBToT_Cache_Exception)
+{
+	const byte wkbBytes[] = {
+		0x01,
+		0xd3, 0x00, 0x00, 0x00, // unknown geometry
+	};
+	char buffer[DEFAULT_BUFFER_SIZE];
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(
+		1,
+		FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+	fiftyoneDegreesStringBuilder builder = { buffer, sizeof(buffer) };
+	fiftyoneDegreesStringBuilderInit(&builder);
+	fiftyoneDegreesWriteWkbAsWktToStringBuilderCached(
+		cache,
+		1,
+		wkbBytes,
+		FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE,
+		3,
+		&builder,
+		exception);
+	EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_CHECK(UNKNOWN_GEOMETRY));
+	EXPECT_EQ(0, cache->count);
+	fiftyoneDegreesRenderCacheFree(cache);
+}
+
+TEST(WKBToT, WKBToT_Cache_Stream)
+{
+	const byte wkbStringBytes[] = {
+		20,00, // length of WKB 'trail' of #String
+		0x00,
+		0x00, 0x00, 0x00, 0x01,
+		0x40, 0x31, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x40, 0x8b, 0xe0, 0xc0, 0x00, 0x00, 0x00, 0x00,
+	};
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	fiftyoneDegreesRenderCache *cache = fiftyoneDegreesRenderCacheCreate(
+		1,
+		FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT);
+	for (int i = 0; i < 2; i++) {
+		std::stringstream stream;
+		FiftyoneDegrees::Common::writeWkbStringToStringStream(
+			cache,
+			7,
+			(const fiftyoneDegreesVarLengthByteArray*)wkbStringBytes,
+			FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE,
+			stream,
+			3,
+			exception);
+		EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+		EXPECT_EQ("POINT(17.25 892.094)", stream.str());
+	}
+	EXPECT_EQ(1, cache->count);
+	fiftyoneDegreesRenderCacheFree(cache);
+}
+
+TEST(WKBToT, WKBToT_Stream_Long)
+{
+	// A line string whose text is longer than the chunk used to stream it.
+	const uint32_t points = 40;
+	std::vector<byte> wkbString = { 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00 };
+	for (int i = 0; i < 4; i++) {
+		wkbString.push_back((byte)(points >> (i * 8)));
+	}
+	std::stringstream expected;
+	expected << "LINESTRING(";
+	for (uint32_t i = 0; i < points; i++) {
+		const double coordinate = i;
+		for (int j = 0; j < 2; j++) {
+			const byte *bytes = (const byte*)&coordinate;
+			wkbString.insert(wkbString.end(), bytes, bytes + sizeof(double));
+		}
+		expected << (i > 0 ? "," : "") << i << " " << i;
+	}
+	expected << ")";
+	const int16_t size = (int16_t)(wkbString.size() - sizeof(int16_t));
+	memcpy(wkbString.data(), &size, sizeof(size));
+
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	std::stringstream stream;
+	const fiftyoneDegreesWkbtotResult result =
+		FiftyoneDegrees::Common::writeWkbStringToStringStream(
+			(const fiftyoneDegreesVarLengthByteArray*)wkbString.data(),
+			FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE,
+			stream,
+			3,
+			exception);
+	EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_OKAY);
+	EXPECT_FALSE(result.bufferTooSmall);
+	EXPECT_GT(expected.str().size(), (size_t)FIFTYONE_DEGREES_REASONABLE_WKT_STRING_LENGTH);
+	EXPECT_EQ(expected.str(), stream.str());
+}
+
+TEST(WKBToT, WKBToT_Stream_Exception)
+{
+	// A geometry collection with a line string whose text is longer than the
+	// chunk used to stream it, followed by an unknown geometry.
+	std::string wkt;
+	const std::vector<byte> lineString = lineStringWkb(40, wkt);
+	std::vector<byte> wkbString = {
+		0x00, 0x00,
+		0x01,
+		0x07, 0x00, 0x00, 0x00, // geometry collection
+		0x02, 0x00, 0x00, 0x00,
+	};
+	wkbString.insert(wkbString.end(), lineString.begin(), lineString.end());
+	wkbString.insert(wkbString.end(), { 0x01, 0xd3, 0x00, 0x00, 0x00 });
+	const int16_t size = (int16_t)(wkbString.size() - sizeof(int16_t));
+	memcpy(wkbString.data(), &size, sizeof(size));
+
+	// Nothing is added to the stream when there is an exception, even once
+	// more text than the chunk has been rendered.
+	FIFTYONE_DEGREES_EXCEPTION_CREATE;
+	std::stringstream stream;
+	stream << "Before|";
+	FiftyoneDegrees::Common::writeWkbStringToStringStream(
+		(const fiftyoneDegreesVarLengthByteArray*)wkbString.data(),
+		FIFTYONE_DEGREES_WKBToT_REDUCTION_NONE,
+		stream,
+		3,
+		exception);
+	EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_CHECK(UNKNOWN_GEOMETRY));
+	EXPECT_EQ("Before|", stream.str());
+
+	FIFTYONE_DEGREES_EXCEPTION_CLEAR;
+	FiftyoneDegrees::Common::writeStoredBinaryValueToStringStream(
+		(const fiftyoneDegreesStoredBinaryValue*)wkbString.data(),
+		FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_WKB,
+		stream,
+		3,
+		exception);
+	EXPECT_TRUE(FIFTYONE_DEGREES_EXCEPTION_CHECK(UNKNOWN_GEOMETRY));
+	EXPECT_EQ("Before|", stream.str());
+}
@@ -350,6 +350,32 @@ supported. */
     FIFTYONE_DEGREES_INTERLOCK_EXCHANGE(d,e,c)
 #endif
 
+/**
+ * 64 bit atomic add. Adds the value to the destination and returns the value
+ * of the destination after the addition.
+ * @param d pointer to the destination to add to
+ * @param a the value to add, which may be negative
+ * @return value after adding
+ */
+#ifdef _MSC_VER
+#define FIFTYONE_DEGREES_INTERLOCK_ADD_64(d,a) \
+	(InterlockedExchangeAdd64((volatile __int64*)(d), (__int64)(a)) + \
+	(__int64)(a))
+#else
+#define FIFTYONE_DEGREES_INTERLOCK_ADD_64(d,a) \
+	(__atomic_add_fetch(d, a, __ATOMIC_SEQ_CST))
+#endif
+
+/**
+ * Storage class specifier for variables which have a separate instance for
+ * each thread. Only static variables of plain data types should use this.
+ */
+#ifdef _MSC_VER
+#define FIFTYONE_DEGREES_THREAD_LOCAL __declspec(thread)
+#else
+#define FIFTYONE_DEGREES_THREAD_LOCAL __thread
+#endif
+
 /**
  * Replaces the destination pointer with the exchange pointer, only if the
  * destination pointer matched the comparand. Returns the value of d before
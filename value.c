@@ -36,6 +36,11 @@ typedef struct value_search_t {
 	StringBuilder *tempBuilder;
 } valueSearch;
 
+// Size of the buffer on the stack that typed values are formatted into as
+// text to compare with the name. The buffer is sized from the length of the
+// name so longer names use a buffer on the heap.
+#define TEMP_BUFFER_LENGTH 64
+
 static int compareValueByName(
 	void *state,
 	Item *item,
@@ -70,6 +75,65 @@ static int compareValueByName(
 	return result;
 }
 
+// Searches the values of the property for the value name returning the index
+// of the value, or -1 if not found. If found the item contains the value and
+// must be released by the caller.
+static long searchByName(
+	const Collection *values,
+	const Collection *strings,
+	const Property *property,
+	PropertyValueType storedValueType,
+	const char *valueName,
+	Item *item,
+	Exception *exception) {
+	long index;
+	valueSearch search;
+	search.valueName = valueName;
+	search.strings = strings;
+	search.valueType = storedValueType;
+	search.tempBuilder = NULL;
+
+	if (storedValueType == FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING) {
+		return CollectionBinarySearch(
+			values,
+			item,
+			(CollectionIndexOrOffset){property->firstValueIndex},
+			(CollectionIndexOrOffset){property->lastValueIndex},
+			CollectionKeyType_Value,
+			(void*)&search,
+			compareValueByName,
+			exception);
+	}
+
+	// Values are ordered by their text, which differs from the natural order
+	// of every other stored type (e.g. "10" sorts before "9"), so the search
+	// must compare the text of each value with the name.
+	const size_t requiredSize = strlen(valueName) + 3;
+	char stackBuffer[TEMP_BUFFER_LENGTH];
+	char * const buffer = requiredSize <= sizeof(stackBuffer) ?
+		stackBuffer : 
+		(char*)Malloc(requiredSize);
+	if (buffer == NULL) {
+		EXCEPTION_SET(INSUFFICIENT_MEMORY);
+		return -1;
+	}
+	StringBuilder tempBuilder = { buffer, requiredSize };
+	search.tempBuilder = &tempBuilder;
+	index = CollectionBinarySearch(
+		values,
+		item,
+		(CollectionIndexOrOffset){property->firstValueIndex},
+		(CollectionIndexOrOffset){property->lastValueIndex},
+		CollectionKeyType_Value,
+		(void*)&search,
+		compareValueByName,
+		exception);
+	if (buffer != stackBuffer) {
+		Free(buffer);
+	}
+	return index;
+}
+
 const StoredBinaryValue* fiftyoneDegreesValueGetContent(
 	const Collection *strings,
 	const Value *value,
@@ -174,31 +238,16 @@ long fiftyoneDegreesValueGetIndexByNameAndType(
 	const char *valueName,
 	Exception *exception) {
 	Item item;
-	valueSearch search;
 	long index;
 	DataReset(&item.data);
-	search.valueName = valueName;
-	search.strings = strings;
-	search.valueType = storedValueType;
-
-	const bool isString = (storedValueType == FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING);
-	const size_t requiredSize = strlen(valueName) + 3;
-	char * const buffer = isString ? NULL : Malloc(requiredSize);
-	StringBuilder tempBuilder = { buffer, requiredSize };
-	search.tempBuilder = isString ? NULL : &tempBuilder;
-
-	index = CollectionBinarySearch(
+	index = searchByName(
 		values,
+		strings,
+		property,
+		storedValueType,
+		valueName,
 		&item,
-		(CollectionIndexOrOffset){property->firstValueIndex},
-		(CollectionIndexOrOffset){property->lastValueIndex},
-		CollectionKeyType_Value,
-		(void*)&search,
-		compareValueByName,
 		exception);
-	if (buffer) {
-		Free(buffer);
-	}
 	if (EXCEPTION_OKAY) {
 		COLLECTION_RELEASE(values, &item);
 	}
@@ -231,35 +280,20 @@ const Value* fiftyoneDegreesValueGetByNameAndType(
 	const char * const valueName,
 	CollectionItem * const item,
 	Exception * const exception) {
-	valueSearch search;
 	Value *value = NULL;
-	search.valueName = valueName;
-	search.strings = strings;
-	search.valueType = storedValueType;
-
-	const bool isString = (storedValueType == FIFTYONE_DEGREES_PROPERTY_VALUE_TYPE_STRING);
-	const size_t requiredSize = strlen(valueName) + 3;
-	char * const buffer = isString ? NULL : Malloc(requiredSize);
-	StringBuilder tempBuilder = { buffer, requiredSize };
-	search.tempBuilder = isString ? NULL : &tempBuilder;
-
 	if (
 		(int)property->firstValueIndex != -1 &&
-		CollectionBinarySearch(
+		searchByName(
 			values,
+			strings,
+			property,
+			storedValueType,
+			valueName,
 			item,
-			(CollectionIndexOrOffset){property->firstValueIndex},
-			(CollectionIndexOrOffset){property->lastValueIndex},
-			CollectionKeyType_Value,
-			(void*)&search,
-			compareValueByName,
 			exception) >= 0 &&
 		EXCEPTION_OKAY) {
 		value = (Value*)item->data.ptr;
 	}
-	if (buffer) {
-		Free(buffer);
-	}
 	return value;
 }
 
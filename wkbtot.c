@@ -623,6 +623,118 @@ void fiftyoneDegreesWriteWkbAsWktToStringBuilder(
         exception);
 }
 
+/**
+ * State of the writer used to render WKT which might be added to a cache.
+ */
+typedef struct wkt_cache_writer_t {
+    StringBuilderGrowable wkt; /* WKT rendered while it might be cached */
+    size_t maxLength; /* Maximum length of a WKT that can be cached */
+    StringBuilder *builder; /* Builder the WKT is written to if not cached */
+    bool direct; /* True once the WKT is written directly to the builder */
+} wktCacheWriter;
+
+/**
+ * Keeps the characters until the WKT is known to be longer than the cache
+ * allows, after which they are written directly to the builder.
+ */
+static bool writeCacheable(void *state, const char *chars, size_t length) {
+    wktCacheWriter * const writer = (wktCacheWriter*)state;
+    if (writer->direct == false && (
+        writer->wkt.length + length > writer->maxLength ||
+        StringBuilderGrowableWrite(&writer->wkt, chars, length) == false)) {
+        writer->direct = true;
+        if (writer->wkt.ptr != NULL) {
+            StringBuilderAddChars(
+                writer->builder,
+                writer->wkt.ptr,
+                writer->wkt.length);
+            StringBuilderGrowableFree(&writer->wkt);
+        }
+    }
+    if (writer->direct) {
+        StringBuilderAddChars(writer->builder, chars, length);
+    }
+    return true;
+}
+
+void fiftyoneDegreesWriteWkbAsWktToStringBuilderCached(
+    fiftyoneDegreesRenderCache * const cache,
+    const uint32_t offset,
+    unsigned const char * const wellKnownBinary,
+    const WkbtotReductionMode reductionMode,
+    const DecimalPlacesType decimalPlaces,
+    fiftyoneDegreesStringBuilder * const builder,
+    fiftyoneDegreesException * const exception) {
+
+    // The second half of the key is the format of the WKT.
+    const uint32_t format =
+        ((uint32_t)reductionMode << 8) | (uint32_t)decimalPlaces;
+    const RenderCacheEntry *entry = cache == NULL ?
+        NULL : RenderCacheGet(cache, offset, format);
+
+    // Render the WKT directly into the builder if it can't be cached.
+    if (cache == NULL ||
+        (entry == NULL && RenderCacheIsFull(cache)) ||
+        (entry != NULL &&
+            entry->length == FIFTYONE_DEGREES_RENDER_CACHE_TOO_LONG)) {
+        handleWKBRoot(
+            wellKnownBinary,
+            reductionMode,
+            builder,
+            decimalPlaces,
+            exception);
+        return;
+    }
+
+    if (entry == NULL) {
+
+        // Render the WKT keeping it separately until it is known to be short
+        // enough to be cached. Longer WKT is written to the builder as soon
+        // as it exceeds the maximum length so that it is only rendered once.
+        char chunk[REASONABLE_WKT_STRING_LENGTH];
+        wktCacheWriter writer = {
+            { NULL, 0, 0 },
+            cache->maxLength,
+            builder,
+            false };
+        StringBuilder wktBuilder = { chunk, sizeof(chunk) };
+        StringBuilderInitWriter(&wktBuilder, writeCacheable, &writer);
+        handleWKBRoot(
+            wellKnownBinary,
+            reductionMode,
+            &wktBuilder,
+            decimalPlaces,
+            exception);
+        if (EXCEPTION_FAILED) {
+            StringBuilderGrowableFree(&writer.wkt);
+            return;
+        }
+        StringBuilderComplete(&wktBuilder);
+        if (writer.direct) {
+            // Record that the WKT is too long to render it directly next time.
+            RenderCacheAddTooLong(cache, offset, format);
+            return;
+        }
+        entry = RenderCacheAdd(
+            cache,
+            offset,
+            format,
+            writer.wkt.ptr != NULL ? writer.wkt.ptr : "",
+            writer.wkt.length);
+        if (entry == NULL) {
+            // The cache became full, or there was insufficient memory.
+            StringBuilderAddChars(builder, writer.wkt.ptr, writer.wkt.length);
+            StringBuilderGrowableFree(&writer.wkt);
+            return;
+        }
+        StringBuilderGrowableFree(&writer.wkt);
+    }
+    StringBuilderAddChars(
+        builder,
+        FIFTYONE_DEGREES_RENDER_CACHE_VALUE(entry),
+        entry->length);
+}
+
 fiftyoneDegreesWkbtotResult fiftyoneDegreesConvertWkbToWkt(
     const byte * const wellKnownBinary,
     const WkbtotReductionMode reductionMode,
@@ -27,6 +27,14 @@
 
 #include "string.h"
 #include "exceptions.h"
+#include "renderCache.h"
+
+/**
+ * Default maximum length of a WKT string held in a cache used with
+ * #fiftyoneDegreesWriteWkbAsWktToStringBuilderCached. Polygons with hundreds
+ * of points fit within this length.
+ */
+#define FIFTYONE_DEGREES_WKT_CACHE_MAX_LENGTH_DEFAULT 16384
 
 /**
  * Used as a return type from the conversion routines to carry information about
@@ -53,6 +61,8 @@ typedef enum {
 
 /**
  * Converts WKB geometry bytes to WKT string and writes it to string builder.
+ * If the builder has a writer, see #fiftyoneDegreesStringBuilderInitWriter,
+ * then WKT of any length is written in a single pass.
  * @param wellKnownBinary bytes of WKB geometry.
  * @param reductionMode type/value reduction applied to decrease WKB size.
  * @param decimalPlaces precision for numbers (places after the decimal dot).
@@ -68,6 +78,34 @@ fiftyoneDegreesWriteWkbAsWktToStringBuilder
  fiftyoneDegreesStringBuilder *builder,
  fiftyoneDegreesException *exception);
 
+/**
+ * Converts WKB geometry bytes to WKT string and writes it to string builder
+ * using a cache of WKT strings already rendered. The cache is keyed by the
+ * offset of the value in the strings collection, the reduction mode and the
+ * decimal places, so must only be used with values from a single strings
+ * collection. This is usually the wktCache of the data set which is freed
+ * with it. If the WKT is not cached then it is rendered and added unless it
+ * is longer than the maximum length or the cache is full. Once the cache is
+ * full, or a WKT has been found to be longer than the maximum length, the WKT
+ * is rendered directly into the builder as if there were no cache.
+ * @param cache of rendered WKT strings, or NULL to always render.
+ * @param offset of the value in the strings collection.
+ * @param wellKnownBinary bytes of WKB geometry at the offset.
+ * @param reductionMode type/value reduction applied to decrease WKB size.
+ * @param decimalPlaces precision for numbers (places after the decimal dot).
+ * @param builder string builder to write WKT into.
+ * @param exception pointer to the exception struct.
+ */
+EXTERNAL void
+fiftyoneDegreesWriteWkbAsWktToStringBuilderCached
+(fiftyoneDegreesRenderCache *cache,
+ uint32_t offset,
+ const unsigned char *wellKnownBinary,
+ fiftyoneDegreesWkbtotReductionMode reductionMode,
+ uint8_t decimalPlaces,
+ fiftyoneDegreesStringBuilder *builder,
+ fiftyoneDegreesException *exception);
+
 /**
  * Converts WKB geometry bytes to WKT string written into provided buffer.
  * @param wellKnownBinary bytes of WKB geometry.
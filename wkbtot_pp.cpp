@@ -26,8 +26,7 @@
 // with C implementation file
 
 #include "wkbtot_pp.hpp"
-
-#include <memory>
+#include "string_pp.hpp"
 
 #include "fiftyone.h"
 
@@ -39,6 +38,24 @@ namespace FiftyoneDegrees::Common {
         std::stringstream &stream,
         const uint8_t decimalPlaces,
         Exception * const exception) {
+        return writeWkbStringToStringStream(
+            nullptr,
+            0,
+            wkbString,
+            reductionMode,
+            stream,
+            decimalPlaces,
+            exception);
+    }
+
+    WkbtotResult writeWkbStringToStringStream(
+        RenderCache * const cache,
+        const uint32_t offset,
+        const VarLengthByteArray * const wkbString,
+        WkbtotReductionMode reductionMode,
+        std::stringstream &stream,
+        const uint8_t decimalPlaces,
+        Exception * const exception) {
 
         WkbtotResult toWktResult = {
             0,
@@ -49,56 +66,30 @@ namespace FiftyoneDegrees::Common {
             EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_NULL_POINTER);
             return toWktResult;
         }
-        const auto * const wkbBytes = &wkbString->firstByte;
-        if (!wkbBytes) {
-            EXCEPTION_SET(FIFTYONE_DEGREES_STATUS_INVALID_INPUT);
-            return toWktResult;
-        }
 
-        {
-            char buffer[REASONABLE_WKT_STRING_LENGTH];
-            StringBuilder builder = { buffer, REASONABLE_WKT_STRING_LENGTH };
-            StringBuilderInit(&builder);
-            WriteWkbAsWktToStringBuilder(
-                wkbBytes,
-                reductionMode,
-                decimalPlaces,
-                &builder,
-                exception
-                );
-            StringBuilderComplete(&builder);
-            toWktResult = {
-                builder.added,
-                builder.full,
-            };
-            if (EXCEPTION_OKAY && !toWktResult.bufferTooSmall) {
-                stream << buffer;
-                return toWktResult;
-            }
-        }
-        if (toWktResult.bufferTooSmall) {
-            EXCEPTION_CLEAR;
-            const size_t requiredSize = toWktResult.written + 1;
-            const std::unique_ptr<char[]> buffer = std::make_unique<char[]>(requiredSize);
-            StringBuilder builder = { buffer.get(), requiredSize };
-            StringBuilderInit(&builder);
-            WriteWkbAsWktToStringBuilder(
-                wkbBytes,
-                reductionMode,
-                decimalPlaces,
-                &builder,
-                exception
-                );
-            StringBuilderComplete(&builder);
-            toWktResult = {
-                builder.added,
-                builder.full,
-            };
-            if (EXCEPTION_OKAY && !toWktResult.bufferTooSmall) {
-                stream << buffer.get();
-                return toWktResult;
-            }
+        // Cached or not the WKT is rendered once. Short WKT stays in the
+        // chunk, and longer WKT is kept until it is complete, so that the
+        // stream is only written to if there is no exception.
+        char chunk[REASONABLE_WKT_STRING_LENGTH];
+        std::string pending;
+        StringBuilder builder = { chunk, REASONABLE_WKT_STRING_LENGTH };
+        StringBuilderInitWriter(&builder, writeToString, &pending);
+        WriteWkbAsWktToStringBuilderCached(
+            cache,
+            offset,
+            &wkbString->firstByte,
+            reductionMode,
+            decimalPlaces,
+            &builder,
+            exception);
+        if (EXCEPTION_FAILED) {
+            return toWktResult;
         }
+        completeToStringStream(&builder, pending, stream);
+        toWktResult = {
+            builder.added,
+            builder.full,
+        };
         return toWktResult;
     }
 }
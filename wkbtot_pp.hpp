@@ -30,12 +30,13 @@
 namespace FiftyoneDegrees::Common {
     /**
      * Converts WKB "string" to WKT string and pushes into a string stream.
+     * Nothing is pushed if an exception occurs.
      * @param wkbString "string" containing WKB geometry.
      * @param reductionMode type/value reduction applied to decrease WKB size.
      * @param stream string stream to push WKT into.
      * @param decimalPlaces precision for numbers (places after the decimal dot).
      * @param exception pointer to the exception struct.
-     * @return How many bytes were written to the buffer and if it was too small.
+     * @return How many bytes were written to the stream.
      */
     fiftyoneDegreesWkbtotResult writeWkbStringToStringStream(
         const fiftyoneDegreesVarLengthByteArray *wkbString,
@@ -43,6 +44,29 @@ namespace FiftyoneDegrees::Common {
         std::stringstream &stream,
         uint8_t decimalPlaces,
         fiftyoneDegreesException *exception);
+
+    /**
+     * Converts WKB "string" to WKT string and pushes into a string stream
+     * using a cache of WKT strings already rendered. See
+     * #fiftyoneDegreesWriteWkbAsWktToStringBuilderCached. Nothing is pushed
+     * if an exception occurs.
+     * @param cache of rendered WKT strings, or nullptr to always render.
+     * @param offset of the WKB "string" in the strings collection.
+     * @param wkbString "string" containing WKB geometry.
+     * @param reductionMode type/value reduction applied to decrease WKB size.
+     * @param stream string stream to push WKT into.
+     * @param decimalPlaces precision for numbers (places after the decimal dot).
+     * @param exception pointer to the exception struct.
+     * @return How many bytes were written to the stream.
+     */
+    fiftyoneDegreesWkbtotResult writeWkbStringToStringStream(
+        fiftyoneDegreesRenderCache *cache,
+        uint32_t offset,
+        const fiftyoneDegreesVarLengthByteArray *wkbString,
+        fiftyoneDegreesWkbtotReductionMode reductionMode,
+        std::stringstream &stream,
+        uint8_t decimalPlaces,
+        fiftyoneDegreesException *exception);
 }
 
 #endif //FIFTYONE_DEGREES_WKBTOT_HPP_INCLUDED